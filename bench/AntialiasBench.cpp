@@ -0,0 +1,238 @@
+/*!
+    /file AntialiasBench.cpp
+    /brief Frame time and edge quality of the anti-aliasing choices on an offscreen context
+    A book open on a text page, turned and tilted so its borders, ruled lines
+    and stroke text cross the pixel grid at odd angles, is drawn without
+    anti-aliasing, with 4x multisampling resolved by a blit, and filtered by
+    the fragment program of Antialiasing at every quality level. Each frame
+    is compared with the mean of ANTIALIAS_BENCH_JITTER x ANTIALIAS_BENCH_JITTER
+    frames, each shifted by a fraction of a pixel, so lines keep their width
+    as in the others: the error over the pixels the reference shows an edge
+    in says how well edges are smoothed, the error over the other pixels how
+    much of the rest is blurred.
+*/
+
+#define GL_GLEXT_PROTOTYPES
+#include "../lib/headers/Offscreen.h"
+#include "../lib/headers/Antialiasing.h"
+#include "../lib/headers/Book.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+#define ANTIALIAS_BENCH_FRAMES 20
+#define ANTIALIAS_BENCH_JITTER 4
+
+/*!
+    \struct Framebuffer
+    \brief Framebuffer object the scene is drawn into
+*/
+struct Framebuffer{
+    GLuint framebuffer, renderbuffers[2];
+};
+
+/*!
+    \struct Method
+    \brief Anti-aliasing choice measured
+*/
+struct Method{
+    const char *name;
+    GLint samples; /*!< Samples of the framebuffer drawn into, 0 for one */
+    GLint quality; /*!< Antialiasing quality applied afterwards */
+};
+
+char pageText[] = "A flipbook is a book with a series of pictures.\nThe quick brown fox jumps over the lazy dog.";
+Book book;
+GLuint screen; /*!< Framebuffer of the offscreen context, frames are resolved and read back from it */
+
+/*!
+    \fn createFramebuffer(Framebuffer *target, GLint samples)
+    \brief Color and depth renderbuffers of WINDOW_WIDTH x WINDOW_HEIGHT with samples per pixel, returns 0 when incomplete
+*/
+GLint createFramebuffer(Framebuffer *target, GLint samples){
+    glGenFramebuffers(1, &target->framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, target->framebuffer);
+    glGenRenderbuffers(2, target->renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, target->renderbuffers[0]);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, WINDOW_WIDTH, WINDOW_HEIGHT);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, target->renderbuffers[0]);
+    glBindRenderbuffer(GL_RENDERBUFFER, target->renderbuffers[1]);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, WINDOW_WIDTH, WINDOW_HEIGHT);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target->renderbuffers[1]);
+    GLint complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, screen);
+    return complete;
+}
+
+/*!
+    \fn drawScene(GLfloat dx, GLfloat dy)
+    \brief Draw the book lit as the room does, turned 25 degrees and tilted by 7, shifted by dx, dy pixels
+*/
+void drawScene(GLfloat dx, GLfloat dy){
+    GLfloat LIGHT_AMBIENT[]={0.5f,0.59f, 0.57f, 0.0f};
+    GLfloat LIGHT_DIFFUSE[]={0.73f,0.74f,0.76f,0.22f};
+    GLfloat LIGHT_POSITION[]={350.0f, 300.0f, 20.0f, 999.0f};
+    fbViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+    fbClearColor(0.25, 0.22, 0.2, 1);
+    fbClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadIdentity();
+    fbTranslatef(2 * dx / WINDOW_WIDTH, 2 * dy / WINDOW_HEIGHT, 0);
+    fbPerspective(45, (GLfloat)WINDOW_WIDTH/WINDOW_HEIGHT, 20, 20000);
+    fbMatrixMode(GL_MODELVIEW);
+    fbLoadIdentity();
+    fbLightfv(GL_LIGHT1, GL_AMBIENT, LIGHT_AMBIENT);
+    fbLightfv(GL_LIGHT1, GL_DIFFUSE, LIGHT_DIFFUSE);
+    fbLightfv(GL_LIGHT1, GL_POSITION, LIGHT_POSITION);
+    fbTranslatef(0, 0, -1.8f * book.height);
+    fbRotatef(7, 0, 0, 1);
+    fbRotatef(-25, 0, 1, 0);
+    fbRotatef(10, 1, 0, 0);
+    fbTranslatef(-book.width/2, -book.height/2, 0);
+    fbEnable(GL_LIGHTING);
+    fbEnable(GL_LIGHT0);
+    fbEnable(GL_LIGHT1);
+    fbColor3f(0, 0, 0);
+    book.renderBook();
+    book.renderPage(0);
+    fbDisable(GL_LIGHTING);
+    fbDisable(GL_LIGHT0);
+    fbDisable(GL_LIGHT1);
+}
+
+/*!
+    \fn drawFrame(const Framebuffer *target, Antialiasing *antialiasing, GLuint query)
+    \brief Draw a frame into target, or the framebuffer of the context for NULL, and filter it there
+    A query other than 0 counts the pixels the filter draws
+*/
+void drawFrame(const Framebuffer *target, Antialiasing *antialiasing, GLuint query = 0){
+    glBindFramebuffer(GL_FRAMEBUFFER, target != NULL ? target->framebuffer : screen);
+    drawScene(0, 0);
+    if(target != NULL){ /*!< Resolve the samples as a swap would */
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, target->framebuffer);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, screen);
+        glBlitFramebuffer(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, screen);
+    }
+    if(query != 0)
+        glBeginQuery(GL_SAMPLES_PASSED, query);
+    antialiasing->apply(WINDOW_WIDTH, WINDOW_HEIGHT);
+    if(query != 0)
+        glEndQuery(GL_SAMPLES_PASSED);
+}
+
+/*!
+    \fn readFrame(std::vector<unsigned char> *pixels)
+    \brief Read the RGBA of the frame back
+*/
+void readFrame(std::vector<unsigned char> *pixels){
+    pixels->resize(WINDOW_WIDTH * WINDOW_HEIGHT * 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, screen);
+    glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels->data());
+}
+
+/*!
+    \fn error(const std::vector<unsigned char> &frame, const std::vector<unsigned char> &reference, const std::vector<unsigned char> &edges, GLint onEdges)
+    \brief Root mean square difference of the RGB of frame from the reference, over the pixels on edges or off them
+*/
+double error(const std::vector<unsigned char> &frame, const std::vector<unsigned char> &reference,
+    const std::vector<unsigned char> &edges, GLint onEdges){
+    double sum = 0;
+    size_t count = 0;
+    for(size_t i=0;i<edges.size();i++){
+        if(edges[i] != onEdges)
+            continue;
+        for(int c=0;c<3;c++){
+            double difference = (double)frame[4*i + c] - reference[4*i + c];
+            sum += difference * difference;
+        }
+        count++;
+    }
+    return count > 0 ? sqrt(sum / (3 * count)) : 0;
+}
+
+/*!
+    \fn main()
+    Usage: flipbook_antialias
+*/
+int main(){
+    if(!createOffscreenContext(WINDOW_WIDTH, WINDOW_HEIGHT)){
+        printf("No offscreen GL context, nothing to draw into\n");
+        return -1;
+    }
+    GLint framebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &framebuffer);
+    screen = framebuffer;
+    glShadeModel(GL_SMOOTH);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_NORMALIZE);
+    glEnable(GL_COLOR_MATERIAL);
+    book.pixelError = 0; /*!< Full detail at every sample count */
+    book.addPage(PAGE_TYPE_TEXT, pageText);
+    Framebuffer multisampled;
+    if(!createFramebuffer(&multisampled, 4)){
+        printf("%s cannot draw into a framebuffer of 4 samples\n", (const char*)glGetString(GL_RENDERER));
+        return -1;
+    }
+    static const Method methods[] = {
+        {"no AA", 0, ANTIALIASING_OFF},
+        {"MSAA 4x", 4, ANTIALIASING_OFF},
+        {"FXAA low", 0, ANTIALIASING_LOW},
+        {"FXAA medium", 0, ANTIALIASING_MEDIUM},
+        {"FXAA high", 0, ANTIALIASING_HIGH}
+    };
+    /*! Reference frame, and the pixels it shows an edge in, where the frame drawn with one sample differs */
+    std::vector<unsigned char> referencePixels(WINDOW_WIDTH * WINDOW_HEIGHT * 4), aliased, pixels, edges(WINDOW_WIDTH * WINDOW_HEIGHT);
+    std::vector<GLint> sum(referencePixels.size(), 0);
+    for(int j=0;j<ANTIALIAS_BENCH_JITTER * ANTIALIAS_BENCH_JITTER;j++){
+        drawScene((j % ANTIALIAS_BENCH_JITTER + 0.5f) / ANTIALIAS_BENCH_JITTER - 0.5f,
+            (j / ANTIALIAS_BENCH_JITTER + 0.5f) / ANTIALIAS_BENCH_JITTER - 0.5f);
+        readFrame(&pixels);
+        for(size_t i=0;i<sum.size();i++)
+            sum[i] += pixels[i];
+    }
+    for(size_t i=0;i<sum.size();i++)
+        referencePixels[i] = (sum[i] + ANTIALIAS_BENCH_JITTER * ANTIALIAS_BENCH_JITTER / 2) / (ANTIALIAS_BENCH_JITTER * ANTIALIAS_BENCH_JITTER);
+    Antialiasing off;
+    drawFrame(NULL, &off);
+    readFrame(&aliased);
+    GLint noOfEdges = 0;
+    for(size_t i=0;i<edges.size();i++){
+        edges[i] = abs(aliased[4*i] - referencePixels[4*i]) + abs(aliased[4*i + 1] - referencePixels[4*i + 1])
+            + abs(aliased[4*i + 2] - referencePixels[4*i + 2]) > 6;
+        noOfEdges += edges[i];
+    }
+    printf("%s, %dx%d frame, %d edge pixels against %d jittered frames, mean of %d frames\n",
+        (const char*)glGetString(GL_RENDERER), WINDOW_WIDTH, WINDOW_HEIGHT, noOfEdges,
+        ANTIALIAS_BENCH_JITTER * ANTIALIAS_BENCH_JITTER, ANTIALIAS_BENCH_FRAMES);
+    printf("%-12s %9s %9s %11s %11s %8s\n", "method", "frame ms", "extra ms", "edge error", "other error", "blended");
+    GLuint query;
+    glGenQueries(1, &query);
+    double noAntialiasing = 0;
+    for(size_t m=0;m<sizeof(methods)/sizeof(methods[0]);m++){
+        const Framebuffer *target = methods[m].samples > 0 ? &multisampled : NULL;
+        Antialiasing antialiasing;
+        antialiasing.setQuality(methods[m].quality);
+        drawFrame(target, &antialiasing); /*!< Warm up */
+        glFinish();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int i=0;i<ANTIALIAS_BENCH_FRAMES;i++){
+            drawFrame(target, &antialiasing);
+            glFinish();
+        }
+        double frameTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+            / ANTIALIAS_BENCH_FRAMES;
+        if(m == 0)
+            noAntialiasing = frameTime;
+        readFrame(&pixels);
+        GLuint blended = 0; /*!< Pixels on an edge, drawn by both passes of the filter */
+        drawFrame(target, &antialiasing, query);
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &blended);
+        blended /= 2;
+        printf("%-12s %9.2f %9.2f %11.2f %11.2f %8u\n", methods[m].name, frameTime, frameTime - noAntialiasing,
+            error(pixels, referencePixels, edges, 1), error(pixels, referencePixels, edges, 0), blended);
+        antialiasing.frames = 0; /*!< Not a frame of the application, nothing to report */
+    }
+    return 0;
+}
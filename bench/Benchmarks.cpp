@@ -0,0 +1,225 @@
+/*!
+    /file Benchmarks.cpp
+    /brief CPU-side microbenchmarks for the drawing code
+    Runs the drawing code against the recording GL backend, so no GL context
+    or display is required. Reports ns/op, calls/op and vertices/op.
+*/
+
+#include "../lib/headers/Book.h"
+#include "../components/headers/Drawings.h"
+#include "../components/headers/Room.h"
+#include "../lib/headers/FrameArena.h"
+#include "../lib/headers/FramePipeline.h"
+#include "../lib/headers/Library.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+typedef void (*DrawingFunction)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+
+/*!
+    \struct Benchmark
+    \brief A named benchmark and the function it measures
+*/
+struct Benchmark{
+    const char *name;
+    void (*run)(void*);
+    void *argument;
+};
+
+/*!
+    \struct Orbit
+    \brief Distance and pixel error the orbit benchmarks look at the book with
+*/
+struct Orbit{
+    GLfloat distance, pixelError;
+};
+
+GLRecorder recorder;
+char shortText[] = "\n The \n   TETRIS  \n Game";
+char longText[] = "A flipbook is a book with a series of pictures that vary gradually from one page to the next, "
+    "so that when the pages are turned rapidly the pictures appear to animate by simulating motion.\n"
+    "The quick brown fox jumps over the lazy dog.";
+Page shortTextPage(PAGE_TYPE_TEXT, BOOK_BORDER_SIZE, BOOK_BORDER_SIZE, 0, shortText);
+Page longTextPage(PAGE_TYPE_TEXT, BOOK_BORDER_SIZE, BOOK_BORDER_SIZE, 0, longText);
+Book book;
+Book thinBook, thickBook, orbitBook;
+Orbit orbits[] = {{900, 0}, {900, PAGE_DETAIL_PIXEL_ERROR}, {10000, 0}, {10000, PAGE_DETAIL_PIXEL_ERROR}};
+GLfloat orbitAngle = 0;
+Library library;
+FramePipeline pipeline;
+CommandBuffer serialFrame;
+GLRecorder serialRecorder;
+
+void runRenderText(void *page){ ((Page*)page)->renderText(); }
+void runSetPageLines(void *page){ ((Page*)page)->setPageLines(); }
+void runRenderPage(void *page){ ((Page*)page)->renderPage(); }
+void runCubeConstruction(void*){ cubeConstruction(0, 0, 0, PAGE_WIDTH, PAGE_HEIGHT, -PAGE_THICKNESS); }
+void runFillFaces(void*){ book.fillFaces(book.x + book.width, book.y + book.height, book.z - BOOK_THICKNESS); }
+void runRenderBook(void*){ book.renderBook(); }
+void runRecordBookPage(void*){ book.pages[0]->content[PAGE_DETAIL_FULL].invalidate(); book.renderPage(0); }
+void runReplayBookPage(void*){ book.renderPage(0); }
+void runDrawRoom(void*){ drawRoom(); }
+void runRenderStacks(void *book){ ((Book*)book)->renderStacks(((Book*)book)->noOfPages/2); }
+void runBuildStacks(void *book){ ((Book*)book)->buildStacks(((Book*)book)->noOfPages/2); }
+
+/*!
+    \fn runOrbit(void *orbit)
+    \brief Draw the pages of a book turning around it as in the 360 views
+    Every run moves on by 7 degrees, so pages are seen from the front, edge on and from behind.
+*/
+void runOrbit(void *orbit){
+    orbitBook.pixelError = ((Orbit*)orbit)->pixelError;
+    fbViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadIdentity();
+    fbPerspective(45, (GLfloat)WINDOW_WIDTH/WINDOW_HEIGHT, 20, 20000);
+    fbMatrixMode(GL_MODELVIEW);
+    fbLoadIdentity();
+    fbTranslatef(0, 0, -((Orbit*)orbit)->distance);
+    fbRotatef(orbitAngle, 0, 1, 0);
+    fbTranslatef(-BOOK_WIDTH/2, -BOOK_HEIGHT/2, 0);
+    for(int i=0;i<orbitBook.noOfPages;i++)
+        orbitBook.renderPage(i);
+    orbitAngle = fmodf(orbitAngle + 7, 360);
+}
+
+/*!
+    \fn runLibrary(void*)
+    \brief Cull, batch and draw the library from the middle of the hall
+*/
+void runLibrary(void*){
+    GLfloat eye[] = {0, LIBRARY_EYE_HEIGHT, -library.length/2};
+    library.update(eye, 20, (GLfloat)WINDOW_WIDTH/WINDOW_HEIGHT, -1);
+    library.render();
+}
+
+/*!
+    \fn prepareBookFrame(void*)
+    \brief Build a frame of a big book from scratch: room, book shell and four text pages
+*/
+void prepareBookFrame(void*){
+    drawRoom();
+    book.renderBook();
+    for(int i=0;i<4;i++){
+        book.pages[0]->content[PAGE_DETAIL_FULL].invalidate();
+        book.renderPage(0);
+    }
+}
+
+/*!
+    \fn runSerialFrame(void*)
+    \brief Prepare a frame and submit it on the same thread
+*/
+void runSerialFrame(void*){
+    serialFrame.clear();
+    serialRecorder.reset();
+    setGLBackend(BACKEND_RECORDING, &serialRecorder);
+    prepareBookFrame(NULL);
+    setGLBackend(BACKEND_RECORDING, &recorder);
+    serialFrame.replay();
+}
+
+/*!
+    \fn runPipelinedFrame(void*)
+    \brief Submit frames until the worker has prepared a new one
+*/
+void runPipelinedFrame(void*){
+    GLuint prepared = pipeline.framesPrepared;
+    GLint state = 0;
+    do{
+        recorder.reset();
+        pipeline.submit(&state)->replay();
+    }while(pipeline.framesPrepared == prepared);
+}
+void runDrawing(void *function){
+    ((DrawingFunction)function)(BOOK_BORDER_SIZE + MARGIN_WIDTH, BOOK_BORDER_SIZE, 0, PAGE_WIDTH, PAGE_HEIGHT - MARGIN_HEIGHT);
+}
+
+/*!
+    \fn measure(Benchmark *benchmark)
+    \brief Run a benchmark for at least BENCH_MIN_TIME_MS and print the results
+*/
+void measure(Benchmark *benchmark){
+    using namespace std::chrono;
+    long iterations = 0, batch = 1;
+    double elapsed = 0;
+    recorder.reset();
+    benchmark->run(benchmark->argument); /*!< Warm up */
+    while(elapsed < BENCH_MIN_TIME_MS * 1e6){
+        steady_clock::time_point start = steady_clock::now();
+        for(long i=0;i<batch;i++){
+            recorder.reset();
+            frameArena()->reset();
+            benchmark->run(benchmark->argument);
+        }
+        elapsed += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+        iterations += batch;
+        batch *= 2;
+    }
+    printf("%-28s %10ld %12.1f %10u %12u\n", benchmark->name, iterations, elapsed / iterations,
+        recorder.totalCalls, recorder.vertices);
+}
+
+/*!
+    \fn main(int argc, char **argv)
+    Runs every benchmark whose name contains argv[1], or all of them.
+*/
+int main(int argc, char **argv){
+    static const DrawingFunction levels[] = {
+        level, level1, level2, level3, level4, level5, level6, level7, level8, level9, level10, level11,
+        level12, level13, level14, level15, level16, level17, level18, level19, level20, level21, level22
+    };
+    static char levelNames[23][16];
+    Benchmark benchmarks[64] = {
+        {"Page::renderText short", runRenderText, &shortTextPage},
+        {"Page::renderText long", runRenderText, &longTextPage},
+        {"Page::setPageLines", runSetPageLines, &shortTextPage},
+        {"Page::renderPage", runRenderPage, &longTextPage},
+        {"cubeConstruction", runCubeConstruction, NULL},
+        {"Book::fillFaces", runFillFaces, NULL},
+        {"Book::renderBook", runRenderBook, NULL},
+        {"Book::renderPage record", runRecordBookPage, NULL},
+        {"Book::renderPage replay", runReplayBookPage, NULL},
+        {"drawRoom", runDrawRoom, NULL},
+        {"Frame serial", runSerialFrame, NULL},
+        {"Frame pipelined", runPipelinedFrame, NULL},
+        {"Book::renderStacks 25", runRenderStacks, &thinBook},
+        {"Book::renderStacks 5000", runRenderStacks, &thickBook},
+        {"Book::buildStacks 25", runBuildStacks, &thinBook},
+        {"Book::buildStacks 5000", runBuildStacks, &thickBook},
+        {"Library::update 10000", runLibrary, NULL},
+        {"Book orbit near full", runOrbit, &orbits[0]},
+        {"Book orbit near LOD", runOrbit, &orbits[1]},
+        {"Book orbit far full", runOrbit, &orbits[2]},
+        {"Book orbit far LOD", runOrbit, &orbits[3]}
+    };
+    int noOfBenchmarks = 21;
+    book.addPage(PAGE_TYPE_TEXT, longText);
+    for(int i=0;i<5000;i++){
+        if(i < 25)
+            thinBook.addPage(PAGE_TYPE_TEXT, shortText);
+        thickBook.addPage(PAGE_TYPE_TEXT, shortText);
+    }
+    library.build(LIBRARY_BENCH_BOOKS);
+    orbitBook.addPage(PAGE_TYPE_TEXT, longText);
+    orbitBook.addPage(PAGE_TYPE_TEXT, shortText);
+    orbitBook.addPage(PAGE_TYPE_DRAWING, level21);
+    orbitBook.addPage(PAGE_TYPE_DRAWING, level13);
+    serialRecorder.captureVertices = 0;
+    serialRecorder.commands = &serialFrame;
+    pipeline.start(prepareBookFrame, sizeof(GLint));
+    for(int i=0;i<23;i++){
+        snprintf(levelNames[i], sizeof(levelNames[i]), i == 0 ? "level" : "level%d", i);
+        Benchmark drawingBenchmark = {levelNames[i], runDrawing, (void*)levels[i]};
+        benchmarks[noOfBenchmarks++] = drawingBenchmark;
+    }
+    setGLBackend(BACKEND_RECORDING, &recorder);
+    printf("%-28s %10s %12s %10s %12s\n", "benchmark", "iterations", "ns/op", "calls/op", "vertices/op");
+    for(int i=0;i<noOfBenchmarks;i++)
+        if(argc < 2 || strstr(benchmarks[i].name, argv[1]) != NULL)
+            measure(&benchmarks[i]);
+    printf("Frame worker parked %u times in %u frames\n", pipeline.workerParks, pipeline.framesPrepared);
+    pipeline.stop();
+    return 0;
+}
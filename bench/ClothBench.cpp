@@ -0,0 +1,96 @@
+/*!
+    /file ClothBench.cpp
+    /brief Time the cloth solver per animation step for grid sizes and thread counts
+    Every grid is turned over like a page, driven along one edge and by a
+    corner, for FLIP_STEPS steps. The time of every step is measured with
+    the constraints solved on the calling thread only and on thread pools of
+    several sizes. The particles must end up the same bit for bit whatever
+    the number of threads, exits with 1 when they do not.
+*/
+
+#include "../lib/headers/Cloth.h"
+#include "../lib/headers/Matrix.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+static const GLint FLIP_STEPS = 100, SIZE = 300;
+GLint failures = 0;
+
+/*!
+    \fn drive(Cloth *cloth, GLfloat angle)
+    \brief Hold the first two columns and the bottom far corner where a rigid page turned by angle would be
+*/
+void drive(Cloth *cloth, GLfloat angle){
+    GLfloat m[16];
+    rotationMatrix(m, angle, 0, -1, 0);
+    for(int j=0;j<cloth->rows;j++)
+        for(int i=0;i<cloth->columns;i++){
+            GLint particle = j*cloth->columns + i;
+            if(i >= 2 && !(j == 0 && i == cloth->columns - 1))
+                continue;
+            GLfloat rest[3] = {(GLfloat)SIZE * i / (cloth->columns - 1), (GLfloat)SIZE * j / (cloth->rows - 1), 0};
+            cloth->inverseMass[particle] = 0;
+            transformPoints(&cloth->targets[particle*3], m, rest, 1);
+        }
+}
+
+/*!
+    \fn flip(GLint grid, ThreadPool *pool, std::vector<double> *times, std::vector<GLfloat> *positions)
+    \brief Turn a grid by grid cloth over, times receives the milliseconds of every step and positions where it ended
+*/
+void flip(GLint grid, ThreadPool *pool, std::vector<double> *times, std::vector<GLfloat> *positions){
+    using namespace std::chrono;
+    Cloth cloth;
+    cloth.create(grid, grid, 0, 0, 0, SIZE, SIZE);
+    cloth.floorX = 0;
+    cloth.floorZ[0] = 0;
+    cloth.floorZ[1] = 0;
+    times->clear();
+    for(int step=0;step<FLIP_STEPS;step++){
+        drive(&cloth, 180.0f * (step + 1) / FLIP_STEPS);
+        steady_clock::time_point start = steady_clock::now();
+        cloth.step(CLOTH_SUBSTEPS, CLOTH_ITERATIONS, pool);
+        times->push_back(duration<double, std::milli>(steady_clock::now() - start).count());
+    }
+    *positions = cloth.positions;
+}
+
+/*!
+    \fn main()
+    \brief Time every grid size on every thread count, exits with 1 when the thread counts disagree
+*/
+int main(){
+    const GLint grids[] = {16, 32, 64, 128};
+    GLint hardware = std::thread::hardware_concurrency();
+    GLint threads[] = {1, 2, 4, hardware > 0 ? hardware : 1};
+    printf("%d steps of %d substeps of %d passes, chunks of at least %d constraints\n\n",
+        FLIP_STEPS, CLOTH_SUBSTEPS, CLOTH_ITERATIONS, CLOTH_MIN_CHUNK);
+    printf("%-8s %8s %12s %12s %12s %10s\n", "grid", "threads", "mean ms", "p99 ms", "max ms", "speedup");
+    for(size_t g=0;g<sizeof(grids)/sizeof(grids[0]);g++){
+        std::vector<GLfloat> reference, positions;
+        std::vector<double> times;
+        double single = 0;
+        for(size_t t=0;t<sizeof(threads)/sizeof(threads[0]);t++){
+            ThreadPool *pool = threads[t] > 1 ? new ThreadPool(threads[t] - 1) : NULL; /*!< The calling thread solves a chunk too */
+            flip(grids[g], pool, &times, &positions);
+            delete pool;
+            double mean = 0;
+            for(size_t i=0;i<times.size();i++)
+                mean += times[i] / times.size();
+            std::sort(times.begin(), times.end());
+            if(t == 0){
+                single = mean;
+                reference = positions;
+            }
+            GLint same = memcmp(reference.data(), positions.data(), reference.size() * sizeof(GLfloat)) == 0;
+            failures += !same;
+            printf("%3dx%-4d %8d %12.4f %12.4f %12.4f %9.2fx %s\n", grids[g], grids[g], threads[t], mean,
+                times[times.size() * 99 / 100], times.back(), single / mean, same ? "" : "MISMATCH");
+        }
+    }
+    return failures > 0;
+}
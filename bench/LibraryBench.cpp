@@ -0,0 +1,125 @@
+/*!
+    /file LibraryBench.cpp
+    /brief Stress benchmark of the library view
+    Walks a camera down a library of thousands of books, with and without
+    frustum culling and level of detail, and reports the time per frame.
+    Frames are drawn into an offscreen framebuffer, see createOffscreenContext,
+    so no display is required and software GL can be measured.
+    Without EGL only the culling and batching on the CPU is measured.
+*/
+
+#include "../lib/headers/Library.h"
+#include "../lib/headers/Offscreen.h"
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*!
+    \struct LibraryScenario
+    \brief Culling and level of detail settings measured together
+*/
+struct LibraryScenario{
+    const char *name;
+    GLint culling, levelOfDetail;
+};
+
+static const GLint FRAME_WIDTH = 1024, FRAME_HEIGHT = 768;
+Library library;
+GLint noOfFrames = LIBRARY_BENCH_FRAMES;
+
+/*!
+    \fn setupLighting()
+    \brief Lamp and clear color the library is drawn with
+*/
+void setupLighting(){
+    GLfloat LIGHT_AMBIENT[]={0.35f, 0.33f, 0.3f, 1.0f};
+    GLfloat LIGHT_DIFFUSE[]={0.8f, 0.75f, 0.65f, 1.0f};
+    glClearColor(0.1f, 0.08f, 0.06f, 1.0f);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_NORMALIZE);
+    glEnable(GL_COLOR_MATERIAL);
+    glEnable(GL_LIGHTING);
+    glEnable(GL_LIGHT1);
+    glLightfv(GL_LIGHT1, GL_AMBIENT, LIGHT_AMBIENT);
+    glLightfv(GL_LIGHT1, GL_DIFFUSE, LIGHT_DIFFUSE);
+}
+
+/*!
+    \fn measure(const LibraryScenario *scenario, GLint draw)
+    \brief Walk down the hall for noOfFrames frames and print the averages
+    cpu -> culling and batching, draw -> submitting the batches
+    and waiting for GL to finish the frame.
+*/
+void measure(const LibraryScenario *scenario, GLint draw){
+    using namespace std::chrono;
+    GLfloat aspect = (GLfloat)FRAME_WIDTH/FRAME_HEIGHT;
+    double cpu = 0, total = 0, books[DETAIL_LEVELS + 1] = {0, 0, 0, 0}, vertices = 0;
+    std::vector<double> frames;
+    library.culling = scenario->culling;
+    library.levelOfDetail = scenario->levelOfDetail;
+    for(int i=0;i<noOfFrames;i++){
+        GLfloat eye[3] = {0, LIBRARY_EYE_HEIGHT, LIBRARY_CASE_WIDTH/2 - library.length * i / noOfFrames};
+        GLfloat yaw = 30 * sinf(i * 0.2f);
+        steady_clock::time_point start = steady_clock::now();
+        library.update(eye, yaw, aspect, -1);
+        steady_clock::time_point culled = steady_clock::now();
+        if(draw){
+            GLfloat LIGHT_POSITION[]={eye[0], LIBRARY_SHELVES*LIBRARY_SHELF_HEIGHT, eye[2], 1.0f};
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            library.loadCamera();
+            glLightfv(GL_LIGHT1, GL_POSITION, LIGHT_POSITION);
+            library.render();
+            glFinish();
+        }
+        double frame = duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1e6;
+        cpu += duration_cast<nanoseconds>(culled - start).count() / 1e6;
+        total += frame;
+        frames.push_back(frame);
+        for(int d=0;d<DETAIL_LEVELS;d++){
+            books[d] += library.visible[d];
+            vertices += library.batches[d].size() / 9;
+        }
+        books[DETAIL_LEVELS] += library.culled;
+    }
+    std::sort(frames.begin(), frames.end());
+    printf("%-16s %9.2f %9.2f %9.2f %9.2f %8.0f %8.0f %8.0f %8.0f %10.0f\n", scenario->name,
+        cpu / noOfFrames, (total - cpu) / noOfFrames, total / noOfFrames, frames[frames.size()*95/100],
+        books[DETAIL_FULL] / noOfFrames, books[DETAIL_BOX] / noOfFrames, books[DETAIL_IMPOSTOR] / noOfFrames,
+        books[DETAIL_LEVELS] / noOfFrames, vertices / noOfFrames);
+}
+
+/*!
+    \fn main(int argc, char **argv)
+    Usage: flipbook_library [books] [frames]
+*/
+int main(int argc, char **argv){
+    static const LibraryScenario scenarios[] = {
+        {"cull + LOD", 1, 1},
+        {"cull only", 1, 0},
+        {"LOD only", 0, 1},
+        {"none", 0, 0}
+    };
+    GLint noOfBooks = argc > 1 ? atoi(argv[1]) : LIBRARY_BENCH_BOOKS;
+    if(argc > 2)
+        noOfFrames = atoi(argv[2]);
+    if(noOfBooks <= 0 || noOfFrames <= 0){
+        printf("Usage: flipbook_library [books] [frames]\n");
+        return -1;
+    }
+    library.build(noOfBooks);
+    GLint draw = createOffscreenContext(FRAME_WIDTH, FRAME_HEIGHT);
+    if(draw){
+        setupLighting();
+        printf("%s, %dx%d offscreen\n", (const char*)glGetString(GL_RENDERER), FRAME_WIDTH, FRAME_HEIGHT);
+    }
+    else
+        printf("No offscreen GL context, measuring culling and batching only\n");
+    printf("%d books in %d bookcases, %d frames\n", noOfBooks, (GLint)library.bookcases.size(), noOfFrames);
+    printf("%-16s %9s %9s %9s %9s %8s %8s %8s %8s %10s\n", "scenario", "cpu ms", "draw ms", "frame ms",
+        "p95 ms", "full", "box", "impostor", "culled", "vertices");
+    for(size_t i=0;i<sizeof(scenarios)/sizeof(scenarios[0]);i++)
+        measure(&scenarios[i], draw);
+    return 0;
+}
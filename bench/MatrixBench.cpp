@@ -0,0 +1,312 @@
+/*!
+    /file MatrixBench.cpp
+    /brief Check the matrix library against GL and GLU and measure its throughput
+    Every transform is built by the matrix library and by the fixed function
+    calls it replaces, on an offscreen GL context, and the largest difference
+    is reported. Without a GL context the products are only checked against the
+    reference product. Exits with 1 when a check fails.
+*/
+
+#include "../lib/headers/Matrix.h"
+#include "../lib/headers/Offscreen.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static const GLfloat TOLERANCE = 1e-5f; /*!< Largest difference, relative to the size of the values */
+static const GLint MULTIPLIES = 2000000, BATCH = 4096, POINTS = 100000, FRAMES = 200000;
+GLint failures = 0;
+volatile GLfloat sink; /*!< Keeps timed results alive */
+
+/*!
+    \fn difference(const GLfloat *a, const GLfloat *b, GLint count)
+    \brief Largest difference between a and b, relative to values above 1
+*/
+GLfloat difference(const GLfloat *a, const GLfloat *b, GLint count){
+    GLfloat largest = 0;
+    for(int i=0;i<count;i++){
+        GLfloat size = fmaxf(1, fmaxf(fabsf(a[i]), fabsf(b[i])));
+        largest = fmaxf(largest, fabsf(a[i] - b[i]) / size);
+    }
+    return largest;
+}
+
+/*!
+    \fn report(const char *name, GLfloat error)
+    \brief Print a check and count it when it fails
+*/
+void report(const char *name, GLfloat error){
+    GLint failed = !(error <= TOLERANCE);
+    failures += failed;
+    printf("%-36s %12.3g %s\n", name, error, failed ? "FAIL" : "ok");
+}
+
+/*!
+    \fn randomValue(GLfloat range)
+    \brief Uniform value in -range to range
+*/
+GLfloat randomValue(GLfloat range){
+    return range * (2.0f * rand() / RAND_MAX - 1);
+}
+
+/*!
+    \fn glMatrix(GLfloat m[16])
+    \brief Current modelview matrix of GL, left loaded with identity
+*/
+void glMatrix(GLfloat m[16]){
+    glGetFloatv(GL_MODELVIEW_MATRIX, m);
+    glLoadIdentity();
+}
+
+/*!
+    \fn checkAgainstGL()
+    \brief Build every kind of transform with GL and GLU and with the matrix library
+*/
+void checkAgainstGL(){
+    GLfloat ours[16], theirs[16], lookAt = 0, perspective = 0, ortho = 0, rotate = 0, chain = 0;
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    for(int i=0;i<1000;i++){
+        GLfloat eye[3] = {randomValue(3000), randomValue(3000), randomValue(3000)}, center[3] = {randomValue(500), randomValue(500), randomValue(500)};
+        gluLookAt(eye[0], eye[1], eye[2], center[0], center[1], center[2], 0, 1, 0);
+        glMatrix(theirs);
+        lookAtMatrix(ours, eye[0], eye[1], eye[2], center[0], center[1], center[2], 0, 1, 0);
+        lookAt = fmaxf(lookAt, difference(ours, theirs, 16));
+        GLfloat fovy = 10 + rand() % 120, aspect = 0.5f + rand() % 100 / 50.0f, zNear = 1 + rand() % 100;
+        GLfloat zFar = zNear + 100 + rand() % 20000;
+        gluPerspective(fovy, aspect, zNear, zFar);
+        glMatrix(theirs);
+        perspectiveMatrix(ours, fovy, aspect, zNear, zFar);
+        perspective = fmaxf(perspective, difference(ours, theirs, 16));
+        GLfloat box[6] = {-randomValue(2000) - 1, randomValue(2000) + 2001, -randomValue(2000) - 1, randomValue(2000) + 2001, -5000, 5000};
+        glOrtho(box[0], box[1], box[2], box[3], box[4], box[5]);
+        glMatrix(theirs);
+        orthoMatrix(ours, box[0], box[1], box[2], box[3], box[4], box[5]);
+        ortho = fmaxf(ortho, difference(ours, theirs, 16));
+        GLfloat angle = randomValue(720), axis[3] = {randomValue(1), randomValue(1), randomValue(1)};
+        glRotatef(angle, axis[0], axis[1], axis[2]);
+        glMatrix(theirs);
+        rotationMatrix(ours, angle, axis[0], axis[1], axis[2]);
+        rotate = fmaxf(rotate, difference(ours, theirs, 16));
+        /*! Page flip and view rotation chain as the scene used to issue it */
+        identityMatrix(ours);
+        gluLookAt(eye[0], eye[1], eye[2], 0, 0, 0, 0, 50, 0);
+        lookAtMatrix(ours, eye[0], eye[1], eye[2], 0, 0, 0, 0, 50, 0);
+        glRotatef(angle, axis[0], axis[1], axis[2]);
+        rotateMatrix(ours, angle, axis[0], axis[1], axis[2]);
+        glTranslatef(-100, -100, 50);
+        translateMatrix(ours, -100, -100, 50);
+        glScalef(0.5f, 2, 1);
+        scaleMatrix(ours, 0.5f, 2, 1);
+        glTranslatef(0, 420, 0);
+        translateMatrix(ours, 0, 420, 0);
+        glRotatef(angle * 0.5f, -1, -1, 0);
+        rotateMatrix(ours, angle * 0.5f, -1, -1, 0);
+        glTranslatef(0, -420, 0);
+        translateMatrix(ours, 0, -420, 0);
+        glMatrix(theirs);
+        chain = fmaxf(chain, difference(ours, theirs, 16) / 1000); /*!< Translations in the thousands */
+    }
+    report("gluLookAt", lookAt);
+    report("gluPerspective", perspective);
+    report("glOrtho", ortho);
+    report("glRotatef", rotate);
+    report("lookAt, rotate, translate, scale", chain);
+}
+
+/*!
+    \fn checkProducts()
+    \brief Check the vectorized products and the quaternions against the reference
+*/
+void checkProducts(){
+    std::vector<GLfloat> matrices(16*BATCH), products(16*BATCH), points(3*BATCH), moved(3*BATCH);
+    GLfloat a[16], ours[16], theirs[16], single = 0, batch = 0, transformed = 0, quaternion = 0, slerp = 0;
+    for(int i=0;i<16;i++)
+        a[i] = randomValue(10);
+    for(size_t i=0;i<matrices.size();i++)
+        matrices[i] = randomValue(10);
+    for(size_t i=0;i<points.size();i++)
+        points[i] = randomValue(1000);
+    for(int i=0;i<BATCH;i++){
+        multiplyMatrices(ours, a, &matrices[16*i]);
+        multiplyMatricesReference(theirs, a, &matrices[16*i]);
+        single = fmaxf(single, difference(ours, theirs, 16));
+    }
+    multiplyMatrixBatch(products.data(), a, matrices.data(), BATCH);
+    for(int i=0;i<BATCH;i++){
+        multiplyMatricesReference(theirs, a, &matrices[16*i]);
+        batch = fmaxf(batch, difference(&products[16*i], theirs, 16));
+    }
+    transformPoints(moved.data(), a, points.data(), BATCH);
+    for(int i=0;i<BATCH;i++){
+        const GLfloat *p = &points[3*i];
+        for(int row=0;row<3;row++){
+            GLfloat expected = a[row]*p[0] + a[4 + row]*p[1] + a[8 + row]*p[2] + a[12 + row];
+            transformed = fmaxf(transformed, difference(&moved[3*i + row], &expected, 1) / 100);
+        }
+    }
+    for(int i=0;i<1000;i++){
+        GLfloat q[3][4], m[2][16];
+        axisAngleQuaternion(q[0], randomValue(360), randomValue(1), randomValue(1), randomValue(1));
+        axisAngleQuaternion(q[1], randomValue(360), randomValue(1), randomValue(1), randomValue(1));
+        multiplyQuaternions(q[2], q[0], q[1]);
+        quaternionMatrix(m[0], q[0]);
+        quaternionMatrix(m[1], q[1]);
+        multiplyMatrices(theirs, m[0], m[1]);
+        quaternionMatrix(ours, q[2]);
+        quaternion = fmaxf(quaternion, difference(ours, theirs, 16));
+        slerpQuaternions(q[2], q[0], q[1], 0);
+        slerp = fmaxf(slerp, difference(q[2], q[0], 4));
+        slerpQuaternions(q[2], q[0], q[1], 1);
+        quaternionMatrix(ours, q[2]);
+        slerp = fmaxf(slerp, difference(ours, m[1], 16));
+    }
+    /*! Halfway between no rotation and 90 degrees is 45 degrees */
+    GLfloat none[4], quarter[4], half[4], expected[4];
+    axisAngleQuaternion(none, 0, 0, 0, 1);
+    axisAngleQuaternion(quarter, 90, 0, 0, 1);
+    axisAngleQuaternion(expected, 45, 0, 0, 1);
+    slerpQuaternions(half, none, quarter, 0.5f);
+    slerp = fmaxf(slerp, difference(half, expected, 4));
+    report("multiplyMatrices", single);
+    report("multiplyMatrixBatch", batch);
+    report("transformPoints", transformed);
+    report("multiplyQuaternions", quaternion);
+    report("slerpQuaternions", slerp);
+}
+
+/*!
+    \fn measure(const char *name, GLint count, const char *unit, F run)
+    \brief Time run and print the rate it reaches
+*/
+template<typename F>
+void measure(const char *name, GLint count, const char *unit, F run){
+    using namespace std::chrono;
+    steady_clock::time_point start = steady_clock::now();
+    run();
+    double seconds = duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1e9;
+    printf("%-36s %9.2f ms %12.1f M%s/s\n", name, seconds * 1e3, count / seconds / 1e6, unit);
+}
+
+/*!
+    \fn measureThroughput(GLint gl)
+    \brief Products, batches and the transforms of a frame, on the CPU and through GL
+*/
+void measureThroughput(GLint gl){
+    std::vector<GLfloat> matrices(16*BATCH), products(16*BATCH), points(3*POINTS), moved(3*POINTS);
+    GLfloat a[16], m[16];
+    for(int i=0;i<16;i++)
+        a[i] = randomValue(1);
+    for(size_t i=0;i<matrices.size();i++)
+        matrices[i] = randomValue(1);
+    for(size_t i=0;i<points.size();i++)
+        points[i] = randomValue(1000);
+    printf("\n%-36s %12s %16s\n", "throughput", "time", "rate");
+    measure("multiplyMatricesReference", MULTIPLIES, "products", [&](){
+        identityMatrix(m);
+        for(int i=0;i<MULTIPLIES;i++)
+            multiplyMatricesReference(m, m, &matrices[16*(i % BATCH)]);
+        sink = m[0];
+    });
+    measure("multiplyMatrices", MULTIPLIES, "products", [&](){
+        identityMatrix(m);
+        for(int i=0;i<MULTIPLIES;i++)
+            multiplyMatrices(m, m, &matrices[16*(i % BATCH)]);
+        sink = m[0];
+    });
+    measure("multiplyMatrixBatch", MULTIPLIES, "products", [&](){
+        for(int i=0;i<MULTIPLIES/BATCH;i++)
+            multiplyMatrixBatch(products.data(), a, matrices.data(), BATCH);
+        sink = products[0];
+    });
+    measure("transformPoints", POINTS * 20, "points", [&](){
+        for(int i=0;i<20;i++)
+            transformPoints(moved.data(), a, points.data(), POINTS);
+        sink = moved[0];
+    });
+    measure("frame transforms on the CPU", FRAMES, "frames", [&](){
+        GLfloat view[16], book[16], flip[16];
+        for(int i=0;i<FRAMES;i++){
+            lookAtMatrix(view, -500, 0, 3000, 0, 0, 0, 0, 80, 0);
+            rotateMatrix(view, i * 0.01f, 0, -1, -1);
+            identityMatrix(book);
+            translateMatrix(book, -100, -100, 0);
+            translateMatrix(book, 10, 20, 50);
+            identityMatrix(flip);
+            translateMatrix(flip, 0, 420, 0);
+            rotateMatrix(flip, i * 0.02f, 0, -1, 0);
+            translateMatrix(flip, 0, -420, 0);
+            multiplyMatrices(book, view, book);
+            multiplyMatrices(flip, book, flip);
+        }
+        sink = flip[0];
+    });
+    if(!gl)
+        return;
+    glMatrixMode(GL_MODELVIEW);
+    measure("frame transforms through GL", FRAMES, "frames", [&](){
+        for(int i=0;i<FRAMES;i++){
+            glLoadIdentity();
+            gluLookAt(-500, 0, 3000, 0, 0, 0, 0, 80, 0);
+            glRotatef(i * 0.01f, 0, -1, -1);
+            glPushMatrix();
+            glTranslatef(-100, -100, 0);
+            glTranslatef(10, 20, 50);
+            glPushMatrix();
+            glTranslatef(0, 420, 0);
+            glRotatef(i * 0.02f, 0, -1, 0);
+            glTranslatef(0, -420, 0);
+            glPopMatrix();
+            glPopMatrix();
+        }
+        glFinish();
+    });
+    measure("frame transforms loaded into GL", FRAMES, "frames", [&](){
+        GLfloat view[16], book[16], flip[16];
+        for(int i=0;i<FRAMES;i++){
+            lookAtMatrix(view, -500, 0, 3000, 0, 0, 0, 0, 80, 0);
+            rotateMatrix(view, i * 0.01f, 0, -1, -1);
+            identityMatrix(book);
+            translateMatrix(book, -100, -100, 0);
+            translateMatrix(book, 10, 20, 50);
+            identityMatrix(flip);
+            translateMatrix(flip, 0, 420, 0);
+            rotateMatrix(flip, i * 0.02f, 0, -1, 0);
+            translateMatrix(flip, 0, -420, 0);
+            multiplyMatrices(book, view, book);
+            multiplyMatrices(flip, book, flip);
+            glLoadMatrixf(view);
+            glLoadMatrixf(book);
+            glLoadMatrixf(flip);
+        }
+        glFinish();
+    });
+}
+
+/*!
+    \fn main()
+    Usage: flipbook_matrix
+*/
+int main(){
+    srand(1);
+#if defined(__SSE__) || defined(_M_X64)
+    printf("Products vectorized with SSE\n");
+#elif defined(__ARM_NEON)
+    printf("Products vectorized with NEON\n");
+#else
+    printf("Products not vectorized\n");
+#endif
+    GLint gl = createOffscreenContext(64, 64);
+    printf("%-36s %12s\n", "check", "max error");
+    if(gl)
+        checkAgainstGL();
+    else
+        printf("No GL context, checking against the reference product only\n");
+    checkProducts();
+    measureThroughput(gl);
+    if(failures > 0)
+        printf("\n%d checks failed\n", failures);
+    return failures > 0;
+}
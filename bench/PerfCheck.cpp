@@ -0,0 +1,291 @@
+/*!
+    /file PerfCheck.cpp
+    /brief Performance regression gate, comparing headless replays of fixed scenarios with a baseline
+    Every scenario is an input journal replayed by ./flipbook --headless
+    PERF_RUNS times. A run gives the median frame time of its steps after
+    PERF_WARMUP_STEPS, the welcome screen runs also the time the room and book
+    took to load. The mean and standard deviation of the runs are compared
+    with PERF_BASELINE: a scenario regresses when it is slower by more than
+    PERF_MIN_REGRESSION of its baseline and by more than PERF_NOISE_SIGMAS
+    standard errors of the difference.
+    A scenario also fails when any frame after the warm up makes a heap
+    allocation, sub-scenes recorded the first time they are shown aside.
+*/
+
+#include "../config/Constants.h"
+#include <algorithm>
+#include <map>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/*!
+    \struct Scenario
+    \brief A workload replayed by perfcheck
+*/
+struct Scenario{
+    const char *name;
+    const char *events; /*!< Journal lines replayed before PERF_STEPS */
+    const char *arguments; /*!< Further arguments of ./flipbook */
+    int startup; /*!< 1 also measures the time until the room and book are loaded */
+};
+
+/*!
+    \struct Result
+    \brief Mean and standard deviation of the runs of a scenario, in ms
+*/
+struct Result{
+    double mean, stddev;
+    int runs;
+};
+
+char pageDirectory[] = "/tmp/flipbook_perfXXXXXX";
+char largePageArguments[64];
+
+/*!
+    \fn writeLargePage()
+    \brief Write the source of a first page of several thousand characters, returns 0 on failure
+*/
+int writeLargePage(){
+    if(mkdtemp(pageDirectory) == NULL)
+        return 0;
+    FILE *file = fopen((std::string(pageDirectory) + "/1" + PAGE_SOURCE_EXTENSION).c_str(), "w");
+    if(file == NULL)
+        return 0;
+    for(int i=0;i<60;i++)
+        fprintf(file, "Line %d of a long page, laid out and drawn every frame. ", i + 1);
+    fclose(file);
+    snprintf(largePageArguments, sizeof(largePageArguments), "--watch-pages %s", pageDirectory);
+    return 1;
+}
+
+/*!
+    \fn removeLargePage()
+    \brief Remove the page source written by writeLargePage
+*/
+void removeLargePage(){
+    unlink((std::string(pageDirectory) + "/1" + PAGE_SOURCE_EXTENSION).c_str());
+    rmdir(pageDirectory);
+}
+
+/*!
+    \fn median(std::vector<double> values)
+    \brief Median of values, 0 when there are none
+*/
+double median(std::vector<double> values){
+    if(values.empty())
+        return 0;
+    std::sort(values.begin(), values.end());
+    size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+/*!
+    \fn summarise(const std::vector<double> *samples)
+    \brief Mean and sample standard deviation of samples
+*/
+Result summarise(const std::vector<double> *samples){
+    Result result = {0, 0, (int)samples->size()};
+    for(size_t i=0;i<samples->size();i++)
+        result.mean += (*samples)[i] / samples->size();
+    for(size_t i=0;i<samples->size() && samples->size() > 1;i++)
+        result.stddev += pow((*samples)[i] - result.mean, 2) / (samples->size() - 1);
+    result.stddev = sqrt(result.stddev);
+    return result;
+}
+
+/*!
+    \fn replay(const Scenario *scenario, double *frameTime, double *startupTime, unsigned long *allocations)
+    \brief Replay a scenario once, returns 0 when ./flipbook fails
+    frameTime -> median frame time after the warm up steps
+    startupTime -> ms until the room and book were loaded, 0 when not reported
+    allocations -> heap allocations of the frames after the warm up steps
+*/
+int replay(const Scenario *scenario, double *frameTime, double *startupTime, unsigned long *allocations){
+    const char *journalFilename = "perfcheck.journal";
+    FILE *journal = fopen(journalFilename, "w");
+    if(journal == NULL)
+        return 0;
+    fprintf(journal, "flipbook input journal 1\n%send %d\n", scenario->events, PERF_STEPS);
+    fclose(journal);
+    std::string command = std::string("./flipbook --headless --replay-input ") + journalFilename + " " + scenario->arguments + " 2>&1";
+    FILE *output = popen(command.c_str(), "r");
+    char line[512];
+    *startupTime = 0;
+    while(output != NULL && fgets(line, sizeof(line), output) != NULL)
+        sscanf(line, "Room and book ready %lf", startupTime);
+    if(output == NULL || pclose(output) != 0)
+        return 0;
+    FILE *profile = fopen(INPUT_PROFILE_LOG, "r");
+    std::vector<double> frameTimes;
+    unsigned step;
+    double time;
+    unsigned long frameAllocations;
+    *allocations = 0;
+    while(profile != NULL && fgets(line, sizeof(line), profile) != NULL)
+        if(sscanf(line, "%u,%lf,%lu", &step, &time, &frameAllocations) == 3 && step >= PERF_WARMUP_STEPS){
+            frameTimes.push_back(time);
+            *allocations += frameAllocations;
+        }
+    if(profile != NULL)
+        fclose(profile);
+    unlink(journalFilename);
+    *frameTime = median(frameTimes);
+    return !frameTimes.empty();
+}
+
+/*!
+    \fn loadBaseline(const char *filename, std::map<std::string, Result> *baseline)
+    \brief Read a baseline written by saveBaseline, returns 0 when there is none
+    The file is JSON with one scenario per line, which is all that is parsed.
+*/
+int loadBaseline(const char *filename, std::map<std::string, Result> *baseline){
+    FILE *file = fopen(filename, "r");
+    char line[256], name[128];
+    Result result;
+    if(file == NULL)
+        return 0;
+    while(fgets(line, sizeof(line), file) != NULL)
+        if(sscanf(line, " \"%127[^\"]\": {\"mean_ms\": %lf, \"stddev_ms\": %lf, \"runs\": %d}",
+                name, &result.mean, &result.stddev, &result.runs) == 4)
+            (*baseline)[name] = result;
+    fclose(file);
+    return 1;
+}
+
+/*!
+    \fn saveBaseline(const char *filename, const std::vector<std::string> *names, std::map<std::string, Result> *results)
+    \brief Write results as the new baseline, returns 0 on failure
+*/
+int saveBaseline(const char *filename, const std::vector<std::string> *names, std::map<std::string, Result> *results){
+    FILE *file = fopen(filename, "w");
+    if(file == NULL)
+        return 0;
+    fprintf(file, "{\n  \"runs\": %d,\n  \"steps\": %d,\n  \"warmup_steps\": %d,\n  \"scenarios\": {\n",
+        PERF_RUNS, PERF_STEPS, PERF_WARMUP_STEPS);
+    for(size_t i=0;i<names->size();i++){
+        Result *result = &(*results)[(*names)[i]];
+        fprintf(file, "    \"%s\": {\"mean_ms\": %.3f, \"stddev_ms\": %.3f, \"runs\": %d}%s\n", (*names)[i].c_str(),
+            result->mean, result->stddev, result->runs, i + 1 < names->size() ? "," : "");
+    }
+    fprintf(file, "  }\n}\n");
+    fclose(file);
+    return 1;
+}
+
+/*!
+    \fn main(int argc, char **argv)
+    Usage: flipbook_perfcheck [--update] [runs]
+    --update -> write the results as the new baseline instead of comparing.
+    Exits with 1 when a scenario regressed or could not be replayed.
+*/
+int main(int argc, char **argv){
+    int update = 0, runs = PERF_RUNS;
+    for(int i=1;i<argc;i++){
+        if(strcmp(argv[i], "--update") == 0)
+            update = 1;
+        else if(atoi(argv[i]) > 0)
+            runs = atoi(argv[i]);
+    }
+    if(!writeLargePage()){
+        printf("Cannot write the page source of the large page scenario\n");
+        return 1;
+    }
+    const Scenario scenarios[] = {
+        {"welcome", "", "", 1},
+        {"room normal view", "0 0 key 13 0 0 0\n0 0 menu 7 0 0 0\n", "", 0},
+        {"room top view", "0 0 key 13 0 0 0\n0 0 menu 8 0 0 0\n", "", 0},
+        {"room bottom view", "0 0 key 13 0 0 0\n0 0 menu 9 0 0 0\n", "", 0},
+        {"room horizontal 360", "0 0 key 13 0 0 0\n0 0 menu 10 0 0 0\n", "", 0},
+        {"room vertical 360", "0 0 key 13 0 0 0\n0 0 menu 14 0 0 0\n", "", 0},
+        {"room h/v 360", "0 0 key 13 0 0 0\n0 0 menu 15 0 0 0\n", "", 0},
+        {"large text page", "0 0 key 13 0 0 0\n0 0 menu 11 0 0 0\n1 0 menu 11 0 0 0\n", largePageArguments, 0},
+        {"1000 page book flip", "0 0 key 13 0 0 0\n0 0 menu 11 0 0 0\n0 0 menu 12 0 0 0\n0 0 menu 12 0 0 0\n", "--pages 1000", 0},
+        {"100000 page overview scroll", "0 0 key 13 0 0 0\n0 0 key 111 0 0 0\n20 0 special 105 0 0 0\n30 0 special 105 0 0 0\n"
+            "40 0 special 105 0 0 0\n50 0 special 105 0 0 0\n60 0 special 105 0 0 0\n70 0 special 105 0 0 0\n"
+            "80 0 special 105 0 0 0\n90 0 special 105 0 0 0\n100 0 special 105 0 0 0\n110 0 special 105 0 0 0\n", "--pages 100000", 0},
+        {"500 page riffle", "0 0 key 13 0 0 0\n20 0 special 105 0 0 0\n20 0 special 105 0 0 0\n20 0 special 105 0 0 0\n"
+            "20 0 special 105 0 0 0\n20 0 special 105 0 0 0\n80 0 special 104 0 0 0\n80 0 special 104 0 0 0\n"
+            "80 0 special 104 0 0 0\n80 0 special 104 0 0 0\n80 0 special 104 0 0 0\n", "--pages 1000", 0},
+        {"2 animated pages", "0 0 key 13 0 0 0\n0 0 menu 7 0 0 0\n",
+            "--animate-page 1 ../img/falling.png --animate-page 2 ../img/falling.png", 0},
+        {"2 vector pages", "0 0 key 13 0 0 0\n0 0 menu 7 0 0 0\n",
+            "--vector-page 1 ../img/tetris.svg --vector-page 2 ../img/tetris.svg", 0}
+    };
+    std::vector<std::string> names;
+    std::map<std::string, Result> results, baseline;
+    std::vector<unsigned long> allocations(sizeof(scenarios)/sizeof(scenarios[0]), 0);
+    int failed = 0;
+    printf("%d runs of %d steps per scenario, the first %d steps left out\n", runs, PERF_STEPS, PERF_WARMUP_STEPS);
+    for(size_t i=0;i<sizeof(scenarios)/sizeof(scenarios[0]);i++){
+        std::vector<double> frameTimes, startupTimes;
+        for(int run=0;run<runs;run++){
+            double frameTime, startupTime;
+            unsigned long runAllocations;
+            if(!replay(&scenarios[i], &frameTime, &startupTime, &runAllocations))
+                break;
+            allocations[i] += runAllocations;
+            frameTimes.push_back(frameTime);
+            if(startupTime > 0)
+                startupTimes.push_back(startupTime);
+        }
+        if((int)frameTimes.size() < runs){
+            printf("%s could not be replayed, is build/flipbook built and can it create an offscreen EGL context?\n", scenarios[i].name);
+            failed = 1;
+            continue;
+        }
+        names.push_back(scenarios[i].name);
+        results[scenarios[i].name] = summarise(&frameTimes);
+        if(scenarios[i].startup && !startupTimes.empty()){
+            names.push_back("startup, room and book loaded");
+            results[names.back()] = summarise(&startupTimes);
+        }
+    }
+    removeLargePage();
+    if(update){
+        if(!saveBaseline(PERF_BASELINE, &names, &results)){
+            printf("Cannot write %s\n", PERF_BASELINE);
+            return 1;
+        }
+        printf("Baseline of %zu scenarios written to %s\n", names.size(), PERF_BASELINE);
+        return failed;
+    }
+    if(!loadBaseline(PERF_BASELINE, &baseline))
+        printf("No baseline in %s, write one with make perfbaseline\n", PERF_BASELINE);
+    printf("%-30s %18s %18s %9s %9s\n", "scenario", "baseline ms", "current ms", "change", "noise ms");
+    for(size_t i=0;i<names.size();i++){
+        Result *current = &results[names[i]];
+        printf("%-30s", names[i].c_str());
+        if(baseline.count(names[i]) == 0){
+            printf(" %18s %9.2f +-%6.2f %9s %9s  new\n", "-", current->mean, current->stddev, "", "");
+            continue;
+        }
+        Result *base = &baseline[names[i]];
+        double difference = current->mean - base->mean;
+        double noise = sqrt(pow(base->stddev, 2) / base->runs + pow(current->stddev, 2) / current->runs);
+        double threshold = std::max(PERF_NOISE_SIGMAS * noise, PERF_MIN_REGRESSION * base->mean);
+        const char *verdict = "ok";
+        if(difference > threshold){
+            verdict = "REGRESSION";
+            failed = 1;
+        }
+        else if(-difference > threshold)
+            verdict = "faster";
+        printf(" %9.2f +-%6.2f %9.2f +-%6.2f %+8.1f%% %9.2f  %s\n", base->mean, base->stddev,
+            current->mean, current->stddev, 100 * difference / base->mean, noise, verdict);
+    }
+    printf("\n%-30s %18s\n", "scenario", "heap allocations");
+    for(size_t i=0;i<allocations.size();i++){
+        const char *verdict = "ok";
+        if(allocations[i] > 0){
+            verdict = "ALLOCATES, see ./flipbook --allocations";
+            failed = 1;
+        }
+        printf("%-30s %18lu  %s\n", scenarios[i].name, allocations[i], verdict);
+    }
+    return failed;
+}
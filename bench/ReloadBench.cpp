@@ -0,0 +1,188 @@
+/*!
+    /file ReloadBench.cpp
+    /brief Time from saving a page source to the page on screen, in a book of thousands of pages
+    Every page has been drawn once, so all of them hold recordings. The open
+    page is then edited, by saving its source into a watched directory or
+    through Book::setPageText, and the frame showing it is drawn. The same
+    edit is also measured rebuilding every page, as without per page tracking.
+    Frames are drawn into an offscreen framebuffer, see createOffscreenContext.
+*/
+
+#include "../lib/headers/Book.h"
+#include "../lib/headers/FrameArena.h"
+#include "../lib/headers/PageWatcher.h"
+#include "../lib/headers/Offscreen.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+static const GLint FRAME_WIDTH = 1024, FRAME_HEIGHT = 768;
+Book book;
+GLint draw, openPage;
+GLRecorder frameRecorder; /*!< Receives the frame when there is no GL context */
+
+/*!
+    \fn pageText(GLint pageIndex, GLint edit)
+    \brief Text of a page, different for every edit
+*/
+std::string pageText(GLint pageIndex, GLint edit){
+    char text[128];
+    snprintf(text, sizeof(text), "\n Page %d\n edit %d\n of the\n flipbook", pageIndex + 1, edit);
+    return text;
+}
+
+/*!
+    \fn loadCamera()
+    \brief Look at the book held up for flipping, as the normal view of the room does
+*/
+void loadCamera(){
+    GLfloat projection[16], view[16];
+    perspectiveMatrix(projection, 45, (GLfloat)FRAME_WIDTH/FRAME_HEIGHT, 20, 20000);
+    lookAtMatrix(view, 0, 0, 1900, 0, 0, 0, 0, 50, 0);
+    translateMatrix(view, -100, -100, 50);
+    fbViewport(0, 0, FRAME_WIDTH, FRAME_HEIGHT);
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadMatrixf(projection);
+    fbMatrixMode(GL_MODELVIEW);
+    fbLoadMatrixf(view);
+}
+
+/*!
+    \fn drawFrame()
+    \brief Draw the open book and wait for GL to finish it
+*/
+void drawFrame(){
+    if(!draw){
+        frameRecorder.reset();
+        setGLBackend(BACKEND_RECORDING, &frameRecorder);
+    }
+    fbClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    loadCamera();
+    book.renderBook();
+    book.renderStacks(openPage);
+    book.renderPage(openPage);
+    book.renderPage(openPage + 1);
+    if(draw)
+        glFinish();
+    setGLBackend(BACKEND_IMMEDIATE);
+    frameArena()->reset();
+}
+
+/*!
+    \fn rebuildEveryPage()
+    \brief Lay out and record every page again, as a rebuild from scratch would
+*/
+void rebuildEveryPage(){
+    CommandBuffer commands;
+    GLRecorder recorder;
+    recorder.captureVertices = 0;
+    recorder.commands = &commands;
+    setGLBackend(BACKEND_RECORDING, &recorder);
+    for(int i=0;i<book.noOfPages;i++){
+        commands.clear();
+        recorder.reset();
+        book.pages[i]->renderPage();
+        book.pages[i]->tinted = 0;
+    }
+    setGLBackend(BACKEND_IMMEDIATE);
+}
+
+/*!
+    \fn report(const char *name, std::vector<double> *times)
+    \brief Print the average, 95th percentile and worst of times in ms
+*/
+void report(const char *name, std::vector<double> *times){
+    double total = 0;
+    std::sort(times->begin(), times->end());
+    for(size_t i=0;i<times->size();i++)
+        total += (*times)[i];
+    printf("%-34s %9.2f %9.2f %9.2f\n", name, total / times->size(), (*times)[times->size()*95/100], times->back());
+}
+
+/*!
+    \fn main(int argc, char **argv)
+    Usage: flipbook_reload [pages] [edits]
+*/
+int main(int argc, char **argv){
+    using namespace std::chrono;
+    GLint noOfPages = argc > 1 ? atoi(argv[1]) : RELOAD_BENCH_PAGES;
+    GLint noOfEdits = argc > 2 ? atoi(argv[2]) : RELOAD_BENCH_EDITS;
+    if(noOfPages < 2 || noOfEdits <= 0){
+        printf("Usage: flipbook_reload [pages] [edits]\n");
+        return -1;
+    }
+    char placeholder[] = "";
+    for(int i=0;i<noOfPages;i++){
+        book.addPage(PAGE_TYPE_TEXT, placeholder);
+        book.setPageText(i, pageText(i, 0).c_str());
+    }
+    openPage = noOfPages / 2;
+    draw = createOffscreenContext(FRAME_WIDTH, FRAME_HEIGHT);
+    if(draw){
+        glEnable(GL_DEPTH_TEST);
+        printf("%s, %dx%d offscreen\n", (const char*)glGetString(GL_RENDERER), FRAME_WIDTH, FRAME_HEIGHT);
+    }
+    else
+        printf("No offscreen GL context, frames are recorded only\n");
+    steady_clock::time_point start = steady_clock::now();
+    frameRecorder.captureVertices = 0;
+    frameRecorder.reset();
+    setGLBackend(BACKEND_RECORDING, &frameRecorder);
+    loadCamera();
+    for(int i=0;i<noOfPages;i++) /*!< Every page recorded once, as if the whole book had been read */
+        book.renderPage(i);
+    setGLBackend(BACKEND_IMMEDIATE);
+    drawFrame();
+    printf("%d pages, all recorded once in %.0f ms, %d edits of page %d\n", noOfPages,
+        duration_cast<microseconds>(steady_clock::now() - start).count() / 1e3, noOfEdits, openPage + 1);
+    printf("%-34s %9s %9s %9s\n", "edit to frame shown", "mean ms", "p95 ms", "max ms");
+    std::vector<double> detected, shown;
+    char directory[] = "/tmp/flipbook_pagesXXXXXX";
+    PageWatcher watcher;
+    if(mkdtemp(directory) != NULL && watcher.watch(directory)){
+        std::string path = std::string(directory) + "/" + std::to_string(openPage + 1) + PAGE_SOURCE_EXTENSION;
+        for(int edit=1;edit<=noOfEdits;edit++){
+            std::string text = pageText(openPage, edit);
+            std::vector<PageSource> sources;
+            steady_clock::time_point saved = steady_clock::now();
+            FILE *file = fopen(path.c_str(), "w");
+            fputs(text.c_str(), file);
+            fclose(file);
+            while(watcher.poll(&sources) == 0)
+                usleep(50);
+            steady_clock::time_point reloaded = steady_clock::now();
+            book.setPageText(sources.back().pageIndex, sources.back().text.c_str());
+            drawFrame();
+            detected.push_back(duration_cast<nanoseconds>(reloaded - saved).count() / 1e6);
+            shown.push_back(duration_cast<nanoseconds>(steady_clock::now() - saved).count() / 1e6);
+        }
+        unlink(path.c_str());
+        rmdir(directory);
+        report("saved file, detected", &detected);
+        report("saved file, on screen", &shown);
+    }
+    else
+        printf("Page sources cannot be watched here, measuring edits through the API only\n");
+    shown.clear();
+    for(int edit=1;edit<=noOfEdits;edit++){
+        steady_clock::time_point edited = steady_clock::now();
+        book.setPageText(openPage, pageText(openPage, noOfEdits + edit).c_str());
+        drawFrame();
+        shown.push_back(duration_cast<nanoseconds>(steady_clock::now() - edited).count() / 1e6);
+    }
+    report("setPageText, on screen", &shown);
+    shown.clear();
+    for(int edit=1;edit<=noOfEdits;edit++){
+        steady_clock::time_point edited = steady_clock::now();
+        book.setPageText(openPage, pageText(openPage, 2*noOfEdits + edit).c_str());
+        rebuildEveryPage();
+        drawFrame();
+        shown.push_back(duration_cast<nanoseconds>(steady_clock::now() - edited).count() / 1e6);
+    }
+    report("every page rebuilt, on screen", &shown);
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*!
+    /file Replay.cpp
+    /brief Standalone replay of a captured frame for driver-level profiling
+    Loads a command buffer saved with the 'c' key and replays it for a number
+    of frames, reporting the time spent per frame.
+*/
+
+#include "../lib/headers/CommandBuffer.h"
+#include <chrono>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+
+CommandBuffer frame;
+GLint noOfFrames = REPLAY_FRAMES;
+
+/*!
+    \fn createPlaceholderTextures()
+    \brief Create a checkerboard texture for every texture bound by the frame
+    The captured frame only holds texture names, so the texturing path is
+    exercised with placeholder images of a fixed size.
+*/
+void createPlaceholderTextures(){
+    std::set<GLuint> textures;
+    const GLfloat *a = frame.args.data();
+    static GLubyte pixels[256][256][3];
+    for(int y=0;y<256;y++)
+        for(int x=0;x<256;x++)
+            pixels[y][x][0] = pixels[y][x][1] = pixels[y][x][2] = ((x/32 + y/32)%2) ? 255 : 96;
+    for(size_t i=0;i<frame.calls.size();i++){
+        if(frame.calls[i] == CALL_BIND_TEXTURE)
+            textures.insert((GLuint)a[1]);
+        a += callArguments(frame.calls[i], a);
+    }
+    for(std::set<GLuint>::iterator texture=textures.begin();texture!=textures.end();++texture){
+        glBindTexture(GL_TEXTURE_2D, *texture);
+        gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGB, 256, 256, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+}
+
+/*!
+    \fn display()
+    \brief Replay the frame noOfFrames times and report the timing
+*/
+void display(){
+    using namespace std::chrono;
+    GLRecorder counter;
+    counter.captureVertices = 0;
+    setGLBackend(BACKEND_RECORDING, &counter);
+    frame.replay();
+    setGLBackend(BACKEND_IMMEDIATE);
+    frame.replay(); /*!< Warm up */
+    glFinish();
+    steady_clock::time_point start = steady_clock::now();
+    for(int i=0;i<noOfFrames;i++){
+        frame.replay();
+        glutSwapBuffers();
+    }
+    glFinish();
+    double elapsed = duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1e6;
+    printf("%s\n%d frames, %.3f ms/frame, %u commands/frame, %u vertices/frame\n",
+        (const char*)glGetString(GL_RENDERER), noOfFrames, elapsed / noOfFrames, counter.totalCalls, counter.vertices);
+    exit(0);
+}
+
+/*!
+    \fn main(int argc, char **argv)
+    Usage: flipbook_replay [capture file] [frames]
+*/
+int main(int argc, char **argv){
+    glutInit(&argc, argv);
+    const char *filename = argc > 1 ? argv[1] : CAPTURE_FILENAME;
+    if(argc > 2)
+        noOfFrames = atoi(argv[2]);
+    if(!frame.load(filename)){
+        printf("Replay Error: %s is missing or not a captured frame\n", filename);
+        return -1;
+    }
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
+    glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
+    glutCreateWindow("FlipBook Replay");
+    glShadeModel(GL_SMOOTH);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_NORMALIZE);
+    glEnable(GL_COLOR_MATERIAL);
+    createPlaceholderTextures();
+    glutDisplayFunc(display);
+    glutMainLoop();
+    return 0;
+}
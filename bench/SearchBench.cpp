@@ -0,0 +1,242 @@
+/*!
+    /file SearchBench.cpp
+    /brief Check the search index against a scan of the pages and time its queries
+    Queries on a small book are checked page by page and span by span against
+    a plain scan of every page. Queries on a book of SEARCH_PAGES pages are
+    timed as the search prompt runs them, finding the next page from a random
+    one. Exits with 1 when a check fails or a kind of query takes longer than
+    SEARCH_BUDGET_MS at the 99th percentile.
+*/
+
+#include "../lib/headers/SearchIndex.h"
+#include <algorithm>
+#include <chrono>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+static const GLint SEARCH_PAGES = 100000, CHECK_PAGES = 3000, WORDS = 20000, PAGE_WORDS = 45, QUERIES = 2000;
+static const double SEARCH_BUDGET_MS = 1.0;
+std::vector<std::string> vocabulary;
+GLint failures = 0;
+
+/*!
+    \fn makeVocabulary()
+    \brief WORDS made up words of two to four syllables
+*/
+void makeVocabulary(){
+    const char *syllables[] = {"fla", "pe", "gor", "im", "tu", "ban", "so", "rik", "el", "mo", "dra", "qui",
+        "ne", "sta", "lu", "ver", "ca", "dom", "ix", "ar", "po", "zen", "ha", "ty"};
+    GLint count = sizeof(syllables) / sizeof(syllables[0]);
+    while((GLint)vocabulary.size() < WORDS){
+        std::string word;
+        for(int i=0, length=2 + rand() % 3;i<length;i++)
+            word += syllables[rand() % count];
+        vocabulary.push_back(word);
+    }
+}
+
+/*!
+    \fn pickWord()
+    \brief A word of the vocabulary, the first ones far more often than the last ones
+*/
+const std::string& pickWord(){
+    GLint a = rand() % WORDS, b = rand() % WORDS;
+    return vocabulary[(GLint)((long)a * b / WORDS)];
+}
+
+/*!
+    \fn makePage(std::string *text)
+    \brief Text of a page, PAGE_WORDS words on lines of about 30 characters
+*/
+void makePage(std::string *text){
+    text->clear();
+    GLint line = 0;
+    for(int i=0;i<PAGE_WORDS;i++){
+        std::string word = pickWord();
+        if(rand() % 7 == 0)
+            word[0] = toupper(word[0]);
+        if(line + (GLint)word.size() > 30){
+            *text += '\n';
+            line = 0;
+        }
+        else if(line > 0){
+            *text += rand() % 9 == 0 ? ", " : " ";
+            line++;
+        }
+        *text += word;
+        line += word.size();
+    }
+    *text += '.';
+}
+
+/*!
+    \fn makeQuery(GLint kind, std::string *query)
+    \brief Query of a kind: rare term, common term, two terms, prefix or missing term
+*/
+void makeQuery(GLint kind, std::string *query){
+    if(kind == 0)
+        *query = vocabulary[WORDS/2 + rand() % (WORDS/2)];
+    else if(kind == 1)
+        *query = vocabulary[rand() % 20];
+    else if(kind == 2)
+        *query = pickWord() + " " + pickWord();
+    else if(kind == 3)
+        *query = pickWord().substr(0, 4) + "*";
+    else
+        *query = "xylophone";
+}
+
+/*!
+    \fn scanPage(const std::string &text, const std::string &query, SearchHit *hit)
+    \brief Whether text holds every word of query, hit receives the spans of all of them
+*/
+GLint scanPage(const std::string &text, const std::string &query, SearchHit *hit){
+    std::vector<std::string> words;
+    std::vector<GLint> prefix;
+    for(size_t i=0;i<query.size();){
+        if(!isalnum((unsigned char)query[i])){
+            i++;
+            continue;
+        }
+        std::string word;
+        for(;i<query.size() && isalnum((unsigned char)query[i]);i++)
+            word += tolower((unsigned char)query[i]);
+        words.push_back(word);
+        prefix.push_back(i < query.size() && query[i] == '*');
+    }
+    std::vector<GLint> found(words.size(), 0);
+    hit->spans.clear();
+    for(size_t i=0;i<text.size();){
+        if(!isalnum((unsigned char)text[i])){
+            i++;
+            continue;
+        }
+        GLint start = i;
+        std::string word;
+        for(;i<text.size() && isalnum((unsigned char)text[i]);i++)
+            word += tolower((unsigned char)text[i]);
+        GLint matched = 0;
+        for(size_t w=0;w<words.size();w++)
+            if(word == words[w] || (prefix[w] && word.compare(0, words[w].size(), words[w]) == 0))
+                found[w] = matched = 1;
+        if(matched){
+            SearchSpan span = {start, (GLint)word.size()};
+            hit->spans.push_back(span);
+        }
+    }
+    for(size_t w=0;w<words.size();w++)
+        if(!found[w])
+            return 0;
+    return !words.empty();
+}
+
+/*!
+    \fn checkQueries()
+    \brief Compare the pages and spans found for every kind of query with a scan of the pages
+    Some pages are replaced and some indexed out of order first, so the
+    incremental updates are checked as well.
+*/
+void checkQueries(){
+    SearchIndex index;
+    std::vector<std::string> pages(CHECK_PAGES);
+    for(int i=CHECK_PAGES-1;i>=0;i-=2){ /*!< Odd pages before even ones */
+        makePage(&pages[i]);
+        index.setPage(i, pages[i].c_str());
+    }
+    for(int i=CHECK_PAGES-2;i>=0;i-=2){
+        makePage(&pages[i]);
+        index.setPage(i, pages[i].c_str());
+    }
+    for(int i=0;i<CHECK_PAGES/10;i++){
+        GLint page = rand() % CHECK_PAGES;
+        makePage(&pages[page]);
+        index.setPage(page, pages[page].c_str());
+    }
+    GLint mismatches = 0, queries = 0;
+    std::vector<SearchHit> hits;
+    std::string query;
+    for(int kind=0;kind<5;kind++)
+        for(int q=0;q<40;q++, queries++){
+            makeQuery(kind, &query);
+            GLint from = rand() % CHECK_PAGES, maxPages = 1 + rand() % 30;
+            index.search(query.c_str(), from, maxPages, &hits);
+            std::vector<SearchHit> expected;
+            for(int i=0;i<CHECK_PAGES && (GLint)expected.size()<maxPages;i++){
+                SearchHit hit;
+                hit.pageIndex = (from + i) % CHECK_PAGES;
+                if(scanPage(pages[hit.pageIndex], query, &hit))
+                    expected.push_back(hit);
+            }
+            GLint same = hits.size() == expected.size();
+            for(size_t h=0;same && h<hits.size();h++){
+                same = hits[h].pageIndex == expected[h].pageIndex && hits[h].spans.size() == expected[h].spans.size();
+                for(size_t s=0;same && s<hits[h].spans.size();s++)
+                    same = hits[h].spans[s].start == expected[h].spans[s].start && hits[h].spans[s].length == expected[h].spans[s].length;
+            }
+            if(!same && mismatches++ == 0)
+                printf("\"%s\" from page %d: %zu pages found, %zu expected\n", query.c_str(), from, hits.size(), expected.size());
+        }
+    failures += mismatches > 0;
+    printf("%-36s %6d queries %6d mismatches %s\n", "search against a scan of the pages", queries, mismatches, mismatches ? "FAIL" : "ok");
+}
+
+/*!
+    \fn measureQueries()
+    \brief Build the index of a SEARCH_PAGES page book and time every kind of query on it
+*/
+void measureQueries(){
+    using namespace std::chrono;
+    const char *kinds[] = {"rare term", "common term", "two terms", "prefix", "missing term"};
+    SearchIndex index;
+    std::string text;
+    steady_clock::time_point start = steady_clock::now();
+    for(int i=0;i<SEARCH_PAGES;i++){
+        makePage(&text);
+        index.setPage(i, text.c_str());
+    }
+    double buildTime = duration<double, std::milli>(steady_clock::now() - start).count();
+    printf("\n%d pages indexed in %.1f ms, %zu terms, %zu postings\n", SEARCH_PAGES, buildTime, index.terms.size(), index.postings);
+    start = steady_clock::now();
+    for(int i=0;i<1000;i++){
+        makePage(&text);
+        index.setPage(rand() % SEARCH_PAGES, text.c_str());
+    }
+    printf("a page edited and indexed again in %.3f ms\n\n", duration<double, std::milli>(steady_clock::now() - start).count() / 1000);
+    printf("%-16s %12s %12s %12s %10s\n", "next page for", "mean ms", "p99 ms", "max ms", "found");
+    std::vector<SearchHit> hits;
+    std::string query;
+    for(int kind=0;kind<5;kind++){
+        std::vector<double> times;
+        GLint found = 0;
+        for(int q=0;q<QUERIES;q++){
+            makeQuery(kind, &query);
+            GLint from = rand() % SEARCH_PAGES;
+            start = steady_clock::now();
+            found += index.search(query.c_str(), from, 1, &hits);
+            times.push_back(duration<double, std::milli>(steady_clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        double mean = 0;
+        for(size_t i=0;i<times.size();i++)
+            mean += times[i] / times.size();
+        double p99 = times[times.size() * 99 / 100];
+        GLint failed = p99 > SEARCH_BUDGET_MS;
+        failures += failed;
+        printf("%-16s %12.4f %12.4f %12.4f %10d %s\n", kinds[kind], mean, p99, times.back(), found, failed ? "FAIL" : "ok");
+    }
+}
+
+/*!
+    \fn main()
+    \brief Check the queries, then time them, exits with 1 when anything failed
+*/
+int main(){
+    srand(42);
+    makeVocabulary();
+    checkQueries();
+    measureQueries();
+    return failures > 0;
+}
@@ -0,0 +1,191 @@
+/*!
+    /file UploadBench.cpp
+    /brief Texture upload bandwidth, in one blocking call and streamed through the upload ring
+    Every texture, with its whole chain of mipmap levels, is uploaded once by
+    glTexImage2D from client memory, the way uploadTexture does, then written
+    into an UploadRing from a producer thread while the main thread pumps
+    UPLOAD_BYTES_PER_FRAME a frame. The median and longest frames are printed,
+    the longest being the one allocating level 0, which software GL clears.
+    The streamed texture is read back and compared with its source, exits
+    with 1 when they differ.
+*/
+
+#define GL_GLEXT_PROTOTYPES
+#include "../lib/headers/Offscreen.h"
+#include "../lib/headers/UploadRing.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/*!
+    \struct UploadScenario
+    \brief Texture uploaded by a scenario
+*/
+struct UploadScenario{
+    const char *name;
+    GLint size; /*!< Texels on a side of level 0 */
+    GLint compressed; /*!< DXT5 blocks instead of RGBA texels */
+};
+
+/*!
+    \struct SourceLevel
+    \brief Level of a texture in client memory
+*/
+struct SourceLevel{
+    GLint width, height;
+    std::vector<unsigned char> data;
+};
+
+UploadRing ring;
+GLint failures = 0;
+
+/*!
+    \fn levelSize(GLint width, GLint height, GLint compressed)
+    \brief Bytes of a level
+*/
+size_t levelSize(GLint width, GLint height, GLint compressed){
+    if(compressed)
+        return (size_t)((width + 3)/4) * ((height + 3)/4) * 16;
+    return (size_t)width * height * 4;
+}
+
+/*!
+    \fn makeLevels(const UploadScenario *scenario, std::vector<SourceLevel> *levels)
+    \brief Fill every level of the texture with a pattern, returns the bytes of all levels
+*/
+size_t makeLevels(const UploadScenario *scenario, std::vector<SourceLevel> *levels){
+    size_t total = 0;
+    levels->clear();
+    for(GLint size=scenario->size, level=0;;size/=2, level++){
+        SourceLevel source;
+        source.width = source.height = size > 0 ? size : 1;
+        source.data.resize(levelSize(source.width, source.height, scenario->compressed));
+        for(size_t i=0;i<source.data.size();i++)
+            source.data[i] = (unsigned char)(i * 7 + i / 4093 + level * 31);
+        total += source.data.size();
+        levels->push_back(source);
+        if(size <= 1)
+            break;
+    }
+    return total;
+}
+
+/*!
+    \fn uploadDirect(const UploadScenario *scenario, const std::vector<SourceLevel> &levels)
+    \brief Upload every level in one go from client memory, returns the ms until GL is done
+*/
+double uploadDirect(const UploadScenario *scenario, const std::vector<SourceLevel> &levels){
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glFinish();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t i=0;i<levels.size();i++){
+        if(scenario->compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, i, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, levels[i].width, levels[i].height, 0,
+                levels[i].data.size(), levels[i].data.data());
+        else
+            glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA, levels[i].width, levels[i].height, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                levels[i].data.data());
+    }
+    glFinish();
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glDeleteTextures(1, &texture);
+    return time;
+}
+
+/*!
+    \fn matches(const UploadScenario *scenario, GLuint texture, const std::vector<SourceLevel> &levels)
+    \brief 1 when every level of texture holds its source
+*/
+GLint matches(const UploadScenario *scenario, GLuint texture, const std::vector<SourceLevel> &levels){
+    std::vector<unsigned char> read;
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    for(size_t i=0;i<levels.size();i++){
+        read.assign(levels[i].data.size(), 0);
+        if(scenario->compressed)
+            glGetCompressedTexImage(GL_TEXTURE_2D, i, read.data());
+        else
+            glGetTexImage(GL_TEXTURE_2D, i, GL_RGBA, GL_UNSIGNED_BYTE, read.data());
+        if(read != levels[i].data)
+            return 0;
+    }
+    return 1;
+}
+
+/*!
+    \fn measure(const UploadScenario *scenario)
+    \brief Upload the texture of scenario both ways and print the bandwidths
+*/
+void measure(const UploadScenario *scenario){
+    std::vector<SourceLevel> levels;
+    double megabytes = makeLevels(scenario, &levels) / 1048576.0;
+    double direct = uploadDirect(scenario, levels);
+    StreamedTexture streamed;
+    streamed.texture = 0;
+    streamed.ready = 0;
+    streamed.noOfLevels = levels.size();
+    streamed.compressed = scenario->compressed;
+    streamed.format = scenario->compressed ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_RGBA;
+    ring.resetStatistics();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::thread producer([&levels, &streamed]{
+        for(size_t i=0;i<levels.size();i++)
+            ring.write(&streamed, i, levels[i].width, levels[i].height, levels[i].data.data(), levels[i].data.size());
+    });
+    std::vector<double> frames; /*!< Time of every pump which uploaded something */
+    while(streamed.ready == 0){
+        std::chrono::steady_clock::time_point frame = std::chrono::steady_clock::now();
+        if(ring.pump(UPLOAD_BYTES_PER_FRAME) == 0)
+            ring.waitForWrite(1);
+        else
+            frames.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frame).count());
+    }
+    producer.join();
+    ring.flush();
+    double wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    GLint same = matches(scenario, streamed.texture, levels);
+    failures += same == 0;
+    std::sort(frames.begin(), frames.end());
+    printf("%-12s %8.2f %10.2f %10.0f %8u %10.2f %10.2f %10.0f %10.0f %10.2f %6s\n", scenario->name, megabytes,
+        direct, megabytes/(direct/1000), ring.pumps, frames[frames.size()/2], frames.back(),
+        megabytes/(ring.uploadTime/1000), megabytes/(ring.writeTime/1000), wall, same ? "ok" : "FAIL");
+    glDeleteTextures(1, &streamed.texture);
+}
+
+/*!
+    \fn main()
+    Usage: flipbook_upload
+*/
+int main(){
+    static const UploadScenario scenarios[] = {
+        {"rgba 512", 512, 0},
+        {"rgba 1024", 1024, 0},
+        {"rgba 2048", 2048, 0},
+        {"rgba 4096", 4096, 0},
+        {"dxt5 2048", 2048, 1},
+        {"dxt5 4096", 4096, 1}
+    };
+    if(!createOffscreenContext(64, 64)){
+        printf("No offscreen GL context, nothing to upload into\n");
+        return -1;
+    }
+    const char *extensions = (const char*)glGetString(GL_EXTENSIONS);
+    GLint compression = extensions != NULL && strstr(extensions, "GL_EXT_texture_compression_s3tc") != NULL;
+    GLint persistent = ring.create(UPLOAD_RING_SIZE, UPLOAD_BYTES_PER_FRAME);
+    printf("%s, %s of %d KB, %d KB a frame\n", (const char*)glGetString(GL_RENDERER),
+        persistent ? "pixel buffer ring" : "client memory ring", UPLOAD_RING_SIZE/1024, UPLOAD_BYTES_PER_FRAME/1024);
+    printf("%-12s %8s %10s %10s %8s %10s %10s %10s %10s %10s %6s\n", "texture", "MB", "direct ms", "direct MB/s",
+        "frames", "median ms", "max ms", "ring MB/s", "copy MB/s", "wall ms", "check");
+    for(size_t i=0;i<sizeof(scenarios)/sizeof(scenarios[0]);i++)
+        if(compression || scenarios[i].compressed == 0)
+            measure(&scenarios[i]);
+    ring.destroy();
+    return failures > 0;
+}
@@ -0,0 +1,212 @@
+/*!
+    /file VectorBench.cpp
+    /brief Tessellation throughput and draw cost of vector drawing pages
+    Drawings made up here stress the tessellator: a gear with a hole, a few
+    hundred curved blobs, self-intersecting stars filled by the even-odd rule
+    and a page of dense strokes, next to img/tetris.svg when it is found.
+    Each is parsed and tessellated VECTOR_BENCH_RUNS times, then drawn onto
+    an offscreen page both as the single array draw pages use and vertex by
+    vertex between fbBegin and fbEnd, timed up to glFinish.
+*/
+
+#include "../lib/headers/Offscreen.h"
+#include "../lib/headers/VectorDrawing.h"
+#include "../lib/headers/GLBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#define VECTOR_BENCH_RUNS 20
+#define VECTOR_BENCH_DRAWS 50
+#define VECTOR_BENCH_WIDTH 512
+#define VECTOR_BENCH_HEIGHT 768
+
+/*!
+    \fn gear(GLint teeth)
+    \brief Gear of the given number of teeth around a round hole, filled nonzero
+*/
+std::string gear(GLint teeth){
+    std::string svg = "<svg viewBox=\"0 0 200 200\"><path fill=\"#607080\" stroke=\"#202020\" stroke-width=\"0.5\" d=\"";
+    char point[64];
+    for(GLint i=0;i<teeth*4;i++){
+        GLfloat angle = 2*M_PI*i / (teeth*4), radius = (i/2) % 2 ? 80 : 95;
+        snprintf(point, sizeof(point), "%c%.3f %.3f ", i == 0 ? 'M' : 'L', 100 + radius*cosf(angle), 100 + radius*sinf(angle));
+        svg += point;
+    }
+    svg += "Z M100 70 A30 30 0 1 0 100 130 A30 30 0 1 0 100 70 Z\"/></svg>";
+    return svg;
+}
+
+/*!
+    \fn blobs(GLint count)
+    \brief Overlapping blobs, each closed by three cubic curves
+*/
+std::string blobs(GLint count){
+    std::string svg = "<svg viewBox=\"0 0 200 300\">";
+    char shape[256];
+    for(GLint i=0;i<count;i++){
+        GLfloat x = 10 + (i*37 % 180), y = 10 + (i*53 % 280), r = 4 + i % 7;
+        snprintf(shape, sizeof(shape), "<path fill=\"rgb(%d,%d,%d)\" d=\"M%.1f %.1f C%.1f %.1f %.1f %.1f %.1f %.1f "
+            "S%.1f %.1f %.1f %.1f S%.1f %.1f %.1f %.1fZ\"/>", i*41 % 256, i*89 % 256, i*13 % 256,
+            x - r, y, x - r, y - r*1.6f, x + r*0.4f, y - r, x + r, y,
+            x + r*1.4f, y + r*1.2f, x, y + r, x - r*0.3f, y + r*1.8f, x - r, y);
+        svg += shape;
+    }
+    return svg + "</svg>";
+}
+
+/*!
+    \fn stars(GLint count, GLint points)
+    \brief Stars drawn in one stroke each, crossing themselves, filled by the even-odd rule
+*/
+std::string stars(GLint count, GLint points){
+    std::string svg = "<svg viewBox=\"0 0 200 300\"><g fill-rule=\"evenodd\" stroke=\"navy\" stroke-width=\"0.3\">";
+    char point[64];
+    for(GLint s=0;s<count;s++){
+        GLfloat x = 25 + (s % 4) * 50, y = 25 + (s / 4) * 50;
+        snprintf(point, sizeof(point), "<path fill=\"#%02x%02xff\" d=\"", s*40 % 256, s*70 % 256);
+        svg += point;
+        for(GLint i=0;i<points;i++){
+            GLfloat angle = 2*M_PI*i*(points/2 - 1) / points;
+            snprintf(point, sizeof(point), "%c%.3f %.3f ", i == 0 ? 'M' : 'L', x + 22*sinf(angle), y - 22*cosf(angle));
+            svg += point;
+        }
+        svg += "Z\"/>";
+    }
+    return svg + "</g></svg>";
+}
+
+/*!
+    \fn strokes(GLint lines)
+    \brief Wavy polylines stroked close together, as handwriting or a plot would be
+*/
+std::string strokes(GLint lines){
+    std::string svg = "<svg viewBox=\"0 0 200 300\"><g fill=\"none\" stroke=\"#303030\" stroke-width=\"0.8\">";
+    char point[64];
+    for(GLint l=0;l<lines;l++){
+        svg += "<polyline points=\"";
+        for(GLint i=0;i<=100;i++){
+            snprintf(point, sizeof(point), "%.2f,%.2f ", 5 + i*1.9f, 10 + l*(280.0f/lines) + 3*sinf(i*0.4f + l));
+            svg += point;
+        }
+        svg += "\"/>";
+    }
+    return svg + "</g></svg>";
+}
+
+/*!
+    \fn readFile(const char *filename, std::string *text)
+    \brief Read a whole file, returns 0 when it cannot be opened
+*/
+GLint readFile(const char *filename, std::string *text){
+    FILE *file = fopen(filename, "rb");
+    if(file == NULL)
+        return 0;
+    char buffer[4096];
+    size_t length;
+    while((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        text->append(buffer, length);
+    fclose(file);
+    return 1;
+}
+
+/*!
+    \fn drawImmediate(VectorDrawing *drawing, GLfloat left, GLfloat bottom, GLfloat z, GLfloat right, GLfloat top)
+    \brief Draw the mesh of a drawing vertex by vertex, as pages drew before keeping arrays
+*/
+void drawImmediate(VectorDrawing *drawing, GLfloat left, GLfloat bottom, GLfloat z, GLfloat right, GLfloat top){
+    GLfloat offset[2], scale = drawing->place(left, bottom, right, top, offset);
+    fbBegin(GL_TRIANGLES);
+    fbNormal3f(0, 0, 1);
+    for(size_t i=0;i<drawing->mesh.size();i+=6){
+        const GLfloat *corner = &drawing->mesh[i];
+        fbColor3f(corner[3], corner[4], corner[5]);
+        fbVertex3f(offset[0] + corner[0]*scale, offset[1] - corner[1]*scale,
+            z - PAGE_THICKNESS/2.0f * (1 - (corner[2] + 1) / drawing->noOfLayers));
+    }
+    fbEnd();
+}
+
+/*!
+    \fn timeDraws(VectorDrawing *drawing, GLint immediate)
+    \brief ms a draw of the drawing onto a cleared page takes, up to glFinish
+*/
+double timeDraws(VectorDrawing *drawing, GLint immediate){
+    glFinish();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(GLint i=0;i<VECTOR_BENCH_DRAWS;i++){
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        if(immediate)
+            drawImmediate(drawing, 0, 0, 0, VECTOR_BENCH_WIDTH, VECTOR_BENCH_HEIGHT);
+        else
+            drawing->draw(0, 0, 0, VECTOR_BENCH_WIDTH, VECTOR_BENCH_HEIGHT);
+    }
+    glFinish();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / VECTOR_BENCH_DRAWS;
+}
+
+/*!
+    \fn measure(const char *name, const std::string &svg)
+    \brief Tessellate and draw a drawing, printing its throughput
+*/
+void measure(const char *name, const std::string &svg){
+    std::vector<double> parses, tessellations;
+    VectorDrawing drawing;
+    for(GLint run=0;run<VECTOR_BENCH_RUNS;run++){
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        drawing.parse(svg.c_str());
+        parses.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        tessellations.push_back(drawing.tessellationTime);
+    }
+    std::sort(parses.begin(), parses.end());
+    std::sort(tessellations.begin(), tessellations.end());
+    double tessellation = tessellations[VECTOR_BENCH_RUNS/2];
+    double arrays = timeDraws(&drawing, 0), immediate = timeDraws(&drawing, 1);
+    printf("%-10s %7d %8d %9d %8.2f %8.2f %10.0f %10.0f %9.3f %9.3f %7.1fx\n", name, drawing.noOfShapes,
+        drawing.noOfPoints, drawing.noOfTriangles(), parses[VECTOR_BENCH_RUNS/2], tessellation,
+        drawing.noOfPoints / (tessellation > 0 ? tessellation : 1e-3), drawing.noOfTriangles() / (tessellation > 0 ? tessellation : 1e-3),
+        arrays, immediate, immediate / arrays);
+}
+
+/*!
+    \fn main(int argc, char **argv)
+    Usage: flipbook_vector [drawing.svg...]
+*/
+int main(int argc, char **argv){
+    if(!createOffscreenContext(VECTOR_BENCH_WIDTH, VECTOR_BENCH_HEIGHT)){
+        printf("No offscreen GL context, nothing to draw into\n");
+        return -1;
+    }
+    glViewport(0, 0, VECTOR_BENCH_WIDTH, VECTOR_BENCH_HEIGHT);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0, VECTOR_BENCH_WIDTH, 0, VECTOR_BENCH_HEIGHT, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_LIGHTING);
+    glEnable(GL_LIGHT0);
+    glEnable(GL_COLOR_MATERIAL);
+    printf("%s, %dx%d page, median of %d tessellations, mean of %d draws\n", (const char*)glGetString(GL_RENDERER),
+        VECTOR_BENCH_WIDTH, VECTOR_BENCH_HEIGHT, VECTOR_BENCH_RUNS, VECTOR_BENCH_DRAWS);
+    printf("%-10s %7s %8s %9s %8s %8s %10s %10s %9s %9s %8s\n", "drawing", "shapes", "points", "triangles",
+        "parse ms", "tess ms", "points/ms", "tris/ms", "array ms", "vertex ms", "speedup");
+    measure("gear", gear(180));
+    measure("blobs", blobs(400));
+    measure("stars", stars(24, 31));
+    measure("strokes", strokes(120));
+    std::string text;
+    if(readFile("../img/tetris.svg", &text))
+        measure("tetris", text);
+    for(int i=1;i<argc;i++){
+        text.clear();
+        if(readFile(argv[i], &text))
+            measure(argv[i], text);
+        else
+            printf("Cannot read %s\n", argv[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,342 @@
+/*!
+    /file Animation.cpp
+    /brief Animated pages, their frames decoded ahead on a thread and streamed through the upload ring
+    The decoder keeps at most ANIMATION_SLOTS frames of every animation ahead
+    of playback. Once warmed up it decodes into buffers of its own and writes
+    into the upload ring, so playing allocates nothing.
+*/
+
+#include "./headers/Animation.h"
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+/*!
+    \fn drawOverWhite(const unsigned char *rgba, GLint noOfPixels, unsigned char *rgb)
+    \brief Blend rgba pixels over white into rgb pixels, rgb may be rgba itself
+*/
+static void drawOverWhite(const unsigned char *rgba, GLint noOfPixels, unsigned char *rgb){
+    for(int i=0;i<noOfPixels;i++){
+        unsigned char pixel[4];
+        memcpy(pixel, rgba + i*4, 4);
+        for(int c=0;c<3;c++)
+            rgb[i*3 + c] = (unsigned char)((pixel[c] * pixel[3] + 255 * (255 - pixel[3]) + 127) / 255);
+    }
+}
+
+/*!
+    \fn Animation::Animation()
+    \brief Constructor
+*/
+Animation::Animation(){
+    noOfFrames = columns = rows = 0;
+    sheetWidth = sheetHeight = 0;
+    page.texture = 0;
+    page.aspect = 1;
+    nextFrame = 0;
+    shownFrame = dueFrame = -1;
+    framesOnTime = framesLate = 0;
+    resized.width = resized.height = ANIMATION_FRAME_SIZE;
+    resized.pixels = NULL;
+    resized.size = 0;
+    for(int i=0;i<ANIMATION_SLOTS;i++){
+        slots[i].state = SLOT_FREE;
+        slots[i].frame = -1;
+        slots[i].texture.texture = 0;
+        slots[i].texture.noOfLevels = 1;
+        slots[i].texture.format = GL_RGB;
+        slots[i].texture.compressed = 0;
+        slots[i].texture.ready = 0;
+    }
+}
+
+/*!
+    \fn Animation::open(const char *path, GLint columns, GLint rows)
+    \brief Read the frames of path, a directory of images or a sprite sheet of columns by rows tiles
+    A sprite sheet with no columns given is a strip of square tiles side by
+    side. Returns 0 when path has no frame.
+*/
+GLint Animation::open(const char *path, GLint columns, GLint rows){
+    struct stat info;
+    int width, height, channels;
+    source = path;
+    if(stat(path, &info) != 0)
+        return 0;
+    if(S_ISDIR(info.st_mode)){
+        DIR *dir = opendir(path);
+        if(dir == NULL)
+            return 0;
+        struct dirent *entry;
+        while((entry = readdir(dir)) != NULL)
+            if(entry->d_name[0] != '.')
+                frameFiles.push_back(source + "/" + entry->d_name);
+        closedir(dir);
+        std::sort(frameFiles.begin(), frameFiles.end());
+        if(frameFiles.empty())
+            return 0;
+        unsigned char *pixels = SOIL_load_image(frameFiles[0].c_str(), &width, &height, &channels, SOIL_LOAD_RGBA);
+        if(pixels == NULL)
+            return 0;
+        SOIL_free_image_data(pixels);
+        noOfFrames = frameFiles.size();
+        page.aspect = (GLfloat)width / height;
+        return 1;
+    }
+    unsigned char *pixels = SOIL_load_image(path, &width, &height, &channels, SOIL_LOAD_RGBA);
+    if(pixels == NULL)
+        return 0;
+    sheet.resize(width * height * 3);
+    drawOverWhite(pixels, width * height, sheet.data());
+    SOIL_free_image_data(pixels);
+    sheetWidth = width;
+    sheetHeight = height;
+    this->columns = columns > 0 ? columns : std::max(1, width / std::max(1, height));
+    this->rows = columns > 0 && rows > 0 ? rows : 1;
+    if(this->columns > width || this->rows > height)
+        return 0;
+    noOfFrames = this->columns * this->rows;
+    page.aspect = (GLfloat)(width / this->columns) / (height / this->rows);
+    return 1;
+}
+
+/*!
+    \fn Animation::resident()
+    \brief 1 when every frame fits in the slots at once, they are then decoded only once
+*/
+GLint Animation::resident(){
+    return noOfFrames <= ANIMATION_SLOTS;
+}
+
+/*!
+    \fn Animation::decodeFrame(GLint index)
+    \brief Decode frame index into the buffer returned by frame, a frame which cannot be read is white
+    Called on the decoder thread only.
+*/
+void Animation::decodeFrame(GLint index){
+    int width, height, channels;
+    if(frameFiles.empty()){
+        width = sheetWidth / columns;
+        height = sheetHeight / rows;
+        tile.resize(width * height * 3);
+        const unsigned char *first = &sheet[((index / columns) * height * sheetWidth + (index % columns) * width) * 3];
+        for(int y=0;y<height;y++)
+            memcpy(&tile[y * width * 3], first + y * sheetWidth * 3, width * 3);
+    }
+    else{
+        unsigned char *pixels = SOIL_load_image(frameFiles[index].c_str(), &width, &height, &channels, SOIL_LOAD_RGBA);
+        if(pixels == NULL){
+            resized.data.assign(resized.width * resized.height * 3, 255);
+            return;
+        }
+        tile.resize(width * height * 3);
+        drawOverWhite(pixels, width * height, tile.data());
+        SOIL_free_image_data(pixels);
+    }
+    resizeImage(tile.data(), width, height, 3, &resized);
+}
+
+/*!
+    \fn Animation::frame()
+    \brief Rgb rows, top first, of the frame decoded last
+*/
+const unsigned char* Animation::frame(){
+    return resized.data.data();
+}
+
+/*!
+    \fn AnimationPlayer::AnimationPlayer()
+    \brief Constructor
+*/
+AnimationPlayer::AnimationPlayer(){
+    playedFrame = -1;
+    decodeTime = 0;
+    framesDecoded = 0;
+    ring = NULL;
+    startStep = 0;
+    running = 0;
+    stopped = 1;
+}
+
+/*!
+    \fn AnimationPlayer::add(const char *path, GLint columns, GLint rows)
+    \brief Read an animation before playback starts, returns NULL when it has no frame
+*/
+Animation* AnimationPlayer::add(const char *path, GLint columns, GLint rows){
+    Animation *animation = new Animation();
+    if(!animation->open(path, columns, rows)){
+        delete animation;
+        return NULL;
+    }
+    animations.push_back(animation);
+    return animation;
+}
+
+/*!
+    \fn AnimationPlayer::start(UploadRing *ring, GLuint step)
+    \brief Start decoding, frame 0 being due at animation step step
+    Does nothing without animations.
+*/
+void AnimationPlayer::start(UploadRing *ring, GLuint step){
+    if(animations.empty() || running)
+        return;
+    this->ring = ring;
+    startStep = step;
+    playedFrame = 0;
+    running = 1;
+    stopped = 0;
+    decoder = std::thread(&AnimationPlayer::decode, this);
+}
+
+/*!
+    \fn AnimationPlayer::stop()
+    \brief Stop the decoder, pumping the ring meanwhile as the decoder may wait for it
+    Must be called on the GL thread.
+*/
+void AnimationPlayer::stop(){
+    if(!decoder.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = 0;
+    }
+    slotFreed.notify_all();
+    while(stopped == 0){
+        ring->pump(UPLOAD_RING_SIZE);
+        ring->waitForWrite(1);
+    }
+    decoder.join();
+}
+
+/*!
+    \fn AnimationPlayer::nextToDecode(AnimationSlot **slot, GLint *frame)
+    \brief Claim a free slot of the animation buffered the least ahead and the frame to decode into it
+    Frames already due are skipped. Returns NULL when every animation is
+    buffered ANIMATION_SLOTS - 1 frames ahead, or has all its frames when
+    resident. Called with the mutex held.
+*/
+Animation* AnimationPlayer::nextToDecode(AnimationSlot **slot, GLint *frame){
+    Animation *chosen = NULL;
+    GLint ahead = 0;
+    for(size_t i=0;i<animations.size();i++){
+        Animation *animation = animations[i];
+        GLint resident = animation->resident();
+        GLint candidate = resident ? animation->nextFrame : std::max(animation->nextFrame, playedFrame);
+        if(resident ? candidate >= animation->noOfFrames : candidate - playedFrame >= ANIMATION_SLOTS - 1)
+            continue;
+        GLint buffered = resident ? -1 : candidate - playedFrame; /*!< Resident frames are decoded first, once */
+        if(chosen != NULL && buffered >= ahead)
+            continue;
+        AnimationSlot *free = NULL;
+        for(int k=0;k<ANIMATION_SLOTS && free == NULL;k++)
+            if(animation->slots[k].state.load(std::memory_order_acquire) == SLOT_FREE)
+                free = &animation->slots[k];
+        if(free == NULL)
+            continue;
+        chosen = animation;
+        *slot = free;
+        *frame = candidate;
+        ahead = buffered;
+    }
+    if(chosen != NULL){
+        (*slot)->state.store(SLOT_DECODING, std::memory_order_relaxed);
+        chosen->nextFrame = *frame + 1;
+    }
+    return chosen;
+}
+
+/*!
+    \fn AnimationPlayer::decode()
+    \brief Body of the decoder thread
+    Decodes a frame at a time into a claimed slot and writes it into the
+    ring, waiting for played slots to be freed when every animation is buffered.
+*/
+void AnimationPlayer::decode(){
+    for(;;){
+        Animation *animation = NULL;
+        AnimationSlot *slot = NULL;
+        GLint frame = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while(running && (animation = nextToDecode(&slot, &frame)) == NULL)
+                slotFreed.wait(lock);
+            if(!running)
+                break;
+        }
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        animation->decodeFrame(frame % animation->noOfFrames);
+        decodeTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        framesDecoded++;
+        slot->frame = frame;
+        slot->texture.ready = 0;
+        ring->write(&slot->texture, 0, ANIMATION_FRAME_SIZE, ANIMATION_FRAME_SIZE, animation->frame(),
+            ANIMATION_FRAME_SIZE * ANIMATION_FRAME_SIZE * 3);
+        slot->state.store(SLOT_QUEUED, std::memory_order_release);
+    }
+    stopped = 1;
+}
+
+/*!
+    \fn AnimationPlayer::update(GLuint step)
+    \brief Show the frames due at animation step step and free the slots played
+    A frame not uploaded yet when due counts as late, the page keeps the
+    frame it shows until it is. Must be called on the GL thread, after the
+    ring is pumped.
+*/
+void AnimationPlayer::update(GLuint step){
+    if(running == 0)
+        return;
+    GLint frame = (step - startStep) / ANIMATION_STEPS_PER_FRAME, freed = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        playedFrame = frame;
+        for(size_t i=0;i<animations.size();i++){
+            Animation *animation = animations[i];
+            GLint due = animation->resident() ? frame % animation->noOfFrames : frame;
+            AnimationSlot *shown = NULL;
+            for(int k=0;k<ANIMATION_SLOTS;k++){
+                AnimationSlot *slot = &animation->slots[k];
+                if(slot->state.load(std::memory_order_acquire) == SLOT_QUEUED && slot->texture.ready && slot->frame == due)
+                    shown = slot;
+            }
+            if(frame != animation->dueFrame && animation->shownFrame >= 0){
+                if(shown != NULL)
+                    animation->framesOnTime++;
+                else
+                    animation->framesLate++;
+            }
+            animation->dueFrame = frame;
+            if(shown != NULL){
+                animation->page.texture.store(shown->texture.texture, std::memory_order_release);
+                animation->shownFrame = due;
+            }
+            if(animation->resident())
+                continue;
+            for(int k=0;k<ANIMATION_SLOTS;k++){
+                AnimationSlot *slot = &animation->slots[k];
+                if(slot->state.load(std::memory_order_acquire) == SLOT_QUEUED && slot->texture.ready &&
+                    slot->frame < frame && slot->frame != animation->shownFrame){
+                    slot->state.store(SLOT_FREE, std::memory_order_release);
+                    freed = 1;
+                }
+            }
+        }
+    }
+    if(freed)
+        slotFreed.notify_all();
+}
+
+/*!
+    \fn AnimationPlayer::report()
+    \brief Print the frames decoded and how many were shown when due
+*/
+void AnimationPlayer::report(){
+    GLuint onTime = 0, late = 0;
+    for(size_t i=0;i<animations.size();i++){
+        onTime += animations[i]->framesOnTime;
+        late += animations[i]->framesLate;
+    }
+    printf("Animated pages showed %u frames when due and %u late, %u frames decoded in %.2f ms\n",
+        onTime, late, framesDecoded, decodeTime);
+}
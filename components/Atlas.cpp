@@ -0,0 +1,263 @@
+/*!
+    /file Atlas.cpp
+    /brief Packs the scene textures into a single atlas texture
+    Every image keeps its own size inside the atlas instead of being padded to a
+    power of two, and the whole scene is drawn with one texture bound. Each image
+    is surrounded by a gutter of its extruded border texels, so mipmap levels down
+    to a one texel gutter never sample a neighbouring image.
+*/
+
+#include "./headers/Atlas.h"
+#include "./headers/DXT.h"
+#include "./headers/TextureCache.h"
+#include "../lib/headers/GLBackend.h"
+#include "../lib/headers/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+
+#define ATLAS_METADATA 7 /*!< Values stored per image: region x, y, width, height and source width, height, channels */
+
+static char atlasFilename[] = ATLAS_FILENAME;
+
+/*!
+    \fn cellSize(GLint size)
+    \brief Size of the atlas cell holding an image side of size texels
+    The cell adds the gutter on both sides and is aligned to DXT blocks.
+*/
+static GLint cellSize(GLint size){
+    return (size + 2*ATLAS_PADDING + 3) & ~3;
+}
+
+/*!
+    \fn textureMemory(GLint width, GLint height, GLint channels, GLint compress, GLint noOfLevels)
+    \brief Bytes taken by a texture and its mipmap levels, 0 levels counts the full chain
+*/
+static size_t textureMemory(GLint width, GLint height, GLint channels, GLint compress, GLint noOfLevels){
+    size_t bytes = 0;
+    for(int i=0;noOfLevels == 0 || i<noOfLevels;i++){
+        bytes += compress ? dxtImageSize(width, height, channels) : (size_t)width*height*channels;
+        if(width == 1 && height == 1)
+            break;
+        width = width > 1 ? width/2 : 1;
+        height = height > 1 ? height/2 : 1;
+    }
+    return bytes;
+}
+
+/*!
+    \fn packAtlas(const std::vector<AtlasRect> &sizes, GLint pageWidth, GLint pageHeight, std::vector<AtlasRect> *placed)
+    \brief Place rectangles of the given sizes in a page
+    Guillotine packing: the largest rectangles are placed first, each into the
+    smallest free space it fits, and the space left over is split along its
+    shorter side. Returns 0 if the rectangles do not fit the page.
+*/
+GLint packAtlas(const std::vector<AtlasRect> &sizes, GLint pageWidth, GLint pageHeight, std::vector<AtlasRect> *placed){
+    std::vector<GLint> order(sizes.size());
+    for(size_t i=0;i<order.size();i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&sizes](GLint a, GLint b){
+        return sizes[a].width*sizes[a].height > sizes[b].width*sizes[b].height;
+    });
+    AtlasRect page = {0, 0, pageWidth, pageHeight};
+    std::vector<AtlasRect> spaces(1, page);
+    placed->resize(sizes.size());
+    for(size_t i=0;i<order.size();i++){
+        const AtlasRect *size = &sizes[order[i]];
+        GLint best = -1;
+        for(size_t s=0;s<spaces.size();s++)
+            if(spaces[s].width >= size->width && spaces[s].height >= size->height
+                    && (best < 0 || spaces[s].width*spaces[s].height < spaces[best].width*spaces[best].height))
+                best = s;
+        if(best < 0)
+            return 0;
+        AtlasRect space = spaces[best];
+        spaces.erase(spaces.begin() + best);
+        AtlasRect rect = {space.x, space.y, size->width, size->height};
+        (*placed)[order[i]] = rect;
+        GLint right = space.width - size->width, below = space.height - size->height;
+        AtlasRect rightSpace = {space.x + size->width, space.y, right, right < below ? size->height : space.height};
+        AtlasRect belowSpace = {space.x, space.y + size->height, right < below ? space.width : size->width, below};
+        if(rightSpace.width > 0 && rightSpace.height > 0)
+            spaces.push_back(rightSpace);
+        if(belowSpace.width > 0 && belowSpace.height > 0)
+            spaces.push_back(belowSpace);
+    }
+    return 1;
+}
+
+/*!
+    \fn layoutAtlas(TextureImage *images, GLint count, GLint maxSize, TextureImage *atlas)
+    \brief Choose the smallest page holding every image and record the regions in atlas->metadata
+    Images are halved until they fit a page of maxSize if they do not fit at their own size.
+*/
+static void layoutAtlas(TextureImage *images, GLint count, GLint maxSize, TextureImage *atlas){
+    std::vector<AtlasRect> cells(count), placed;
+    for(int shift=0;;shift++){
+        for(int i=0;i<count;i++){
+            cells[i].width = cellSize(std::max(images[i].width >> shift, 1));
+            cells[i].height = cellSize(std::max(images[i].height >> shift, 1));
+        }
+        for(int size=64;size<=maxSize;size*=2){
+            for(int height=size/2;height<=size;height*=2){
+                if(!packAtlas(cells, size, height, &placed))
+                    continue;
+                atlas->width = size;
+                atlas->height = height;
+                atlas->metadata.resize(count*ATLAS_METADATA);
+                for(int i=0;i<count;i++){
+                    GLfloat *region = &atlas->metadata[i*ATLAS_METADATA];
+                    region[0] = placed[i].x + ATLAS_PADDING;
+                    region[1] = placed[i].y + ATLAS_PADDING;
+                    region[2] = std::max(images[i].width >> shift, 1);
+                    region[3] = std::max(images[i].height >> shift, 1);
+                    region[4] = images[i].width;
+                    region[5] = images[i].height;
+                    region[6] = images[i].channels;
+                }
+                return;
+            }
+        }
+    }
+}
+
+/*!
+    \fn composeAtlas(TextureImage *images, GLint count, TextureImage *atlas)
+    \brief Copy every image into its region of the atlas and extrude its border into the gutter
+    The scene is drawn without blending, so the atlas keeps the rgb channels only.
+*/
+static void composeAtlas(TextureImage *images, GLint count, TextureImage *atlas){
+    atlas->channels = 3;
+    atlas->levels.resize(1);
+    TextureLevel *page = &atlas->levels[0];
+    page->width = atlas->width;
+    page->height = atlas->height;
+    page->data.assign(page->width * page->height * atlas->channels, 0);
+    for(int i=0;i<count;i++){
+        const GLfloat *region = &atlas->metadata[i*ATLAS_METADATA];
+        GLint x = region[0], y = region[1], width = region[2], height = region[3];
+        GLint channels = images[i].channels;
+        TextureLevel scaled;
+        const unsigned char *pixels = images[i].levels[0].data.data();
+        if(width != images[i].width || height != images[i].height){
+            scaled.width = width;
+            scaled.height = height;
+            resizeImage(pixels, images[i].width, images[i].height, channels, &scaled);
+            pixels = scaled.data.data();
+        }
+        GLint cellX = x - ATLAS_PADDING, cellY = y - ATLAS_PADDING;
+        for(int ty=cellY;ty<cellY + cellSize(height);ty++)
+            for(int tx=cellX;tx<cellX + cellSize(width);tx++){
+                GLint sx = std::min(std::max(tx - x, 0), width - 1), sy = std::min(std::max(ty - y, 0), height - 1);
+                const unsigned char *texel = pixels + (sy*width + sx)*channels;
+                unsigned char *out = &page->data[(ty*page->width + tx)*atlas->channels];
+                out[0] = texel[0];
+                out[1] = texel[1];
+                out[2] = texel[2];
+            }
+    }
+}
+
+/*!
+    \fn prepareTextureAtlas(char **filenames, GLint count, GLint compress, GLint maxSize, TextureImage *atlas)
+    \brief Build the atlas of the images, ready to be uploaded
+    The atlas is kept in the texture cache and rebuilt when any of the images change.
+    Safe to call from any thread, compress and maxSize come from the GL thread.
+*/
+void prepareTextureAtlas(char **filenames, GLint count, GLint compress, GLint maxSize, TextureImage *atlas){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    maxSize = std::min(maxSize, ATLAS_MAX_SIZE);
+    std::vector<TextureImage> images(count);
+    std::vector<GLint> decoded(count);
+    ThreadPool pool(TEXTURE_LOADER_THREADS);
+    for(int i=0;i<count;i++){
+        images[i].filename = filenames[i];
+        pool.enqueue([&images, i, compress]{ images[i].key = textureCacheKey(images[i].filename, compress); });
+    }
+    pool.wait();
+
+    GLint layout[] = {ATLAS_PADDING, maxSize, compress, count};
+    atlas->filename = atlasFilename;
+    atlas->key = hashBytes(14695981039346656037ULL, layout, sizeof(layout));
+    for(int i=0;i<count;i++)
+        atlas->key = images[i].key == 0 ? 0 : hashBytes(atlas->key, &images[i].key, sizeof(images[i].key));
+    if(!readTextureCache(atlas) || (GLint)atlas->metadata.size() != count*ATLAS_METADATA){
+        releaseTextureCache(atlas);
+        for(int i=0;i<count;i++)
+            pool.enqueue([&images, &decoded, i]{ decoded[i] = decodeImage(&images[i]); });
+        pool.wait();
+        for(int i=0;i<count;i++)
+            if(!decoded[i]){
+                cout<<"Texture Load Error: " + string(filenames[i]) +" File is Probably Missing or Load Error\n";
+                exit(-1);
+            }
+        layoutAtlas(images.data(), count, maxSize, atlas);
+        composeAtlas(images.data(), count, atlas);
+        images.clear();
+        buildTextureLevels(atlas, compress, ATLAS_MIPMAP_LEVELS);
+        writeTextureCache(atlas);
+    }
+    atlas->stageTime[STAGE_DECODE] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+    \fn registerTextureAtlas(TextureImage *atlas, GLuint texture, char **filenames, GLuint **textures, GLint count)
+    \brief Register the regions of an atlas built by prepareTextureAtlas and uploaded as texture
+    textures[i] receives a texture name standing for the region of filenames[i],
+    binding it binds the atlas and maps texture coordinates into the region.
+    Must be called on the GL thread.
+*/
+void registerTextureAtlas(TextureImage *atlas, GLuint texture, char **filenames, GLuint **textures, GLint count){
+    size_t separateBytes = 0, atlasBytes = 0;
+    for(size_t i=0;i<atlas->levels.size();i++)
+        atlasBytes += atlas->levels[i].size;
+    GLint cached = atlas->cached, compress = atlas->compressed;
+    for(int i=0;i<count;i++){
+        const GLfloat *region = &atlas->metadata[i*ATLAS_METADATA];
+        *textures[i] = registerTextureRegion(texture, region[0]/atlas->width, region[1]/atlas->height,
+            (region[0] + region[2])/atlas->width, (region[1] + region[3])/atlas->height);
+        GLint width = region[4], height = region[5];
+        GLint powerOfTwoWidth = 1, powerOfTwoHeight = 1;
+        while(powerOfTwoWidth < width) powerOfTwoWidth *= 2;
+        while(powerOfTwoHeight < height) powerOfTwoHeight *= 2;
+        separateBytes += textureMemory(powerOfTwoWidth, powerOfTwoHeight, region[6], compress, 0);
+        cout<<endl<<filenames[i]<<" -> Loaded Successfully";
+    }
+    printf("\nTexture atlas %dx%d (%s) holds %d textures in %.2f MB instead of %.2f MB, %.0f%% saved,"
+        " prepared in %.2f ms, uploaded in %.2f ms\n",
+        atlas->width, atlas->height, cached ? "cache hit" : "cache miss", count, atlasBytes/1048576.0, separateBytes/1048576.0,
+        100.0 - 100.0*atlasBytes/separateBytes, atlas->stageTime[STAGE_DECODE], atlas->stageTime[STAGE_UPLOAD]);
+    fflush(stdout);
+}
+
+/*!
+    \fn uploadTextureAtlas(TextureImage *atlas, char **filenames, GLuint **textures, GLint count)
+    \brief Upload an atlas built by prepareTextureAtlas and register its regions
+    See registerTextureAtlas for textures. Must be called on the GL thread, returns the atlas texture.
+*/
+GLuint uploadTextureAtlas(TextureImage *atlas, char **filenames, GLuint **textures, GLint count){
+    GLuint texture = uploadTexture(atlas);
+    registerTextureAtlas(atlas, texture, filenames, textures, count);
+    return texture;
+}
+
+/*!
+    \fn maxTextureSize()
+    \brief Largest texture side supported, must be called on the GL thread
+*/
+GLint maxTextureSize(){
+    GLint size;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+    return size;
+}
+
+/*!
+    \fn loadTextureAtlas(char **filenames, GLuint **textures, GLint count)
+    \brief Load images into one atlas texture, must be called on the GL thread
+    Returns the atlas texture, see uploadTextureAtlas for textures.
+*/
+GLuint loadTextureAtlas(char **filenames, GLuint **textures, GLint count){
+    TextureImage atlas;
+    prepareTextureAtlas(filenames, count, textureCompressionSupported(), maxTextureSize(), &atlas);
+    return uploadTextureAtlas(&atlas, filenames, textures, count);
+}
@@ -0,0 +1,147 @@
+/*!
+    /file DXT.cpp
+    /brief Compression of images to DXT1 (RGB) and DXT5 (RGBA) blocks
+*/
+
+#include "./headers/DXT.h"
+
+/*!
+    \fn dxtBlockSize(GLint channels)
+    \brief Bytes per 4x4 block, DXT1 for RGB images and DXT5 for RGBA images
+*/
+GLint dxtBlockSize(GLint channels){
+    return channels == 4 ? 16 : 8;
+}
+
+/*!
+    \fn dxtImageSize(GLint width, GLint height, GLint channels)
+    \brief Bytes needed to store a compressed image
+*/
+GLint dxtImageSize(GLint width, GLint height, GLint channels){
+    return ((width + 3)/4) * ((height + 3)/4) * dxtBlockSize(channels);
+}
+
+/*!
+    \fn packColor(const int color[3])
+    \brief Pack an 8 bit rgb color as 565
+*/
+static unsigned short packColor(const int color[3]){
+    return ((color[0] * 31 + 127)/255) << 11 | ((color[1] * 63 + 127)/255) << 5 | ((color[2] * 31 + 127)/255);
+}
+
+/*!
+    \fn unpackColor(unsigned short packed, int color[3])
+    \brief Expand a 565 color to 8 bit rgb
+*/
+static void unpackColor(unsigned short packed, int color[3]){
+    color[0] = ((packed >> 11) & 31) * 255/31;
+    color[1] = ((packed >> 5) & 63) * 255/63;
+    color[2] = (packed & 31) * 255/31;
+}
+
+/*!
+    \fn compressColorBlock(unsigned char block[16][4], unsigned char *out)
+    \brief Compress the colors of a 4x4 block into 8 bytes
+    The end points are the inset corners of the block's color bounding box.
+*/
+static void compressColorBlock(unsigned char block[16][4], unsigned char *out){
+    int low[3] = {255, 255, 255}, high[3] = {0, 0, 0}, palette[4][3];
+    for(int i=0;i<16;i++)
+        for(int c=0;c<3;c++){
+            if(block[i][c] < low[c]) low[c] = block[i][c];
+            if(block[i][c] > high[c]) high[c] = block[i][c];
+        }
+    for(int c=0;c<3;c++){
+        int inset = (high[c] - low[c])/16;
+        low[c] += inset;
+        high[c] -= inset;
+    }
+    unsigned short color0 = packColor(high), color1 = packColor(low);
+    if(color0 < color1){
+        unsigned short swap = color0;
+        color0 = color1;
+        color1 = swap;
+    }
+    unpackColor(color0, palette[0]);
+    unpackColor(color1, palette[1]);
+    for(int c=0;c<3;c++){
+        palette[2][c] = (2*palette[0][c] + palette[1][c])/3;
+        palette[3][c] = (palette[0][c] + 2*palette[1][c])/3;
+    }
+    unsigned int indices = 0;
+    for(int i=0;i<16 && color0 != color1;i++){
+        int best = 0, bestDistance = 1 << 30;
+        for(int p=0;p<4;p++){
+            int distance = 0;
+            for(int c=0;c<3;c++)
+                distance += (block[i][c] - palette[p][c]) * (block[i][c] - palette[p][c]);
+            if(distance < bestDistance){
+                bestDistance = distance;
+                best = p;
+            }
+        }
+        indices |= best << (2*i);
+    }
+    out[0] = color0 & 0xff; out[1] = color0 >> 8;
+    out[2] = color1 & 0xff; out[3] = color1 >> 8;
+    for(int i=0;i<4;i++)
+        out[4 + i] = (indices >> (8*i)) & 0xff;
+}
+
+/*!
+    \fn compressAlphaBlock(unsigned char block[16][4], unsigned char *out)
+    \brief Compress the alpha of a 4x4 block into 8 bytes using the 8 value DXT5 mode
+*/
+static void compressAlphaBlock(unsigned char block[16][4], unsigned char *out){
+    int alpha0 = 0, alpha1 = 255, palette[8];
+    for(int i=0;i<16;i++){
+        if(block[i][3] > alpha0) alpha0 = block[i][3];
+        if(block[i][3] < alpha1) alpha1 = block[i][3];
+    }
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    for(int p=1;p<7;p++)
+        palette[p + 1] = ((7 - p)*alpha0 + p*alpha1)/7;
+    unsigned long long indices = 0;
+    for(int i=0;i<16 && alpha0 != alpha1;i++){
+        int best = 0, bestDistance = 256;
+        for(int p=0;p<8;p++){
+            int distance = block[i][3] > palette[p] ? block[i][3] - palette[p] : palette[p] - block[i][3];
+            if(distance < bestDistance){
+                bestDistance = distance;
+                best = p;
+            }
+        }
+        indices |= (unsigned long long)best << (3*i);
+    }
+    out[0] = alpha0;
+    out[1] = alpha1;
+    for(int i=0;i<6;i++)
+        out[2 + i] = (indices >> (8*i)) & 0xff;
+}
+
+/*!
+    \fn compressDXT(const unsigned char *pixels, GLint width, GLint height, GLint channels, unsigned char *out)
+    \brief Compress an RGB or RGBA image
+    out must hold dxtImageSize(width, height, channels) bytes.
+    Blocks crossing the image edge repeat the last row and column.
+*/
+void compressDXT(const unsigned char *pixels, GLint width, GLint height, GLint channels, unsigned char *out){
+    unsigned char block[16][4];
+    for(int by=0;by<height;by+=4)
+        for(int bx=0;bx<width;bx+=4){
+            for(int i=0;i<16;i++){
+                int x = bx + i%4 < width ? bx + i%4 : width - 1;
+                int y = by + i/4 < height ? by + i/4 : height - 1;
+                const unsigned char *pixel = pixels + (y*width + x)*channels;
+                for(int c=0;c<4;c++)
+                    block[i][c] = c < channels ? pixel[c] : 255;
+            }
+            if(channels == 4){
+                compressAlphaBlock(block, out);
+                out += 8;
+            }
+            compressColorBlock(block, out);
+            out += 8;
+        }
+}
@@ -0,0 +1,514 @@
+/*!
+    /file Lightmap.cpp
+    /brief Diffuse light of the room baked on the CPU, with ambient occlusion and shadows
+    Every room surface gets a square tile of a lightmap texture. A texel holds
+    the ambient light reaching it past the nearby surfaces and the light of the
+    ceiling lamp and of the viewer, shadowed by the other surfaces. The result
+    is stored in a cache file keyed by a hash of the surfaces and the settings.
+*/
+
+#define GL_GLEXT_PROTOTYPES
+#include "./headers/Lightmap.h"
+#include "./headers/Atlas.h"
+#include "./headers/TextureCache.h"
+#include "../lib/headers/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+static const GLfloat LIGHTMAP_AMBIENT[3] = {0.5f, 0.59f, 0.57f}; /*!< Reaching an unoccluded texel */
+static const GLfloat LIGHTMAP_LAMP[3] = {0.6f, 0.56f, 0.48f}; /*!< Ceiling lamp, falls off with distance */
+static const GLfloat LIGHTMAP_LAMP_POSITION[3] = {0, 450, -250};
+static const GLfloat LIGHTMAP_FILL[3] = {0.25f, 0.25f, 0.27f}; /*!< Light from the viewer, like the headlight of the book */
+static const GLfloat LIGHTMAP_VIEWER[3] = {0, 0, 1900}; /*!< Eye of the normal view, surfaces face it */
+
+/*!
+    \struct LightmapHeader
+    \brief Start of a lightmap cache file, followed by the RGB texels
+*/
+struct LightmapHeader{
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    int32_t size;
+};
+
+/*!
+    \struct LightmapTriangle
+    \brief Triangle of a surface occluding the light
+*/
+struct LightmapTriangle{
+    GLfloat origin[3], edges[2][3];
+    GLint surface;
+};
+
+static void subtract(GLfloat *r, const GLfloat *a, const GLfloat *b){
+    for(int i=0;i<3;i++)
+        r[i] = a[i] - b[i];
+}
+
+static GLfloat dot(const GLfloat *a, const GLfloat *b){
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2];
+}
+
+static void cross(GLfloat *r, const GLfloat *a, const GLfloat *b){
+    r[0] = a[1]*b[2] - a[2]*b[1];
+    r[1] = a[2]*b[0] - a[0]*b[2];
+    r[2] = a[0]*b[1] - a[1]*b[0];
+}
+
+static void normalize(GLfloat *v){
+    GLfloat length = sqrtf(dot(v, v));
+    for(int i=0;length > 0 && i<3;i++)
+        v[i] /= length;
+}
+
+/*!
+    \fn tilesAcross(GLint noOfSurfaces)
+    \brief Tiles on a row of the lightmap
+*/
+static GLint tilesAcross(GLint noOfSurfaces){
+    GLint across = 1;
+    while(across*across < noOfSurfaces)
+        across++;
+    return across;
+}
+
+/*!
+    \fn atlasSize(GLint noOfSurfaces, GLint tileSize)
+    \brief Texels on a side of a texture holding a tile of tileSize texels per surface, a power of two
+*/
+static GLint atlasSize(GLint noOfSurfaces, GLint tileSize){
+    GLint size = 1;
+    while(size < tilesAcross(noOfSurfaces) * tileSize)
+        size *= 2;
+    return size;
+}
+
+/*!
+    \fn lightmapTile(GLint surface, GLint noOfSurfaces, GLint tileSize, GLfloat tile[4][2])
+    \brief Coordinates of the corners of a surface in a texture with a tile of tileSize texels per surface
+    The corners sit on the centres of the border texels of the tile, so the
+    filtering never reads the tiles next to it.
+*/
+void lightmapTile(GLint surface, GLint noOfSurfaces, GLint tileSize, GLfloat tile[4][2]){
+    const GLint corners[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    GLint across = tilesAcross(noOfSurfaces);
+    GLfloat size = atlasSize(noOfSurfaces, tileSize);
+    for(int c=0;c<4;c++){
+        tile[c][0] = ((surface % across) * tileSize + 0.5f + corners[c][0]*(tileSize - 1)) / size;
+        tile[c][1] = ((surface / across) * tileSize + 0.5f + corners[c][1]*(tileSize - 1)) / size;
+    }
+}
+
+/*!
+    \fn lightmapKey(const RoomSurface *surfaces, GLint noOfSurfaces)
+    \brief FNV-1a hash of the surface vertices and of everything the bake depends on
+*/
+uint64_t lightmapKey(const RoomSurface *surfaces, GLint noOfSurfaces){
+    uint64_t hash = 14695981039346656037ULL;
+    for(int i=0;i<noOfSurfaces;i++)
+        hash = hashBytes(hash, surfaces[i].vertices, sizeof(surfaces[i].vertices));
+    GLfloat settings[] = {LIGHTMAP_VERSION, LIGHTMAP_TILE_SIZE, LIGHTMAP_AO_RAYS, LIGHTMAP_AO_DISTANCE, LIGHTMAP_LAMP_RANGE};
+    hash = hashBytes(hash, settings, sizeof(settings));
+    const GLfloat *lights[] = {LIGHTMAP_AMBIENT, LIGHTMAP_LAMP, LIGHTMAP_LAMP_POSITION, LIGHTMAP_FILL, LIGHTMAP_VIEWER};
+    for(int i=0;i<5;i++)
+        hash = hashBytes(hash, lights[i], 3*sizeof(GLfloat));
+    return hash;
+}
+
+/*!
+    \fn occluded(const std::vector<LightmapTriangle> &triangles, GLint surface, const GLfloat *origin, const GLfloat *direction, GLfloat distance)
+    \brief Whether a ray from origin hits a triangle of another surface closer than distance
+    Moller-Trumbore intersection, direction need not be normalized, distance is in its lengths.
+*/
+static GLint occluded(const std::vector<LightmapTriangle> &triangles, GLint surface, const GLfloat *origin,
+    const GLfloat *direction, GLfloat distance){
+    for(size_t i=0;i<triangles.size();i++){
+        const LightmapTriangle *triangle = &triangles[i];
+        if(triangle->surface == surface)
+            continue;
+        GLfloat p[3], s[3], q[3];
+        cross(p, direction, triangle->edges[1]);
+        GLfloat determinant = dot(triangle->edges[0], p);
+        if(fabsf(determinant) < 1e-6f)
+            continue;
+        subtract(s, origin, triangle->origin);
+        GLfloat u = dot(s, p) / determinant;
+        if(u < 0 || u > 1)
+            continue;
+        cross(q, s, triangle->edges[0]);
+        GLfloat v = dot(direction, q) / determinant;
+        if(v < 0 || u + v > 1)
+            continue;
+        GLfloat t = dot(triangle->edges[1], q) / determinant;
+        if(t > 0 && t < distance)
+            return 1;
+    }
+    return 0;
+}
+
+/*!
+    \fn bakeTexel(const std::vector<LightmapTriangle> &triangles, GLint surface, const GLfloat *position, const GLfloat *normal, unsigned char *texel)
+    \brief Light reaching a point of a surface
+    The ambient light is weighed by the cosine weighted rays of a golden spiral
+    escaping the surfaces within LIGHTMAP_AO_DISTANCE, the same rays for every
+    texel, so the bake is the same on any number of threads.
+*/
+static void bakeTexel(const std::vector<LightmapTriangle> &triangles, GLint surface, const GLfloat *position,
+    const GLfloat *normal, unsigned char *texel){
+    GLfloat tangent[3], bitangent[3], axis[3] = {0, 1, 0}, light[3], toLight[3];
+    if(fabsf(normal[1]) > 0.9f)
+        axis[0] = 1, axis[1] = 0;
+    cross(tangent, axis, normal);
+    normalize(tangent);
+    cross(bitangent, normal, tangent);
+    GLint open = 0;
+    for(int k=0;k<LIGHTMAP_AO_RAYS;k++){
+        GLfloat r = sqrtf((k + 0.5f) / LIGHTMAP_AO_RAYS), phi = k * 2.39996323f, ray[3];
+        GLfloat x = r*cosf(phi), y = r*sinf(phi), z = sqrtf(1 - r*r);
+        for(int c=0;c<3;c++)
+            ray[c] = x*tangent[c] + y*bitangent[c] + z*normal[c];
+        open += !occluded(triangles, surface, position, ray, LIGHTMAP_AO_DISTANCE);
+    }
+    GLfloat ambient = (GLfloat)open / LIGHTMAP_AO_RAYS;
+    for(int c=0;c<3;c++)
+        light[c] = LIGHTMAP_AMBIENT[c] * ambient;
+    /*! Ceiling lamp */
+    subtract(toLight, LIGHTMAP_LAMP_POSITION, position);
+    GLfloat distance = sqrtf(dot(toLight, toLight)), facing = dot(toLight, normal) / distance;
+    if(facing > 0 && !occluded(triangles, surface, position, toLight, 1)){
+        GLfloat falloff = 1 / (1 + distance*distance / (LIGHTMAP_LAMP_RANGE*LIGHTMAP_LAMP_RANGE));
+        for(int c=0;c<3;c++)
+            light[c] += LIGHTMAP_LAMP[c] * facing * falloff;
+    }
+    /*! Viewer */
+    subtract(toLight, LIGHTMAP_VIEWER, position);
+    facing = dot(toLight, normal) / sqrtf(dot(toLight, toLight));
+    if(facing > 0 && !occluded(triangles, surface, position, toLight, 1))
+        for(int c=0;c<3;c++)
+            light[c] += LIGHTMAP_FILL[c] * facing;
+    for(int c=0;c<3;c++)
+        texel[c] = light[c] >= 1 ? 255 : (unsigned char)(light[c]*255 + 0.5f);
+}
+
+/*!
+    \fn bakeRows(const RoomSurface *surface, GLint index, const std::vector<LightmapTriangle> &triangles, GLint first, GLint last, GLint across, Lightmap *lightmap)
+    \brief Bake the rows first to last of the tile of a surface
+    A texel at u, v of the tile lies on the triangle v0 v1 v2 when u >= v and on v0 v2 v3 otherwise,
+    the triangles the surface is drawn with.
+*/
+static void bakeRows(const RoomSurface *surface, GLint index, const std::vector<LightmapTriangle> &triangles,
+    GLint first, GLint last, GLint across, Lightmap *lightmap){
+    const GLfloat (*v)[3] = surface->vertices;
+    GLfloat normals[2][3], e1[3], e2[3], toViewer[3];
+    for(int t=0;t<2;t++){
+        subtract(e1, v[t + 1], v[0]);
+        subtract(e2, v[t + 2], v[0]);
+        cross(normals[t], e1, e2);
+        normalize(normals[t]);
+        subtract(toViewer, LIGHTMAP_VIEWER, v[0]);
+        if(dot(normals[t], toViewer) < 0)
+            for(int c=0;c<3;c++)
+                normals[t][c] = -normals[t][c];
+    }
+    for(int j=first;j<last;j++)
+        for(int i=0;i<LIGHTMAP_TILE_SIZE;i++){
+            GLfloat u = (GLfloat)i / (LIGHTMAP_TILE_SIZE - 1), w = (GLfloat)j / (LIGHTMAP_TILE_SIZE - 1);
+            GLfloat position[3];
+            GLint upper = u < w;
+            for(int c=0;c<3;c++){
+                if(upper)
+                    position[c] = (1 - w)*v[0][c] + u*v[2][c] + (w - u)*v[3][c];
+                else
+                    position[c] = (1 - u)*v[0][c] + (u - w)*v[1][c] + w*v[2][c];
+                position[c] += normals[upper][c] * LIGHTMAP_SURFACE_OFFSET;
+            }
+            GLint x = (index % across) * LIGHTMAP_TILE_SIZE + i, y = (index / across) * LIGHTMAP_TILE_SIZE + j;
+            bakeTexel(triangles, index, position, normals[upper], &lightmap->texels[(y*lightmap->size + x)*3]);
+        }
+}
+
+/*!
+    \fn bakeLightmap(const RoomSurface *surfaces, GLint noOfSurfaces, Lightmap *lightmap)
+    \brief Bake the light of the surfaces, bands of rows of every tile are baked in parallel
+*/
+void bakeLightmap(const RoomSurface *surfaces, GLint noOfSurfaces, Lightmap *lightmap){
+    std::vector<LightmapTriangle> triangles;
+    for(int i=0;i<noOfSurfaces;i++)
+        for(int t=0;t<2;t++){
+            const GLfloat (*v)[3] = surfaces[i].vertices;
+            LightmapTriangle triangle;
+            memcpy(triangle.origin, v[0], sizeof(triangle.origin));
+            subtract(triangle.edges[0], v[t + 1], v[0]);
+            subtract(triangle.edges[1], v[t + 2], v[0]);
+            triangle.surface = i;
+            triangles.push_back(triangle);
+        }
+    GLint across = tilesAcross(noOfSurfaces), band = LIGHTMAP_TILE_SIZE / LIGHTMAP_BANDS;
+    lightmap->size = atlasSize(noOfSurfaces, LIGHTMAP_TILE_SIZE);
+    lightmap->key = lightmapKey(surfaces, noOfSurfaces);
+    lightmap->texels.assign(lightmap->size * lightmap->size * 3, 0);
+    ThreadPool pool(LIGHTMAP_THREADS);
+    lightmap->threads = pool.size();
+    for(int i=0;i<noOfSurfaces;i++)
+        for(int first=0;first<LIGHTMAP_TILE_SIZE;first+=band){
+            GLint last = first + band < LIGHTMAP_TILE_SIZE ? first + band : LIGHTMAP_TILE_SIZE;
+            const RoomSurface *surface = &surfaces[i];
+            const std::vector<LightmapTriangle> *occluders = &triangles;
+            pool.enqueue([=](){ bakeRows(surface, i, *occluders, first, last, across, lightmap); });
+        }
+    pool.wait();
+}
+
+/*!
+    \fn readLightmap(const char *filename, Lightmap *lightmap)
+    \brief Read the texels cached in filename, returns 0 unless they were baked with the key of lightmap
+*/
+GLint readLightmap(const char *filename, Lightmap *lightmap){
+    FILE *file = fopen(filename, "rb");
+    if(file == NULL)
+        return 0;
+    LightmapHeader header;
+    GLint valid = fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, "FBLM", 4) == 0
+        && header.version == LIGHTMAP_VERSION && header.key == lightmap->key && header.size > 0;
+    if(valid){
+        lightmap->texels.resize(header.size * header.size * 3);
+        valid = fread(lightmap->texels.data(), lightmap->texels.size(), 1, file) == 1;
+    }
+    fclose(file);
+    lightmap->size = valid ? header.size : 0;
+    if(!valid)
+        lightmap->texels.clear();
+    lightmap->threads = 0;
+    return valid;
+}
+
+/*!
+    \fn writeLightmap(const char *filename, const Lightmap *lightmap)
+    \brief Store the texels in filename
+    Written under a temporary name and renamed, like the texture cache.
+    Returns 0 if it could not be written.
+*/
+GLint writeLightmap(const char *filename, const Lightmap *lightmap){
+    LightmapHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "FBLM", 4);
+    header.version = LIGHTMAP_VERSION;
+    header.key = lightmap->key;
+    header.size = lightmap->size;
+    std::string temporary = std::string(filename) + ".tmp";
+    FILE *file = fopen(temporary.c_str(), "wb");
+    if(file == NULL)
+        return 0;
+    GLint written = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(lightmap->texels.data(), lightmap->texels.size(), 1, file) == 1;
+    written = fclose(file) == 0 && written;
+    if(!written || rename(temporary.c_str(), filename) != 0){
+        remove(temporary.c_str());
+        return 0;
+    }
+    return 1;
+}
+
+/*!
+    \fn loadLightmap(const char *filename, const RoomSurface *surfaces, GLint noOfSurfaces, Lightmap *lightmap)
+    \brief Read the lightmap of the surfaces from its cache, baking and caching it on a miss
+*/
+void loadLightmap(const char *filename, const RoomSurface *surfaces, GLint noOfSurfaces, Lightmap *lightmap){
+    lightmap->key = lightmapKey(surfaces, noOfSurfaces);
+    if(readLightmap(filename, lightmap))
+        return;
+    bakeLightmap(surfaces, noOfSurfaces, lightmap);
+    if(!writeLightmap(filename, lightmap))
+        printf("The room lightmap cannot be cached in %s\n", filename);
+}
+
+/*!
+    \fn createTexture(GLint width, GLint height, GLint levels, const unsigned char *texels)
+    \brief Create an RGB texture of levels mipmap levels, filtered like the room textures and clamped at its edges
+*/
+static GLuint createTexture(GLint width, GLint height, GLint levels, const unsigned char *texels){
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    /*! The nearest level only, blending two levels costs the room view about 4 ms a frame on llvmpipe */
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levels > 1 ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for(int level=0;level<levels;level++)
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGB, std::max(width >> level, 1), std::max(height >> level, 1), 0, GL_RGB, GL_UNSIGNED_BYTE,
+            level == 0 ? texels : NULL);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return texture;
+}
+
+/*!
+    \fn widenCorners(const GLfloat corners[4][2], GLfloat margin, GLfloat widened[4][2])
+    \brief Coordinates at the corners of a surface grown by margin on every side
+    Extrapolated over the triangles v0 v1 v2 and v0 v2 v3 of the surface, so
+    inside it they interpolate as the coordinates at its corners do.
+*/
+static void widenCorners(const GLfloat corners[4][2], GLfloat margin, GLfloat widened[4][2]){
+    for(int c=0;c<2;c++){
+        widened[0][c] = (1 + margin)*corners[0][c] - margin*corners[2][c];
+        widened[1][c] = (1 + 2*margin)*corners[1][c] - margin*(corners[0][c] + corners[2][c]);
+        widened[2][c] = (1 + margin)*corners[2][c] - margin*corners[0][c];
+        widened[3][c] = (1 + 2*margin)*corners[3][c] - margin*(corners[0][c] + corners[2][c]);
+    }
+}
+
+/*!
+    \fn layoutLitRoom(const RoomSurface *surfaces, GLint noOfSurfaces, std::vector<AtlasRect> *tiles, GLint *width, GLint *height)
+    \brief Place a tile per surface holding the texels its texture region has along its sides
+    Tiles are rounded up to whole blocks of the smallest mipmap level, so no
+    level mixes two tiles, and halved until they fit the largest texture.
+*/
+static void layoutLitRoom(const RoomSurface *surfaces, GLint noOfSurfaces, std::vector<AtlasRect> *tiles, GLint *width, GLint *height){
+    const GLint block = 1 << (LIGHTMAP_LIT_MIPMAP_LEVELS - 1);
+    std::vector<GLfloat> extents(2*noOfSurfaces);
+    for(int i=0;i<noOfSurfaces;i++){
+        GLint size[2];
+        textureSize(*surfaces[i].texture, &size[0], &size[1]);
+        const GLfloat (*texCoords)[2] = surfaces[i].texCoords;
+        for(int side=0;side<2;side++){ /*!< From corner 0 to corner 1, and to corner 3 */
+            GLint corner = side == 0 ? 1 : 3;
+            GLfloat du = (texCoords[corner][0] - texCoords[0][0]) * size[0], dv = (texCoords[corner][1] - texCoords[0][1]) * size[1];
+            extents[2*i + side] = sqrtf(du*du + dv*dv);
+        }
+    }
+    std::vector<AtlasRect> cells(noOfSurfaces);
+    GLint maxSize = maxTextureSize();
+    for(int shift=0;;shift++){
+        for(int i=0;i<noOfSurfaces;i++){
+            cells[i].width = std::max((GLint)ceilf(extents[2*i] / (1 << shift) / block), 1) * block;
+            cells[i].height = std::max((GLint)ceilf(extents[2*i + 1] / (1 << shift) / block), 1) * block;
+        }
+        for(int size=block;size<=maxSize;size*=2){
+            for(int rows=size/2;rows<=size;rows*=2){
+                if(rows < block || !packAtlas(cells, size, rows, tiles))
+                    continue;
+                *width = size;
+                *height = rows;
+                return;
+            }
+        }
+    }
+}
+
+/*!
+    \fn composeLitRoom(const RoomSurface *surfaces, GLint noOfSurfaces, Lightmap *lightmap, GLfloat tiles[][4][2])
+    \brief Texture of the surfaces with their color and light, a tile per surface
+    Every surface is drawn once with its texture and its lightmap tile on a
+    second texture unit into its tile, through a framebuffer object, so drawing
+    the room costs a single unlit texture lookup per pixel. A tile has the
+    texels of the texture region of its surface, see layoutLitRoom. Every
+    mipmap level is drawn from the one above through the same framebuffer,
+    glGenerateMipmap takes about 100 ms on llvmpipe. tiles receives the
+    coordinates of the corners of every surface in it.
+    Returns 0 when nothing is baked, the lightmap texels are released.
+    Must be called on the GL thread with the room textures uploaded.
+*/
+GLuint composeLitRoom(const RoomSurface *surfaces, GLint noOfSurfaces, Lightmap *lightmap, GLfloat tiles[][4][2]){
+    if(lightmap->size == 0)
+        return 0;
+    const GLint order[6] = {0, 1, 2, 0, 2, 3};
+    const GLfloat square[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<AtlasRect> placed;
+    GLint width, height;
+    layoutLitRoom(surfaces, noOfSurfaces, &placed, &width, &height);
+    GLuint lightmapTexture = createTexture(lightmap->size, lightmap->size, 1, lightmap->texels.data());
+    std::vector<unsigned char>().swap(lightmap->texels);
+    GLuint lit = createTexture(width, height, LIGHTMAP_LIT_MIPMAP_LEVELS, NULL);
+    GLint backend = glBackend, previousFramebuffer;
+    GLRecorder *recorder = glRecorder;
+    GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    GLuint framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, lit, 0);
+    setGLBackend(BACKEND_IMMEDIATE);
+    glDisable(GL_DEPTH_TEST);
+    fbDisable(GL_LIGHTING);
+    fbMatrixMode(GL_MODELVIEW);
+    fbLoadIdentity();
+    fbActiveTexture(GL_TEXTURE1);
+    fbEnable(GL_TEXTURE_2D);
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    fbBindTexture(GL_TEXTURE_2D, lightmapTexture);
+    fbActiveTexture(GL_TEXTURE0);
+    fbEnable(GL_TEXTURE_2D);
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    for(int i=0;i<noOfSurfaces;i++){
+        const AtlasRect *rect = &placed[i];
+        /*! Corners of the tile on the centres of its border texels, the quad is grown on both axes alike and clipped */
+        GLfloat marginX = 0.5f / (rect->width - 1), marginY = 0.5f / (rect->height - 1);
+        GLfloat margin = std::max(marginX, marginY), corners[4][2], tile[4][2], texCoords[4][2], quad[4][2];
+        lightmapTile(i, noOfSurfaces, LIGHTMAP_TILE_SIZE, corners);
+        widenCorners(corners, margin, tile);
+        widenCorners(surfaces[i].texCoords, margin, texCoords);
+        widenCorners(square, margin, quad);
+        fbViewport(rect->x, rect->y, rect->width, rect->height);
+        fbMatrixMode(GL_PROJECTION);
+        fbLoadIdentity();
+        fbOrtho(-marginX, 1 + marginX, -marginY, 1 + marginY, -1, 1);
+        fbMatrixMode(GL_MODELVIEW);
+        fbBindTexture(GL_TEXTURE_2D, *surfaces[i].texture);
+        fbColor3f(surfaces[i].color[0], surfaces[i].color[1], surfaces[i].color[2]);
+        fbBegin(GL_TRIANGLES);
+        for(int v=0;v<6;v++){
+            GLint c = order[v];
+            fbTexCoord2f(texCoords[c][0], texCoords[c][1]);
+            fbMultiTexCoord2f(GL_TEXTURE1, tile[c][0], tile[c][1]);
+            fbVertex2f(quad[c][0], quad[c][1]);
+        }
+        fbEnd();
+        for(int c=0;c<4;c++){
+            tiles[i][c][0] = (rect->x + 0.5f + square[c][0]*(rect->width - 1)) / width;
+            tiles[i][c][1] = (rect->y + 0.5f + square[c][1]*(rect->height - 1)) / height;
+        }
+    }
+    fbActiveTexture(GL_TEXTURE1);
+    fbDisable(GL_TEXTURE_2D);
+    fbActiveTexture(GL_TEXTURE0);
+    /*! Every level is drawn from the one above, a bilinear lookup between 2x2 texels is their mean */
+    fbBindTexture(GL_TEXTURE_2D, lit);
+    fbColor3f(1, 1, 1);
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadIdentity();
+    fbOrtho(0, 1, 0, 1, -1, 1);
+    fbMatrixMode(GL_MODELVIEW);
+    for(int level=1;level<LIGHTMAP_LIT_MIPMAP_LEVELS;level++){
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level - 1);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, lit, level);
+        fbViewport(0, 0, width >> level, height >> level);
+        fbBegin(GL_TRIANGLES);
+        for(int v=0;v<6;v++){
+            fbTexCoord2f(square[order[v]][0], square[order[v]][1]);
+            fbVertex2f(square[order[v]][0], square[order[v]][1]);
+        }
+        fbEnd();
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, LIGHTMAP_LIT_MIPMAP_LEVELS - 1);
+    fbDisable(GL_TEXTURE_2D);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &lightmapTexture);
+    if(depthTest)
+        glEnable(GL_DEPTH_TEST);
+    setGLBackend(backend, recorder);
+    glFinish();
+    printf("Room light composed into a %dx%d texture in %.2f ms\n", width, height,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    return lit;
+}
@@ -4,7 +4,9 @@
 */
 
 #include "./headers/Room.h"
+#include "./headers/Lightmap.h"
 #include <stdio.h>
+#include <string.h>
 GLuint wallTexture;
 GLuint ceilingTexture;
 GLuint floorTexture;
@@ -12,203 +14,76 @@ GLuint picTexture;
 GLuint tableTexture;
 GLuint pic2Texture;
 GLuint wall2Texture;
+GLuint litRoomTexture; /*!< Room textures with their baked light, 0 until composed */
 extern GLuint welcomeTexture;
-static void setHexColor(int);
-void makeTable();
+
+/*! Walls, flooring, ceiling, photoframes and the table of the room */
+const RoomSurface roomSurfaces[] = {
+    /*! Left wall */
+    {&wall2Texture, {1, 1, 1}, {{0, 0}, {0, 1}, {1, 1}, {1, 0}},
+        {{-900, -800, 0}, {-900, 800, 0}, {-500, 500, -500}, {-500, -500, -500}}},
+    /*! Right wall */
+    {&wall2Texture, {1, 1, 1}, {{1, 1}, {1, 0}, {0, 0}, {0, 1}},
+        {{900, 800, 0}, {900, -800, 0}, {500, -500, -500}, {500, 500, -500}}},
+    /*! Center wall */
+    {&wall2Texture, {1, 1, 1}, {{0, 0}, {0, 1}, {1, 1}, {1, 0}},
+        {{-500, -500, -500}, {-500, 500, -500}, {500, 500, -500}, {500, -500, -500}}},
+    /*! Floor */
+    {&floorTexture, {0xE0/255.0f, 0xE0/255.0f, 0xE0/255.0f}, {{0, 0}, {1, 0}, {1, 1}, {0, 1}},
+        {{-900, -800, 0}, {-500, -500, -500}, {500, -500, -500}, {900, -800, 0}}},
+    /*! Roof */
+    {&wallTexture, {0.5, 0.5, 1}, {{0, 0}, {1, 0}, {1, 1}, {0, 1}},
+        {{-900, 800, 0}, {-500, 500, -500}, {500, 500, -500}, {900, 800, 0}}},
+    /*! Left photoframe with photo */
+    {&picTexture, {1, 1, 1}, {{0, 0}, {0, 1}, {1, 1}, {1, 0}},
+        {{-700, 100, 0}, {-700, 400, 0}, {-600, 350, -300}, {-600, 120, -300}}},
+    /*! Right photoframe with photo */
+    {&pic2Texture, {1, 1, 1}, {{0, 0}, {0, 1}, {1, 1}, {1, 0}},
+        {{700, 100, 0}, {700, 400, 0}, {600, 350, -300}, {600, 120, -300}}},
+    /*! Top of the table */
+    {&tableTexture, {0x9E/255.0f, 0x9E/255.0f, 0x9E/255.0f}, {{0, 0}, {1, 0}, {1, 1}, {0, 1}},
+        {{-300, -300, -300}, {-400, -280, -500}, {400, -280, -500}, {300, -300, -300}}},
+    /*! Front of the table */
+    {&tableTexture, {0x9E/255.0f, 0x9E/255.0f, 0x9E/255.0f}, {{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+        {{-300, -300, -300}, {300, -300, -300}, {300, -500, -310}, {-300, -500, -310}}},
+    /*! Left of the table */
+    {&tableTexture, {0x9E/255.0f, 0x9E/255.0f, 0x9E/255.0f}, {{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+        {{-300, -300, -300}, {-400, -280, -500}, {-300, -500, -500}, {-300, -500, -310}}},
+    /*! Right of the table */
+    {&tableTexture, {0x9E/255.0f, 0x9E/255.0f, 0x9E/255.0f}, {{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+        {{300, -300, -300}, {400, -280, -500}, {300, -500, -500}, {300, -500, -310}}},
+    /*! Bottom of the table */
+    {&tableTexture, {0x9E/255.0f, 0x9E/255.0f, 0x9E/255.0f}, {{1, 0}, {1, 1}, {1, 0}, {1, 1}},
+        {{-300, -500, -500}, {300, -500, -500}, {300, -500, -310}, {-300, -500, -310}}}
+};
+const GLint noOfRoomSurfaces = sizeof(roomSurfaces) / sizeof(roomSurfaces[0]);
+GLfloat litRoomTiles[sizeof(roomSurfaces) / sizeof(roomSurfaces[0])][4][2]; /*!< Corners of every surface in litRoomTexture */
 
 /*!
     \fn drawRoom()
     \brief Construct the room, walls with a table
     Constructs the Room with the table with texture mapping for the walls.
     Flooring and ceiling set with the furniture texture.
+    The room is not lit, the textures and colors of its surfaces are baked with
+    their light into litRoomTexture, so the whole room is a single draw.
 */
 void drawRoom(){
-    /*! Left wall being constructed */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, wall2Texture);
-    glColor3f(1,1,1);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-900, -800, 0);
-        glNormal3f(-900, -800, 0);
-        glTexCoord2f(0, 1); glVertex3f(-900, 800, 0);
-        glNormal3f(-900, 800, 0);
-        glTexCoord2f(1, 1); glVertex3f(-500, 500, -500);
-        glNormal3f(-500, 500, -500);
-        glTexCoord2f(1, 0); glVertex3f(-500, -500, -500);
-        glNormal3f(-500, -500, -500);
-    glEnd();
-    /*! Right wall being constructed */
-    glBegin(GL_QUADS);
-        glTexCoord2f(1, 1); glVertex3f(900, 800, 0);
-        glNormal3f(900, 800, 0);
-        glTexCoord2f(1, 0); glVertex3f(900, -800, 0);
-        glNormal3f(900, -800, 0);
-        glTexCoord2f(0, 0); glVertex3f(500, -500, -500);
-        glNormal3f(500, -500, -500);
-        glTexCoord2f(0, 1); glVertex3f(500, 500, -500);
-        glNormal3f(500, 500, -500);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-    /*! Center wall being constructed */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, wall2Texture);
-    glColor3f(1,1,1);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-500, -500, -500);
-        glNormal3f(-500, -500, -500);
-        glTexCoord2f(0, 1); glVertex3f(-500, 500, -500);
-        glNormal3f(-500, 500, -500);
-        glTexCoord2f(1, 1); glVertex3f(500, 500, -500);
-        glNormal3f(500, 500, -500);
-        glTexCoord2f(1, 0); glVertex3f(500, -500, -500);
-        glNormal3f(500, -500, -500);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-    /*! Floor being constructed */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, floorTexture);
-    setHexColor(0xE0E0E0);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-900, -800, 0);
-        glNormal3f(-900, -800, 0);
-        glTexCoord2f(1, 0); glVertex3f(-500, -500, -500);
-        glNormal3f(-500, -500, -500);
-        glTexCoord2f(1, 1); glVertex3f(500, -500, -500);
-        glNormal3f(500, -500, -500);
-        glTexCoord2f(0, 1); glVertex3f(900, -800, 0);
-        glNormal3f(900, -800, 0);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-    /*! Roof being constructed */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, wallTexture);
-    glColor3f(0.5,0.5,1);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-900, 800, 0);
-        glNormal3f(-900, 800, 0);
-        glTexCoord2f(1, 0); glVertex3f(-500, 500, -500);
-        glNormal3f(-500, 500, -500);
-        glTexCoord2f(1, 1); glVertex3f(500, 500, -500);
-        glNormal3f(500, 500, -500);
-        glTexCoord2f(0, 1); glVertex3f(900, 800, 0);
-        glNormal3f(900, 800, 0);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-    glColor3f(1,1,1);
-    /*! Left Photoframe with photo being constructed */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, picTexture);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-700, 100, 0);
-        glNormal3f(-700, 100, 0);
-        glTexCoord2f(0, 1); glVertex3f(-700, 400, 0);
-        glNormal3f(-700, 400, 0);
-        glTexCoord2f(1, 1); glVertex3f(-600, 350, -300);
-        glNormal3f(-600, 350, -300);
-        glTexCoord2f(1, 0); glVertex3f(-600, 120, -300);
-        glNormal3f(-600, 120, -300);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-    /*! Right photoframe with photo being constructed */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, pic2Texture);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(700, 100, 0);
-        glNormal3f(700, 100, 0);
-        glTexCoord2f(0, 1); glVertex3f(700, 400, 0);
-        glNormal3f(700, 400, 0);
-        glTexCoord2f(1, 1); glVertex3f(600, 350, -300);
-        glNormal3f(600, 350, -300);
-        glTexCoord2f(1, 0); glVertex3f(600, 120, -300);
-        glNormal3f(600, 120, -300);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-    makeTable(); /*!< Table construction */
-}
-
-/*!
-    \fn makeTable()
-    \brief Construct a table
-    Constructs the table with the specified texture mapped.
-*/
-void makeTable(){
-    /*! Top view of the table */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, tableTexture);
-    setHexColor(0x9E9E9E);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-300, -300, -300);
-        glNormal3f(-300, -300, -300);
-        glTexCoord2f(1, 0); glVertex3f(-400, -280, -500);
-        glNormal3f(-400, -280, -500);
-        glTexCoord2f(1, 1); glVertex3f(400, -280, -500);
-        glNormal3f(400, -280, -500);
-        glTexCoord2f(0, 1); glVertex3f(300, -300, -300);
-        glNormal3f(300, -300, -300);
-    glEnd();
-    /*! Front view of the table */
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-300, -300, -300);
-        glNormal3f(-300, -300, -300);
-        glTexCoord2f(0, 1); glVertex3f(300, -300, -300);
-        glNormal3f(300, -300, -300);
-        glTexCoord2f(1, 0); glVertex3f(300, -500, -310);
-        glNormal3f(300, -500, -310);
-        glTexCoord2f(1, 1); glVertex3f(-300, -500, -310);
-        glNormal3f(-300, -500, -310);
-    glEnd();
-    /*! Left view of the table */
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-300, -300, -300);
-        glNormal3f(-300, -300, -300);
-        glTexCoord2f(0, 1); glVertex3f(-400, -280, -500);
-        glNormal3f(-400, -280, -500);
-        glTexCoord2f(1, 0); glVertex3f(-300, -500, -500);
-        glNormal3f(-300, -500, -500);
-        glTexCoord2f(1, 1); glVertex3f(-300, -500, -310);
-        glNormal3f(-300, -500, -310);
-    glEnd();
-    /*! Right view of the table */
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(300, -300, -300);
-        glNormal3f(300, -300, -300);
-        glTexCoord2f(0, 1); glVertex3f(400, -280, -500);
-        glNormal3f(400, -280, -500);
-        glTexCoord2f(1, 0); glVertex3f(300, -500, -500);
-        glNormal3f(300, -500, -500);
-        glTexCoord2f(1, 1); glVertex3f(300, -500, -310);
-        glNormal3f(300, -500, -310);
-    glEnd();
-    /*! Bottom view of the table */
-    glBegin(GL_QUADS);
-        glTexCoord2f(1, 0); glVertex3f(-300, -500, -500);
-        glNormal3f(-400, -280, -500);
-        glTexCoord2f(1, 1); glVertex3f(300, -500, -500);
-        glNormal3f(400, -280, -500);
-        glTexCoord2f(1, 0); glVertex3f(300, -500, -310);
-        glNormal3f(300, -500, -310);
-        glTexCoord2f(1, 1); glVertex3f(-300, -500, -310);
-        glNormal3f(-300, -500, -310);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
+    const GLint corners[6] = {0, 1, 2, 0, 2, 3}; /*!< Triangles of a surface */
+    GLfloat vertices[sizeof(roomSurfaces) / sizeof(roomSurfaces[0]) * 6 * 8]; /*!< Position, normal and lit texture coordinates */
+    GLfloat *vertex = vertices;
+    for(int i=0;i<noOfRoomSurfaces;i++){
+        const GLfloat (*tile)[2] = litRoomTiles[i];
+        for(int v=0;v<6;v++,vertex+=8){
+            memcpy(vertex, roomSurfaces[i].vertices[corners[v]], 3*sizeof(GLfloat));
+            vertex[3] = vertex[4] = vertex[5] = 0; /*!< Unlit */
+            vertex[6] = tile[corners[v]][0];
+            vertex[7] = tile[corners[v]][1];
+        }
+    }
+    fbEnable(GL_TEXTURE_2D);
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    fbBindTexture(GL_TEXTURE_2D, litRoomTexture);
+    fbColor3f(1,1,1);
+    fbDrawTexturedArrays(GL_TRIANGLES, noOfRoomSurfaces * 6, vertices);
+    fbDisable(GL_TEXTURE_2D);
 }
-
-/*!
-    \fn setHexColor(int x)
-    \brief Set hexadecimal color value as rgb color
-    setHexColor is used to set color from received hexadecimal, to
-    the required rgb format.    
-*/
-static void setHexColor(int x /*!< Hexadecimal value */){
-    GLfloat b=(x%0xff)/255.0;
-    GLfloat g=((x>>8)%0xff)/255.0;
-    GLfloat r=((x>>16)%0xff)/255.0;
-    glColor3f(r, g, b); 
-}
\ No newline at end of file
@@ -0,0 +1,225 @@
+/*!
+    /file TextureCache.cpp
+    /brief Persistent cache of decoded textures stored next to the source images
+    Every image has a <image>.fbtc file holding its ready-to-upload mipmap chain.
+    The file is keyed by a hash of the image contents and the load flags, a stale
+    or damaged file is ignored and rewritten the next time the image is decoded.
+*/
+
+#include "./headers/TextureCache.h"
+#include "./headers/DXT.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*!
+    \struct TextureCacheHeader
+    \brief Start of a texture cache file
+    Followed by noOfLevels level headers, noOfMetadata floats and the level data.
+*/
+struct TextureCacheHeader{
+    char magic[4];
+    uint32_t version;
+    uint64_t key;
+    int32_t width, height, channels, compressed, noOfLevels, noOfMetadata;
+};
+
+/*!
+    \struct TextureCacheLevel
+    \brief Size of one cached mipmap level
+*/
+struct TextureCacheLevel{
+    int32_t width, height, size;
+};
+
+/*!
+    \fn cacheFilename(const char *filename)
+    \brief Name of the cache file of an image
+*/
+static std::string cacheFilename(const char *filename){
+    return std::string(filename) + TEXTURE_CACHE_EXTENSION;
+}
+
+/*!
+    \fn mapFile(const char *filename, size_t *size)
+    \brief Map a whole file read-only, NULL if it is missing or empty
+*/
+static void* mapFile(const char *filename, size_t *size){
+    struct stat info;
+    int file = open(filename, O_RDONLY);
+    if(file < 0)
+        return NULL;
+    void *data = NULL;
+    if(fstat(file, &info) == 0 && info.st_size > 0){
+        data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if(data == MAP_FAILED)
+            data = NULL;
+        *size = info.st_size;
+    }
+    close(file);
+    return data;
+}
+
+/*!
+    \fn textureCacheKey(const char *filename, GLint compress)
+    \brief FNV-1a hash of an image file and the flags it is loaded with, 0 if the file is missing
+*/
+uint64_t textureCacheKey(const char *filename, GLint compress){
+    size_t size;
+    void *data = mapFile(filename, &size);
+    if(data == NULL)
+        return 0;
+    uint64_t hash = hashBytes(14695981039346656037ULL, data, size);
+    munmap(data, size);
+    uint32_t flags[] = {TEXTURE_CACHE_VERSION, (uint32_t)compress};
+    return hashBytes(hash, flags, sizeof(flags));
+}
+
+/*!
+    \fn hashBytes(uint64_t hash, const void *data, size_t size)
+    \brief Continue an FNV-1a hash over size bytes of data
+*/
+uint64_t hashBytes(uint64_t hash, const void *data, size_t size){
+    const unsigned char *bytes = (const unsigned char*)data;
+    for(size_t i=0;i<size;i++)
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    return hash;
+}
+
+/*!
+    \fn expectedLevelSize(const TextureCacheHeader *header, GLint64 width, GLint64 height)
+    \brief Bytes a level of the given size takes in the format the header describes
+*/
+static GLint64 expectedLevelSize(const TextureCacheHeader *header, GLint64 width, GLint64 height){
+    if(header->compressed)
+        return ((width + 3)/4) * ((height + 3)/4) * dxtBlockSize(header->channels);
+    return width * height * header->channels;
+}
+
+/*!
+    \fn readTextureCache(TextureImage *image)
+    \brief Map the cached levels of image, returns 0 on a miss
+    Levels point into the mapping, which stays alive until releaseTextureCache.
+    A file whose level sizes do not follow from the header is a miss, so no
+    upload reads past the mapping.
+*/
+GLint readTextureCache(TextureImage *image){
+    for(int i=0;i<TEXTURE_STAGES;i++)
+        image->stageTime[i] = 0;
+    image->cached = 0;
+    image->mapping = NULL;
+    if(image->key == 0)
+        return 0;
+    size_t size;
+    unsigned char *data = (unsigned char*)mapFile(cacheFilename(image->filename).c_str(), &size);
+    if(data == NULL)
+        return 0;
+    TextureCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    if(size >= sizeof(header))
+        memcpy(&header, data, sizeof(header));
+    size_t levelsOffset = sizeof(header);
+    size_t metadataOffset = levelsOffset + header.noOfLevels * sizeof(TextureCacheLevel);
+    size_t offset = metadataOffset + header.noOfMetadata * sizeof(GLfloat);
+    GLint valid = memcmp(header.magic, "FBTC", 4) == 0 && header.version == TEXTURE_CACHE_VERSION
+        && header.key == image->key && header.noOfLevels > 0 && header.noOfMetadata >= 0 && offset <= size
+        && header.width > 0 && header.width <= 1 << 30 && header.height > 0 && header.height <= 1 << 30
+        && (header.channels == 3 || header.channels == 4) && (header.compressed == 0 || header.compressed == 1);
+    /*! The chain starts at the header size rounded up to a power of two and halves down to at most 1x1 */
+    GLint64 width = 1, height = 1;
+    while(valid && width < header.width)
+        width *= 2;
+    while(valid && height < header.height)
+        height *= 2;
+    image->levels.resize(valid ? header.noOfLevels : 0);
+    for(int i=0;valid && i<header.noOfLevels;i++){
+        TextureCacheLevel level;
+        memcpy(&level, data + levelsOffset + i*sizeof(level), sizeof(level));
+        if(i > 0){
+            valid = width > 1 || height > 1;
+            width = width > 1 ? width/2 : 1;
+            height = height > 1 ? height/2 : 1;
+        }
+        valid = valid && level.width == width && level.height == height
+            && level.size == expectedLevelSize(&header, width, height) && offset + level.size <= size;
+        image->levels[i].width = level.width;
+        image->levels[i].height = level.height;
+        image->levels[i].data.clear();
+        image->levels[i].pixels = data + offset;
+        image->levels[i].size = level.size;
+        offset += level.size;
+    }
+    if(!valid){
+        image->levels.clear();
+        munmap(data, size);
+        return 0;
+    }
+    image->metadata.resize(header.noOfMetadata);
+    if(header.noOfMetadata > 0)
+        memcpy(image->metadata.data(), data + metadataOffset, header.noOfMetadata * sizeof(GLfloat));
+    image->width = header.width;
+    image->height = header.height;
+    image->channels = header.channels;
+    image->compressed = header.compressed;
+    image->cached = 1;
+    image->mapping = data;
+    image->mappingSize = size;
+    return 1;
+}
+
+/*!
+    \fn writeTextureCache(TextureImage *image)
+    \brief Store the decoded levels of image in its cache file
+    The file is written under a temporary name and renamed, so a concurrent or
+    interrupted start never sees a partial file. Returns 0 if it could not be written.
+*/
+GLint writeTextureCache(TextureImage *image){
+    if(image->key == 0)
+        return 0;
+    TextureCacheHeader header;
+    memcpy(header.magic, "FBTC", 4);
+    header.version = TEXTURE_CACHE_VERSION;
+    header.key = image->key;
+    header.width = image->width;
+    header.height = image->height;
+    header.channels = image->channels;
+    header.compressed = image->compressed;
+    header.noOfLevels = image->levels.size();
+    header.noOfMetadata = image->metadata.size();
+    std::string filename = cacheFilename(image->filename);
+    std::string temporary = filename + ".tmp";
+    FILE *file = fopen(temporary.c_str(), "wb");
+    if(file == NULL)
+        return 0;
+    GLint written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for(size_t i=0;written && i<image->levels.size();i++){
+        TextureCacheLevel level = {image->levels[i].width, image->levels[i].height, image->levels[i].size};
+        written = fwrite(&level, sizeof(level), 1, file) == 1;
+    }
+    if(written && !image->metadata.empty())
+        written = fwrite(image->metadata.data(), sizeof(GLfloat), image->metadata.size(), file) == image->metadata.size();
+    for(size_t i=0;written && i<image->levels.size();i++)
+        written = fwrite(image->levels[i].pixels, image->levels[i].size, 1, file) == 1;
+    written = fclose(file) == 0 && written;
+    if(!written || rename(temporary.c_str(), filename.c_str()) != 0){
+        remove(temporary.c_str());
+        return 0;
+    }
+    return 1;
+}
+
+/*!
+    \fn releaseTextureCache(TextureImage *image)
+    \brief Unmap the cache file of image once its levels are uploaded
+*/
+void releaseTextureCache(TextureImage *image){
+    if(image->mapping == NULL)
+        return;
+    munmap(image->mapping, image->mappingSize);
+    image->mapping = NULL;
+    image->levels.clear();
+}
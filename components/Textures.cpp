@@ -1,9 +1,275 @@
 /*!
     /file Textures.cpp
     /brief Includes usage of libSOIL for loading and rendering images as Textures
+    Images are decoded, resized to a power of two, mipmapped and compressed on the CPU,
+    so every stage except the GL upload can run on worker threads.
 */
 
 #include "./headers/Textures.h"
+#include "./headers/DXT.h"
+#include "./headers/TextureCache.h"
+#include "../lib/headers/ThreadPool.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+/*!
+    \fn elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+    \brief Milliseconds since start
+*/
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+    \fn nextPowerOfTwo(GLint x)
+    \brief Smallest power of two not less than x
+*/
+static GLint nextPowerOfTwo(GLint x){
+    GLint power = 1;
+    while(power < x)
+        power *= 2;
+    return power;
+}
+
+/*!
+    \fn textureCompressionSupported()
+    \brief Check for DXT texture support, must be called on the GL thread
+*/
+GLint textureCompressionSupported(){
+    const char *extensions = (const char*)glGetString(GL_EXTENSIONS);
+    return extensions != NULL && strstr(extensions, "GL_EXT_texture_compression_s3tc") != NULL;
+}
+
+/*!
+    \fn resizeImage(const unsigned char *pixels, GLint width, GLint height, GLint channels, TextureLevel *level)
+    \brief Bilinear resize of an image to the size of level
+*/
+void resizeImage(const unsigned char *pixels, GLint width, GLint height, GLint channels, TextureLevel *level){
+    level->data.resize(level->width * level->height * channels);
+    for(int y=0;y<level->height;y++){
+        GLfloat sy = (y + 0.5f) * height / level->height - 0.5f;
+        int y0 = sy < 0 ? 0 : (int)sy, y1 = y0 + 1 < height ? y0 + 1 : height - 1;
+        GLfloat fy = sy < 0 ? 0 : sy - y0;
+        for(int x=0;x<level->width;x++){
+            GLfloat sx = (x + 0.5f) * width / level->width - 0.5f;
+            int x0 = sx < 0 ? 0 : (int)sx, x1 = x0 + 1 < width ? x0 + 1 : width - 1;
+            GLfloat fx = sx < 0 ? 0 : sx - x0;
+            for(int c=0;c<channels;c++){
+                GLfloat top = pixels[(y0*width + x0)*channels + c] * (1 - fx) + pixels[(y0*width + x1)*channels + c] * fx;
+                GLfloat bottom = pixels[(y1*width + x0)*channels + c] * (1 - fx) + pixels[(y1*width + x1)*channels + c] * fx;
+                level->data[(y*level->width + x)*channels + c] = (unsigned char)(top * (1 - fy) + bottom * fy + 0.5f);
+            }
+        }
+    }
+}
+
+/*!
+    \fn halveImage(const TextureLevel *source, GLint channels, TextureLevel *level)
+    \brief Next mipmap level, each texel is the average of a 2x2 box of source
+*/
+static void halveImage(const TextureLevel *source, GLint channels, TextureLevel *level){
+    level->width = source->width > 1 ? source->width/2 : 1;
+    level->height = source->height > 1 ? source->height/2 : 1;
+    level->data.resize(level->width * level->height * channels);
+    for(int y=0;y<level->height;y++)
+        for(int x=0;x<level->width;x++){
+            int x0 = 2*x < source->width ? 2*x : source->width - 1, x1 = x0 + 1 < source->width ? x0 + 1 : x0;
+            int y0 = 2*y < source->height ? 2*y : source->height - 1, y1 = y0 + 1 < source->height ? y0 + 1 : y0;
+            for(int c=0;c<channels;c++){
+                const unsigned char *s = source->data.data();
+                int sum = s[(y0*source->width + x0)*channels + c] + s[(y0*source->width + x1)*channels + c]
+                    + s[(y1*source->width + x0)*channels + c] + s[(y1*source->width + x1)*channels + c];
+                level->data[(y*level->width + x)*channels + c] = (sum + 2)/4;
+            }
+        }
+}
+
+/*!
+    \fn decodeImage(TextureImage *image)
+    \brief Decode image->filename into a single level of its original size
+    Alpha is multiplied and y inverted like SOIL_FLAG_MULTIPLY_ALPHA | SOIL_FLAG_INVERT_Y.
+    Safe to call from any thread. Returns 0 if the image could not be decoded.
+*/
+GLint decodeImage(TextureImage *image){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    int width, height, channels;
+    for(int i=0;i<TEXTURE_STAGES;i++)
+        image->stageTime[i] = 0;
+    image->levels.clear();
+    image->cached = 0;
+    image->mapping = NULL;
+    unsigned char *pixels = SOIL_load_image(image->filename, &width, &height, &channels, SOIL_LOAD_AUTO);
+    if(pixels == NULL)
+        return 0;
+    /*! Grey and grey-alpha images are expanded to rgb and rgba */
+    image->channels = (channels == 2 || channels == 4) ? 4 : 3;
+    std::vector<unsigned char> rgb(width * height * image->channels);
+    for(int i=0;i<width*height;i++){
+        const unsigned char *pixel = pixels + i*channels;
+        unsigned char *out = &rgb[i*image->channels];
+        out[0] = pixel[0];
+        out[1] = channels >= 3 ? pixel[1] : pixel[0];
+        out[2] = channels >= 3 ? pixel[2] : pixel[0];
+        if(image->channels == 4){
+            out[3] = pixel[channels - 1];
+            for(int c=0;c<3;c++)
+                out[c] = (out[c] * out[3] + 128)/255; /*!< Multiply alpha */
+        }
+    }
+    SOIL_free_image_data(pixels);
+    /*! Invert y */
+    GLint stride = width * image->channels;
+    std::vector<unsigned char> row(stride);
+    for(int y=0;y<height/2;y++){
+        memcpy(row.data(), &rgb[y*stride], stride);
+        memcpy(&rgb[y*stride], &rgb[(height - 1 - y)*stride], stride);
+        memcpy(&rgb[(height - 1 - y)*stride], row.data(), stride);
+    }
+    image->width = width;
+    image->height = height;
+    image->levels.resize(1);
+    image->levels[0].width = width;
+    image->levels[0].height = height;
+    image->levels[0].data.swap(rgb);
+    image->stageTime[STAGE_DECODE] = elapsedMilliseconds(start);
+    return 1;
+}
+
+/*!
+    \fn buildTextureLevels(TextureImage *image, GLint compress, GLint noOfLevels)
+    \brief Turn the single level left by decodeImage into a power of two mipmap chain
+    noOfLevels limits the chain, 0 builds every level down to 1x1.
+    The levels are compressed to DXT when compress is set.
+*/
+void buildTextureLevels(TextureImage *image, GLint compress, GLint noOfLevels){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    TextureLevel *base = &image->levels[0];
+    if(base->width != nextPowerOfTwo(base->width) || base->height != nextPowerOfTwo(base->height)){
+        TextureLevel level;
+        level.width = nextPowerOfTwo(base->width);
+        level.height = nextPowerOfTwo(base->height);
+        resizeImage(base->data.data(), base->width, base->height, image->channels, &level);
+        base->width = level.width;
+        base->height = level.height;
+        base->data.swap(level.data);
+    }
+    image->stageTime[STAGE_RESIZE] = elapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    while((image->levels.back().width > 1 || image->levels.back().height > 1)
+            && (noOfLevels == 0 || (GLint)image->levels.size() < noOfLevels)){
+        TextureLevel level;
+        halveImage(&image->levels.back(), image->channels, &level);
+        image->levels.push_back(TextureLevel());
+        image->levels.back().width = level.width;
+        image->levels.back().height = level.height;
+        image->levels.back().data.swap(level.data);
+    }
+    image->stageTime[STAGE_MIPMAPS] = elapsedMilliseconds(start);
+
+    start = std::chrono::steady_clock::now();
+    image->compressed = compress;
+    for(size_t i=0;compress && i<image->levels.size();i++){
+        TextureLevel *level = &image->levels[i];
+        std::vector<unsigned char> blocks(dxtImageSize(level->width, level->height, image->channels));
+        compressDXT(level->data.data(), level->width, level->height, image->channels, blocks.data());
+        level->data.swap(blocks);
+    }
+    for(size_t i=0;i<image->levels.size();i++){
+        image->levels[i].pixels = image->levels[i].data.data();
+        image->levels[i].size = image->levels[i].data.size();
+    }
+    image->stageTime[STAGE_COMPRESS] = elapsedMilliseconds(start);
+}
+
+/*!
+    \fn decodeTexture(TextureImage *image, GLint compress)
+    \brief Decode image->filename into a chain of mipmap levels
+    Performs the CPU work SOIL_load_OGL_texture does with the flags used by this project:
+    power of two, mipmaps, multiply alpha, invert y and optionally DXT compression.
+    Safe to call from any thread. Returns 0 if the image could not be decoded.
+*/
+GLint decodeTexture(TextureImage *image, GLint compress){
+    if(!decodeImage(image))
+        return 0;
+    buildTextureLevels(image, compress, 0);
+    return 1;
+}
+
+/*!
+    \fn loadTextureImage(TextureImage *image, GLint compress)
+    \brief Fill image from the texture cache, decoding and caching it on a miss
+    Safe to call from any thread. Returns 0 if the image could not be decoded.
+*/
+GLint loadTextureImage(TextureImage *image, GLint compress){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    image->key = textureCacheKey(image->filename, compress);
+    if(readTextureCache(image)){
+        image->stageTime[STAGE_DECODE] = elapsedMilliseconds(start);
+        return 1;
+    }
+    double hashTime = elapsedMilliseconds(start);
+    if(!decodeTexture(image, compress))
+        return 0;
+    image->stageTime[STAGE_DECODE] += hashTime;
+    writeTextureCache(image);
+    return 1;
+}
+
+/*!
+    \fn uploadTexture(TextureImage *image)
+    \brief Upload every level of a decoded image as a new texture, must be called on the GL thread
+*/
+GLuint uploadTexture(TextureImage *image){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    GLuint texture;
+    GLenum format = image->channels == 4 ? GL_RGBA : GL_RGB;
+    GLenum compressedFormat = image->channels == 4 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for(size_t i=0;i<image->levels.size();i++){
+        TextureLevel *level = &image->levels[i];
+        if(image->compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, i, compressedFormat, level->width, level->height, 0,
+                level->size, level->pixels);
+        else
+            glTexImage2D(GL_TEXTURE_2D, i, format, level->width, level->height, 0, format, GL_UNSIGNED_BYTE, level->pixels);
+    }
+    releaseTextureCache(image);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, image->levels.size() - 1);
+    glEnable(GL_TEXTURE_2D);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    image->stageTime[STAGE_UPLOAD] = elapsedMilliseconds(start);
+    return texture;
+}
+
+/*!
+    \fn streamTexture(UploadRing *ring, TextureImage *image, StreamedTexture *texture)
+    \brief Copy every level of a decoded image into ring, texture is created from them by ring->pump
+    Safe to call from any thread, blocks while the ring is full. The levels
+    are copied, so the cache file of image is released right away.
+*/
+void streamTexture(UploadRing *ring, TextureImage *image, StreamedTexture *texture){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    texture->texture = 0;
+    texture->ready = 0;
+    texture->noOfLevels = image->levels.size();
+    texture->compressed = image->compressed;
+    if(image->compressed)
+        texture->format = image->channels == 4 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    else
+        texture->format = image->channels == 4 ? GL_RGBA : GL_RGB;
+    for(size_t i=0;i<image->levels.size();i++){
+        TextureLevel *level = &image->levels[i];
+        ring->write(texture, i, level->width, level->height, level->pixels, level->size);
+    }
+    releaseTextureCache(image);
+    image->stageTime[STAGE_UPLOAD] = elapsedMilliseconds(start);
+}
 
 /*!
     \fn loadTextures(char* filename)
@@ -11,26 +277,87 @@
     Load the given input filename as an image using libSOIL and render it as a texture
 */
 GLuint loadTextures(char* filename){
-    GLuint texture = SOIL_load_OGL_texture(
-                filename,
-                SOIL_LOAD_AUTO,
-                SOIL_CREATE_NEW_ID,
-                SOIL_FLAG_POWER_OF_TWO
-                | SOIL_FLAG_MIPMAPS
-                | SOIL_FLAG_MULTIPLY_ALPHA
-                | SOIL_FLAG_COMPRESS_TO_DXT
-                | SOIL_FLAG_DDS_LOAD_DIRECT
-                | SOIL_FLAG_INVERT_Y
-                );
-
-    if (texture == 0){
+    TextureImage image;
+    image.filename = filename;
+    if(!loadTextureImage(&image, textureCompressionSupported())){
         cout<<"Texture Load Error: " + string(filename) +" File is Probably Missing or Load Error\n";
         exit(-1);
     }
     cout<<endl<<filename<<" -> Loaded Successfully";
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture (GL_TEXTURE_2D, texture);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    return texture;
-}
\ No newline at end of file
+    return uploadTexture(&image);
+}
+
+/*!
+    \fn decodeTextures(char **filenames, TextureImage *images, GLint count, GLint compress)
+    \brief Fill images[i] from filenames[i] on a pool of worker threads
+    Images are read from the texture cache or decoded. Safe to call from any thread,
+    returns the number of threads used.
+*/
+GLint decodeTextures(char **filenames, TextureImage *images, GLint count, GLint compress){
+    std::vector<GLint> decoded(count);
+    ThreadPool pool(TEXTURE_LOADER_THREADS);
+    for(int i=0;i<count;i++){
+        images[i].filename = filenames[i];
+        pool.enqueue([images, &decoded, i, compress]{ decoded[i] = loadTextureImage(&images[i], compress); });
+    }
+    pool.wait();
+    for(int i=0;i<count;i++)
+        if(!decoded[i]){
+            cout<<"Texture Load Error: " + string(filenames[i]) +" File is Probably Missing or Load Error\n";
+            exit(-1);
+        }
+    return pool.size();
+}
+
+/*!
+    \fn uploadTextures(TextureImage *images, GLuint **textures, GLint count)
+    \brief Upload decoded images, textures[i] receives the texture of images[i]
+*/
+void uploadTextures(TextureImage *images, GLuint **textures, GLint count){
+    for(int i=0;i<count;i++){
+        *textures[i] = uploadTexture(&images[i]);
+        cout<<endl<<images[i].filename<<" -> Loaded Successfully";
+    }
+}
+
+/*!
+    \fn loadTexturesParallel(char **filenames, GLuint **textures, GLint count)
+    \brief Load several images as textures at once
+    Images are decoded on a pool of worker threads, only the upload runs on the GL thread.
+    textures[i] receives the texture created from filenames[i].
+*/
+void loadTexturesParallel(char **filenames, GLuint **textures, GLint count){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::vector<TextureImage> images(count);
+    GLint noOfThreads = decodeTextures(filenames, images.data(), count, textureCompressionSupported());
+    uploadTextures(images.data(), textures, count);
+    printTextureTimings(images.data(), count, elapsedMilliseconds(start), noOfThreads);
+}
+
+/*!
+    \fn printTextureTimings(TextureImage *images, GLint count, double wallTime, GLint noOfThreads)
+    \brief Print the time spent in every stage of loading each image
+*/
+void printTextureTimings(TextureImage *images, GLint count, double wallTime, GLint noOfThreads){
+    const char *stages[] = {"decode", "resize", "mipmaps", "compress", "upload"};
+    double total[TEXTURE_STAGES] = {0}, sum = 0;
+    GLint hits = 0;
+    printf("\n%-22s %11s %6s", "texture (ms)", "size", "cache");
+    for(int s=0;s<TEXTURE_STAGES;s++)
+        printf(" %9s", stages[s]);
+    for(int i=0;i<count;i++){
+        printf("\n%-22s %5dx%-5d %6s", images[i].filename, images[i].width, images[i].height, images[i].cached ? "hit" : "miss");
+        hits += images[i].cached;
+        for(int s=0;s<TEXTURE_STAGES;s++){
+            printf(" %9.2f", images[i].stageTime[s]);
+            total[s] += images[i].stageTime[s];
+            sum += images[i].stageTime[s];
+        }
+    }
+    printf("\n%-22s %11s %6s", "total", "", "");
+    for(int s=0;s<TEXTURE_STAGES;s++)
+        printf(" %9.2f", total[s]);
+    printf("\n%s start: textures loaded in %.2f ms on %d threads (%.2f ms of work, %d of %d from cache)\n",
+        hits == count ? "Warm" : "Cold", wallTime, noOfThreads, sum, hits, count);
+    fflush(stdout);
+}
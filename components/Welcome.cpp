@@ -5,7 +5,6 @@
 
 #include "./headers/Welcome.h"
 
-extern GLfloat pageAngle, pageFlipLimit;
 extern void setHexColor(int);
 GLuint welcomeTexture;
 
@@ -17,16 +16,17 @@ GLuint welcomeTexture;
 void renderText(char *string){
     int length = strlen(string);
     for(int i=0;i<length;i++)
-        glutStrokeCharacter(GLUT_STROKE_ROMAN, string[i]);
+        fbStrokeCharacter(string[i]);
 }
 
 /*!
-    \fn showHeading()
+    \fn showHeading(GLfloat angle)
     \brief Render Heading
     Heading Text which is rendered which flips along the x axis during idle execution.
+    angle -> current rotation of the heading
 */
-void showHeading(){
-    char heading[] = "FlipBook";
+void showHeading(GLfloat angle){
+    static char heading[] = "FlipBook"; /*!< Static, so the strings are not copied onto the stack every frame */
     GLfloat LIGHT_AMBIENT[]={0.04f,0.09f, 0.07f, 1};
     GLfloat LIGHT_DIFFUSE[]={0.73f,0.74f,0.46f,1};
     GLfloat LIGHT_POSITION[]={550.0f, 500.0f, 100.0f, 1.0f};
@@ -35,39 +35,39 @@ void showHeading(){
     GLfloat mat_specular[]={1.0f,1.0f,1.0f,1.0f};
     GLfloat mat_shininess[]={50.0f};
     /*!< Lighting and Shading */
-    glEnable(GL_LIGHTING);
-    glEnable(GL_LIGHT0);
-    glLightfv(GL_LIGHT0, GL_AMBIENT, LIGHT_AMBIENT);
-    glLightfv(GL_LIGHT0, GL_DIFFUSE, LIGHT_DIFFUSE);
+    fbEnable(GL_LIGHTING);
+    fbEnable(GL_LIGHT0);
+    fbLightfv(GL_LIGHT0, GL_AMBIENT, LIGHT_AMBIENT);
+    fbLightfv(GL_LIGHT0, GL_DIFFUSE, LIGHT_DIFFUSE);
     GLfloat LIGHT_AMBIENT1[]={0.4f,0.4f, 0.47f, 1};
     GLfloat LIGHT_DIFFUSE1[]={0.53f,0.74f,0.66f,1};
-    glEnable(GL_LIGHT1);
-    glLightfv(GL_LIGHT1, GL_AMBIENT, LIGHT_AMBIENT1);
-    glLightfv(GL_LIGHT1, GL_DIFFUSE, LIGHT_DIFFUSE1);
-    glLightfv(GL_LIGHT1, GL_POSITION, LIGHT_POSITION);
-    glLineWidth(2);
-    //glColor3f(0.3,0,0.5);
-    glPushMatrix();
-        glLoadIdentity();
-        glMaterialfv(GL_FRONT,GL_AMBIENT,mat_ambient);
-        glMaterialfv(GL_FRONT,GL_DIFFUSE,mat_diffuse);
-        glMaterialfv(GL_FRONT,GL_SPECULAR,mat_specular);
-        glMaterialfv(GL_FRONT,GL_SHININESS,mat_shininess);
-        glTranslatef(-300,450,0);
-        glScalef(1.5,1.5,10);
-        glRotatef(pageAngle, 1 , 0 ,0);
-        glBegin(GL_LINES);
-            glVertex3f(-20,-15,0);
-            glVertex3f(510, -15, 0);
-        glEnd();
+    fbEnable(GL_LIGHT1);
+    fbLightfv(GL_LIGHT1, GL_AMBIENT, LIGHT_AMBIENT1);
+    fbLightfv(GL_LIGHT1, GL_DIFFUSE, LIGHT_DIFFUSE1);
+    fbLightfv(GL_LIGHT1, GL_POSITION, LIGHT_POSITION);
+    fbLineWidth(2);
+    //fbColor3f(0.3,0,0.5);
+    fbPushMatrix();
+        fbLoadIdentity();
+        fbMaterialfv(GL_FRONT,GL_AMBIENT,mat_ambient);
+        fbMaterialfv(GL_FRONT,GL_DIFFUSE,mat_diffuse);
+        fbMaterialfv(GL_FRONT,GL_SPECULAR,mat_specular);
+        fbMaterialfv(GL_FRONT,GL_SHININESS,mat_shininess);
+        fbTranslatef(-300,450,0);
+        fbScalef(1.5,1.5,10);
+        fbRotatef(angle, 1 , 0 ,0);
+        fbBegin(GL_LINES);
+            fbVertex3f(-20,-15,0);
+            fbVertex3f(510, -15, 0);
+        fbEnd();
         renderText(heading);
-        glFlush();
-    glPopMatrix();
-    glDisable(GL_LIGHT0);
-    glDisable(GL_LIGHT1);
-    glDisable(GL_LIGHTING);
-    glLineWidth(1);
-    glColor3f(1,1,1);
+        fbFlush();
+    fbPopMatrix();
+    fbDisable(GL_LIGHT0);
+    fbDisable(GL_LIGHT1);
+    fbDisable(GL_LIGHTING);
+    fbLineWidth(1);
+    fbColor3f(1,1,1);
 }
 
 /*!
@@ -76,7 +76,7 @@ void showHeading(){
     Credits for the project are displayed under this section using lighting and shading.
 */
 void showCredits(){
-    char developer[][50] = {"Kshitij Karthick 1RE12CS042","Srinivas Ananth 1RE12CS034"};
+    static char developer[][50] = {"Kshitij Karthick 1RE12CS042","Srinivas Ananth 1RE12CS034"};
     GLfloat LIGHT_AMBIENT[] =   //< light ambience
         {0.3f,0.3f, 0.57f, 1};
     GLfloat LIGHT_DIFFUSE[] =   //< light diffusion
@@ -84,78 +84,80 @@ void showCredits(){
     GLfloat LIGHT_POSITION[] =  //< light position
         {-322.0f, -500.0f, 350.0f, 1};
     /*! Enable lighting and shading */
-    glEnable(GL_LIGHT0);
-    glEnable(GL_LIGHTING);
-    glLightfv(GL_LIGHT0, GL_AMBIENT, LIGHT_AMBIENT);
-    glLightfv(GL_LIGHT0, GL_DIFFUSE, LIGHT_DIFFUSE);
-    glLightfv(GL_LIGHT0, GL_POSITION, LIGHT_POSITION);
-    glLineWidth(2);
-    glPushMatrix();
-        glLoadIdentity();
-        glTranslatef(-880,-400,0);
-        glScalef(0.5,0.5,1);
+    fbEnable(GL_LIGHT0);
+    fbEnable(GL_LIGHTING);
+    fbLightfv(GL_LIGHT0, GL_AMBIENT, LIGHT_AMBIENT);
+    fbLightfv(GL_LIGHT0, GL_DIFFUSE, LIGHT_DIFFUSE);
+    fbLightfv(GL_LIGHT0, GL_POSITION, LIGHT_POSITION);
+    fbLineWidth(2);
+    fbPushMatrix();
+        fbLoadIdentity();
+        fbTranslatef(-880,-400,0);
+        fbScalef(0.5,0.5,1);
         renderText(developer[0]);
-        glFlush();
-    glPopMatrix();
-    glPushMatrix();
-        glLoadIdentity();
-        glTranslatef(-880,-500,0);
-        glScalef(0.5,0.5,1);
+        fbFlush();
+    fbPopMatrix();
+    fbPushMatrix();
+        fbLoadIdentity();
+        fbTranslatef(-880,-500,0);
+        fbScalef(0.5,0.5,1);
         renderText(developer[1]);
-        glFlush();
-    glPopMatrix();
-    glDisable(GL_LIGHT0);
-    glDisable(GL_LIGHTING);
-    glLineWidth(1);
+        fbFlush();
+    fbPopMatrix();
+    fbDisable(GL_LIGHT0);
+    fbDisable(GL_LIGHTING);
+    fbLineWidth(1);
 }
 
 /*!
-    \fn showFooter()
+    \fn showFooter(GLfloat angle)
     \brief Show footer message
     Show footer message for instructions to be followed by the user as a marquee.
+    angle -> animation angle the marquee position follows
 */
-void showFooter(){
-    char message[]="Press Enter to Continue to the Flipbook, +/- to Speed Control, n/p Page Control, W to go to welcome screen, Q for quit";
-    glLineWidth(2.0);
-    glPushMatrix();
-        glLoadIdentity();
-        glTranslatef(- 2 * WINDOW_WIDTH + pageAngle*4,-650,0);
-        glScalef(0.5,0.5,1);
+void showFooter(GLfloat angle){
+    static char message[]="Press Enter to Continue to the Flipbook, +/- to Speed Control, n/p Page Control, / to Search, O for Overview, W to go to welcome screen, Q for quit";
+    fbLineWidth(2.0);
+    fbPushMatrix();
+        fbLoadIdentity();
+        fbTranslatef(- 2 * WINDOW_WIDTH + angle*4,-650,0);
+        fbScalef(0.5,0.5,1);
         renderText(message);
-        glFlush();
-    glPopMatrix();
-    glLineWidth(1);
+        fbFlush();
+    fbPopMatrix();
+    fbLineWidth(1);
 }
 
 /*!
-    \fn runWelcomeScreen()
+    \fn runWelcomeScreen(GLfloat angle, GLint footer)
     \brief Set background image
     Load the welcome screen with the required welcome image.
     Render the header, footer, credits to the user using stroke character
     and transformations with lighting and shading.
+    footer -> 0 leaves the footer to be drawn over the scaled up scene
 */
-void runWelcomeScreen(){
-    pageFlipLimit = 720;
-    glPushMatrix();
-    glLoadIdentity();
+void runWelcomeScreen(GLfloat angle, GLint footer){
+    fbPushMatrix();
+    fbLoadIdentity();
     /*! Render the background image on the welcome screen */
-    glEnable(GL_TEXTURE_2D);
-    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    glBindTexture(GL_TEXTURE_2D, welcomeTexture);
-    glColor3f(1,1,1);
-    glBegin(GL_QUADS);
-        glTexCoord2f(0, 0); glVertex3f(-WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
-        glNormal3f(-WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
-        glTexCoord2f(1, 0); glVertex3f(WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
-        glNormal3f(WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
-        glTexCoord2f(1, 1); glVertex3f(WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
-        glNormal3f(WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
-        glTexCoord2f(0, 1); glVertex3f(-WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
-        glNormal3f(-WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
-    glEnd();
-    glDisable(GL_TEXTURE_2D);
-    glPopMatrix();
-    showHeading();
+    fbEnable(GL_TEXTURE_2D);
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    fbBindTexture(GL_TEXTURE_2D, welcomeTexture);
+    fbColor3f(1,1,1);
+    fbBegin(GL_QUADS);
+        fbTexCoord2f(0, 0); fbVertex3f(-WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
+        fbNormal3f(-WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
+        fbTexCoord2f(1, 0); fbVertex3f(WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
+        fbNormal3f(WINDOW_WIDTH, -WINDOW_HEIGHT, -1000);
+        fbTexCoord2f(1, 1); fbVertex3f(WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
+        fbNormal3f(WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
+        fbTexCoord2f(0, 1); fbVertex3f(-WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
+        fbNormal3f(-WINDOW_WIDTH, WINDOW_HEIGHT, -1000);
+    fbEnd();
+    fbDisable(GL_TEXTURE_2D);
+    fbPopMatrix();
+    showHeading(angle);
     showCredits();
-    showFooter();
+    if(footer == 1)
+        showFooter(angle);
 }
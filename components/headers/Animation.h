@@ -0,0 +1,114 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _ANIMATION_H
+#define _ANIMATION_H
+#include "../../lib/headers/Page.h"
+#include "../../lib/headers/UploadRing.h"
+#include "./Textures.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*!
+    \struct AnimationSource
+    \brief Animated page asked for on the command line
+*/
+struct AnimationSource{
+    GLint pageIndex;
+    const char *path; /*!< Directory of frames or sprite sheet */
+    GLint columns, rows; /*!< Frames of a sprite sheet, 0 for a strip of square frames */
+};
+
+enum AnimationSlotState{
+    SLOT_FREE, /*!< May be decoded into */
+    SLOT_DECODING, /*!< Owned by the decoder */
+    SLOT_QUEUED /*!< Written into the upload ring, uploaded once its texture is ready */
+};
+
+/*!
+    \struct AnimationSlot
+    \brief Decoded frame of an animation with the texture it is uploaded into
+    The texture is created once and every frame decoded into the slot is
+    uploaded into it again.
+*/
+struct AnimationSlot{
+    std::atomic<GLint> state;
+    GLint frame; /*!< Frame held, counted from the start of playback without wrapping */
+    StreamedTexture texture;
+};
+
+/*!
+    \class Animation
+    \brief Frames of an animated page, decoded ahead into a ring of slots
+    The frames are the images of a directory in name order, or the tiles of
+    a sprite sheet read left to right, top to bottom. Every frame is drawn
+    over white and resized to ANIMATION_FRAME_SIZE texels square. Animations
+    of no more than ANIMATION_SLOTS frames are decoded once and stay resident.
+*/
+class Animation{
+    public:
+        std::string source;
+        GLint noOfFrames;
+        GLint columns, rows; /*!< Tiles of the sprite sheet, 0 for a directory */
+        std::vector<std::string> frameFiles; /*!< Frames of a directory, empty for a sprite sheet */
+        std::vector<unsigned char> sheet; /*!< Sprite sheet drawn over white, rgb rows top first */
+        GLint sheetWidth, sheetHeight;
+        PageAnimation page; /*!< Frame the page shows */
+        AnimationSlot slots[ANIMATION_SLOTS];
+        GLint nextFrame; /*!< Next frame to decode, guarded by the mutex of the player */
+        GLint shownFrame; /*!< Frame the page shows, -1 before the first */
+        GLint dueFrame; /*!< Frame due when last updated, -1 before the first */
+        GLuint framesOnTime, framesLate; /*!< Frames shown when due, frames due before they were uploaded */
+        Animation();
+        GLint open(const char*, GLint, GLint);
+        GLint resident();
+        void decodeFrame(GLint);
+        const unsigned char* frame();
+    private:
+        std::vector<unsigned char> tile; /*!< Tile of the sprite sheet or decoded frame, rgb */
+        TextureLevel resized; /*!< Frame at ANIMATION_FRAME_SIZE, rgb */
+};
+
+/*!
+    \class AnimationPlayer
+    \brief Plays the animated pages on the animation clock
+    One decoder thread decodes the frames of every animation ahead into free
+    slots and writes them into the upload ring, so each frame is uploaded once,
+    the ring being pumped on the GL thread. update is called on the GL thread
+    every animation step, shows the frames due and frees the slots played.
+*/
+class AnimationPlayer{
+    public:
+        std::vector<Animation*> animations;
+        GLint playedFrame; /*!< Frame due at the current step, -1 before playback starts */
+        double decodeTime; /*!< ms spent decoding frames */
+        GLuint framesDecoded;
+        AnimationPlayer();
+        Animation* add(const char*, GLint, GLint);
+        void start(UploadRing*, GLuint);
+        void stop();
+        void update(GLuint);
+        void report();
+    private:
+        UploadRing *ring;
+        GLuint startStep;
+        std::thread decoder;
+        std::mutex mutex;
+        std::condition_variable slotFreed;
+        GLint running;
+        std::atomic<GLint> stopped; /*!< Set by the decoder once it returned */
+        void decode();
+        Animation* nextToDecode(AnimationSlot**, GLint*);
+};
+#endif
@@ -0,0 +1,28 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _ATLAS_H
+#define _ATLAS_H
+#include "./Textures.h"
+/*!
+    \struct AtlasRect
+    \brief Rectangle of texels in an atlas
+*/
+struct AtlasRect{
+    GLint x, y, width, height;
+};
+
+GLint packAtlas(const std::vector<AtlasRect>&, GLint, GLint, std::vector<AtlasRect>*);
+void prepareTextureAtlas(char**, GLint, GLint, GLint, TextureImage*);
+void registerTextureAtlas(TextureImage*, GLuint, char**, GLuint**, GLint);
+GLuint uploadTextureAtlas(TextureImage*, char**, GLuint**, GLint);
+GLint maxTextureSize();
+GLuint loadTextureAtlas(char**, GLuint**, GLint);
+#endif
@@ -0,0 +1,11 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _DXT_H
+#define _DXT_H
+GLint dxtBlockSize(GLint);
+GLint dxtImageSize(GLint, GLint, GLint);
+void compressDXT(const unsigned char*, GLint, GLint, GLint, unsigned char*);
+#endif
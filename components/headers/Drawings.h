@@ -5,6 +5,7 @@
 
 #ifndef _DRAWINGS_H
 #define _DRAWINGS_H
+#include "../../lib/headers/GLBackend.h"
 void level(GLfloat,GLfloat, GLfloat, GLfloat, GLfloat);
 void level1(GLfloat,GLfloat, GLfloat, GLfloat, GLfloat);
 void level2(GLfloat,GLfloat, GLfloat, GLfloat, GLfloat);
@@ -0,0 +1,34 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _LIGHTMAP_H
+#define _LIGHTMAP_H
+#include "./Room.h"
+#include <stdint.h>
+#include <vector>
+/*!
+    \struct Lightmap
+    \brief Light baked over the room surfaces, a square tile per surface
+*/
+struct Lightmap{
+    GLint size; /*!< Texels on a side, 0 when nothing is baked */
+    uint64_t key; /*!< Hash of the surfaces and the bake settings */
+    std::vector<unsigned char> texels; /*!< RGB rows */
+    GLint threads; /*!< Threads it was baked on, 0 when read from its cache */
+};
+
+void lightmapTile(GLint, GLint, GLint, GLfloat[4][2]);
+uint64_t lightmapKey(const RoomSurface*, GLint);
+void bakeLightmap(const RoomSurface*, GLint, Lightmap*);
+GLint readLightmap(const char*, Lightmap*);
+GLint writeLightmap(const char*, const Lightmap*);
+void loadLightmap(const char*, const RoomSurface*, GLint, Lightmap*);
+GLuint composeLitRoom(const RoomSurface*, GLint, Lightmap*, GLfloat[][4][2]);
+#endif
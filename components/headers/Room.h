@@ -10,5 +10,21 @@
 
 #ifndef _ROOM_H
 #define _ROOM_H
+#include "../../lib/headers/GLBackend.h"
+/*!
+    \struct RoomSurface
+    \brief Textured quad of the room or its furniture
+    Drawn as the triangles v0 v1 v2 and v0 v2 v3, the lightmap is baked over the same ones.
+*/
+struct RoomSurface{
+    GLuint *texture; /*!< Texture of the surface */
+    GLfloat color[3];
+    GLfloat texCoords[4][2];
+    GLfloat vertices[4][3];
+};
+extern const RoomSurface roomSurfaces[];
+extern const GLint noOfRoomSurfaces;
+extern GLuint litRoomTexture;
+extern GLfloat litRoomTiles[][4][2];
 void drawRoom(void);
-#endif
\ No newline at end of file
+#endif
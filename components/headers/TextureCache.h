@@ -0,0 +1,19 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _TEXTURE_CACHE_H
+#define _TEXTURE_CACHE_H
+#include "./Textures.h"
+uint64_t hashBytes(uint64_t, const void*, size_t);
+uint64_t textureCacheKey(const char*, GLint);
+GLint readTextureCache(TextureImage*);
+GLint writeTextureCache(TextureImage*);
+void releaseTextureCache(TextureImage*);
+#endif
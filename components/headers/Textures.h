@@ -10,8 +10,60 @@
 
 #ifndef _TEXTURES_H_
 #define _TEXTURES_H_
+#include "../../lib/headers/UploadRing.h"
 #include <SOIL/SOIL.h>
 #include <iostream>
+#include <stdint.h>
+#include <vector>
 using namespace std;
+
+/*!
+    \enum TextureStage
+    \brief Stages of loading an image as a texture, timed individually
+*/
+enum TextureStage{
+    STAGE_DECODE, STAGE_RESIZE, STAGE_MIPMAPS, STAGE_COMPRESS, STAGE_UPLOAD, TEXTURE_STAGES
+};
+
+/*!
+    \struct TextureLevel
+    \brief A single mipmap level ready to be uploaded
+*/
+struct TextureLevel{
+    GLint width, height;
+    std::vector<unsigned char> data; /*!< Texels owned by this level, empty when mapped from the cache */
+    const unsigned char *pixels; /*!< Data uploaded for this level */
+    GLint size; /*!< Bytes at pixels */
+};
+
+/*!
+    \struct TextureImage
+    \brief An image decoded on the CPU into a chain of mipmap levels
+*/
+struct TextureImage{
+    char *filename;
+    GLint width, height, channels; /*!< Size of the decoded image, channels is 3 or 4 */
+    GLint compressed; /*!< Levels hold DXT1 (3 channels) or DXT5 (4 channels) blocks */
+    std::vector<TextureLevel> levels;
+    double stageTime[TEXTURE_STAGES]; /*!< Milliseconds spent in every stage */
+    std::vector<GLfloat> metadata; /*!< Extra values stored with the image in the texture cache */
+    uint64_t key; /*!< Hash of the image file and load flags */
+    GLint cached; /*!< Levels were mapped from the texture cache */
+    void *mapping; /*!< Mapped cache file, released after upload */
+    size_t mappingSize;
+};
+
+GLint textureCompressionSupported();
+void resizeImage(const unsigned char*, GLint, GLint, GLint, TextureLevel*);
+GLint decodeImage(TextureImage*);
+void buildTextureLevels(TextureImage*, GLint, GLint);
+GLint decodeTexture(TextureImage*, GLint);
+GLint loadTextureImage(TextureImage*, GLint);
+GLuint uploadTexture(TextureImage*);
+void streamTexture(UploadRing*, TextureImage*, StreamedTexture*);
 GLuint loadTextures(char*);
-#endif
\ No newline at end of file
+GLint decodeTextures(char**, TextureImage*, GLint, GLint);
+void uploadTextures(TextureImage*, GLuint**, GLint);
+void loadTexturesParallel(char**, GLuint**, GLint);
+void printTextureTimings(TextureImage*, GLint, double, GLint);
+#endif
@@ -11,9 +11,10 @@
 #ifndef _WELCOME_SCREEN_H
 #define _WELCOME_SCREEN_H
 #include <string.h>
+#include "../../lib/headers/GLBackend.h"
 void renderText(char*);
-void showHeading();
-void showFooter();
+void showHeading(GLfloat);
+void showFooter(GLfloat);
 void showCredits();
-void runWelcomeScreen();
+void runWelcomeScreen(GLfloat, GLint footer = 1);
 #endif
\ No newline at end of file
@@ -48,6 +48,51 @@
 	/brief Identify a page that it is a drawing page
 */
 #define PAGE_TYPE_DRAWING 1
+/*!
+	/def PAGE_TYPE_ANIMATION
+	/brief Identify a page that it is an animated page
+*/
+#define PAGE_TYPE_ANIMATION 2
+/*!
+	/def PAGE_TYPE_VECTOR
+	/brief Identify a page that it is a vector drawing page
+*/
+#define PAGE_TYPE_VECTOR 3
+/*!
+	/def PAGE_DETAIL_FULL
+	/brief Page detail level drawing every stroke of the text and every polygon of a drawing
+*/
+#define PAGE_DETAIL_FULL 0
+/*!
+	/def PAGE_DETAIL_SIMPLE
+	/brief Page detail level drawing text with simplified glyph outlines
+*/
+#define PAGE_DETAIL_SIMPLE 1
+/*!
+	/def PAGE_DETAIL_GREEKED
+	/brief Page detail level drawing a grey bar per line of text
+*/
+#define PAGE_DETAIL_GREEKED 2
+/*!
+	/def PAGE_DETAIL_FLAT
+	/brief Page detail level drawing the page as a single tinted quad
+*/
+#define PAGE_DETAIL_FLAT 3
+/*!
+	/def PAGE_DETAIL_LEVELS
+	/brief Number of page detail levels
+*/
+#define PAGE_DETAIL_LEVELS 4
+/*!
+	/def PAGE_DETAIL_PIXEL_ERROR
+	/brief Largest error in pixels a page may be drawn with, 0 always draws full detail
+*/
+#define PAGE_DETAIL_PIXEL_ERROR 2
+/*!
+	/def PAGE_GLYPH_TOLERANCE
+	/brief Largest distance in font units a simplified glyph strays from the original strokes
+*/
+#define PAGE_GLYPH_TOLERANCE 8
 /*!
 	/def BOOK_THICKNESS
 	/brief Set max book thickness
@@ -70,9 +115,89 @@
 #define BOOK_WIDTH PAGE_WIDTH + 2*BOOK_BORDER_SIZE
 /*!
 	/def MAX_NO_PAGES
-	/brief Set max no of pages in a book
+	/brief Initial no of pages a book has room for, the book grows beyond it as pages are added
 */
 #define MAX_NO_PAGES 100
+/*!
+	/def PAGE_STACK_MAX_THICKNESS
+	/brief Pages of thick books are squeezed to keep the page stack within this depth
+*/
+#define PAGE_STACK_MAX_THICKNESS 200
+/*!
+	/def PAGE_STACK_DETAIL
+	/brief Slabs of the page stack per level of detail, each level has twice the pages per slab
+*/
+#define PAGE_STACK_DETAIL 8
+/*!
+	/def PAGE_STACK_LEVELS
+	/brief Levels of detail of the page stack, the pages beyond them form a single slab
+*/
+#define PAGE_STACK_LEVELS 3
+/*!
+	/def LIBRARY_BOOKS
+	/brief Closed books standing on the shelves of the library view
+*/
+#define LIBRARY_BOOKS 5000
+/*!
+	/def LIBRARY_BOOK_MIN_PAGES
+	/brief Fewest pages a book of the library opens with, its title and last page included
+*/
+#define LIBRARY_BOOK_MIN_PAGES 6
+/*!
+	/def LIBRARY_BOOK_MAX_PAGES
+	/brief Most pages a book of the library opens with
+*/
+#define LIBRARY_BOOK_MAX_PAGES 40
+/*!
+	/def LIBRARY_SHELVES
+	/brief Shelves of every bookcase in the library
+*/
+#define LIBRARY_SHELVES 6
+/*!
+	/def LIBRARY_SHELF_HEIGHT
+	/brief Distance between two shelves of a bookcase
+*/
+#define LIBRARY_SHELF_HEIGHT 400
+/*!
+	/def LIBRARY_CASE_WIDTH
+	/brief Length of a bookcase along the wall
+*/
+#define LIBRARY_CASE_WIDTH 1200
+/*!
+	/def LIBRARY_HALL_WIDTH
+	/brief Distance between the bookcases on the two walls of the library
+*/
+#define LIBRARY_HALL_WIDTH 1600
+/*!
+	/def LIBRARY_EYE_HEIGHT
+	/brief Height of the camera walking through the library
+*/
+#define LIBRARY_EYE_HEIGHT 1000
+/*!
+	/def LIBRARY_FIELD_OF_VIEW
+	/brief Vertical field of view of the library camera in degrees
+*/
+#define LIBRARY_FIELD_OF_VIEW 60
+/*!
+	/def LIBRARY_FAR_PLANE
+	/brief Books beyond this distance are culled
+*/
+#define LIBRARY_FAR_PLANE 20000
+/*!
+	/def LIBRARY_FULL_DETAIL_DISTANCE
+	/brief Books closer than this are drawn with covers, spine and page block
+*/
+#define LIBRARY_FULL_DETAIL_DISTANCE 1500
+/*!
+	/def LIBRARY_BOX_DETAIL_DISTANCE
+	/brief Books closer than this are drawn as a box, further ones as a spine impostor
+*/
+#define LIBRARY_BOX_DETAIL_DISTANCE 6000
+/*!
+	/def LIBRARY_WALK_STEP
+	/brief Distance walked per arrow key press in the library
+*/
+#define LIBRARY_WALK_STEP 150
 /*!
 	/def MARGIN_HEIGHT
 	/brief Set max margin height
@@ -88,3 +213,449 @@
 	/brief Set default flip speed
 */
 #define PAGE_FLIP_SPEED 2
+
+/*!
+	/def BACKEND_IMMEDIATE
+	/brief GL backend which forwards every call to OpenGL
+*/
+#define BACKEND_IMMEDIATE 0
+/*!
+	/def BACKEND_RECORDING
+	/brief GL backend which records every call into memory
+*/
+#define BACKEND_RECORDING 1
+/*!
+	/def BENCH_MIN_TIME_MS
+	/brief Minimum time spent measuring a single benchmark
+*/
+#define BENCH_MIN_TIME_MS 200
+/*!
+	/def CAPTURE_FILENAME
+	/brief File a captured frame is saved to
+*/
+#define CAPTURE_FILENAME "frame.fbcb"
+/*!
+	/def REPLAY_FRAMES
+	/brief Default number of frames replayed by the replay benchmark
+*/
+#define REPLAY_FRAMES 500
+/*!
+	/def LIBRARY_BENCH_BOOKS
+	/brief Default number of books in the library stress benchmark
+*/
+#define LIBRARY_BENCH_BOOKS 10000
+/*!
+	/def LIBRARY_BENCH_FRAMES
+	/brief Default number of frames walked through the library by the stress benchmark
+*/
+#define LIBRARY_BENCH_FRAMES 60
+/*!
+	/def RELOAD_BENCH_PAGES
+	/brief Pages of the book edited by the page reload benchmark
+*/
+#define RELOAD_BENCH_PAGES 10000
+/*!
+	/def RELOAD_BENCH_EDITS
+	/brief Default number of page sources saved by the page reload benchmark
+*/
+#define RELOAD_BENCH_EDITS 20
+/*!
+	/def PERF_BASELINE
+	/brief Baseline perfcheck compares against, relative to build
+*/
+#define PERF_BASELINE "../perf/baseline.json"
+/*!
+	/def PERF_RUNS
+	/brief Replays of every perfcheck scenario, each giving one sample
+*/
+#define PERF_RUNS 5
+/*!
+	/def PERF_STEPS
+	/brief Animation steps replayed by every perfcheck scenario
+*/
+#define PERF_STEPS 120
+/*!
+	/def PERF_WARMUP_STEPS
+	/brief First steps of a perfcheck scenario left out of its frame time, while assets load
+*/
+#define PERF_WARMUP_STEPS 20
+/*!
+	/def PERF_NOISE_SIGMAS
+	/brief Standard errors a scenario has to slow down by to count as a regression
+*/
+#define PERF_NOISE_SIGMAS 3.0
+/*!
+	/def PERF_MIN_REGRESSION
+	/brief Fraction of its baseline a scenario has to slow down by to count as a regression
+*/
+#define PERF_MIN_REGRESSION 0.10
+/*!
+	/def PAGE_SOURCE_DIRECTORY
+	/brief Directory watched for page sources by --watch-pages unless another one is given
+*/
+#define PAGE_SOURCE_DIRECTORY "../pages"
+/*!
+	/def PAGE_SOURCE_EXTENSION
+	/brief Extension of a page source, named after its page number as in 3.txt
+*/
+#define PAGE_SOURCE_EXTENSION ".txt"
+/*!
+	/def PAGE_SOURCE_MAX_PAGE
+	/brief Largest page number a page source can be named after
+*/
+#define PAGE_SOURCE_MAX_PAGE 1000000
+/*!
+	/def PAGE_SOURCE_MAX_SIZE
+	/brief Bytes of a page source read as the text of its page
+*/
+#define PAGE_SOURCE_MAX_SIZE 65536
+/*!
+	/def TEXTURE_LOADER_THREADS
+	/brief Threads decoding textures at startup, 0 uses one per hardware thread
+*/
+#define TEXTURE_LOADER_THREADS 0
+/*!
+	/def FRAME_PIPELINE_SPIN_US
+	/brief Microseconds the frame worker spins for the next frame before parking on its condition variable
+*/
+#define FRAME_PIPELINE_SPIN_US 2000
+/*!
+	/def TEXTURE_CACHE_EXTENSION
+	/brief Extension added to an image filename to name its texture cache file
+*/
+#define TEXTURE_CACHE_EXTENSION ".fbtc"
+/*!
+	/def TEXTURE_CACHE_VERSION
+	/brief Version of the texture cache format, bump it when decoding changes
+*/
+#define TEXTURE_CACHE_VERSION 2
+/*!
+	/def TEXTURE_ATLAS
+	/brief Pack the room textures into one atlas texture, 0 loads them as separate textures
+*/
+#define TEXTURE_ATLAS 1
+/*!
+	/def ATLAS_FILENAME
+	/brief Name the room texture atlas is cached under
+*/
+#define ATLAS_FILENAME "../img/room.atlas"
+/*!
+	/def ATLAS_MAX_SIZE
+	/brief Largest side of the texture atlas
+*/
+#define ATLAS_MAX_SIZE 4096
+/*!
+	/def ATLAS_PADDING
+	/brief Texels of extruded border around each image in the atlas
+*/
+#define ATLAS_PADDING 8
+/*!
+	/def ATLAS_MIPMAP_LEVELS
+	/brief Mipmap levels of the atlas, the gutter is still one texel wide in the last one
+*/
+#define ATLAS_MIPMAP_LEVELS 4
+/*!
+	/def DYNAMIC_RESOLUTION_BUDGET_MS
+	/brief Frame time in ms dynamic resolution holds unless --frame-budget is given
+*/
+#define DYNAMIC_RESOLUTION_BUDGET_MS 16.6f
+/*!
+	/def DYNAMIC_RESOLUTION_MIN_SCALE
+	/brief Smallest fraction of the window width and height the scene is drawn at
+*/
+#define DYNAMIC_RESOLUTION_MIN_SCALE 0.35f
+/*!
+	/def DYNAMIC_RESOLUTION_RESPONSE
+	/brief Part of the way to the scale holding the budget the scale moves every frame
+*/
+#define DYNAMIC_RESOLUTION_RESPONSE 0.3f
+/*!
+	/def DYNAMIC_RESOLUTION_LOG
+	/brief File the frame time and scale of every frame are logged to
+*/
+#define DYNAMIC_RESOLUTION_LOG "resolution.csv"
+/*!
+	/def INPUT_JOURNAL_FILENAME
+	/brief File input is recorded to and replayed from unless another one is given
+*/
+#define INPUT_JOURNAL_FILENAME "input.journal"
+/*!
+	/def INPUT_PROFILE_LOG
+	/brief File the frame time and state hash of every replayed step are logged to
+*/
+#define INPUT_PROFILE_LOG "replay.csv"
+/*!
+	/def FRAME_ARENA_BYTES
+	/brief Bytes a frame arena starts with, it grows to the largest frame seen
+*/
+#define FRAME_ARENA_BYTES 262144
+/*!
+	/def SEARCH_QUERY_LENGTH
+	/brief Characters of the search prompt including the terminating 0, a multiple of 4
+*/
+#define SEARCH_QUERY_LENGTH 64
+/*!
+	/def OVERVIEW_COLUMNS
+	/brief Thumbnails in a row of the page overview
+*/
+#define OVERVIEW_COLUMNS 8
+/*!
+	/def OVERVIEW_SLOT_SIZE
+	/brief Texels of a thumbnail in the overview atlas, including the gutter around it
+*/
+#define OVERVIEW_SLOT_SIZE 128
+/*!
+	/def OVERVIEW_GUTTER
+	/brief Texels left blank around a thumbnail, at least 2 to the power of the last mipmap level keeps every level apart
+*/
+#define OVERVIEW_GUTTER 8
+/*!
+	/def OVERVIEW_ATLAS_SIZE
+	/brief Texels of the overview atlas on a side, it holds (OVERVIEW_ATLAS_SIZE/OVERVIEW_SLOT_SIZE)^2 thumbnails
+*/
+#define OVERVIEW_ATLAS_SIZE 2048
+/*!
+	/def OVERVIEW_MIPMAP_LEVELS
+	/brief Mipmap levels of the overview atlas, small thumbnails are sampled from the smaller ones
+*/
+#define OVERVIEW_MIPMAP_LEVELS 4
+/*!
+	/def OVERVIEW_MARGIN_ROWS
+	/brief Rows above and below the window whose thumbnails are rendered ahead of scrolling
+*/
+#define OVERVIEW_MARGIN_ROWS 2
+/*!
+	/def OVERVIEW_RENDERS_PER_FRAME
+	/brief Thumbnails rendered at most in a frame, the others show a blank page until later frames
+*/
+#define OVERVIEW_RENDERS_PER_FRAME 12
+/*!
+	/def OVERVIEW_SCROLL_RESPONSE
+	/brief Part of the way to the row scrolled to the overview moves every step
+*/
+#define OVERVIEW_SCROLL_RESPONSE 0.35f
+/*!
+	/def RIFFLE_MIN_PAGES
+	/brief Pages a jump must cover to be riffled, shorter jumps open the page at once
+*/
+#define RIFFLE_MIN_PAGES 3
+/*!
+	/def RIFFLE_MAX_SHEETS
+	/brief Sheets a riffle turns at most, further pages are turned several to a sheet
+*/
+#define RIFFLE_MAX_SHEETS 48
+/*!
+	/def RIFFLE_FLIP_STEPS
+	/brief Animation steps a sheet of a riffle takes to turn over
+*/
+#define RIFFLE_FLIP_STEPS 24
+/*!
+	/def RIFFLE_SHEET_INTERVAL
+	/brief Animation steps between the starts of two sheets of a riffle
+*/
+#define RIFFLE_SHEET_INTERVAL 0.75f
+/*!
+	/def RIFFLE_JUMP_PAGES
+	/brief Pages Page Up and Page Down jump in the room
+*/
+#define RIFFLE_JUMP_PAGES 100
+/*!
+	/def CLOTH_COLUMNS
+	/brief Particles across a page bent by the cloth flip
+*/
+#define CLOTH_COLUMNS 16
+/*!
+	/def CLOTH_ROWS
+	/brief Particles up a page bent by the cloth flip
+*/
+#define CLOTH_ROWS 16
+/*!
+	/def CLOTH_SUBSTEPS
+	/brief Substeps a cloth is advanced in every animation step
+*/
+#define CLOTH_SUBSTEPS 4
+/*!
+	/def CLOTH_ITERATIONS
+	/brief Passes over every constraint of a cloth in a substep
+*/
+#define CLOTH_ITERATIONS 2
+/*!
+	/def CLOTH_STRUCTURAL_STIFFNESS
+	/brief Part of the stretch between neighbouring particles corrected in a pass
+*/
+#define CLOTH_STRUCTURAL_STIFFNESS 1.0f
+/*!
+	/def CLOTH_SHEAR_STIFFNESS
+	/brief Part of the stretch along the diagonals corrected in a pass
+*/
+#define CLOTH_SHEAR_STIFFNESS 0.9f
+/*!
+	/def CLOTH_BEND_STIFFNESS
+	/brief Part of the stretch between particles two apart corrected in a pass, paper bends but does not fold
+*/
+#define CLOTH_BEND_STIFFNESS 0.9f
+/*!
+	/def CLOTH_FOLLOW
+	/brief Part of the way to a rigid page a page turned as cloth is pulled every substep, paper springs back
+*/
+#define CLOTH_FOLLOW 0.008f
+/*!
+	/def CLOTH_DAMPING
+	/brief Part of the velocity of a particle lost every substep
+*/
+#define CLOTH_DAMPING 0.02f
+/*!
+	/def CLOTH_GRAVITY
+	/brief Distance a particle falls towards the pages per animation step squared
+*/
+#define CLOTH_GRAVITY 0.08f
+/*!
+	/def CLOTH_MIN_CHUNK
+	/brief Constraints a worker projects at least, smaller batches are projected on the calling thread
+*/
+#define CLOTH_MIN_CHUNK 256
+/*!
+	/def CLOTH_THREADS
+	/brief Worker threads solving the cloth of the pages in flight, 0 for one per hardware thread
+*/
+#define CLOTH_THREADS 0
+/*!
+	/def CLOTH_MAX_PAGES
+	/brief Pages bent by the cloth flip at once, the turned ones settle while the next one lifts
+*/
+#define CLOTH_MAX_PAGES 4
+/*!
+	/def CLOTH_SETTLE_STEPS
+	/brief Animation steps a turned page keeps bending before it joins the stack
+*/
+#define CLOTH_SETTLE_STEPS 60
+/*!
+	/def CLOTH_TEXTURE_SIZE
+	/brief Texels of the image of a page bent by the cloth flip on a side
+*/
+#define CLOTH_TEXTURE_SIZE 256
+/*!
+	/def LIGHTMAP_TILE_SIZE
+	/brief Texels on a side of the lightmap tile of a room surface
+*/
+#define LIGHTMAP_TILE_SIZE 64
+/*!
+	/def LIGHTMAP_AO_RAYS
+	/brief Rays a lightmap texel casts to find the surfaces occluding its ambient light
+*/
+#define LIGHTMAP_AO_RAYS 64
+/*!
+	/def LIGHTMAP_AO_DISTANCE
+	/brief Surfaces further away from a texel than this do not occlude its ambient light
+*/
+#define LIGHTMAP_AO_DISTANCE 300.0f
+/*!
+	/def LIGHTMAP_LAMP_RANGE
+	/brief Distance at which the ceiling lamp of the room has fallen off to half
+*/
+#define LIGHTMAP_LAMP_RANGE 700.0f
+/*!
+	/def LIGHTMAP_SURFACE_OFFSET
+	/brief Rays start this far off their surface, clear of the surfaces meeting it at its edges
+*/
+#define LIGHTMAP_SURFACE_OFFSET 0.5f
+/*!
+	/def LIGHTMAP_BANDS
+	/brief Bands of rows every lightmap tile is split in, a band is baked by a task
+*/
+#define LIGHTMAP_BANDS 4
+/*!
+	/def LIGHTMAP_THREADS
+	/brief Threads baking the lightmap, 0 for one per hardware thread
+*/
+#define LIGHTMAP_THREADS 0
+/*!
+	/def LIGHTMAP_VERSION
+	/brief Version of the lightmap cache file, bump when the baking changes
+*/
+#define LIGHTMAP_VERSION 1
+/*!
+	/def LIGHTMAP_LIT_MIPMAP_LEVELS
+	/brief Mipmap levels of the room texture its light is baked into, its tiles are whole texels of the last
+*/
+#define LIGHTMAP_LIT_MIPMAP_LEVELS 5
+/*!
+	/def UPLOAD_RING_SIZE
+	/brief Bytes of the ring texture uploads are streamed through
+*/
+#define UPLOAD_RING_SIZE 4194304
+/*!
+	/def UPLOAD_BYTES_PER_FRAME
+	/brief Most bytes of streamed textures uploaded in a frame, bands of rows are cut no larger
+*/
+#define UPLOAD_BYTES_PER_FRAME 1048576
+/*!
+	/def UPLOAD_RING_JOBS
+	/brief Bands of rows the upload ring holds at once
+*/
+#define UPLOAD_RING_JOBS 256
+/*!
+	/def UPLOAD_RING_ALIGNMENT
+	/brief Bands start at multiples of this many bytes in the upload ring
+*/
+#define UPLOAD_RING_ALIGNMENT 64
+/*!
+	/def UPLOAD_RING_WAIT
+	/brief Nanoseconds to wait at most for an upload to be read before checking again
+*/
+#define UPLOAD_RING_WAIT 100000000
+/*!
+	/def ANIMATION_SLOTS
+	/brief Decoded frames an animated page buffers ahead, animations this short stay resident
+*/
+#define ANIMATION_SLOTS 8
+/*!
+	/def ANIMATION_FRAME_SIZE
+	/brief Texels on a side of the texture a frame of an animated page is resized to
+*/
+#define ANIMATION_FRAME_SIZE 256
+/*!
+	/def ANIMATION_STEPS_PER_FRAME
+	/brief Animation steps a frame of an animated page is shown for
+*/
+#define ANIMATION_STEPS_PER_FRAME 4
+/*!
+	/def PAGE_SOURCE_VECTOR_EXTENSION
+	/brief Extension of the page sources holding a vector drawing, 3.svg draws the third page
+*/
+#define PAGE_SOURCE_VECTOR_EXTENSION ".svg"
+/*!
+	/def VECTOR_SOURCE_MAX_SIZE
+	/brief Most bytes read from a vector drawing page source
+*/
+#define VECTOR_SOURCE_MAX_SIZE 4194304
+/*!
+	/def VECTOR_FLATNESS
+	/brief Most distance of a flattened curve from the curve, in thousandths of the larger side of the drawing
+*/
+#define VECTOR_FLATNESS 0.5f
+/*!
+	/def VECTOR_MAX_CURVE_SEGMENTS
+	/brief Most segments a Bezier curve of a vector drawing is flattened into, four times as many for a full ellipse
+*/
+#define VECTOR_MAX_CURVE_SEGMENTS 64
+/*!
+	/def ANTIALIASING_OFF
+	/brief Post-process anti-aliasing level leaving the frame as drawn
+*/
+#define ANTIALIASING_OFF 0
+/*!
+	/def ANTIALIASING_LOW
+	/brief Anti-aliasing level smoothing strong edges only, with a short search along them
+*/
+#define ANTIALIASING_LOW 1
+/*!
+	/def ANTIALIASING_MEDIUM
+	/brief Anti-aliasing level smoothing most edges and thin lines
+*/
+#define ANTIALIASING_MEDIUM 2
+/*!
+	/def ANTIALIASING_HIGH
+	/brief Anti-aliasing level smoothing faint edges too, with the longest search along them
+*/
+#define ANTIALIASING_HIGH 3
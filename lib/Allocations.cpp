@@ -0,0 +1,87 @@
+/*!
+    /file Allocations.cpp
+    /brief Count every heap allocation made through new, per subsystem
+    Replaces the global operator new and delete of the program it is linked
+    into. Allocations are counted against the tag of the allocating thread.
+*/
+
+#include "./headers/Allocations.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+static std::atomic<unsigned long> allocationCount[ALLOCATION_TAGS], allocationBytes[ALLOCATION_TAGS];
+static thread_local GLint allocationTag = ALLOCATION_OTHER;
+
+/*!
+    \fn countedAllocation(size_t size)
+    \brief Allocate size bytes and count them against the tag of the calling thread, NULL on failure
+*/
+static void* countedAllocation(size_t size){
+    void *block = malloc(size == 0 ? 1 : size);
+    if(block != NULL){
+        allocationCount[allocationTag].fetch_add(1, std::memory_order_relaxed);
+        allocationBytes[allocationTag].fetch_add(size, std::memory_order_relaxed);
+    }
+    return block;
+}
+
+void* operator new(size_t size){
+    void *block = countedAllocation(size);
+    if(block == NULL)
+        throw std::bad_alloc();
+    return block;
+}
+void* operator new[](size_t size){ return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept{ return countedAllocation(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept{ return countedAllocation(size); }
+void operator delete(void *block) noexcept{ free(block); }
+void operator delete[](void *block) noexcept{ free(block); }
+void operator delete(void *block, const std::nothrow_t&) noexcept{ free(block); }
+void operator delete[](void *block, const std::nothrow_t&) noexcept{ free(block); }
+
+/*!
+    \fn setAllocationTag(GLint tag)
+    \brief Count the allocations of the calling thread against tag, returns the previous tag
+*/
+GLint setAllocationTag(GLint tag){
+    GLint previous = allocationTag;
+    allocationTag = tag >= 0 && tag < ALLOCATION_TAGS ? tag : ALLOCATION_OTHER;
+    return previous;
+}
+
+/*!
+    \fn readAllocationCounts(AllocationCounts *counts)
+    \brief Allocations made since the start of the program, by all threads
+*/
+void readAllocationCounts(AllocationCounts *counts){
+    for(int i=0;i<ALLOCATION_TAGS;i++){
+        counts->allocations[i] = allocationCount[i].load(std::memory_order_relaxed);
+        counts->bytes[i] = allocationBytes[i].load(std::memory_order_relaxed);
+    }
+}
+
+/*!
+    \fn allocationsSince(const AllocationCounts *before, AllocationCounts *since)
+    \brief Allocations made since before was read, returns their total
+    since receives them per subsystem.
+*/
+unsigned long allocationsSince(const AllocationCounts *before, AllocationCounts *since){
+    unsigned long total = 0;
+    readAllocationCounts(since);
+    for(int i=0;i<ALLOCATION_TAGS;i++){
+        since->allocations[i] -= before->allocations[i];
+        since->bytes[i] -= before->bytes[i];
+        total += since->allocations[i];
+    }
+    return total;
+}
+
+/*!
+    \fn allocationTagName(GLint tag)
+    \brief Name of a subsystem allocations are counted against
+*/
+const char* allocationTagName(GLint tag){
+    static const char *names[ALLOCATION_TAGS] = {"other", "scene", "pages", "library", "welcome", "commands", "assets", "recordings"};
+    return tag >= 0 && tag < ALLOCATION_TAGS ? names[tag] : "other";
+}
@@ -0,0 +1,346 @@
+/*!
+    /file Antialiasing.cpp
+    /brief Post-process anti-aliasing of the drawn frame, an ARB fragment program after FXAA 3.11
+*/
+
+#define GL_GLEXT_PROTOTYPES
+#include "./headers/Antialiasing.h"
+#include <stdio.h>
+#include <string.h>
+
+/*!
+    \struct AntialiasingPreset
+    \brief Edge detection and search of a quality level
+*/
+struct AntialiasingPreset{
+    const char *name;
+    GLfloat edgeThreshold; /*!< Least luma contrast of an edge, relative to the brightest pixel around */
+    GLfloat edgeThresholdMin; /*!< Least luma contrast of an edge in dark areas */
+    GLfloat subpixel; /*!< How far thin lines and single pixels are blended with their neighbours */
+    GLint noOfSteps;
+    GLfloat steps[12]; /*!< Pixels moved along an edge at every step searching for its ends */
+};
+
+/*! The steps are those of the FXAA 3.11 quality presets 12, 15 and 39 */
+static const AntialiasingPreset presets[] = {
+    {"off", 1, 1, 0, 0, {0}},
+    {"low", 0.250f, 0.0833f, 0.50f, 5, {1, 1.5f, 2, 4, 12}},
+    {"medium", 0.166f, 0.0833f, 0.75f, 8, {1, 1.5f, 2, 2, 2, 2, 4, 12}},
+    {"high", 0.125f, 0.0625f, 0.75f, 12, {1, 1, 1, 1, 1, 1.5f, 2, 2, 2, 2, 4, 8}}
+};
+
+/*!
+    \fn Antialiasing::Antialiasing()
+    \brief Constructor, frames are left as drawn until setQuality is called
+*/
+Antialiasing::Antialiasing(){
+    quality = ANTIALIASING_OFF;
+    supported = -1;
+    width = height = 0;
+    texture = 0;
+    textureWidth = textureHeight = 0;
+    for(int i=0;i<=ANTIALIASING_HIGH;i++)
+        programs[i] = 0;
+    frames = 0;
+}
+
+/*!
+    \fn Antialiasing::~Antialiasing()
+    \brief Report the session
+*/
+Antialiasing::~Antialiasing(){
+    report();
+}
+
+/*!
+    \fn Antialiasing::qualityName(GLint quality)
+    \brief Name of a quality level
+*/
+const char *Antialiasing::qualityName(GLint quality){
+    if(quality < ANTIALIASING_OFF || quality > ANTIALIASING_HIGH)
+        return "unknown";
+    return presets[quality].name;
+}
+
+/*!
+    \fn Antialiasing::setQuality(GLint quality)
+    \brief Filter the frames from now on at a quality level, reporting the frames filtered at the previous one
+*/
+void Antialiasing::setQuality(GLint quality){
+    quality = quality < ANTIALIASING_OFF ? ANTIALIASING_OFF : (quality > ANTIALIASING_HIGH ? ANTIALIASING_HIGH : quality);
+    if(quality == this->quality)
+        return;
+    report();
+    this->quality = quality;
+    frames = 0;
+}
+
+/*!
+    \fn Antialiasing::programSource(GLint quality)
+    \brief Text of the fragment program filtering at a quality level
+    program.env[0] holds the size of a texel, program.env[1] the edge
+    thresholds and the subpixel blend of the preset. For ANTIALIASING_OFF it
+    is the program finding the edges, discarding every pixel on none. The
+    filtering programs run on those pixels only and read the same five
+    texels first, without discarding, so they can be depth tested before
+    they run. The search along the
+    edge is unrolled, one step per preset step: a side whose end was found
+    stops moving, so reading it again reads the same luma. N and S are the
+    rows below and above, W and E the columns left and right.
+*/
+std::string Antialiasing::programSource(GLint quality){
+    const AntialiasingPreset *preset = &presets[quality];
+    std::string source =
+        "!!ARBfp1.0\n"
+        "PARAM texel = program.env[0];\n"
+        "PARAM settings = program.env[1];\n"
+        "PARAM lumaWeights = {0.299, 0.587, 0.114, 0};\n"
+        "TEMP posM, colorM, tap, coords, luma, lumaM, lumaDiagonal, range, sums, pairs;\n"
+        "TEMP edge, edge1, edge2, edge3, span, sign, gradient, subpixel, offset, search, step, notDone, ends, distance, goodSpan, blend;\n"
+        "MOV posM, fragment.texcoord[0];\n"
+        "TEX colorM, posM, texture[0], 2D;\n"
+        "DP3 lumaM.x, colorM, lumaWeights;\n"
+        "MAD coords, texel.xyxy, {0, -1, 0, 1}, posM.xyxy;\n"
+        "TEX tap, coords, texture[0], 2D;\n"
+        "DP3 luma.x, tap, lumaWeights;\n"
+        "TEX tap, coords.zwzw, texture[0], 2D;\n"
+        "DP3 luma.y, tap, lumaWeights;\n"
+        "MAD coords, texel.xyxy, {-1, 0, 1, 0}, posM.xyxy;\n"
+        "TEX tap, coords, texture[0], 2D;\n"
+        "DP3 luma.z, tap, lumaWeights;\n"
+        "TEX tap, coords.zwzw, texture[0], 2D;\n"
+        "DP3 luma.w, tap, lumaWeights;\n"
+        /* Pixels whose luma range is under the threshold are on no edge */
+        "MAX range.x, luma.x, luma.y;\n"
+        "MAX range.y, luma.z, luma.w;\n"
+        "MAX range.x, range.x, range.y;\n"
+        "MAX range.x, range.x, lumaM.x;\n"
+        "MIN range.z, luma.x, luma.y;\n"
+        "MIN range.w, luma.z, luma.w;\n"
+        "MIN range.z, range.z, range.w;\n"
+        "MIN range.z, range.z, lumaM.x;\n"
+        "SUB range.y, range.x, range.z;\n"
+        "MUL range.w, range.x, settings.x;\n"
+        "MAX range.w, range.w, settings.y;\n"
+        "SUB range.w, range.y, range.w;\n";
+    if(quality == ANTIALIASING_OFF)
+        return source + "KIL range.w;\nMOV result.color, colorM;\nEND\n";
+    source +=
+        "MAD coords, texel.xyxy, {-1, -1, 1, -1}, posM.xyxy;\n"
+        "TEX tap, coords, texture[0], 2D;\n"
+        "DP3 lumaDiagonal.x, tap, lumaWeights;\n"
+        "TEX tap, coords.zwzw, texture[0], 2D;\n"
+        "DP3 lumaDiagonal.y, tap, lumaWeights;\n"
+        "MAD coords, texel.xyxy, {-1, 1, 1, 1}, posM.xyxy;\n"
+        "TEX tap, coords, texture[0], 2D;\n"
+        "DP3 lumaDiagonal.z, tap, lumaWeights;\n"
+        "TEX tap, coords.zwzw, texture[0], 2D;\n"
+        "DP3 lumaDiagonal.w, tap, lumaWeights;\n"
+        /* Horizontal or vertical edge, from the second differences of the 3x3 lumas */
+        "ADD sums.x, luma.x, luma.y;\n"
+        "ADD sums.y, luma.z, luma.w;\n"
+        "ADD sums.z, lumaDiagonal.y, lumaDiagonal.w;\n"
+        "ADD sums.w, lumaDiagonal.x, lumaDiagonal.y;\n"
+        "ADD pairs.x, lumaDiagonal.x, lumaDiagonal.z;\n"
+        "ADD pairs.y, lumaDiagonal.z, lumaDiagonal.w;\n"
+        "MAD edge1.xy, lumaM.x, -2, sums;\n"
+        "MAD edge2.xy, luma.wxww, -2, sums.zwww;\n"
+        "MAD edge3.xy, luma.zyzz, -2, pairs;\n"
+        "ABS edge1.xy, edge1;\n"
+        "ABS edge2.xy, edge2;\n"
+        "ABS edge3.xy, edge3;\n"
+        "MAD edge.xy, edge1, 2, edge2;\n"
+        "ADD edge.xy, edge, edge3;\n"
+        "SGE span.x, edge.x, edge.y;\n"
+        "SUB span.y, 1, span.x;\n"
+        "MOV span.zw, 0;\n"
+        /* Subpixel blend, from the contrast of the pixel with the average around it */
+        "ADD subpixel.x, sums.x, sums.y;\n"
+        "ADD subpixel.y, pairs.x, sums.z;\n"
+        "MAD subpixel.x, subpixel.x, 2, subpixel.y;\n"
+        "MAD subpixel.x, subpixel.x, 0.0833333, -lumaM.x;\n"
+        "RCP range.z, range.y;\n"
+        "ABS subpixel.x, subpixel.x;\n"
+        "MUL_SAT subpixel.x, subpixel.x, range.z;\n"
+        /* The side of the edge with the steeper gradient */
+        "LRP pairs.zw, span.x, luma.xyxy, luma.zwzw;\n"
+        "LRP sign.x, span.x, texel.y, texel.x;\n"
+        "SUB gradient.xy, pairs.zwzw, lumaM.x;\n"
+        "ADD sums.xy, pairs.zwzw, lumaM.x;\n"
+        "ABS gradient.xy, gradient;\n"
+        "SGE gradient.z, gradient.x, gradient.y;\n"
+        "MAX gradient.w, gradient.x, gradient.y;\n"
+        "MAD sign.y, gradient.z, -2, 1;\n"
+        "MUL sign.x, sign.x, sign.y;\n"
+        "MUL offset.xy, texel, span;\n"
+        "MUL sign.z, sign.x, 0.5;\n"
+        "MAD search.xy, span.yxxx, sign.z, posM;\n"
+        "MOV search.zw, search.xyxy;\n"
+        "LRP sums.z, gradient.z, sums.x, sums.y;\n"
+        "MUL sums.z, sums.z, 0.5;\n"
+        "SUB sums.w, lumaM.x, sums.z;\n"
+        "MUL gradient.w, gradient.w, 0.25;\n"
+        "MUL step, offset.xyxy, {-1, -1, 1, 1};\n"
+        "MOV notDone, 1;\n";
+    /* Search both ends of the edge, the last step moves without reading */
+    char line[128];
+    for(int i=0;i<preset->noOfSteps;i++){
+        snprintf(line, sizeof(line), "MUL tap, step, notDone.xxyy;\nMAD search, tap, %.2f, search;\n", preset->steps[i]);
+        source += line;
+        if(i == preset->noOfSteps - 1)
+            break;
+        source +=
+            "TEX tap, search, texture[0], 2D;\n"
+            "DP3 ends.x, tap, lumaWeights;\n"
+            "TEX tap, search.zwzw, texture[0], 2D;\n"
+            "DP3 ends.y, tap, lumaWeights;\n"
+            "SUB ends.xy, ends, sums.z;\n"
+            "ABS blend.xy, ends;\n"
+            "SLT notDone.xy, blend, gradient.w;\n";
+    }
+    source +=
+        /* Blend across the edge by the distance to its nearer end */
+        "SUB tap, posM, search;\n"
+        "DP3 distance.x, tap, span;\n"
+        "SUB tap, search.zwzw, posM;\n"
+        "DP3 distance.y, tap, span;\n"
+        "SLT goodSpan.xy, ends, 0;\n"
+        "SLT goodSpan.z, sums.w, 0;\n"
+        "SUB goodSpan.xy, goodSpan, goodSpan.z;\n"
+        "ABS goodSpan.xy, goodSpan;\n"
+        "ADD blend.x, distance.x, distance.y;\n"
+        "RCP blend.x, blend.x;\n"
+        "SLT blend.y, distance.x, distance.y;\n"
+        "MIN blend.z, distance.x, distance.y;\n"
+        "LRP goodSpan.x, blend.y, goodSpan.x, goodSpan.y;\n"
+        "MAD blend.z, blend.z, -blend.x, 0.5;\n"
+        "MUL blend.z, blend.z, goodSpan.x;\n"
+        "MAD subpixel.y, subpixel.x, -2, 3;\n"
+        "MUL subpixel.z, subpixel.x, subpixel.x;\n"
+        "MUL subpixel.y, subpixel.y, subpixel.z;\n"
+        "MUL subpixel.y, subpixel.y, subpixel.y;\n"
+        "MUL subpixel.y, subpixel.y, settings.z;\n"
+        "MAX blend.z, blend.z, subpixel.y;\n"
+        "MUL blend.z, blend.z, sign.x;\n"
+        "MAD posM.xy, span.yxxx, blend.z, posM;\n"
+        "TEX result.color, posM, texture[0], 2D;\n"
+        "END\n";
+    return source;
+}
+
+/*!
+    \fn Antialiasing::program(GLint quality)
+    \brief Fragment program of a quality level, loaded on first use, 0 if it does not load
+*/
+GLuint Antialiasing::program(GLint quality){
+    if(programs[quality] != 0)
+        return programs[quality];
+    std::string source = programSource(quality);
+    glGenProgramsARB(1, &programs[quality]);
+    glBindProgramARB(GL_FRAGMENT_PROGRAM_ARB, programs[quality]);
+    glProgramStringARB(GL_FRAGMENT_PROGRAM_ARB, GL_PROGRAM_FORMAT_ASCII_ARB, source.size(), source.c_str());
+    GLint errorPosition = -1;
+    glGetIntegerv(GL_PROGRAM_ERROR_POSITION_ARB, &errorPosition);
+    if(errorPosition != -1){
+        printf("\nAnti-aliasing %s program does not load at %d: %s\n", qualityName(quality), errorPosition,
+            (const char*)glGetString(GL_PROGRAM_ERROR_STRING_ARB));
+        fflush(stdout);
+        glDeleteProgramsARB(1, &programs[quality]);
+        programs[quality] = 0;
+        supported = 0;
+    }
+    return programs[quality];
+}
+
+/*!
+    \fn drawQuad(GLuint program)
+    \brief Draw the frame over itself at the nearest depth with a fragment program
+*/
+static void drawQuad(GLuint program){
+    glBindProgramARB(GL_FRAGMENT_PROGRAM_ARB, program);
+    fbBegin(GL_QUADS);
+        fbTexCoord2f(0, 0); fbVertex3f(-1, -1, -1);
+        fbTexCoord2f(1, 0); fbVertex3f(1, -1, -1);
+        fbTexCoord2f(1, 1); fbVertex3f(1, 1, -1);
+        fbTexCoord2f(0, 1); fbVertex3f(-1, 1, -1);
+    fbEnd();
+}
+
+/*!
+    \fn Antialiasing::apply(GLint width, GLint height)
+    \brief Filter the lower left width x height of the frame drawn so far
+    Called on the GL thread after the scene is drawn, before it is scaled up
+    to the window. Nothing is done while the quality is ANTIALIASING_OFF or
+    without ARB_fragment_program.
+*/
+void Antialiasing::apply(GLint width, GLint height){
+    if(quality == ANTIALIASING_OFF || width <= 0 || height <= 0)
+        return;
+    if(supported < 0){
+        const char *extensions = (const char*)glGetString(GL_EXTENSIONS);
+        supported = extensions != NULL && strstr(extensions, "GL_ARB_fragment_program") != NULL;
+        if(supported == 0){
+            printf("\nAnti-aliasing needs ARB_fragment_program, frames are left as drawn\n");
+            fflush(stdout);
+        }
+    }
+    if(supported == 0 || program(ANTIALIASING_OFF) == 0 || program(quality) == 0)
+        return;
+    this->width = width;
+    this->height = height;
+    fbBindTexture(GL_TEXTURE_2D, texture);
+    if(texture == 0 || textureWidth != width || textureHeight != height){ /*!< Sampled up to the frame edge, no wider */
+        if(texture == 0){
+            glGenTextures(1, &texture);
+            fbBindTexture(GL_TEXTURE_2D, texture);
+        }
+        textureWidth = width;
+        textureHeight = height;
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR); /*!< The search reads two rows at once */
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    }
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+    const AntialiasingPreset *preset = &presets[quality];
+    glEnable(GL_FRAGMENT_PROGRAM_ARB);
+    glProgramEnvParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 0, 1.0f/width, 1.0f/height, 0, 0);
+    glProgramEnvParameter4fARB(GL_FRAGMENT_PROGRAM_ARB, 1, preset->edgeThreshold, preset->edgeThresholdMin, preset->subpixel, 0);
+    fbViewport(0, 0, width, height);
+    fbMatrixMode(GL_PROJECTION);
+    fbPushMatrix();
+    fbLoadIdentity();
+    fbMatrixMode(GL_MODELVIEW);
+    fbPushMatrix();
+    fbLoadIdentity();
+    /*! The edges found are marked at the nearest depth, the filter is drawn only where it is */
+    fbEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_ALWAYS);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    drawQuad(programs[ANTIALIASING_OFF]);
+    glDepthFunc(GL_EQUAL);
+    glDepthMask(GL_FALSE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    drawQuad(programs[quality]);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+    fbPopMatrix();
+    fbMatrixMode(GL_PROJECTION);
+    fbPopMatrix();
+    fbMatrixMode(GL_MODELVIEW);
+    glDisable(GL_FRAGMENT_PROGRAM_ARB);
+    frames++;
+}
+
+/*!
+    \fn Antialiasing::report()
+    \brief Print the frames filtered at the current quality
+*/
+void Antialiasing::report(){
+    if(frames == 0)
+        return;
+    printf("\nAnti-aliasing %s: %u frames filtered at %dx%d\n", qualityName(quality), frames, width, height);
+    fflush(stdout);
+}
@@ -12,19 +12,75 @@ Book::Book(){
     this->width = BOOK_WIDTH;
     this->height = BOOK_HEIGHT;
     this->noOfPages = 0;
-    this->pages = new Page*[MAX_NO_PAGES];
+    this->capacity = MAX_NO_PAGES;
+    this->pages = new Page*[capacity];
     this->currentPageIndex = 0;
+    this->stackPageIndex = -1;
+    this->stackNoOfPages = 0;
+    this->pixelError = PAGE_DETAIL_PIXEL_ERROR;
+    this->highlightedPage = -1;
+    /*! Both stacks at their most slabs, so moving through the book does not grow it */
+    this->stack.reserve(2 * (PAGE_STACK_DETAIL * PAGE_STACK_LEVELS + 1) * 4 * 4 * 6);
+}
+
+/*!
+    \fn Book::growPages()
+    \brief Double the size of the pages array once it is full
+*/
+void Book::growPages(){
+    if(noOfPages < capacity)
+        return;
+    Page **grown = new Page*[2*capacity];
+    memcpy(grown, pages, noOfPages*sizeof(Page*));
+    delete[] pages;
+    pages = grown;
+    capacity *= 2;
+}
+
+/*!
+    \fn Book::pageSpacing()
+    \brief Distance between two pages of the stack
+    PAGE_THICKNESS + PAGE_GAP, squeezed so the whole stack of a thick book
+    stays within PAGE_STACK_MAX_THICKNESS.
+*/
+GLfloat Book::pageSpacing(){
+    GLfloat spacing = PAGE_THICKNESS + PAGE_GAP;
+    if(noOfPages * spacing > PAGE_STACK_MAX_THICKNESS)
+        spacing = (GLfloat)PAGE_STACK_MAX_THICKNESS / noOfPages;
+    return spacing;
+}
+
+/*!
+    \fn Book::pageDepth(GLint pageIndex)
+    \brief z coordinate of a page lying in the book
+*/
+GLfloat Book::pageDepth(GLint pageIndex){
+    return z - pageIndex * pageSpacing();
+}
+
+/*!
+    \fn Book::thickness()
+    \brief Depth of the book, deep enough to hold every page
+*/
+GLfloat Book::thickness(){
+    GLfloat stackThickness = noOfPages * pageSpacing() + PAGE_GAP;
+    return stackThickness > BOOK_THICKNESS ? stackThickness : BOOK_THICKNESS;
 }
 
 /*!
     \fn Book::renderBook()
     \brief Render the book.
     Render the Book with the margin and border on the screen.
+    Replayed from its recording while the position and size are unchanged.
 */
 void Book::renderBook(){
-    int i=0;
-    glColor3f(0.0,0.0,0.0);
+    GLfloat key[] = {x, y, z, width, height, thickness()};
+    if(replayScene(&shell, key, 6))
+        return;
+    beginScene(&shell, key, 6);
+    fbColor3f(0.0,0.0,0.0);
     setBorder();
+    endScene(&shell);
 }
 
 /*!
@@ -34,12 +90,12 @@ void Book::renderBook(){
     Render a 3d image for the book.
 */
 void Book::setBorder(){
-    glColor3f(0,0,0);
+    fbColor3f(0,0,0);
     GLfloat xLimit = x + width;
     GLfloat yLimit = y + height;
-    GLfloat zLimit = z - BOOK_THICKNESS;
+    GLfloat zLimit = z - thickness();
     cubeConstruction(x, y, z, xLimit, yLimit, zLimit);
-    glColor3f(1,1,1);
+    fbColor3f(1,1,1);
     fillFaces(xLimit, yLimit, zLimit);
 }
 
@@ -52,7 +108,10 @@ void Book::setBorder(){
     s -> String to be rendered onto the page
 */
 void Book::addPage(GLint type, char s[]){
-    pages[noOfPages] = new Page(type, (x + BOOK_BORDER_SIZE), y + BOOK_BORDER_SIZE, -(noOfPages * (PAGE_THICKNESS + PAGE_GAP)), s);
+    growPages();
+    pages[noOfPages] = new Page(type, (x + BOOK_BORDER_SIZE), y + BOOK_BORDER_SIZE, pageDepth(noOfPages), s);
+    if(type == PAGE_TYPE_TEXT)
+        index.setPage(noOfPages, s);
     noOfPages++;
 }
 
@@ -65,10 +124,78 @@ void Book::addPage(GLint type, char s[]){
     pageContent -> function pointer which renders the drawing inside the Page. 
 */
 void Book::addPage(GLint type, void (*pageContent)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat)){
-    pages[noOfPages] = new Page(type, (x + BOOK_BORDER_SIZE), y + BOOK_BORDER_SIZE, -(noOfPages * (PAGE_THICKNESS + PAGE_GAP)), pageContent);
+    growPages();
+    pages[noOfPages] = new Page(type, (x + BOOK_BORDER_SIZE), y + BOOK_BORDER_SIZE, pageDepth(noOfPages), pageContent);
     noOfPages++;
 }
 
+/*!
+    \fn Book::setPageText(GLint pageIndex, const char *text)
+    \brief Replace the content of a page by text
+    Only the recordings of that page are recorded again, returns 0 for a page the book does not have.
+    The page is indexed again for search.
+*/
+GLint Book::setPageText(GLint pageIndex, const char *text){
+    if(pageIndex < 0 || pageIndex >= noOfPages)
+        return 0;
+    pages[pageIndex]->setText(text);
+    index.setPage(pageIndex, pages[pageIndex]->text);
+    return 1;
+}
+
+/*!
+    \fn Book::setPageDrawing(GLint pageIndex, void (*pageContent)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat))
+    \brief Replace the content of a page by a drawing
+    Only the recordings of that page are recorded again, returns 0 for a page the book does not have.
+*/
+GLint Book::setPageDrawing(GLint pageIndex, void (*pageContent)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat)){
+    if(pageIndex < 0 || pageIndex >= noOfPages)
+        return 0;
+    pages[pageIndex]->setDrawing(pageContent);
+    index.removePage(pageIndex);
+    return 1;
+}
+
+/*!
+    \fn Book::setPageVector(GLint pageIndex, VectorDrawing *vector)
+    \brief Replace the content of a page by a vector drawing, which the page takes over
+    Only the recordings of that page are recorded again, returns 0 for a page the book does not have.
+*/
+GLint Book::setPageVector(GLint pageIndex, VectorDrawing *vector){
+    if(pageIndex < 0 || pageIndex >= noOfPages)
+        return 0;
+    pages[pageIndex]->setVector(vector);
+    index.removePage(pageIndex);
+    return 1;
+}
+
+/*!
+    \fn Book::setPageAnimation(GLint pageIndex, PageAnimation *animation)
+    \brief Replace the content of a page by the frames of animation
+    Returns 0 for a page the book does not have.
+*/
+GLint Book::setPageAnimation(GLint pageIndex, PageAnimation *animation){
+    if(pageIndex < 0 || pageIndex >= noOfPages)
+        return 0;
+    pages[pageIndex]->setAnimation(animation);
+    index.removePage(pageIndex);
+    return 1;
+}
+
+/*!
+    \fn Book::highlight(GLint pageIndex, const std::vector<SearchSpan> *spans)
+    \brief Highlight spans of a page found by index, the page highlighted before is cleared
+*/
+void Book::highlight(GLint pageIndex, const std::vector<SearchSpan> *spans){
+    if(highlightedPage >= 0 && highlightedPage < noOfPages)
+        pages[highlightedPage]->setHighlights(NULL);
+    highlightedPage = -1;
+    if(pageIndex < 0 || pageIndex >= noOfPages)
+        return;
+    pages[pageIndex]->setHighlights(spans);
+    highlightedPage = pageIndex;
+}
+
 /*!
     \fn Book::renderPage()
     \brief Render the Page constructed
@@ -82,25 +209,107 @@ void Book::renderPage(){
     \fn Book::renderPage(GLint pageIndex)
     \brief Render the Page constructed
     Render the specified page in the book.
+    The page is replayed from its recording while its position, size, type, content and highlights are unchanged.
+    Pages added later squeeze the stack, so the page is moved to its current depth first.
+    Every detail level the page is drawn at keeps a recording of its own.
 */
 void Book::renderPage(GLint pageIndex){
     if(pageIndex<noOfPages){
-        pages[pageIndex]->renderPage();
+        Page *page = pages[pageIndex];
+        page->z = pageDepth(pageIndex);
+        page->renderRecorded(page->selectDetail(pixelError));
         currentPageIndex = pageIndex;
     }
 }
 
+/*!
+    \fn Book::renderStacks(GLint pageIndex)
+    \brief Render the stacks of pages around the open pages
+    Pages before pageIndex lie turned over left of the binding, pages after the
+    two open ones lie below them. Both stacks are drawn with a single call and
+    only rebuilt when the reading position or the number of pages changes.
+*/
+void Book::renderStacks(GLint pageIndex){
+    if(pageIndex != stackPageIndex || noOfPages != stackNoOfPages)
+        buildStacks(pageIndex);
+    if(stack.empty())
+        return;
+    fbColor3f(0.95,0.94,0.9);
+    fbDrawArrays(GL_QUADS, stack.size()/6, stack.data());
+    fbColor3f(1,1,1);
+}
+
+/*!
+    \fn Book::buildStacks(GLint pageIndex)
+    \brief Build the slabs of both page stacks for the reading position pageIndex
+    Pages close to the open pages get a slab each, so their edges can be told
+    apart. Further away every PAGE_STACK_DETAIL slabs the pages per slab double,
+    and after PAGE_STACK_LEVELS levels the rest of the stack is a single slab,
+    so a thick book costs about as much as a thin one.
+*/
+void Book::buildStacks(GLint pageIndex){
+    stack.clear();
+    stackPageIndex = pageIndex;
+    stackNoOfPages = noOfPages;
+    /*! Unread pages below the two open pages */
+    GLint pagesPerSlab = 1;
+    for(int first=pageIndex + 2, slabs=0;first<noOfPages;first+=pagesPerSlab, slabs++){
+        if(slabs == PAGE_STACK_DETAIL * PAGE_STACK_LEVELS)
+            pagesPerSlab = noOfPages;
+        else if(slabs > 0 && slabs % PAGE_STACK_DETAIL == 0)
+            pagesPerSlab *= 2;
+        addSlab(first, first + pagesPerSlab < noOfPages ? first + pagesPerSlab : noOfPages, 1);
+    }
+    /*! Pages already read, turned over the binding */
+    pagesPerSlab = 1;
+    for(int last=pageIndex, slabs=0;last>0;last-=pagesPerSlab, slabs++){
+        if(slabs == PAGE_STACK_DETAIL * PAGE_STACK_LEVELS)
+            pagesPerSlab = noOfPages;
+        else if(slabs > 0 && slabs % PAGE_STACK_DETAIL == 0)
+            pagesPerSlab *= 2;
+        addSlab(last - pagesPerSlab > 0 ? last - pagesPerSlab : 0, last, -1);
+    }
+}
+
+/*!
+    \fn Book::addSlab(GLint first, GLint last, GLint side)
+    \brief Add the slab made of the pages first to last - 1 to the stacks
+    side 1 -> unread pages lying in the book.
+    side -1 -> read pages, mirrored on the binding at x.
+    A slab is its top face and the three page edges facing away from the binding.
+*/
+void Book::addSlab(GLint first, GLint last, GLint side){
+    GLfloat pageThickness = pageSpacing() * PAGE_THICKNESS / (PAGE_THICKNESS + PAGE_GAP);
+    GLfloat x0 = x + side*BOOK_BORDER_SIZE, x1 = x + side*(BOOK_BORDER_SIZE + PAGE_WIDTH);
+    GLfloat y0 = y + BOOK_BORDER_SIZE, y1 = y0 + PAGE_HEIGHT;
+    /*! Read pages turned over the binding keep their distance from z, on the other side */
+    GLfloat top = side > 0 ? pageDepth(first) : 2*z - pageDepth(last - 1) + pageThickness;
+    GLfloat bottom = side > 0 ? pageDepth(last - 1) - pageThickness : 2*z - pageDepth(first);
+    GLfloat quads[][4][3] = {
+        {{x0, y0, top}, {x1, y0, top}, {x1, y1, top}, {x0, y1, top}},
+        {{x1, y0, top}, {x1, y0, bottom}, {x1, y1, bottom}, {x1, y1, top}},
+        {{x0, y1, top}, {x1, y1, top}, {x1, y1, bottom}, {x0, y1, bottom}},
+        {{x0, y0, top}, {x0, y0, bottom}, {x1, y0, bottom}, {x1, y0, top}}
+    };
+    GLfloat normals[][3] = {{0, 0, 1}, {(GLfloat)side, 0, 0}, {0, 1, 0}, {0, -1, 0}};
+    for(int q=0;q<4;q++)
+        for(int v=0;v<4;v++){
+            stack.insert(stack.end(), quads[q][v], quads[q][v] + 3);
+            stack.insert(stack.end(), normals[q], normals[q] + 3);
+        }
+}
+
 /*!
     \fn constructPolygon()
     \brief Construct a Polygon for the given vertices
 */
 void constructPolygon(GLfloat vertices[][3]){
-    glBegin(GL_POLYGON);
+    fbBegin(GL_POLYGON);
         for(int i=0;i<4;i++){
-            glVertex3f(vertices[i][0],vertices[i][1],vertices[i][2]);
-            glNormal3f(vertices[i][0],vertices[i][1],vertices[i][2]);
+            fbVertex3f(vertices[i][0],vertices[i][1],vertices[i][2]);
+            fbNormal3f(vertices[i][0],vertices[i][1],vertices[i][2]);
         }
-    glEnd();
+    fbEnd();
 }
 
 /*!
@@ -108,7 +317,7 @@ void constructPolygon(GLfloat vertices[][3]){
     \brief Select each face and construct a Polygon
 */
 void Book::fillFaces(GLfloat xLimit, GLfloat yLimit, GLfloat zLimit){
-    glColor3f(0.5,0,0.5);
+    fbColor3f(0.5,0,0.5);
     GLfloat backFace[][3]={
         {x, y, zLimit}, {xLimit, y, zLimit}, {xLimit, yLimit, zLimit}, {x, yLimit, zLimit}
     };
@@ -129,5 +338,5 @@ void Book::fillFaces(GLfloat xLimit, GLfloat yLimit, GLfloat zLimit){
         {xLimit,y,zLimit},{xLimit,yLimit,zLimit},{xLimit,yLimit,z},{xLimit,yLimit,z}
     };
     constructPolygon(rightFace);
-    glColor3f(1,1,1);
+    fbColor3f(1,1,1);
 }
\ No newline at end of file
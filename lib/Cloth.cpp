@@ -0,0 +1,186 @@
+/*!
+    /file Cloth.cpp
+    /brief Position based dynamics of a grid of particles
+*/
+
+#include "./headers/Cloth.h"
+#include <math.h>
+
+/*!
+    \fn Cloth::Cloth()
+    \brief Constructor, a cloth without particles until create is called
+*/
+Cloth::Cloth(){
+    columns = rows = 0;
+    follow = 0;
+    floorX = 0;
+    floorZ[0] = floorZ[1] = -1e9;
+}
+
+/*!
+    \fn Cloth::create(GLint noOfColumns, GLint noOfRows, GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height)
+    \brief Build a grid of noOfColumns by noOfRows particles lying flat at depth z and its constraints
+    Structural constraints hold neighbours together, shear ones the diagonals
+    and bend ones particles two apart, so the cloth resists folding. Every kind
+    is colored so that no batch holds a particle twice.
+*/
+void Cloth::create(GLint noOfColumns, GLint noOfRows, GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height){
+    columns = noOfColumns;
+    rows = noOfRows;
+    GLint count = columns * rows;
+    positions.assign(count*3, 0);
+    previous.assign(count*3, 0);
+    targets.assign(count*3, 0);
+    inverseMass.assign(count, 1);
+    batches.clear();
+    for(int c=0;c<2;c++){
+        addBatch(1, 0, 2, 1, c, 0, CLOTH_STRUCTURAL_STIFFNESS); /*!< Along the rows */
+        addBatch(0, 1, 1, 2, 0, c, CLOTH_STRUCTURAL_STIFFNESS); /*!< Along the columns */
+    }
+    for(int c=0;c<4;c++){
+        addBatch(1, 1, 2, 2, c%2, c/2, CLOTH_SHEAR_STIFFNESS);
+        addBatch(1, -1, 2, 2, c%2, c/2, CLOTH_SHEAR_STIFFNESS);
+    }
+    for(int c=0;c<4;c++){
+        addBatch(2, 0, 4, 1, c, 0, CLOTH_BEND_STIFFNESS);
+        addBatch(0, 2, 1, 4, 0, c, CLOTH_BEND_STIFFNESS);
+    }
+    tasks.reserve(64);
+    reset(x, y, z, width, height);
+}
+
+/*!
+    \fn Cloth::reset(GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height)
+    \brief Lay the cloth flat and at rest at depth z, every particle free and its target where it lies
+*/
+void Cloth::reset(GLfloat x, GLfloat y, GLfloat z, GLfloat width, GLfloat height){
+    for(int j=0;j<rows;j++)
+        for(int i=0;i<columns;i++){
+            GLfloat *p = &positions[(j*columns + i)*3];
+            p[0] = x + width * i / (columns - 1);
+            p[1] = y + height * j / (rows - 1);
+            p[2] = z;
+            inverseMass[j*columns + i] = 1;
+        }
+    previous = positions;
+    targets = positions;
+    for(size_t b=0;b<batches.size();b++)
+        for(size_t c=0;c<batches[b].constraints.size();c++){
+            ClothConstraint *constraint = &batches[b].constraints[c];
+            GLfloat d[3];
+            for(int k=0;k<3;k++)
+                d[k] = positions[constraint->b*3 + k] - positions[constraint->a*3 + k];
+            constraint->rest = sqrtf(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+        }
+}
+
+/*!
+    \fn Cloth::addBatch(GLint di, GLint dj, GLint periodI, GLint periodJ, GLint colorI, GLint colorJ, GLfloat stiffness)
+    \brief Add a batch joining every particle i, j to the particle i + di, j + dj
+    Only particles with i % periodI == colorI and j % periodJ == colorJ start a
+    constraint, which keeps the constraints of the batch apart.
+*/
+void Cloth::addBatch(GLint di, GLint dj, GLint periodI, GLint periodJ, GLint colorI, GLint colorJ, GLfloat stiffness){
+    ClothBatch batch;
+    batch.stiffness = stiffness;
+    for(int j=0;j<rows;j++)
+        for(int i=0;i<columns;i++){
+            if(i % periodI != colorI || j % periodJ != colorJ)
+                continue;
+            if(i + di < 0 || i + di >= columns || j + dj < 0 || j + dj >= rows)
+                continue;
+            ClothConstraint constraint = {j*columns + i, (j + dj)*columns + i + di, 0};
+            batch.constraints.push_back(constraint);
+        }
+    if(!batch.constraints.empty())
+        batches.push_back(batch);
+}
+
+/*!
+    \fn Cloth::step(GLint substeps, GLint iterations, ThreadPool *pool)
+    \brief Advance the cloth by an animation step, split in substeps of iterations constraint passes
+    Driven particles reach their targets by the end of the step. pool may be
+    NULL to solve on the calling thread.
+*/
+void Cloth::step(GLint substeps, GLint iterations, ThreadPool *pool){
+    for(int s=0;s<substeps;s++){
+        GLfloat gravity = CLOTH_GRAVITY / (substeps * substeps);
+        for(int i=0, count=columns*rows;i<count;i++){
+            GLfloat *p = &positions[i*3], *q = &previous[i*3];
+            for(int k=0;k<3;k++){
+                GLfloat position = p[k];
+                if(inverseMass[i] == 0)
+                    p[k] += (targets[i*3 + k] - p[k]) / (substeps - s); /*!< Driven, evenly over the substeps left */
+                else
+                    p[k] += (p[k] - q[k]) * (1 - CLOTH_DAMPING);
+                q[k] = position;
+            }
+            if(inverseMass[i] != 0)
+                p[2] -= gravity;
+        }
+        for(int n=0;n<iterations;n++)
+            for(size_t b=0;b<batches.size();b++)
+                projectBatch(b, pool);
+        for(int i=0, count=columns*rows;i<count;i++){
+            if(inverseMass[i] == 0)
+                continue;
+            GLfloat *p = &positions[i*3];
+            for(int k=0;k<3 && follow > 0;k++)
+                p[k] += (targets[i*3 + k] - p[k]) * follow;
+            GLfloat floor = p[0] >= floorX ? floorZ[0] : floorZ[1];
+            if(p[2] < floor)
+                p[2] = floor;
+        }
+    }
+}
+
+/*!
+    \fn Cloth::projectBatch(GLint batchIndex, ThreadPool *pool)
+    \brief Project a batch, in chunks of at least CLOTH_MIN_CHUNK constraints spread over pool
+    The calling thread projects the last chunk itself. The tasks only capture a
+    pointer, so queuing them does not allocate a closure.
+*/
+void Cloth::projectBatch(GLint batchIndex, ThreadPool *pool){
+    const ClothBatch *batch = &batches[batchIndex];
+    GLint count = batch->constraints.size();
+    GLint chunks = pool == NULL ? 1 : count / CLOTH_MIN_CHUNK;
+    if(pool != NULL && chunks > pool->size() + 1)
+        chunks = pool->size() + 1;
+    if(chunks <= 1){
+        project(batch, 0, count);
+        return;
+    }
+    tasks.clear();
+    for(int c=0;c<chunks;c++){
+        ClothTask task = {this, batch, count * c / chunks, count * (c + 1) / chunks};
+        tasks.push_back(task);
+    }
+    for(int c=0;c<chunks-1;c++){
+        ClothTask *task = &tasks[c];
+        pool->enqueue([task]{ task->cloth->project(task->batch, task->first, task->last); });
+    }
+    project(batch, tasks.back().first, tasks.back().last);
+    pool->wait();
+}
+
+/*!
+    \fn Cloth::project(const ClothBatch *batch, GLint first, GLint last)
+    \brief Move the particles of the constraints first to last of batch towards their distance at rest
+    Each particle moves by its share of the inverse mass, driven ones stay put.
+*/
+void Cloth::project(const ClothBatch *batch, GLint first, GLint last){
+    for(int c=first;c<last;c++){
+        const ClothConstraint *constraint = &batch->constraints[c];
+        GLfloat *a = &positions[constraint->a*3], *b = &positions[constraint->b*3];
+        GLfloat wa = inverseMass[constraint->a], wb = inverseMass[constraint->b];
+        GLfloat d[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        GLfloat length = sqrtf(d[0]*d[0] + d[1]*d[1] + d[2]*d[2]);
+        if(wa + wb == 0 || length == 0)
+            continue;
+        GLfloat correction = batch->stiffness * (length - constraint->rest) / (length * (wa + wb));
+        for(int k=0;k<3;k++){
+            a[k] += wa * correction * d[k];
+            b[k] -= wb * correction * d[k];
+        }
+    }
+}
@@ -0,0 +1,267 @@
+/*!
+    /file ClothFlip.cpp
+    /brief Page flip bending the pages turned as cloth
+*/
+
+#include "./headers/ClothFlip.h"
+#include "./headers/Matrix.h"
+#include <math.h>
+#include <string.h>
+
+/*!
+    \fn imageStale(const ClothSlot *slot, const Page *page)
+    \brief Whether the image of slot is not one of page as it is now
+*/
+static GLint imageStale(const ClothSlot *slot, const Page *page){
+    return slot->type != page->type || slot->textVersion != page->textVersion
+        || slot->drawingVersion != page->drawingVersion || slot->highlightVersion != page->highlightVersion;
+}
+
+/*!
+    \fn ClothFlip::ClothFlip()
+    \brief Constructor, no page in flight
+    The vertices are sized for a whole page, so drawing the pages makes no
+    heap allocations.
+*/
+ClothFlip::ClothFlip(){
+    ClothSlot free;
+    free.pageIndex = -1;
+    free.settling = 0;
+    free.texture = 0;
+    free.type = -1;
+    free.textVersion = free.drawingVersion = free.highlightVersion = 0;
+    slots.assign(CLOTH_MAX_PAGES, free);
+    pool = NULL;
+    vertices.reserve((CLOTH_COLUMNS - 1) * (CLOTH_ROWS - 1) * 4 * 8);
+}
+
+/*!
+    \fn ClothFlip::~ClothFlip()
+    \brief Destructor, stops the workers
+*/
+ClothFlip::~ClothFlip(){
+    delete pool;
+}
+
+/*!
+    \fn ClothFlip::step(Book *book, GLint pageIndex, GLfloat angle)
+    \brief Advance the pages in flight by an animation step, the page pageIndex being turned by angle
+    A page stops being turned when pageIndex moves on, it is then held down
+    on the side it was turned to until it has settled. The cloth of every page
+    is solved as a task of its own.
+*/
+void ClothFlip::step(Book *book, GLint pageIndex, GLfloat angle){
+    if(pageIndex < 0 || pageIndex >= book->noOfPages)
+        return;
+    GLint current = -1, inFlight = 0;
+    for(int s=0;s<CLOTH_MAX_PAGES;s++)
+        if(slots[s].pageIndex == pageIndex)
+            current = s;
+    if(current < 0)
+        current = takeSlot(book, pageIndex);
+    if(pool == NULL)
+        pool = new ThreadPool(CLOTH_THREADS);
+    for(int s=0;s<CLOTH_MAX_PAGES;s++){
+        ClothSlot *slot = &slots[s];
+        if(slot->pageIndex < 0)
+            continue;
+        if(s == current){
+            slot->settling = 0;
+            drive(slot, book, angle, 1);
+        }
+        else if(++slot->settling > CLOTH_SETTLE_STEPS){
+            slot->pageIndex = -1; /*!< Lies on the stack */
+            continue;
+        }
+        else
+            drive(slot, book, slot->pageIndex < pageIndex ? 180 : 0, 0);
+        inFlight++;
+    }
+    if(inFlight == 1){
+        slots[current].cloth.step(CLOTH_SUBSTEPS, CLOTH_ITERATIONS, NULL);
+        return;
+    }
+    for(int s=0;s<CLOTH_MAX_PAGES;s++){
+        Cloth *cloth = &slots[s].cloth;
+        if(slots[s].pageIndex >= 0)
+            pool->enqueue([cloth]{ cloth->step(CLOTH_SUBSTEPS, CLOTH_ITERATIONS, NULL); });
+    }
+    pool->wait();
+}
+
+/*!
+    \fn ClothFlip::clear()
+    \brief Drop every page in flight, they are drawn as rigid pages again
+*/
+void ClothFlip::clear(){
+    for(int s=0;s<CLOTH_MAX_PAGES;s++)
+        slots[s].pageIndex = -1;
+}
+
+/*!
+    \fn ClothFlip::takeSlot(Book *book, GLint pageIndex)
+    \brief Lay the page pageIndex flat into a free slot, or the one settling longest
+*/
+GLint ClothFlip::takeSlot(Book *book, GLint pageIndex){
+    GLint taken = 0;
+    for(int s=0;s<CLOTH_MAX_PAGES;s++){
+        if(slots[s].pageIndex < 0){
+            taken = s;
+            break;
+        }
+        if(slots[s].settling > slots[taken].settling)
+            taken = s;
+    }
+    ClothSlot *slot = &slots[taken];
+    const Page *page = book->pages[pageIndex];
+    GLfloat depth = book->pageDepth(pageIndex);
+    for(int s=0;s<CLOTH_MAX_PAGES;s++) /*!< Every cloth at once, the pages lifted later make no heap allocations */
+        if(slots[s].cloth.columns == 0)
+            slots[s].cloth.create(CLOTH_COLUMNS, CLOTH_ROWS, page->x, page->y, depth, page->width, page->height);
+    slot->cloth.reset(page->x, page->y, depth, page->width, page->height);
+    slot->cloth.follow = CLOTH_FOLLOW;
+    slot->cloth.floorX = book->x;
+    slot->cloth.floorZ[0] = depth; /*!< On the pages still to read */
+    slot->cloth.floorZ[1] = 2*book->z - depth + book->pageSpacing(); /*!< Just above the page on the stack of pages read */
+    slot->pageIndex = pageIndex;
+    slot->settling = 0;
+    slot->type = -1;
+    return taken;
+}
+
+/*!
+    \fn ClothFlip::drive(ClothSlot *slot, Book *book, GLfloat angle, GLint grip)
+    \brief Move the binding of a page, and its bottom corner when grip is set, to a rigid page turned by angle
+    The two columns along the binding are held, so the page leaves the
+    binding at the angle it is turned by. The rest of the page is pulled
+    towards the rigid page.
+*/
+void ClothFlip::drive(ClothSlot *slot, Book *book, GLfloat angle, GLint grip){
+    Cloth *cloth = &slot->cloth;
+    const Page *page = book->pages[slot->pageIndex];
+    GLfloat depth = book->pageDepth(slot->pageIndex), m[16];
+    angle = angle < 0 ? 0 : (angle > 180 ? 180 : angle);
+    identityMatrix(m);
+    translateMatrix(m, book->x, 0, book->z);
+    rotateMatrix(m, angle, 0, -1, 0);
+    translateMatrix(m, -book->x, 0, -book->z);
+    for(int j=0;j<cloth->rows;j++)
+        for(int i=0;i<cloth->columns;i++){
+            GLint particle = j*cloth->columns + i;
+            GLint driven = i < 2 || (grip && j == 0 && i == cloth->columns - 1);
+            cloth->inverseMass[particle] = driven ? 0 : 1;
+            GLfloat rest[3] = {page->x + page->width * i / (cloth->columns - 1), page->y + page->height * j / (cloth->rows - 1), depth};
+            transformPoints(&cloth->targets[particle*3], m, rest, 1);
+        }
+}
+
+/*!
+    \fn ClothFlip::stale(Book *book)
+    \brief Whether a page in flight has no image yet or has been edited since it was taken
+*/
+GLint ClothFlip::stale(Book *book){
+    for(int s=0;s<CLOTH_MAX_PAGES;s++)
+        if(slots[s].pageIndex >= 0 && imageStale(&slots[s], book->pages[slots[s].pageIndex]))
+            return 1;
+    return 0;
+}
+
+/*!
+    \fn ClothFlip::update(Book *book)
+    \brief Take the images of the pages in flight that are stale
+    Every page is rendered into the corner of the frame buffer and copied
+    into its texture, the frame drawn afterwards clears the frame buffer.
+    Pages are replayed from their recordings, so taking an image costs little
+    more than drawing the page.
+    Must be called on the GL thread while no frame is prepared elsewhere.
+*/
+void ClothFlip::update(Book *book){
+    GLint backend = glBackend;
+    GLRecorder *recorder = glRecorder;
+    setGLBackend(BACKEND_IMMEDIATE);
+    fbDisable(GL_LIGHTING);
+    fbDisable(GL_TEXTURE_2D);
+    fbEnable(GL_DEPTH_TEST);
+    fbClearColor(1, 1, 1, 1);
+    for(int s=0;s<CLOTH_MAX_PAGES;s++){
+        ClothSlot *slot = &slots[s];
+        if(slot->pageIndex < 0 || !imageStale(slot, book->pages[slot->pageIndex]))
+            continue;
+        Page *page = book->pages[slot->pageIndex];
+        if(slot->texture == 0){
+            glGenTextures(1, &slot->texture);
+            fbBindTexture(GL_TEXTURE_2D, slot->texture);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, CLOTH_TEXTURE_SIZE, CLOTH_TEXTURE_SIZE, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        page->z = book->pageDepth(slot->pageIndex);
+        page->renderImage(0, 0, CLOTH_TEXTURE_SIZE, book->pixelError); /*!< From the recordings the book is drawn from */
+        fbBindTexture(GL_TEXTURE_2D, slot->texture);
+        glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, CLOTH_TEXTURE_SIZE, CLOTH_TEXTURE_SIZE);
+        slot->type = page->type;
+        slot->textVersion = page->textVersion;
+        slot->drawingVersion = page->drawingVersion;
+        slot->highlightVersion = page->highlightVersion;
+    }
+    fbClearColor(0, 0, 0, 1);
+    setGLBackend(backend, recorder);
+}
+
+/*!
+    \fn ClothFlip::capture(ClothFrame *frame)
+    \brief Copy the pages in flight into frame, for a frame drawn later or on another thread
+    The rest of frame is cleared, so equal frames hash the same.
+*/
+void ClothFlip::capture(ClothFrame *frame){
+    memset(frame, 0, sizeof(ClothFrame));
+    for(int s=0;s<CLOTH_MAX_PAGES;s++){
+        const ClothSlot *slot = &slots[s];
+        if(slot->pageIndex < 0 || slot->type < 0)
+            continue;
+        frame->textures[frame->pages] = slot->texture;
+        memcpy(frame->positions[frame->pages], slot->cloth.positions.data(), sizeof(frame->positions[0]));
+        frame->pages++;
+    }
+}
+
+/*!
+    \fn ClothFlip::render(const ClothFrame *frame)
+    \brief Draw the pages of frame as textured grids, a single call each
+    Normals are taken across the neighbours of every particle.
+*/
+void ClothFlip::render(const ClothFrame *frame){
+    if(frame->pages == 0)
+        return;
+    fbEnable(GL_TEXTURE_2D);
+    fbColor3f(1,1,1);
+    for(int n=0;n<frame->pages;n++){
+        const GLfloat *p = frame->positions[n];
+        vertices.clear();
+        for(int j=0;j<CLOTH_ROWS-1;j++)
+            for(int i=0;i<CLOTH_COLUMNS-1;i++){
+                const GLint corners[4][2] = {{i, j}, {i + 1, j}, {i + 1, j + 1}, {i, j + 1}};
+                for(int c=0;c<4;c++){
+                    GLint u = corners[c][0], v = corners[c][1];
+                    const GLfloat *left = &p[(v*CLOTH_COLUMNS + (u > 0 ? u - 1 : u))*3];
+                    const GLfloat *right = &p[(v*CLOTH_COLUMNS + (u < CLOTH_COLUMNS - 1 ? u + 1 : u))*3];
+                    const GLfloat *down = &p[((v > 0 ? v - 1 : v)*CLOTH_COLUMNS + u)*3];
+                    const GLfloat *up = &p[((v < CLOTH_ROWS - 1 ? v + 1 : v)*CLOTH_COLUMNS + u)*3];
+                    GLfloat a[3] = {right[0] - left[0], right[1] - left[1], right[2] - left[2]};
+                    GLfloat b[3] = {up[0] - down[0], up[1] - down[1], up[2] - down[2]};
+                    GLfloat vertex[8] = {p[(v*CLOTH_COLUMNS + u)*3], p[(v*CLOTH_COLUMNS + u)*3 + 1], p[(v*CLOTH_COLUMNS + u)*3 + 2],
+                        a[1]*b[2] - a[2]*b[1], a[2]*b[0] - a[0]*b[2], a[0]*b[1] - a[1]*b[0],
+                        (GLfloat)u / (CLOTH_COLUMNS - 1), (GLfloat)v / (CLOTH_ROWS - 1)};
+                    GLfloat length = sqrtf(vertex[3]*vertex[3] + vertex[4]*vertex[4] + vertex[5]*vertex[5]);
+                    for(int k=3;k<6 && length > 0;k++)
+                        vertex[k] /= length;
+                    vertices.insert(vertices.end(), vertex, vertex + 8);
+                }
+            }
+        fbBindTexture(GL_TEXTURE_2D, frame->textures[n]);
+        fbDrawTexturedArrays(GL_QUADS, vertices.size()/8, vertices.data());
+    }
+    fbDisable(GL_TEXTURE_2D);
+}
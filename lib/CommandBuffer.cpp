@@ -0,0 +1,221 @@
+/*!
+    /file CommandBuffer.cpp
+    /brief Recording, replay and persistence of GL command buffers
+*/
+
+#include "./headers/CommandBuffer.h"
+#include <stdio.h>
+#include <string.h>
+
+/*! Number of arguments stored for every GLCall */
+static const GLint callArgs[CALL_COUNT] = {
+    1, 0, 3, 3, 3, 2,       /*!< begin, end, vertex, normal, color, texcoord */
+    0, 0, 0, 3, 4, 3,       /*!< push, pop, identity, translate, rotate, scale */
+    1, 1, 2, 3, 1,          /*!< enable, disable, bind texture, texenv, line width */
+    6, 6, 0, 0,             /*!< light, material, flush, stroke character */
+    1, 16, 16, 1, 4, 4,     /*!< matrix mode, load matrix, mult matrix, clear, clear color, viewport */
+    -6, -9, -8,             /*!< draw arrays, draw colored arrays, draw textured arrays: mode, count and 6, 9 or 8 values per vertex */
+    1, 3                    /*!< active texture, multi texcoord */
+};
+static const char COMMAND_BUFFER_MAGIC[4] = {'F', 'B', 'C', 'B'};
+
+/*!
+    \fn callArguments(GLint call, const GLfloat *args)
+    \brief Number of arguments stored for a command starting at args
+*/
+GLint callArguments(GLint call, const GLfloat *args){
+    return callArgs[call] >= 0 ? callArgs[call] : 2 - callArgs[call]*(GLint)args[1];
+}
+
+/*!
+    \fn CommandBuffer::clear()
+    \brief Remove every command, keeping the storage for the next recording
+*/
+void CommandBuffer::clear(){
+    calls.clear();
+    args.clear();
+}
+
+/*!
+    \fn CommandBuffer::append(GLint call, GLint noOfArgs, const GLfloat *values)
+    \brief Append a command with its arguments
+*/
+void CommandBuffer::append(GLint call, GLint noOfArgs, const GLfloat *values){
+    calls.push_back((unsigned char)call);
+    if(callArgs[call] < 0){
+        args.insert(args.end(), values, values + noOfArgs);
+        return;
+    }
+    for(int i=0;i<callArgs[call];i++)
+        args.push_back(i < noOfArgs ? values[i] : 0);
+}
+
+/*!
+    \fn CommandBuffer::replay()
+    \brief Issue every recorded command
+    Commands go to OpenGL with the immediate backend, or are appended to the
+    current recorder when replayed while recording.
+*/
+void CommandBuffer::replay(){
+    const GLfloat *a = args.data();
+    GLint size = calls.size();
+    if(glBackend == BACKEND_RECORDING){
+        for(int i=0;i<size;i++){
+            glRecorder->record(calls[i], callArguments(calls[i], a), a);
+            a += callArguments(calls[i], a);
+        }
+        return;
+    }
+    for(int i=0;i<size;i++){
+        switch(calls[i]){
+            case CALL_BEGIN: glBegin((GLenum)a[0]); break;
+            case CALL_END: glEnd(); break;
+            case CALL_VERTEX: glVertex3fv(a); break;
+            case CALL_NORMAL: glNormal3fv(a); break;
+            case CALL_COLOR: glColor3fv(a); break;
+            case CALL_TEX_COORD: glTexCoord2fv(a); break;
+            case CALL_PUSH_MATRIX: glPushMatrix(); break;
+            case CALL_POP_MATRIX: glPopMatrix(); break;
+            case CALL_LOAD_IDENTITY: glLoadIdentity(); break;
+            case CALL_TRANSLATE: glTranslatef(a[0], a[1], a[2]); break;
+            case CALL_ROTATE: glRotatef(a[0], a[1], a[2], a[3]); break;
+            case CALL_SCALE: glScalef(a[0], a[1], a[2]); break;
+            case CALL_ENABLE: glEnable((GLenum)a[0]); break;
+            case CALL_DISABLE: glDisable((GLenum)a[0]); break;
+            case CALL_BIND_TEXTURE: glBindTexture((GLenum)a[0], (GLuint)a[1]); break;
+            case CALL_TEX_ENV: glTexEnvf((GLenum)a[0], (GLenum)a[1], a[2]); break;
+            case CALL_LINE_WIDTH: glLineWidth(a[0]); break;
+            case CALL_LIGHT: glLightfv((GLenum)a[0], (GLenum)a[1], a + 2); break;
+            case CALL_MATERIAL: glMaterialfv((GLenum)a[0], (GLenum)a[1], a + 2); break;
+            case CALL_FLUSH: glFlush(); break;
+            case CALL_MATRIX_MODE: glMatrixMode((GLenum)a[0]); break;
+            case CALL_LOAD_MATRIX: glLoadMatrixf(a); break;
+            case CALL_MULT_MATRIX: glMultMatrixf(a); break;
+            case CALL_CLEAR: glClear((GLbitfield)a[0]); break;
+            case CALL_CLEAR_COLOR: glClearColor(a[0], a[1], a[2], a[3]); break;
+            case CALL_VIEWPORT: glViewport((GLint)a[0], (GLint)a[1], (GLsizei)a[2], (GLsizei)a[3]); break;
+            case CALL_DRAW_ARRAYS: drawInterleavedArrays((GLenum)a[0], (GLint)a[1], a + 2); break;
+            case CALL_DRAW_COLORED_ARRAYS: drawInterleavedArrays((GLenum)a[0], (GLint)a[1], a + 2, 1); break;
+            case CALL_DRAW_TEXTURED_ARRAYS: drawInterleavedArrays((GLenum)a[0], (GLint)a[1], a + 2, 0, 1); break;
+            case CALL_ACTIVE_TEXTURE: glActiveTexture((GLenum)a[0]); break;
+            case CALL_MULTI_TEX_COORD: glMultiTexCoord2f((GLenum)a[0], a[1], a[2]); break;
+        }
+        a += callArguments(calls[i], a);
+    }
+}
+
+/*!
+    \fn CommandBuffer::save(const char *filename)
+    \brief Save the commands to a file
+    Returns 1 on success, 0 if the file could not be written.
+*/
+GLint CommandBuffer::save(const char *filename){
+    FILE *file = fopen(filename, "wb");
+    if(file == NULL)
+        return 0;
+    GLuint header[] = {1, (GLuint)calls.size(), (GLuint)args.size()};
+    GLint written = fwrite(COMMAND_BUFFER_MAGIC, 4, 1, file) == 1
+        && fwrite(header, sizeof(header), 1, file) == 1
+        && fwrite(calls.data(), 1, calls.size(), file) == calls.size()
+        && fwrite(args.data(), sizeof(GLfloat), args.size(), file) == args.size();
+    fclose(file);
+    return written;
+}
+
+/*!
+    \fn CommandBuffer::load(const char *filename)
+    \brief Load commands saved by CommandBuffer::save
+    Returns 1 on success, 0 if the file is missing or not a command buffer.
+*/
+GLint CommandBuffer::load(const char *filename){
+    char magic[4];
+    GLuint header[3];
+    FILE *file = fopen(filename, "rb");
+    clear();
+    if(file == NULL)
+        return 0;
+    GLint loaded = fread(magic, 4, 1, file) == 1 && memcmp(magic, COMMAND_BUFFER_MAGIC, 4) == 0
+        && fread(header, sizeof(header), 1, file) == 1 && header[0] == 1;
+    if(loaded){
+        calls.resize(header[1]);
+        args.resize(header[2]);
+        loaded = fread(calls.data(), 1, calls.size(), file) == calls.size()
+            && fread(args.data(), sizeof(GLfloat), args.size(), file) == args.size();
+    }
+    /*! Every command must have its arguments, draw arrays a non negative count */
+    size_t noOfArgs = 0;
+    for(size_t i=0;loaded && i<calls.size();i++){
+        loaded = calls[i] < CALL_COUNT;
+        if(loaded && callArgs[calls[i]] < 0)
+            loaded = noOfArgs + 2 <= args.size() && args[noOfArgs + 1] >= 0;
+        if(loaded)
+            noOfArgs += callArguments(calls[i], args.data() + noOfArgs);
+        loaded = loaded && noOfArgs <= args.size();
+    }
+    if(!loaded)
+        clear();
+    fclose(file);
+    return loaded;
+}
+
+/*!
+    \fn RecordedScene::RecordedScene()
+    \brief Constructor
+    The scene starts without a recording.
+*/
+RecordedScene::RecordedScene(){
+    valid = 0;
+    recorder.captureVertices = 0;
+    recorder.commands = &commands;
+    previousBackend = BACKEND_IMMEDIATE;
+    previousRecorder = NULL;
+    previousAllocationTag = ALLOCATION_OTHER;
+}
+
+/*!
+    \fn RecordedScene::invalidate()
+    \brief Force the scene to be recorded again on its next use
+*/
+void RecordedScene::invalidate(){
+    valid = 0;
+}
+
+/*!
+    \fn replayScene(RecordedScene *scene, const GLfloat *key, GLint noOfKeys)
+    \brief Replay a sub-scene if its recording is still valid for key
+    Returns 1 if the scene was replayed, 0 if it has to be recorded again.
+*/
+GLint replayScene(RecordedScene *scene, const GLfloat *key, GLint noOfKeys){
+    if(!scene->valid || (GLint)scene->key.size() != noOfKeys
+        || (noOfKeys > 0 && memcmp(scene->key.data(), key, noOfKeys * sizeof(GLfloat)) != 0))
+        return 0;
+    scene->commands.replay();
+    return 1;
+}
+
+/*!
+    \fn beginScene(RecordedScene *scene, const GLfloat *key, GLint noOfKeys)
+    \brief Start recording a sub-scene
+    Every GL call up to endScene is recorded into the scene instead of being drawn.
+    Heap allocations made meanwhile are counted as recordings.
+*/
+void beginScene(RecordedScene *scene, const GLfloat *key, GLint noOfKeys){
+    scene->previousAllocationTag = setAllocationTag(ALLOCATION_RECORDINGS);
+    scene->key.assign(key, key + noOfKeys);
+    scene->commands.clear();
+    scene->recorder.reset();
+    scene->previousBackend = glBackend;
+    scene->previousRecorder = glRecorder;
+    setGLBackend(BACKEND_RECORDING, &scene->recorder);
+}
+
+/*!
+    \fn endScene(RecordedScene *scene)
+    \brief Stop recording a sub-scene and replay it
+*/
+void endScene(RecordedScene *scene){
+    setGLBackend(scene->previousBackend, scene->previousRecorder);
+    setAllocationTag(scene->previousAllocationTag);
+    scene->valid = 1;
+    scene->commands.replay();
+}
@@ -0,0 +1,172 @@
+/*!
+    /file DynamicResolution.cpp
+    /brief Adaptive scene resolution holding a frame time budget
+*/
+
+#include "./headers/DynamicResolution.h"
+#include <math.h>
+
+/*!
+    \fn DynamicResolution::DynamicResolution()
+    \brief Constructor, the scene is drawn at full resolution until enable is called
+*/
+DynamicResolution::DynamicResolution(){
+    enabled = 0;
+    budget = DYNAMIC_RESOLUTION_BUDGET_MS;
+    scale = 1;
+    width = height = 0;
+    texture = 0;
+    textureWidth = textureHeight = 0;
+    frames = framesOverBudget = 0;
+    totalFrameTime = totalScale = 0;
+    log = NULL;
+}
+
+/*!
+    \fn DynamicResolution::~DynamicResolution()
+    \brief Report the session and close the log
+*/
+DynamicResolution::~DynamicResolution(){
+    disable();
+}
+
+/*!
+    \fn DynamicResolution::enable(GLfloat budget)
+    \brief Start holding budget ms per frame, logging every frame to DYNAMIC_RESOLUTION_LOG
+*/
+void DynamicResolution::enable(GLfloat budget){
+    if(enabled)
+        disable();
+    enabled = 1;
+    this->budget = budget;
+    scale = 1;
+    frames = framesOverBudget = 0;
+    totalFrameTime = totalScale = 0;
+    start = std::chrono::steady_clock::now();
+    log = fopen(DYNAMIC_RESOLUTION_LOG, "w");
+    if(log != NULL)
+        fprintf(log, "time ms,frame ms,scale,width,height\n");
+    printf("Dynamic resolution holding %.1f ms per frame, logging to %s\n", budget, DYNAMIC_RESOLUTION_LOG);
+}
+
+/*!
+    \fn DynamicResolution::disable()
+    \brief Go back to full resolution and report the session
+*/
+void DynamicResolution::disable(){
+    if(!enabled)
+        return;
+    report();
+    if(log != NULL)
+        fclose(log);
+    log = NULL;
+    enabled = 0;
+    scale = 1;
+}
+
+/*!
+    \fn DynamicResolution::resize(GLint windowWidth, GLint windowHeight)
+    \brief Size the scene is drawn at for the window and the current scale
+    Rounded to multiples of 8 pixels, so small changes of scale leave it unchanged.
+*/
+void DynamicResolution::resize(GLint windowWidth, GLint windowHeight){
+    width = windowWidth, height = windowHeight;
+    if(scale >= 1)
+        return;
+    width = ((GLint)(windowWidth * scale) + 4) / 8 * 8;
+    height = ((GLint)(windowHeight * scale) + 4) / 8 * 8;
+    width = width < 8 ? 8 : (width > windowWidth ? windowWidth : width);
+    height = height < 8 ? 8 : (height > windowHeight ? windowHeight : height);
+}
+
+/*!
+    \fn DynamicResolution::present(GLint sceneWidth, GLint sceneHeight, GLint windowWidth, GLint windowHeight)
+    \brief Stretch the scene drawn at sceneWidth x sceneHeight over the whole window
+    Called on the GL thread after the scene is drawn and before any overlay.
+    The scene size is the one the frame was drawn at, which differs from
+    width x height when the frame was prepared before the last resize.
+    Nothing is done while the scene is drawn at the window size.
+*/
+void DynamicResolution::present(GLint sceneWidth, GLint sceneHeight, GLint windowWidth, GLint windowHeight){
+    if(sceneWidth >= windowWidth && sceneHeight >= windowHeight)
+        return;
+    fbBindTexture(GL_TEXTURE_2D, texture);
+    if(texture == 0 || textureWidth != windowWidth || textureHeight != windowHeight){
+        if(texture == 0){
+            glGenTextures(1, &texture);
+            fbBindTexture(GL_TEXTURE_2D, texture);
+        }
+        textureWidth = windowWidth;
+        textureHeight = windowHeight;
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    }
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, sceneWidth, sceneHeight);
+    GLfloat u = (GLfloat)sceneWidth / textureWidth, v = (GLfloat)sceneHeight / textureHeight;
+    fbViewport(0, 0, windowWidth, windowHeight);
+    fbMatrixMode(GL_PROJECTION);
+    fbPushMatrix();
+    fbLoadIdentity();
+    fbMatrixMode(GL_MODELVIEW);
+    fbPushMatrix();
+    fbLoadIdentity();
+    fbDisable(GL_DEPTH_TEST);
+    fbDisable(GL_LIGHTING);
+    fbEnable(GL_TEXTURE_2D);
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    fbBegin(GL_QUADS);
+        fbTexCoord2f(0, 0); fbVertex2f(-1, -1);
+        fbTexCoord2f(u, 0); fbVertex2f(1, -1);
+        fbTexCoord2f(u, v); fbVertex2f(1, 1);
+        fbTexCoord2f(0, v); fbVertex2f(-1, 1);
+    fbEnd();
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    fbDisable(GL_TEXTURE_2D);
+    fbEnable(GL_DEPTH_TEST);
+    fbPopMatrix();
+    fbMatrixMode(GL_PROJECTION);
+    fbPopMatrix();
+    fbMatrixMode(GL_MODELVIEW);
+}
+
+/*!
+    \fn DynamicResolution::update(double frameTime)
+    \brief Log a frame and move the scale towards the one holding the budget
+    The draw cost follows the pixel count, the square of the scale, so the
+    scale holding the budget is scale * sqrt(budget / frameTime). The scale
+    moves part of the way there every frame and ignores changes of a few
+    percent, so a single slow frame does not make it jump.
+*/
+void DynamicResolution::update(double frameTime){
+    if(!enabled)
+        return;
+    frames++;
+    framesOverBudget += frameTime > budget;
+    totalFrameTime += frameTime;
+    totalScale += scale;
+    if(log != NULL)
+        fprintf(log, "%.1f,%.3f,%.3f,%d,%d\n",
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+            frameTime, scale, width, height);
+    GLfloat target = scale * sqrtf(budget / fmax(frameTime, 0.1));
+    target = target < DYNAMIC_RESOLUTION_MIN_SCALE ? DYNAMIC_RESOLUTION_MIN_SCALE : (target > 1 ? 1 : target);
+    if(fabsf(target - scale) > 0.02f)
+        scale += (target - scale) * DYNAMIC_RESOLUTION_RESPONSE;
+}
+
+/*!
+    \fn DynamicResolution::report()
+    \brief Print the average frame time and scale of the session
+*/
+void DynamicResolution::report(){
+    if(frames == 0)
+        return;
+    printf("\nDynamic resolution: %u frames, %.2f ms per frame for a %.1f ms budget, "
+        "average scale %.2f, %.1f%% of frames over budget\n", frames, totalFrameTime / frames, budget,
+        totalScale / frames, 100.0 * framesOverBudget / frames);
+    fflush(stdout);
+}
@@ -0,0 +1,77 @@
+/*!
+    /file FrameArena.cpp
+    /brief Per frame bump allocator, one per thread recording frames
+*/
+
+#include "./headers/FrameArena.h"
+#include <stdlib.h>
+
+/*!
+    \fn FrameArena::FrameArena()
+    \brief Constructor, the block is allocated on first use
+*/
+FrameArena::FrameArena(){
+    block = NULL;
+    capacity = used = 0;
+    overflowBytes = highWater = 0;
+}
+
+/*!
+    \fn FrameArena::~FrameArena()
+    \brief Free the block and any overflow blocks
+*/
+FrameArena::~FrameArena(){
+    for(size_t i=0;i<overflow.size();i++)
+        delete[] overflow[i];
+    delete[] block;
+}
+
+/*!
+    \fn FrameArena::allocate(size_t bytes)
+    \brief bytes aligned to 16, valid until the next reset
+*/
+void* FrameArena::allocate(size_t bytes){
+    bytes = (bytes + 15) / 16 * 16;
+    if(block == NULL){
+        capacity = FRAME_ARENA_BYTES;
+        block = new char[capacity];
+    }
+    if(used + bytes <= capacity){
+        used += bytes;
+        return block + used - bytes;
+    }
+    overflow.push_back(new char[bytes]); /*!< Taken into the block at the next reset */
+    overflowBytes += bytes;
+    return overflow.back();
+}
+
+/*!
+    \fn FrameArena::reset()
+    \brief Take back everything handed out since the last reset
+    After a frame which overflowed, the block grows to hold all of that frame.
+*/
+void FrameArena::reset(){
+    size_t frameBytes = used + overflowBytes;
+    highWater = frameBytes > highWater ? frameBytes : highWater;
+    if(!overflow.empty()){
+        for(size_t i=0;i<overflow.size();i++)
+            delete[] overflow[i];
+        overflow.clear();
+        delete[] block;
+        capacity = highWater + highWater / 2;
+        block = new char[capacity];
+    }
+    used = 0;
+    overflowBytes = 0;
+}
+
+/*!
+    \fn frameArena()
+    \brief Arena of the calling thread
+    The GL thread resets it when a frame is swapped, the frame pipeline
+    worker whenever it has prepared a frame.
+*/
+FrameArena* frameArena(){
+    static thread_local FrameArena arena;
+    return &arena;
+}
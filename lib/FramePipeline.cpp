@@ -0,0 +1,180 @@
+/*!
+    /file FramePipeline.cpp
+    /brief Frame preparation on a worker thread, submission on the GL thread
+*/
+
+#include "./headers/FramePipeline.h"
+#include "./headers/FrameArena.h"
+#include <string.h>
+#include <chrono>
+
+/*!
+    \fn FramePipeline::FramePipeline()
+    \brief Constructor
+    The worker is only started by FramePipeline::start.
+*/
+FramePipeline::FramePipeline() : busy(0), pending(0), running(0), parked(0){
+    front = -1;
+    back = 0;
+    framesPrepared = 0;
+    framesRepeated = 0;
+    workerParks = 0;
+    lockstep = 0;
+    spinTime = 0;
+    prepare = NULL;
+    for(int i=0;i<2;i++){
+        recorders[i].captureVertices = 0;
+        recorders[i].commands = &frames[i];
+    }
+}
+
+/*!
+    \fn FramePipeline::~FramePipeline()
+    \brief Destructor stops the worker
+*/
+FramePipeline::~FramePipeline(){
+    stop();
+}
+
+/*!
+    \fn FramePipeline::start(void (*prepareFrame)(void*), size_t stateSize)
+    \brief Start the worker
+    prepareFrame -> records a frame through the GL backend from a state of stateSize bytes.
+*/
+void FramePipeline::start(void (*prepareFrame)(void*), size_t stateSize){
+    stop();
+    prepare = prepareFrame;
+    states[0].resize(stateSize);
+    states[1].resize(stateSize);
+    spinTime = std::thread::hardware_concurrency() > 1 ? FRAME_PIPELINE_SPIN_US : 0; /*!< Spinning on the only core delays the GL thread */
+    front = -1;
+    back = 0;
+    running = 1;
+    worker = std::thread(&FramePipeline::run, this);
+}
+
+/*!
+    \fn FramePipeline::stop()
+    \brief Wait for the frame in preparation and stop the worker
+*/
+void FramePipeline::stop(){
+    if(!worker.joinable())
+        return;
+    running = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wake.notify_one();
+    }
+    worker.join();
+    busy = 0;
+    pending = 0;
+}
+
+/*!
+    \fn FramePipeline::drain()
+    \brief Wait for the frame in preparation and drop the prepared frames
+    The worker stays parked until the next submit, which records a frame of
+    its own state and waits for it, so the GL thread may change what frames
+    are drawn from in between without stopping the worker.
+*/
+void FramePipeline::drain(){
+    while(busy.load(std::memory_order_acquire))
+        std::this_thread::yield();
+    front = -1;
+}
+
+/*!
+    \fn FramePipeline::started()
+    \brief 1 while the worker thread exists, drained or not
+*/
+GLint FramePipeline::started(){
+    return worker.joinable();
+}
+
+/*!
+    \fn FramePipeline::request(const void *frameState)
+    \brief Hand a state to the worker, which records it into the back buffer
+    A spinning worker sees pending on its own, only a parked one is woken.
+    Both flags are sequentially consistent, so either the worker sees pending
+    before parking or the GL thread sees parked and wakes it.
+*/
+void FramePipeline::request(const void *frameState){
+    memcpy(states[back].data(), frameState, states[back].size());
+    busy.store(1, std::memory_order_release);
+    pending = 1;
+    if(parked){
+        std::lock_guard<std::mutex> lock(mutex); /*!< Held by the worker until it waits */
+        wake.notify_one();
+    }
+}
+
+/*!
+    \fn FramePipeline::submit(const void *frameState)
+    \brief Hand-off point between the GL thread and the worker
+    Returns the most recent prepared frame for the GL thread to submit and
+    queues frameState to be prepared next. If the worker has not finished yet
+    the previous frame is returned again, so the GL thread never waits on it.
+    Only the very first frame is waited for, or every frame in lockstep.
+*/
+CommandBuffer* FramePipeline::submit(const void *frameState){
+    if(front < 0)
+        request(frameState);
+    else if(busy.load(std::memory_order_acquire) && lockstep == 0){
+        framesRepeated++;
+        return &frames[front];
+    }
+    while(busy.load(std::memory_order_acquire))
+        std::this_thread::yield();
+    front = back;
+    back = 1 - front;
+    request(frameState);
+    return &frames[front];
+}
+
+/*!
+    \fn FramePipeline::awaitRequest()
+    \brief Wait for the next frame state, returns 0 once the pipeline stops
+    Spins for spinTime, then parks on the condition variable.
+*/
+GLint FramePipeline::awaitRequest(){
+    using namespace std::chrono;
+    steady_clock::time_point spinEnd = steady_clock::now() + microseconds(spinTime);
+    while(pending == 0 && running && steady_clock::now() < spinEnd)
+        std::this_thread::yield();
+    if(pending == 0 && running){
+        std::unique_lock<std::mutex> lock(mutex);
+        parked = 1;
+        workerParks++;
+        wake.wait(lock, [this]{ return pending || !running; });
+        parked = 0;
+    }
+    pending = 0;
+    return running;
+}
+
+/*!
+    \fn FramePipeline::submittedState()
+    \brief State the frame last returned by submit was recorded from
+    It may be older than the state passed to submit, so whatever is applied
+    to the frame on the GL thread after its replay is taken from this one.
+*/
+const void* FramePipeline::submittedState(){
+    return states[front].data();
+}
+
+/*!
+    \fn FramePipeline::run()
+    \brief Worker loop recording every requested frame into the back buffer
+*/
+void FramePipeline::run(){
+    while(awaitRequest()){
+        frames[back].clear();
+        recorders[back].reset();
+        setGLBackend(BACKEND_RECORDING, &recorders[back]);
+        prepare(states[back].data());
+        setGLBackend(BACKEND_IMMEDIATE);
+        frameArena()->reset();
+        framesPrepared++;
+        busy.store(0, std::memory_order_release);
+    }
+}
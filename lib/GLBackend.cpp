@@ -0,0 +1,672 @@
+/*!
+    /file GLBackend.cpp
+    /brief Indirection between the drawing code and OpenGL
+    Every GL call made by the drawing code goes through this layer, which either
+    forwards it to OpenGL or records it into a GLRecorder.
+*/
+
+#include "./headers/CommandBuffer.h"
+#include "./headers/FrameArena.h"
+#include "./headers/StrokeFont.h"
+#include <map>
+#include <math.h>
+#include <string.h>
+
+thread_local GLint glBackend = BACKEND_IMMEDIATE; /*!< Backend of the calling thread */
+thread_local GLRecorder *glRecorder = NULL;
+
+/*!
+    \struct TextureRegion
+    \brief Part of an atlas texture standing in for a texture name
+*/
+struct TextureRegion{
+    GLuint texture; /*!< Atlas texture holding the region */
+    GLfloat offset[2], scale[2]; /*!< Maps texture coordinates of the region into the atlas */
+};
+static std::map<GLuint, TextureRegion> textureRegions; /*!< Regions by the texture name they replace */
+thread_local const TextureRegion *boundRegion = NULL; /*!< Region selected by the last texture bind */
+
+/*!
+    \fn strokeCharacter(int ch)
+    \brief Glyph of the roman stroke font, NULL for characters it has none for
+*/
+static const StrokeChar* strokeCharacter(int ch){
+    if(ch < 0 || ch >= strokeRoman.noOfChars || strokeRoman.chars[ch].strips == NULL)
+        return NULL;
+    return &strokeRoman.chars[ch];
+}
+
+/*!
+    \struct SimplifiedGlyph
+    \brief Strips of a glyph with the vertices PAGE_GLYPH_TOLERANCE can spare removed
+*/
+struct SimplifiedGlyph{
+    std::vector<GLfloat> vertices; /*!< x, y of every vertex kept */
+    std::vector<GLint> strips; /*!< Number of vertices of every strip */
+    GLfloat right; /*!< Advance to the next character */
+};
+
+/*!
+    \fn simplifyStrip(const StrokeVertex *vertices, GLint first, GLint last, std::vector<char> *keep)
+    \brief Douglas Peucker, keep the vertex furthest from the segment first to last while it is beyond the tolerance
+*/
+static void simplifyStrip(const StrokeVertex *vertices, GLint first, GLint last, std::vector<char> *keep){
+    GLfloat dx = vertices[last].x - vertices[first].x, dy = vertices[last].y - vertices[first].y;
+    GLfloat length = sqrtf(dx*dx + dy*dy), furthest = 0;
+    GLint index = -1;
+    for(int i=first+1;i<last;i++){
+        GLfloat ex = vertices[i].x - vertices[first].x, ey = vertices[i].y - vertices[first].y;
+        GLfloat distance = length > 0 ? fabsf(ex*dy - ey*dx) / length : sqrtf(ex*ex + ey*ey);
+        if(distance > furthest){
+            furthest = distance;
+            index = i;
+        }
+    }
+    if(index < 0 || furthest <= PAGE_GLYPH_TOLERANCE)
+        return;
+    (*keep)[index] = 1;
+    simplifyStrip(vertices, first, index, keep);
+    simplifyStrip(vertices, index, last, keep);
+}
+
+/*!
+    \fn simplifiedCharacter(int ch)
+    \brief Simplified glyph of the roman stroke font, built for every glyph on first use
+*/
+static const SimplifiedGlyph* simplifiedCharacter(int ch){
+    static const std::vector<SimplifiedGlyph> glyphs = [](){
+        std::vector<SimplifiedGlyph> glyphs(strokeRoman.noOfChars);
+        for(int c=0;c<strokeRoman.noOfChars;c++){
+            const StrokeChar *glyph = strokeCharacter(c);
+            glyphs[c].right = glyph != NULL ? glyph->right : 0;
+            for(int i=0;glyph!=NULL && i<glyph->noOfStrips;i++){
+                const StrokeStrip *strip = &glyph->strips[i];
+                if(strip->noOfVertices < 2)
+                    continue;
+                std::vector<char> keep(strip->noOfVertices, 0);
+                keep[0] = keep[strip->noOfVertices - 1] = 1;
+                simplifyStrip(strip->vertices, 0, strip->noOfVertices - 1, &keep);
+                GLint kept = 0;
+                for(int j=0;j<strip->noOfVertices;j++)
+                    if(keep[j]){
+                        glyphs[c].vertices.push_back(strip->vertices[j].x);
+                        glyphs[c].vertices.push_back(strip->vertices[j].y);
+                        kept++;
+                    }
+                glyphs[c].strips.push_back(kept);
+            }
+        }
+        return glyphs;
+    }();
+    if(ch < 0 || ch >= (GLint)glyphs.size())
+        return NULL;
+    return &glyphs[ch];
+}
+
+/*!
+    \fn GLRecorder::GLRecorder()
+    \brief Constructor
+    Creates an empty recorder which captures vertices but no commands.
+*/
+GLRecorder::GLRecorder(){
+    captureVertices = 1;
+    commands = NULL;
+    reset();
+}
+
+/*!
+    \fn GLRecorder::reset()
+    \brief Clear the recorded calls and vertices
+    The vertex storage is kept allocated for the next recording.
+*/
+void GLRecorder::reset(){
+    for(int i=0;i<CALL_COUNT;i++)
+        calls[i] = 0;
+    totalCalls = 0;
+    vertices = 0;
+    vertexData.clear();
+    for(int i=0;i<2;i++){
+        identityMatrix(matrices[i]);
+        matrixStacks[i].clear();
+    }
+    matrixMode = 0;
+    viewport[0] = viewport[1] = 0;
+    viewport[2] = WINDOW_WIDTH;
+    viewport[3] = WINDOW_HEIGHT;
+}
+
+/*!
+    \fn GLRecorder::record(GLint call, GLint noOfArgs, const GLfloat *args)
+    \brief Count a call to the given entry point
+    The call is encoded with its arguments into the attached command buffer.
+    Stroke characters are only counted, their strips are recorded separately.
+*/
+void GLRecorder::record(GLint call, GLint noOfArgs, const GLfloat *args){
+    calls[call]++;
+    totalCalls++;
+    if(call == CALL_VERTEX){
+        vertices++;
+        if(captureVertices)
+            vertexData.insert(vertexData.end(), args, args + 3);
+    }
+    else if(call == CALL_DRAW_ARRAYS || call == CALL_DRAW_COLORED_ARRAYS || call == CALL_DRAW_TEXTURED_ARRAYS){
+        GLint stride = call == CALL_DRAW_ARRAYS ? 6 : (call == CALL_DRAW_COLORED_ARRAYS ? 9 : 8);
+        vertices += (GLint)args[1];
+        for(int i=0;captureVertices && i<(GLint)args[1];i++)
+            vertexData.insert(vertexData.end(), args + 2 + stride*i, args + 5 + stride*i);
+    }
+    else if((call >= CALL_PUSH_MATRIX && call <= CALL_SCALE) || (call >= CALL_MATRIX_MODE && call <= CALL_MULT_MATRIX)
+        || call == CALL_VIEWPORT)
+        trackMatrix(call, args);
+    if(commands != NULL && call != CALL_STROKE_CHARACTER)
+        commands->append(call, noOfArgs, args);
+}
+
+/*!
+    \fn GLRecorder::trackMatrix(GLint call, const GLfloat *args)
+    \brief Apply a matrix or viewport call to the matrices kept by the recorder
+    Lets the drawing code ask for the current transform while recording, see currentTransform.
+*/
+void GLRecorder::trackMatrix(GLint call, const GLfloat *args){
+    GLfloat *m = matrices[matrixMode];
+    std::vector<GLfloat> *stack = &matrixStacks[matrixMode];
+    switch(call){
+        case CALL_MATRIX_MODE: matrixMode = (GLenum)args[0] == GL_PROJECTION; return;
+        case CALL_PUSH_MATRIX: stack->insert(stack->end(), m, m + 16); return;
+        case CALL_POP_MATRIX:
+            if(stack->size() >= 16){
+                memcpy(m, stack->data() + stack->size() - 16, 16*sizeof(GLfloat));
+                stack->resize(stack->size() - 16);
+            }
+            return;
+        case CALL_LOAD_IDENTITY: identityMatrix(m); return;
+        case CALL_LOAD_MATRIX: memcpy(m, args, 16*sizeof(GLfloat)); return;
+        case CALL_VIEWPORT: memcpy(viewport, args, sizeof(viewport)); return;
+        case CALL_MULT_MATRIX: multiplyMatrix(m, args); return;
+        case CALL_TRANSLATE: translateMatrix(m, args[0], args[1], args[2]); return;
+        case CALL_SCALE: scaleMatrix(m, args[0], args[1], args[2]); return;
+        case CALL_ROTATE: rotateMatrix(m, args[0], args[1], args[2], args[3]); return;
+    }
+}
+
+/*!
+    \fn currentTransform(GLfloat transform[16], GLfloat viewport[4])
+    \brief Projection * modelview and the viewport geometry is currently drawn with
+    Read back from OpenGL, or from the matrices tracked by the recorder.
+*/
+void currentTransform(GLfloat transform[16], GLfloat viewport[4]){
+    GLfloat modelview[16];
+    if(glBackend == BACKEND_RECORDING){
+        memcpy(transform, glRecorder->matrices[1], sizeof(modelview));
+        memcpy(modelview, glRecorder->matrices[0], sizeof(modelview));
+        memcpy(viewport, glRecorder->viewport, 4*sizeof(GLfloat));
+    }
+    else{
+        GLint view[4];
+        glGetFloatv(GL_PROJECTION_MATRIX, transform);
+        glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+        glGetIntegerv(GL_VIEWPORT, view);
+        for(int i=0;i<4;i++)
+            viewport[i] = view[i];
+    }
+    multiplyMatrix(transform, modelview);
+}
+
+/*!
+    \fn GLRecorder::vertex(GLfloat x, GLfloat y, GLfloat z)
+    \brief Capture a vertex
+*/
+void GLRecorder::vertex(GLfloat x, GLfloat y, GLfloat z){
+    GLfloat args[] = {x, y, z};
+    record(CALL_VERTEX, 3, args);
+}
+
+/*!
+    \fn setGLBackend(GLint backend, GLRecorder *recorder)
+    \brief Select where GL calls are sent
+    BACKEND_IMMEDIATE -> calls are forwarded to OpenGL.
+    BACKEND_RECORDING -> calls are captured by recorder.
+*/
+void setGLBackend(GLint backend, GLRecorder *recorder){
+    glBackend = (backend == BACKEND_RECORDING && recorder != NULL) ? BACKEND_RECORDING : BACKEND_IMMEDIATE;
+    glRecorder = recorder;
+}
+
+/*!
+    \fn lightParameterCount(GLenum name)
+    \brief Number of values read by glLightfv and glMaterialfv for a parameter
+*/
+static GLint lightParameterCount(GLenum name){
+    if(name == GL_SHININESS || name == GL_SPOT_EXPONENT || name == GL_SPOT_CUTOFF || name == GL_CONSTANT_ATTENUATION
+        || name == GL_LINEAR_ATTENUATION || name == GL_QUADRATIC_ATTENUATION)
+        return 1;
+    if(name == GL_SPOT_DIRECTION)
+        return 3;
+    return 4;
+}
+
+/*!
+    \fn recordParameters(GLint call, GLenum target, GLenum name, const GLfloat *params)
+    \brief Record a glLightfv or glMaterialfv call with its parameter values
+*/
+static void recordParameters(GLint call, GLenum target, GLenum name, const GLfloat *params){
+    GLfloat args[6] = {(GLfloat)target, (GLfloat)name, 0, 0, 0, 0};
+    for(int i=0;i<lightParameterCount(name);i++)
+        args[2 + i] = params[i];
+    glRecorder->record(call, 6, args);
+}
+
+void fbBegin(GLenum mode){
+    GLfloat args[] = {(GLfloat)mode};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_BEGIN, 1, args);
+    else glBegin(mode);
+}
+
+void fbEnd(){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_END);
+    else glEnd();
+}
+
+void fbVertex2f(GLfloat x, GLfloat y){
+    if(glBackend == BACKEND_RECORDING) glRecorder->vertex(x, y, 0);
+    else glVertex2f(x, y);
+}
+
+void fbVertex3f(GLfloat x, GLfloat y, GLfloat z){
+    if(glBackend == BACKEND_RECORDING) glRecorder->vertex(x, y, z);
+    else glVertex3f(x, y, z);
+}
+
+void fbVertex3fv(const GLfloat *v){
+    if(glBackend == BACKEND_RECORDING) glRecorder->vertex(v[0], v[1], v[2]);
+    else glVertex3fv(v);
+}
+
+void fbNormal3f(GLfloat x, GLfloat y, GLfloat z){
+    GLfloat args[] = {x, y, z};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_NORMAL, 3, args);
+    else glNormal3f(x, y, z);
+}
+
+void fbNormal3fv(const GLfloat *v){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_NORMAL, 3, v);
+    else glNormal3fv(v);
+}
+
+void fbColor3f(GLfloat r, GLfloat g, GLfloat b){
+    GLfloat args[] = {r, g, b};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_COLOR, 3, args);
+    else glColor3f(r, g, b);
+}
+
+void fbTexCoord2f(GLfloat s, GLfloat t){
+    if(boundRegion != NULL){
+        s = boundRegion->offset[0] + s*boundRegion->scale[0];
+        t = boundRegion->offset[1] + t*boundRegion->scale[1];
+    }
+    GLfloat args[] = {s, t};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_TEX_COORD, 2, args);
+    else glTexCoord2f(s, t);
+}
+
+/*!
+    \fn fbMultiTexCoord2f(GLenum unit, GLfloat s, GLfloat t)
+    \brief Texture coordinate of another texture unit, never remapped to an atlas region
+*/
+void fbMultiTexCoord2f(GLenum unit, GLfloat s, GLfloat t){
+    GLfloat args[] = {(GLfloat)unit, s, t};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_MULTI_TEX_COORD, 3, args);
+    else glMultiTexCoord2f(unit, s, t);
+}
+
+void fbPushMatrix(){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_PUSH_MATRIX);
+    else glPushMatrix();
+}
+
+void fbPopMatrix(){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_POP_MATRIX);
+    else glPopMatrix();
+}
+
+void fbLoadIdentity(){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_LOAD_IDENTITY);
+    else glLoadIdentity();
+}
+
+void fbTranslatef(GLfloat x, GLfloat y, GLfloat z){
+    GLfloat args[] = {x, y, z};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_TRANSLATE, 3, args);
+    else glTranslatef(x, y, z);
+}
+
+void fbRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z){
+    GLfloat args[] = {angle, x, y, z};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_ROTATE, 4, args);
+    else glRotatef(angle, x, y, z);
+}
+
+void fbScalef(GLfloat x, GLfloat y, GLfloat z){
+    GLfloat args[] = {x, y, z};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_SCALE, 3, args);
+    else glScalef(x, y, z);
+}
+
+void fbEnable(GLenum cap){
+    GLfloat args[] = {(GLfloat)cap};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_ENABLE, 1, args);
+    else glEnable(cap);
+}
+
+void fbDisable(GLenum cap){
+    GLfloat args[] = {(GLfloat)cap};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_DISABLE, 1, args);
+    else glDisable(cap);
+}
+
+/*!
+    \fn registerTextureRegion(GLuint texture, GLfloat u0, GLfloat v0, GLfloat u1, GLfloat v1)
+    \brief Create a texture name standing for the region (u0, v0) - (u1, v1) of texture
+    Binding the returned name binds texture instead, and the texture coordinates given
+    until the next bind are mapped into the region. Must be called on the GL thread
+    before any drawing thread binds the name.
+*/
+GLuint registerTextureRegion(GLuint texture, GLfloat u0, GLfloat v0, GLfloat u1, GLfloat v1){
+    GLuint name;
+    glGenTextures(1, &name);
+    TextureRegion region = {texture, {u0, v0}, {u1 - u0, v1 - v0}};
+    textureRegions[name] = region;
+    return name;
+}
+
+/*!
+    \fn textureSize(GLuint texture, GLint *width, GLint *height)
+    \brief Texels on the sides of a texture name, of its region for a name registered by registerTextureRegion
+    Must be called on the GL thread.
+*/
+void textureSize(GLuint texture, GLint *width, GLint *height){
+    std::map<GLuint, TextureRegion>::const_iterator region = textureRegions.find(texture);
+    GLfloat scale[2] = {1, 1};
+    if(region != textureRegions.end()){
+        texture = region->second.texture;
+        scale[0] = fabsf(region->second.scale[0]);
+        scale[1] = fabsf(region->second.scale[1]);
+    }
+    GLint previous, size[2];
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &previous);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &size[0]);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &size[1]);
+    glBindTexture(GL_TEXTURE_2D, previous);
+    *width = (GLint)(size[0]*scale[0] + 0.5f);
+    *height = (GLint)(size[1]*scale[1] + 0.5f);
+}
+
+/*!
+    \fn resolveTexture(GLuint texture)
+    \brief Texture actually bound for a texture name, selecting its region if it has one
+*/
+static GLuint resolveTexture(GLuint texture){
+    std::map<GLuint, TextureRegion>::const_iterator region = textureRegions.find(texture);
+    boundRegion = region == textureRegions.end() ? NULL : &region->second;
+    return boundRegion == NULL ? texture : boundRegion->texture;
+}
+
+void fbBindTexture(GLenum target, GLuint texture){
+    GLuint boundTexture = resolveTexture(texture);
+    GLfloat args[] = {(GLfloat)target, (GLfloat)boundTexture};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_BIND_TEXTURE, 2, args);
+    else glBindTexture(target, boundTexture);
+}
+
+void fbTexEnvf(GLenum target, GLenum name, GLfloat value){
+    GLfloat args[] = {(GLfloat)target, (GLfloat)name, value};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_TEX_ENV, 3, args);
+    else glTexEnvf(target, name, value);
+}
+
+/*!
+    \fn fbActiveTexture(GLenum unit)
+    \brief Select the texture unit later texture calls apply to
+    Scene textures are tracked for the first unit only, so other units must be
+    bound before the first texture of a scene.
+*/
+void fbActiveTexture(GLenum unit){
+    GLfloat args[] = {(GLfloat)unit};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_ACTIVE_TEXTURE, 1, args);
+    else glActiveTexture(unit);
+}
+
+void fbLineWidth(GLfloat width){
+    GLfloat args[] = {width};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_LINE_WIDTH, 1, args);
+    else glLineWidth(width);
+}
+
+void fbLightfv(GLenum light, GLenum name, const GLfloat *params){
+    if(glBackend == BACKEND_RECORDING) recordParameters(CALL_LIGHT, light, name, params);
+    else glLightfv(light, name, params);
+}
+
+void fbMaterialfv(GLenum face, GLenum name, const GLfloat *params){
+    if(glBackend == BACKEND_RECORDING) recordParameters(CALL_MATERIAL, face, name, params);
+    else glMaterialfv(face, name, params);
+}
+
+/*!
+    \fn drawInterleavedArrays(GLenum mode, GLint count, const GLfloat *data, GLint colors, GLint texCoords)
+    \brief Draw count vertices stored as x, y, z, nx, ny, nz with a single glDrawArrays
+    With colors every vertex is followed by its r, g, b, with texCoords by its s, t.
+*/
+void drawInterleavedArrays(GLenum mode, GLint count, const GLfloat *data, GLint colors, GLint texCoords){
+    GLsizei stride = (6 + (colors ? 3 : 0) + (texCoords ? 2 : 0))*sizeof(GLfloat);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+    glVertexPointer(3, GL_FLOAT, stride, data);
+    glNormalPointer(GL_FLOAT, stride, data + 3);
+    if(colors){
+        glEnableClientState(GL_COLOR_ARRAY);
+        glColorPointer(3, GL_FLOAT, stride, data + 6);
+    }
+    if(texCoords){
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, stride, data + (colors ? 9 : 6));
+    }
+    glDrawArrays(mode, 0, count);
+    if(texCoords)
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    if(colors)
+        glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+/*!
+    \fn recordArrays(GLint call, GLenum mode, GLint count, const GLfloat *data, GLint stride)
+    \brief Record a draw arrays call with a copy of its vertices
+    The arguments are put together in the frame arena, so recording makes no heap allocation.
+*/
+static void recordArrays(GLint call, GLenum mode, GLint count, const GLfloat *data, GLint stride){
+    GLint noOfArgs = 2 + stride*count;
+    GLfloat *args = (GLfloat*)frameArena()->allocate(noOfArgs*sizeof(GLfloat));
+    args[0] = mode;
+    args[1] = count;
+    memcpy(args + 2, data, stride*count*sizeof(GLfloat));
+    glRecorder->record(call, noOfArgs, args);
+}
+
+/*!
+    \fn fbDrawArrays(GLenum mode, GLint count, const GLfloat *data)
+    \brief Draw vertices with interleaved normals in one call, see drawInterleavedArrays
+    The recording keeps a copy of the vertices, so data may change afterwards.
+*/
+void fbDrawArrays(GLenum mode, GLint count, const GLfloat *data){
+    if(glBackend == BACKEND_RECORDING) recordArrays(CALL_DRAW_ARRAYS, mode, count, data, 6);
+    else drawInterleavedArrays(mode, count, data);
+}
+
+/*!
+    \fn fbDrawColoredArrays(GLenum mode, GLint count, const GLfloat *data)
+    \brief Draw vertices with interleaved normals and colors in one call
+*/
+void fbDrawColoredArrays(GLenum mode, GLint count, const GLfloat *data){
+    if(glBackend == BACKEND_RECORDING) recordArrays(CALL_DRAW_COLORED_ARRAYS, mode, count, data, 9);
+    else drawInterleavedArrays(mode, count, data, 1);
+}
+
+/*!
+    \fn fbDrawTexturedArrays(GLenum mode, GLint count, const GLfloat *data)
+    \brief Draw vertices with interleaved normals and texture coordinates in one call
+*/
+void fbDrawTexturedArrays(GLenum mode, GLint count, const GLfloat *data){
+    if(glBackend == BACKEND_RECORDING) recordArrays(CALL_DRAW_TEXTURED_ARRAYS, mode, count, data, 8);
+    else drawInterleavedArrays(mode, count, data, 0, 1);
+}
+
+void fbFlush(){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_FLUSH);
+    else glFlush();
+}
+
+void fbMatrixMode(GLenum mode){
+    GLfloat args[] = {(GLfloat)mode};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_MATRIX_MODE, 1, args);
+    else glMatrixMode(mode);
+}
+
+void fbLoadMatrixf(const GLfloat *m){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_LOAD_MATRIX, 16, m);
+    else glLoadMatrixf(m);
+}
+
+void fbMultMatrixf(const GLfloat *m){
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_MULT_MATRIX, 16, m);
+    else glMultMatrixf(m);
+}
+
+/*!
+    \fn fbLookAt(...)
+    \brief gluLookAt, recorded as the finished viewing matrix
+*/
+void fbLookAt(GLfloat eyeX, GLfloat eyeY, GLfloat eyeZ, GLfloat centerX, GLfloat centerY, GLfloat centerZ,
+        GLfloat upX, GLfloat upY, GLfloat upZ){
+    if(glBackend != BACKEND_RECORDING){
+        gluLookAt(eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ);
+        return;
+    }
+    GLfloat m[16];
+    lookAtMatrix(m, eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ);
+    glRecorder->record(CALL_MULT_MATRIX, 16, m);
+}
+
+/*!
+    \fn fbOrtho(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar)
+    \brief glOrtho, recorded as the finished projection matrix
+*/
+void fbOrtho(GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar){
+    if(glBackend != BACKEND_RECORDING){
+        glOrtho(left, right, bottom, top, zNear, zFar);
+        return;
+    }
+    GLfloat m[16];
+    orthoMatrix(m, left, right, bottom, top, zNear, zFar);
+    glRecorder->record(CALL_MULT_MATRIX, 16, m);
+}
+
+/*!
+    \fn fbPerspective(GLfloat fovy, GLfloat aspect, GLfloat zNear, GLfloat zFar)
+    \brief gluPerspective, recorded as the finished projection matrix
+*/
+void fbPerspective(GLfloat fovy, GLfloat aspect, GLfloat zNear, GLfloat zFar){
+    if(glBackend != BACKEND_RECORDING){
+        gluPerspective(fovy, aspect, zNear, zFar);
+        return;
+    }
+    GLfloat m[16];
+    perspectiveMatrix(m, fovy, aspect, zNear, zFar);
+    glRecorder->record(CALL_MULT_MATRIX, 16, m);
+}
+
+void fbClear(GLbitfield mask){
+    GLfloat args[] = {(GLfloat)mask};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_CLEAR, 1, args);
+    else glClear(mask);
+}
+
+void fbClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a){
+    GLfloat args[] = {r, g, b, a};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_CLEAR_COLOR, 4, args);
+    else glClearColor(r, g, b, a);
+}
+
+void fbViewport(GLint x, GLint y, GLsizei width, GLsizei height){
+    GLfloat args[] = {(GLfloat)x, (GLfloat)y, (GLfloat)width, (GLfloat)height};
+    if(glBackend == BACKEND_RECORDING) glRecorder->record(CALL_VIEWPORT, 4, args);
+    else glViewport(x, y, width, height);
+}
+
+/*!
+    \fn fbStrokeCharacter(int ch)
+    \brief Draw a character of the roman stroke font
+    The glyph strips are submitted as glutStrokeCharacter would, from the
+    tables in StrokeRoman.cpp, so text is drawn without glutInit, as headless
+    replays do. When recording they are expanded the same way, so vertex
+    counts match the immediate backend.
+*/
+void fbStrokeCharacter(int ch){
+    const StrokeChar *glyph = strokeCharacter(ch);
+    if(glBackend != BACKEND_RECORDING){
+        if(glyph == NULL)
+            return;
+        for(int i=0;i<glyph->noOfStrips;i++){
+            glBegin(GL_LINE_STRIP);
+            for(int j=0;j<glyph->strips[i].noOfVertices;j++)
+                glVertex2f(glyph->strips[i].vertices[j].x, glyph->strips[i].vertices[j].y);
+            glEnd();
+        }
+        glTranslatef(glyph->right, 0, 0);
+        return;
+    }
+    glRecorder->record(CALL_STROKE_CHARACTER);
+    if(glyph == NULL)
+        return;
+    for(int i=0;i<glyph->noOfStrips;i++){
+        const StrokeStrip *strip = &glyph->strips[i];
+        GLfloat mode[] = {(GLfloat)GL_LINE_STRIP};
+        glRecorder->record(CALL_BEGIN, 1, mode);
+        for(int j=0;j<strip->noOfVertices;j++)
+            glRecorder->vertex(strip->vertices[j].x, strip->vertices[j].y, 0);
+        glRecorder->record(CALL_END);
+    }
+    GLfloat advance[] = {glyph->right, 0, 0};
+    glRecorder->record(CALL_TRANSLATE, 3, advance);
+}
+
+/*!
+    \fn fbStrokeCharacterSimplified(int ch)
+    \brief Draw a character of the roman stroke font with simplified strips
+    No strip leaves the original by more than PAGE_GLYPH_TOLERANCE font units.
+*/
+void fbStrokeCharacterSimplified(int ch){
+    const SimplifiedGlyph *glyph = simplifiedCharacter(ch);
+    if(glyph == NULL || strokeCharacter(ch) == NULL)
+        return;
+    const GLfloat *vertex = glyph->vertices.data();
+    for(size_t i=0;i<glyph->strips.size();i++){
+        fbBegin(GL_LINE_STRIP);
+        for(int j=0;j<glyph->strips[i];j++, vertex+=2)
+            fbVertex2f(vertex[0], vertex[1]);
+        fbEnd();
+    }
+    fbTranslatef(glyph->right, 0, 0);
+}
+
+/*!
+    \fn fbStrokeWidth(int ch)
+    \brief Width of a character of the roman stroke font
+    Same result as glutStrokeWidth, but usable before glutInit.
+*/
+int fbStrokeWidth(int ch){
+    const StrokeChar *glyph = strokeCharacter(ch);
+    return glyph == NULL ? 0 : (int)(glyph->right + 0.5f);
+}
@@ -0,0 +1,213 @@
+/*!
+    /file InputJournal.cpp
+    /brief Input events recorded to a text file and replayed against the step clock
+    A journal is one header line, then one line per event:
+        step time type values...
+    and ends with
+        end step hash
+    A journal written by hand may end with the step count only, its final
+    state is then not checked.
+*/
+
+#include "./headers/InputJournal.h"
+#include <algorithm>
+#include <string.h>
+
+static const char *JOURNAL_HEADER = "flipbook input journal 1";
+static const char *EVENT_NAMES[INPUT_EVENT_TYPES] = {"key", "special", "click", "motion", "menu", "reshape"};
+
+/*!
+    \fn InputJournal::InputJournal()
+    \brief Constructor, neither recording nor replaying
+*/
+InputJournal::InputJournal(){
+    recording = replaying = 0;
+    step = 0;
+    next = 0;
+    endStep = endHash = 0;
+    ended = 0;
+    file = profile = NULL;
+    framesProfiled = lastProfiledStep = 0;
+    framesAllocating = 0;
+    allocations = 0;
+}
+
+/*!
+    \fn InputJournal::~InputJournal()
+    \brief Close the files left open
+*/
+InputJournal::~InputJournal(){
+    if(file != NULL)
+        fclose(file);
+    if(profile != NULL)
+        fclose(profile);
+}
+
+/*!
+    \fn InputJournal::record(const char *filename)
+    \brief Start recording every event added to filename, returns 0 when it cannot be written
+*/
+GLint InputJournal::record(const char *filename){
+    file = fopen(filename, "w");
+    if(file == NULL)
+        return 0;
+    fprintf(file, "%s\n", JOURNAL_HEADER);
+    recording = 1;
+    step = 0;
+    start = std::chrono::steady_clock::now();
+    printf("Recording input to %s\n", filename);
+    return 1;
+}
+
+/*!
+    \fn InputJournal::add(GLint type, GLint a, GLint b, GLint c, GLint d)
+    \brief Record an event stamped with the current step, nothing is done unless recording
+*/
+void InputJournal::add(GLint type, GLint a, GLint b, GLint c, GLint d){
+    if(recording == 0 || type < 0 || type >= INPUT_EVENT_TYPES)
+        return;
+    fprintf(file, "%u %.3f %s %d %d %d %d\n", step,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+        EVENT_NAMES[type], a, b, c, d);
+}
+
+/*!
+    \fn InputJournal::load(const char *filename)
+    \brief Read a journal to replay, returns 0 when it cannot be read
+    The profile of the replay is written to INPUT_PROFILE_LOG.
+*/
+GLint InputJournal::load(const char *filename){
+    char line[256], name[16];
+    FILE *journal = fopen(filename, "r");
+    if(journal == NULL)
+        return 0;
+    if(fgets(line, sizeof(line), journal) == NULL || strncmp(line, JOURNAL_HEADER, strlen(JOURNAL_HEADER)) != 0){
+        fclose(journal);
+        return 0;
+    }
+    events.clear();
+    while(fgets(line, sizeof(line), journal) != NULL){
+        InputEvent event;
+        GLint values = sscanf(line, "end %u %u", &endStep, &endHash);
+        if(values >= 1){
+            ended = values;
+            break;
+        }
+        if(sscanf(line, "%u %lf %15s %d %d %d %d", &event.step, &event.time, name,
+                &event.values[0], &event.values[1], &event.values[2], &event.values[3]) != 7)
+            continue;
+        for(event.type=0;event.type<INPUT_EVENT_TYPES && strcmp(name, EVENT_NAMES[event.type]) != 0;event.type++);
+        if(event.type < INPUT_EVENT_TYPES)
+            events.push_back(event);
+    }
+    fclose(journal);
+    frameTimes.reserve((ended ? endStep : (events.empty() ? 0 : events.back().step)) + 1); /*!< The profile makes no allocations per frame */
+    replaying = 1;
+    step = 0;
+    next = 0;
+    start = std::chrono::steady_clock::now();
+    profile = fopen(INPUT_PROFILE_LOG, "w");
+    if(profile != NULL)
+        fprintf(profile, "step,frame ms,allocations,state hash\n");
+    printf("Replaying %zu input events from %s, profiling to %s\n", events.size(), filename, INPUT_PROFILE_LOG);
+    return 1;
+}
+
+/*!
+    \fn InputJournal::pending(InputEvent *event)
+    \brief Next event due before the current step is taken, returns 0 when there is none
+*/
+GLint InputJournal::pending(InputEvent *event){
+    if(replaying == 0 || next >= events.size() || events[next].step > step)
+        return 0;
+    *event = events[next++];
+    return 1;
+}
+
+/*!
+    \fn InputJournal::finished()
+    \brief 1 once every event is replayed and as many steps are taken as were recorded
+*/
+GLint InputJournal::finished(){
+    if(replaying == 0 || next < events.size())
+        return 0;
+    return step >= (ended ? endStep : (events.empty() ? 0 : events.back().step));
+}
+
+/*!
+    \fn InputJournal::windowSize(GLint *width, GLint *height)
+    \brief Largest window the journal was recorded in, WINDOW_WIDTH x WINDOW_HEIGHT when unknown
+*/
+void InputJournal::windowSize(GLint *width, GLint *height){
+    *width = *height = 0;
+    for(size_t i=0;i<events.size();i++){
+        if(events[i].type != INPUT_RESHAPE)
+            continue;
+        *width = std::max(*width, events[i].values[0]);
+        *height = std::max(*height, events[i].values[1]);
+    }
+    if(*width <= 0 || *height <= 0){
+        *width = WINDOW_WIDTH;
+        *height = WINDOW_HEIGHT;
+    }
+}
+
+/*!
+    \fn InputJournal::frameDrawn(GLuint hash, double frameTime, unsigned long frameAllocations)
+    \brief Profile the frame of the current step, drawn in frameTime ms from a state hashing to hash
+    frameAllocations -> heap allocations made since the previous frame.
+    Frames drawn again without a step, as on expose, are left out.
+*/
+void InputJournal::frameDrawn(GLuint hash, double frameTime, unsigned long frameAllocations){
+    if(replaying == 0 || (framesProfiled > 0 && step == lastProfiledStep))
+        return;
+    framesProfiled++;
+    lastProfiledStep = step;
+    frameTimes.push_back(frameTime);
+    framesAllocating += frameAllocations > 0;
+    allocations += frameAllocations;
+    if(profile != NULL)
+        fprintf(profile, "%u,%.3f,%lu,%08x\n", step, frameTime, frameAllocations, hash);
+}
+
+/*!
+    \fn InputJournal::close(GLuint hash)
+    \brief End the journal with the step count and the frame state hash
+    Recording -> both are written to the journal.
+    Replaying -> both are checked against the recording and the profile is summarised.
+*/
+void InputJournal::close(GLuint hash){
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if(recording == 1){
+        fprintf(file, "end %u %u\n", step, hash);
+        fclose(file);
+        file = NULL;
+        recording = 0;
+        printf("\nInput recorded: %u steps in %.1f s\n", step, elapsed);
+    }
+    if(replaying == 1){
+        if(profile != NULL)
+            fclose(profile);
+        profile = NULL;
+        replaying = 0;
+        printf("\nInput replayed: %zu of %zu events, %u steps in %.1f s\n", next, events.size(), step, elapsed);
+        if(!frameTimes.empty()){
+            std::vector<double> times = frameTimes;
+            double total = 0;
+            std::sort(times.begin(), times.end());
+            for(size_t i=0;i<times.size();i++)
+                total += times[i];
+            printf("Frame time: %.2f ms mean, %.2f ms p95, %.2f ms max over %u frames\n",
+                total / times.size(), times[times.size()*95/100], times.back(), framesProfiled);
+            printf("Heap allocations: %lu, made in %u of the frames\n", allocations, framesAllocating);
+        }
+        if(ended < 2)
+            printf("The journal has no final state, it is not checked\n");
+        else if(step == endStep && hash == endHash)
+            printf("Final state matches the recording (hash %08x)\n", hash);
+        else
+            printf("Final state differs from the recording: step %u hash %08x, recorded step %u hash %08x\n",
+                step, hash, endStep, endHash);
+    }
+    fflush(stdout);
+}
@@ -0,0 +1,371 @@
+/*!
+    /file Library.cpp
+    /brief Library view, a hall of bookcases with thousands of closed books
+*/
+
+#include "./headers/Library.h"
+#include <math.h>
+
+static const GLfloat SHELF_BOARD = 20; /*!< Thickness of the shelves and bookcase panels */
+static const GLfloat CASE_DEPTH = 300; /*!< Depth of a bookcase behind the spines */
+static const GLfloat COVER = 4; /*!< Thickness of a book cover */
+static const GLfloat WOOD[3] = {0.45f, 0.3f, 0.18f};
+static const GLfloat PAPER[3] = {0.92f, 0.88f, 0.76f};
+static const GLfloat COVERS[][3] = {
+    {0.55f, 0.1f, 0.1f}, {0.1f, 0.25f, 0.5f}, {0.1f, 0.4f, 0.2f},
+    {0.45f, 0.3f, 0.1f}, {0.2f, 0.2f, 0.2f}, {0.5f, 0.45f, 0.3f}
+};
+
+/*!
+    \fn Library::Library()
+    \brief Constructor creates an empty library with culling and level of detail enabled
+*/
+Library::Library(){
+    this->culling = 1;
+    this->levelOfDetail = 1;
+    this->culled = 0;
+    this->length = 0;
+    for(int i=0;i<DETAIL_LEVELS;i++)
+        this->visible[i] = 0;
+}
+
+/*!
+    \fn Library::build(GLint noOfBooks)
+    \brief Fill bookcases with noOfBooks books of random size and color
+    Bookcases alternate between the left and right wall of a hall running along -z.
+    The books come from a fixed seed, so every library of the same size is the same.
+*/
+void Library::build(GLint noOfBooks){
+    GLuint seed = 1;
+    books.clear();
+    bookcases.clear();
+    books.reserve(noOfBooks);
+    for(GLint index=0;(GLint)books.size()<noOfBooks;index++){
+        Bookcase bookcase;
+        bookcase.side = index % 2 == 0 ? 1 : -1;
+        bookcase.first = books.size();
+        GLfloat spine = -bookcase.side * LIBRARY_HALL_WIDTH/2;
+        GLfloat front = -(index/2) * LIBRARY_CASE_WIDTH;
+        for(int shelf=0;shelf<LIBRARY_SHELVES && (GLint)books.size()<noOfBooks;shelf++){
+            GLfloat z = front - SHELF_BOARD;
+            while((GLint)books.size() < noOfBooks){
+                ShelfBook book;
+                seed = seed*1664525 + 1013904223;
+                book.width = 25 + (seed >> 8) % 45;
+                if(z - book.width < front - LIBRARY_CASE_WIDTH + SHELF_BOARD)
+                    break;
+                book.height = 220 + (seed >> 16) % 110;
+                book.depth = 180 + (seed >> 4) % 70;
+                GLfloat shade = 0.8f + ((seed >> 24) % 40) / 100.0f;
+                for(int i=0;i<3;i++)
+                    book.color[i] = COVERS[(seed >> 12) % 6][i] * shade;
+                book.x = spine;
+                book.y = shelf * LIBRARY_SHELF_HEIGHT + SHELF_BOARD;
+                book.z = z;
+                book.side = bookcase.side;
+                books.push_back(book);
+                z -= book.width;
+            }
+        }
+        bookcase.last = books.size();
+        bookcase.min[0] = bookcase.side > 0 ? spine - CASE_DEPTH : spine - SHELF_BOARD;
+        bookcase.max[0] = bookcase.side > 0 ? spine + SHELF_BOARD : spine + CASE_DEPTH;
+        bookcase.min[1] = 0;
+        bookcase.max[1] = LIBRARY_SHELVES * LIBRARY_SHELF_HEIGHT + SHELF_BOARD;
+        bookcase.min[2] = front - LIBRARY_CASE_WIDTH;
+        bookcase.max[2] = front;
+        bookcases.push_back(bookcase);
+    }
+    length = (bookcases.size() + 1)/2 * LIBRARY_CASE_WIDTH;
+}
+
+/*!
+    \fn Library::setCamera(const GLfloat eye[3], GLfloat yaw, GLfloat aspect)
+    \brief Build the camera matrices and the frustum planes
+    yaw is in degrees, 0 looks down the hall along -z.
+    The planes are the rows of projection * view combined as in Gribb and Hartmann,
+    each a, b, c, d with a*x + b*y + c*z + d >= 0 inside the frustum.
+*/
+void Library::setCamera(const GLfloat eye[3], GLfloat yaw, GLfloat aspect){
+    GLfloat forward[3], right[3], clip[16];
+    cameraAxes(yaw, forward, right);
+    lookAtMatrix(view, eye[0], eye[1], eye[2], eye[0] + forward[0], eye[1] + forward[1], eye[2] + forward[2], 0, 1, 0);
+    perspectiveMatrix(projection, LIBRARY_FIELD_OF_VIEW, aspect, 20, LIBRARY_FAR_PLANE);
+    for(int column=0;column<4;column++)
+        for(int row=0;row<4;row++){
+            clip[4*column + row] = 0;
+            for(int k=0;k<4;k++)
+                clip[4*column + row] += projection[4*k + row] * view[4*column + k];
+        }
+    for(int i=0;i<4;i++){
+        planes[0][i] = clip[4*i + 3] + clip[4*i]; /*!< left */
+        planes[1][i] = clip[4*i + 3] - clip[4*i]; /*!< right */
+        planes[2][i] = clip[4*i + 3] + clip[4*i + 1]; /*!< bottom */
+        planes[3][i] = clip[4*i + 3] - clip[4*i + 1]; /*!< top */
+        planes[4][i] = clip[4*i + 3] + clip[4*i + 2]; /*!< near */
+        planes[5][i] = clip[4*i + 3] - clip[4*i + 2]; /*!< far */
+    }
+}
+
+/*!
+    \fn Library::boxVisible(const GLfloat min[3], const GLfloat max[3], GLint *inside)
+    \brief Test a box against the frustum planes of the last setCamera
+    Returns 0 when the box is outside one of the planes. inside is set when
+    the box is within all of them, so whatever it holds needs no more tests.
+*/
+GLint Library::boxVisible(const GLfloat min[3], const GLfloat max[3], GLint *inside){
+    *inside = 1;
+    for(int i=0;i<6;i++){
+        const GLfloat *p = planes[i];
+        GLfloat farthest = p[3], nearest = p[3];
+        for(int k=0;k<3;k++){
+            farthest += p[k] * (p[k] >= 0 ? max[k] : min[k]);
+            nearest += p[k] * (p[k] >= 0 ? min[k] : max[k]);
+        }
+        if(farthest < 0)
+            return 0;
+        if(nearest < 0)
+            *inside = 0;
+    }
+    return 1;
+}
+
+/*!
+    \fn Library::update(const GLfloat eye[3], GLfloat yaw, GLfloat aspect, GLint pulledBook)
+    \brief Cull the library for the camera and fill the batch of every level of detail
+    Bookcases are culled first, the books of a bookcase which lies within the
+    frustum are not tested again. pulledBook, if any, sticks out of its shelf
+    at full detail.
+*/
+void Library::update(const GLfloat eye[3], GLfloat yaw, GLfloat aspect, GLint pulledBook){
+    GLfloat full = LIBRARY_FULL_DETAIL_DISTANCE, box = LIBRARY_BOX_DETAIL_DISTANCE;
+    setCamera(eye, yaw, aspect);
+    culled = 0;
+    for(int i=0;i<DETAIL_LEVELS;i++){
+        batches[i].clear();
+        visible[i] = 0;
+    }
+    for(size_t c=0;c<bookcases.size();c++){
+        const Bookcase *bookcase = &bookcases[c];
+        GLint inside = 1;
+        if(culling && !boxVisible(bookcase->min, bookcase->max, &inside)){
+            culled += bookcase->last - bookcase->first;
+            continue;
+        }
+        addBookcase(bookcase);
+        for(int b=bookcase->first;b<bookcase->last;b++){
+            const ShelfBook *book = &books[b];
+            GLfloat min[3], max[3], distance = 0;
+            GLint bookInside;
+            if(b == pulledBook)
+                continue;
+            bookBounds(book, 0, min, max);
+            if(culling && !inside && !boxVisible(min, max, &bookInside)){
+                culled++;
+                continue;
+            }
+            for(int k=0;k<3;k++)
+                distance += (min[k] + max[k] - 2*eye[k]) * (min[k] + max[k] - 2*eye[k]) / 4;
+            if(!levelOfDetail || distance < full*full)
+                addBook(book, DETAIL_FULL, 0);
+            else if(distance < box*box)
+                addBook(book, DETAIL_BOX, 0);
+            else
+                addBook(book, DETAIL_IMPOSTOR, 0);
+        }
+    }
+    if(pulledBook >= 0 && pulledBook < (GLint)books.size())
+        addBook(&books[pulledBook], DETAIL_FULL, 0.6f * books[pulledBook].depth);
+}
+
+/*!
+    \fn Library::loadCamera()
+    \brief Load the projection and view of the last update
+*/
+void Library::loadCamera(){
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadMatrixf(projection);
+    fbMatrixMode(GL_MODELVIEW);
+    fbLoadMatrixf(view);
+}
+
+/*!
+    \fn Library::render()
+    \brief Draw the batches filled by update, one call per level of detail
+*/
+void Library::render(){
+    for(int i=0;i<DETAIL_LEVELS;i++)
+        if(batches[i].size() > 0)
+            fbDrawColoredArrays(GL_QUADS, batches[i].size()/9, batches[i].data());
+}
+
+/*!
+    \fn rayBox(const GLfloat origin[3], const GLfloat direction[3], const GLfloat min[3], const GLfloat max[3])
+    \brief Distance along the ray to where it enters the box, -1 when it misses
+*/
+static GLfloat rayBox(const GLfloat origin[3], const GLfloat direction[3], const GLfloat min[3], const GLfloat max[3]){
+    GLfloat enter = 0, leave = LIBRARY_FAR_PLANE;
+    for(int k=0;k<3;k++){
+        if(direction[k] == 0){
+            if(origin[k] < min[k] || origin[k] > max[k])
+                return -1;
+            continue;
+        }
+        GLfloat t0 = (min[k] - origin[k]) / direction[k], t1 = (max[k] - origin[k]) / direction[k];
+        enter = fmaxf(enter, fminf(t0, t1));
+        leave = fminf(leave, fmaxf(t0, t1));
+    }
+    return enter <= leave ? enter : -1;
+}
+
+/*!
+    \fn Library::pick(const GLfloat eye[3], GLfloat yaw, GLfloat aspect, GLfloat x, GLfloat y, GLint pulledBook)
+    \brief Index of the nearest book under the point x, y of the view, or -1
+    x and y run from -1 to 1 across the view of the camera, y upwards.
+    The ray from the eye is tested against the bookcases before their books.
+    The camera is passed in rather than taken from the last update, which may
+    run on the frame pipeline worker.
+*/
+GLint Library::pick(const GLfloat eye[3], GLfloat yaw, GLfloat aspect, GLfloat x, GLfloat y, GLint pulledBook){
+    GLfloat scale = tanf(LIBRARY_FIELD_OF_VIEW * M_PI/360), forward[3], right[3], direction[3];
+    GLfloat nearest = LIBRARY_FAR_PLANE;
+    GLint picked = -1;
+    cameraAxes(yaw, forward, right);
+    for(int k=0;k<3;k++)
+        direction[k] = forward[k] + x*scale*aspect*right[k] + (k == 1 ? y*scale : 0);
+    for(size_t c=0;c<bookcases.size();c++){
+        GLfloat min[3], max[3];
+        for(int k=0;k<3;k++){ /*!< Leave room for a pulled book in front of the bookcase */
+            min[k] = bookcases[c].min[k] - (k == 0 ? CASE_DEPTH : 0);
+            max[k] = bookcases[c].max[k] + (k == 0 ? CASE_DEPTH : 0);
+        }
+        if(rayBox(eye, direction, min, max) < 0)
+            continue;
+        for(int b=bookcases[c].first;b<bookcases[c].last;b++){
+            bookBounds(&books[b], b == pulledBook ? 0.6f * books[b].depth : 0, min, max);
+            GLfloat distance = rayBox(eye, direction, min, max);
+            if(distance >= 0 && distance < nearest){
+                nearest = distance;
+                picked = b;
+            }
+        }
+    }
+    return picked;
+}
+
+/*!
+    \fn Library::addBook(const ShelfBook *book, GLint detail, GLfloat pull)
+    \brief Add a book to the batch of its level of detail
+    pull -> distance the book sticks out of its shelf.
+    DETAIL_FULL -> page block between two covers and the spine.
+    DETAIL_BOX -> the faces of its box which can be seen from the hall.
+    DETAIL_IMPOSTOR -> the spine only.
+*/
+void Library::addBook(const ShelfBook *book, GLint detail, GLfloat pull){
+    GLfloat min[3], max[3];
+    GLint spineFace = book->side > 0 ? 0x02 : 0x01;
+    bookBounds(book, pull, min, max);
+    visible[detail]++;
+    if(detail == DETAIL_IMPOSTOR)
+        addBox(&batches[detail], min, max, book->color, spineFace);
+    else if(detail == DETAIL_BOX)
+        addBox(&batches[detail], min, max, book->color, spineFace | 0x08 | 0x10 | 0x20);
+    else{
+        GLfloat part[2][3];
+        for(int k=0;k<3;k++){
+            part[0][k] = min[k];
+            part[1][k] = max[k];
+        }
+        part[0][2] = max[2] - COVER; /*!< Front cover */
+        addBox(&batches[detail], part[0], part[1], book->color);
+        part[0][2] = min[2];
+        part[1][2] = min[2] + COVER; /*!< Back cover */
+        addBox(&batches[detail], part[0], part[1], book->color);
+        part[0][2] = min[2] + COVER;
+        part[1][2] = max[2] - COVER;
+        if(book->side > 0) /*!< Spine */
+            part[0][0] = max[0] - COVER;
+        else
+            part[1][0] = min[0] + COVER;
+        addBox(&batches[detail], part[0], part[1], book->color);
+        part[0][0] = min[0] + COVER; /*!< Page block, set back from the spine and the cover edges */
+        part[1][0] = max[0] - COVER;
+        part[0][1] = min[1] + COVER;
+        part[1][1] = max[1] - COVER;
+        addBox(&batches[detail], part[0], part[1], PAPER);
+    }
+}
+
+/*!
+    \fn Library::addBookcase(const Bookcase *bookcase)
+    \brief Add the back, side panels and shelves of a bookcase to the box batch
+*/
+void Library::addBookcase(const Bookcase *bookcase){
+    const GLfloat *min = bookcase->min, *max = bookcase->max;
+    GLfloat back = bookcase->side > 0 ? min[0] : max[0];
+    GLfloat panel[2][3] = {{min[0], min[1], min[2]}, {max[0], max[1], max[2]}};
+    panel[bookcase->side > 0 ? 1 : 0][0] = back + bookcase->side * SHELF_BOARD;
+    addBox(&batches[DETAIL_BOX], panel[0], panel[1], WOOD); /*!< Back */
+    panel[bookcase->side > 0 ? 1 : 0][0] = bookcase->side > 0 ? max[0] : min[0];
+    panel[0][2] = max[2] - SHELF_BOARD;
+    addBox(&batches[DETAIL_BOX], panel[0], panel[1], WOOD); /*!< Side panels */
+    panel[0][2] = min[2];
+    panel[1][2] = min[2] + SHELF_BOARD;
+    addBox(&batches[DETAIL_BOX], panel[0], panel[1], WOOD);
+    panel[1][2] = max[2];
+    for(int shelf=0;shelf<=LIBRARY_SHELVES;shelf++){
+        panel[0][1] = shelf * LIBRARY_SHELF_HEIGHT;
+        panel[1][1] = panel[0][1] + SHELF_BOARD;
+        addBox(&batches[DETAIL_BOX], panel[0], panel[1], WOOD, 0x3f & ~(bookcase->side > 0 ? 0x01 : 0x02));
+    }
+}
+
+/*!
+    \fn cameraAxes(GLfloat yaw, GLfloat forward[3], GLfloat right[3])
+    \brief Viewing direction and right hand side of a camera turned by yaw degrees from -z
+*/
+void cameraAxes(GLfloat yaw, GLfloat forward[3], GLfloat right[3]){
+    GLfloat angle = yaw * M_PI/180;
+    forward[0] = -sinf(angle); forward[1] = 0; forward[2] = -cosf(angle);
+    right[0] = cosf(angle); right[1] = 0; right[2] = -sinf(angle);
+}
+
+/*!
+    \fn bookBounds(const ShelfBook *book, GLfloat pull, GLfloat min[3], GLfloat max[3])
+    \brief Box around a book pulled out of its shelf by pull
+*/
+void bookBounds(const ShelfBook *book, GLfloat pull, GLfloat min[3], GLfloat max[3]){
+    GLfloat spine = book->x + book->side * pull;
+    min[0] = book->side > 0 ? spine - book->depth : spine;
+    max[0] = book->side > 0 ? spine : spine + book->depth;
+    min[1] = book->y;
+    max[1] = book->y + book->height;
+    min[2] = book->z - book->width;
+    max[2] = book->z;
+}
+
+/*!
+    \fn addBox(std::vector<GLfloat> *batch, const GLfloat min[3], const GLfloat max[3], const GLfloat color[3], GLint faces)
+    \brief Add the faces of a box to a batch of quads with normals and colors
+    faces -> bit i set adds the face facing -x, +x, -y, +y, -z, +z for i = 0 to 5.
+*/
+void addBox(std::vector<GLfloat> *batch, const GLfloat min[3], const GLfloat max[3], const GLfloat color[3], GLint faces){
+    for(int face=0;face<6;face++){
+        if((faces & (1 << face)) == 0)
+            continue;
+        GLint axis = face/2, u = (axis + 1)%3, v = (axis + 2)%3;
+        size_t size = batch->size();
+        batch->resize(size + 4*9);
+        GLfloat *vertex = batch->data() + size;
+        for(int i=0;i<4;i++, vertex+=9){
+            vertex[axis] = face % 2 ? max[axis] : min[axis];
+            vertex[u] = (i == 1 || i == 2) ? max[u] : min[u];
+            vertex[v] = i >= 2 ? max[v] : min[v];
+            vertex[3] = vertex[4] = vertex[5] = 0;
+            vertex[3 + axis] = face % 2 ? 1 : -1;
+            vertex[6] = color[0];
+            vertex[7] = color[1];
+            vertex[8] = color[2];
+        }
+    }
+}
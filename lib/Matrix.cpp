@@ -0,0 +1,292 @@
+/*!
+    /file Matrix.cpp
+    /brief 4x4 matrix and quaternion math for transforms computed on the CPU
+    The view and page transforms are built here and handed to GL as finished
+    matrices, instead of one fixed function matrix call at a time.
+*/
+
+#include "./headers/Matrix.h"
+#include <math.h>
+#include <string.h>
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define MATRIX_SSE 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MATRIX_NEON 1
+#endif
+
+/*!
+    \fn multiplyMatricesReference(GLfloat m[16], const GLfloat a[16], const GLfloat b[16])
+    \brief m = a * b one element at a time, the result the vectorized products are checked against
+*/
+void multiplyMatricesReference(GLfloat m[16], const GLfloat a[16], const GLfloat b[16]){
+    GLfloat result[16];
+    for(int column=0;column<4;column++)
+        for(int row=0;row<4;row++)
+            result[4*column + row] = a[row]*b[4*column] + a[4 + row]*b[4*column + 1]
+                + a[8 + row]*b[4*column + 2] + a[12 + row]*b[4*column + 3];
+    memcpy(m, result, sizeof(result));
+}
+
+/*!
+    \fn multiplyColumns(GLfloat *m, const GLfloat a[16], const GLfloat *b, GLint count)
+    \brief m[i] = a * b[i] for count matrices, the columns of a are loaded once
+    A column of the product is a sum of the columns of a weighted by a column
+    of b, so each one takes four vector multiplies and three adds. A column
+    of b is read before the same column of m is written.
+*/
+static void multiplyColumns(GLfloat *m, const GLfloat a[16], const GLfloat *b, GLint count){
+#if MATRIX_SSE
+    __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+    for(int i=0;i<4*count;i++, b+=4, m+=4){
+        __m128 column = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(b[0])), _mm_mul_ps(a1, _mm_set1_ps(b[1]))),
+            _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(b[2])), _mm_mul_ps(a3, _mm_set1_ps(b[3]))));
+        _mm_storeu_ps(m, column);
+    }
+#elif MATRIX_NEON
+    float32x4_t a0 = vld1q_f32(a), a1 = vld1q_f32(a + 4), a2 = vld1q_f32(a + 8), a3 = vld1q_f32(a + 12);
+    for(int i=0;i<4*count;i++, b+=4, m+=4){
+        float32x4_t column = vmulq_n_f32(a0, b[0]);
+        column = vmlaq_n_f32(column, a1, b[1]);
+        column = vmlaq_n_f32(column, a2, b[2]);
+        vst1q_f32(m, vmlaq_n_f32(column, a3, b[3]));
+    }
+#else
+    GLfloat columns[16];
+    memcpy(columns, a, sizeof(columns));
+    for(int i=0;i<count;i++)
+        multiplyMatricesReference(m + 16*i, columns, b + 16*i);
+#endif
+}
+
+/*!
+    \fn multiplyMatrices(GLfloat m[16], const GLfloat a[16], const GLfloat b[16])
+    \brief m = a * b
+*/
+void multiplyMatrices(GLfloat m[16], const GLfloat a[16], const GLfloat b[16]){
+    multiplyColumns(m, a, b, 1);
+}
+
+/*!
+    \fn multiplyMatrix(GLfloat m[16], const GLfloat by[16])
+    \brief m = m * by, as glMultMatrixf applies by to the current matrix
+*/
+void multiplyMatrix(GLfloat m[16], const GLfloat by[16]){
+    multiplyColumns(m, m, by, 1);
+}
+
+/*!
+    \fn multiplyMatrixBatch(GLfloat *m, const GLfloat a[16], const GLfloat *matrices, GLint count)
+    \brief m[i] = a * matrices[i] for count matrices stored one after the other
+    Places many objects under one camera or parent transform in a single pass.
+*/
+void multiplyMatrixBatch(GLfloat *m, const GLfloat a[16], const GLfloat *matrices, GLint count){
+    multiplyColumns(m, a, matrices, count);
+}
+
+/*!
+    \fn transformPoints(GLfloat *out, const GLfloat m[16], const GLfloat *points, GLint count)
+    \brief Transform count points stored x, y, z one after the other by m, w taken as 1
+*/
+void transformPoints(GLfloat *out, const GLfloat m[16], const GLfloat *points, GLint count){
+#if MATRIX_SSE
+    __m128 m0 = _mm_loadu_ps(m), m1 = _mm_loadu_ps(m + 4), m2 = _mm_loadu_ps(m + 8), m3 = _mm_loadu_ps(m + 12);
+    GLfloat point[4];
+    for(int i=0;i<count;i++, points+=3, out+=3){
+        __m128 p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, _mm_set1_ps(points[0])), _mm_mul_ps(m1, _mm_set1_ps(points[1]))),
+            _mm_add_ps(_mm_mul_ps(m2, _mm_set1_ps(points[2])), m3));
+        _mm_storeu_ps(point, p);
+        out[0] = point[0]; out[1] = point[1]; out[2] = point[2];
+    }
+#elif MATRIX_NEON
+    float32x4_t m0 = vld1q_f32(m), m1 = vld1q_f32(m + 4), m2 = vld1q_f32(m + 8), m3 = vld1q_f32(m + 12);
+    GLfloat point[4];
+    for(int i=0;i<count;i++, points+=3, out+=3){
+        float32x4_t p = vmlaq_n_f32(m3, m0, points[0]);
+        p = vmlaq_n_f32(p, m1, points[1]);
+        vst1q_f32(point, vmlaq_n_f32(p, m2, points[2]));
+        out[0] = point[0]; out[1] = point[1]; out[2] = point[2];
+    }
+#else
+    for(int i=0;i<count;i++, points+=3, out+=3){
+        GLfloat x = points[0], y = points[1], z = points[2];
+        for(int row=0;row<3;row++)
+            out[row] = m[row]*x + m[4 + row]*y + m[8 + row]*z + m[12 + row];
+    }
+#endif
+}
+
+/*!
+    \fn identityMatrix(GLfloat m[16])
+    \brief m = identity
+*/
+void identityMatrix(GLfloat m[16]){
+    for(int i=0;i<16;i++)
+        m[i] = i % 5 == 0;
+}
+
+/*!
+    \fn translateMatrix(GLfloat m[16], GLfloat x, GLfloat y, GLfloat z)
+    \brief m = m * translation, as glTranslatef
+    Only the last column changes, so no full product is needed.
+*/
+void translateMatrix(GLfloat m[16], GLfloat x, GLfloat y, GLfloat z){
+    for(int row=0;row<4;row++)
+        m[12 + row] += m[row]*x + m[4 + row]*y + m[8 + row]*z;
+}
+
+/*!
+    \fn scaleMatrix(GLfloat m[16], GLfloat x, GLfloat y, GLfloat z)
+    \brief m = m * scaling, as glScalef
+*/
+void scaleMatrix(GLfloat m[16], GLfloat x, GLfloat y, GLfloat z){
+    for(int row=0;row<4;row++){
+        m[row] *= x;
+        m[4 + row] *= y;
+        m[8 + row] *= z;
+    }
+}
+
+/*!
+    \fn rotateMatrix(GLfloat m[16], GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+    \brief m = m * rotation by angle degrees around x, y, z, as glRotatef
+*/
+void rotateMatrix(GLfloat m[16], GLfloat angle, GLfloat x, GLfloat y, GLfloat z){
+    GLfloat rotation[16];
+    rotationMatrix(rotation, angle, x, y, z);
+    multiplyMatrix(m, rotation);
+}
+
+/*!
+    \fn rotationMatrix(GLfloat m[16], GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+    \brief Matrix built by glRotatef, identity around a zero axis
+*/
+void rotationMatrix(GLfloat m[16], GLfloat angle, GLfloat x, GLfloat y, GLfloat z){
+    GLfloat q[4];
+    axisAngleQuaternion(q, angle, x, y, z);
+    quaternionMatrix(m, q);
+}
+
+/*!
+    \fn lookAtMatrix(GLfloat m[16], ...)
+    \brief Column major matrix built by gluLookAt
+*/
+void lookAtMatrix(GLfloat m[16], GLfloat eyeX, GLfloat eyeY, GLfloat eyeZ,
+        GLfloat centerX, GLfloat centerY, GLfloat centerZ, GLfloat upX, GLfloat upY, GLfloat upZ){
+    GLfloat f[] = {centerX - eyeX, centerY - eyeY, centerZ - eyeZ};
+    GLfloat length = sqrtf(f[0]*f[0] + f[1]*f[1] + f[2]*f[2]);
+    f[0] /= length; f[1] /= length; f[2] /= length;
+    GLfloat s[] = {f[1]*upZ - f[2]*upY, f[2]*upX - f[0]*upZ, f[0]*upY - f[1]*upX};
+    length = sqrtf(s[0]*s[0] + s[1]*s[1] + s[2]*s[2]);
+    s[0] /= length; s[1] /= length; s[2] /= length;
+    GLfloat u[] = {s[1]*f[2] - s[2]*f[1], s[2]*f[0] - s[0]*f[2], s[0]*f[1] - s[1]*f[0]};
+    GLfloat matrix[16] = {
+        s[0], u[0], -f[0], 0,
+        s[1], u[1], -f[1], 0,
+        s[2], u[2], -f[2], 0,
+        -(s[0]*eyeX + s[1]*eyeY + s[2]*eyeZ), -(u[0]*eyeX + u[1]*eyeY + u[2]*eyeZ), f[0]*eyeX + f[1]*eyeY + f[2]*eyeZ, 1
+    };
+    memcpy(m, matrix, sizeof(matrix));
+}
+
+/*!
+    \fn perspectiveMatrix(GLfloat m[16], GLfloat fovy, GLfloat aspect, GLfloat zNear, GLfloat zFar)
+    \brief Column major matrix built by gluPerspective
+*/
+void perspectiveMatrix(GLfloat m[16], GLfloat fovy, GLfloat aspect, GLfloat zNear, GLfloat zFar){
+    GLfloat f = 1/tanf(fovy * M_PI/360);
+    GLfloat matrix[16] = {
+        f/aspect, 0, 0, 0,
+        0, f, 0, 0,
+        0, 0, (zFar + zNear)/(zNear - zFar), -1,
+        0, 0, 2*zFar*zNear/(zNear - zFar), 0
+    };
+    memcpy(m, matrix, sizeof(matrix));
+}
+
+/*!
+    \fn orthoMatrix(GLfloat m[16], GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar)
+    \brief Column major matrix built by glOrtho
+*/
+void orthoMatrix(GLfloat m[16], GLfloat left, GLfloat right, GLfloat bottom, GLfloat top, GLfloat zNear, GLfloat zFar){
+    GLfloat matrix[16] = {
+        2/(right - left), 0, 0, 0,
+        0, 2/(top - bottom), 0, 0,
+        0, 0, -2/(zFar - zNear), 0,
+        -(right + left)/(right - left), -(top + bottom)/(top - bottom), -(zFar + zNear)/(zFar - zNear), 1
+    };
+    memcpy(m, matrix, sizeof(matrix));
+}
+
+/*!
+    \fn axisAngleQuaternion(GLfloat q[4], GLfloat angle, GLfloat x, GLfloat y, GLfloat z)
+    \brief Unit quaternion rotating by angle degrees around x, y, z, no rotation around a zero axis
+*/
+void axisAngleQuaternion(GLfloat q[4], GLfloat angle, GLfloat x, GLfloat y, GLfloat z){
+    GLfloat length = sqrtf(x*x + y*y + z*z);
+    if(length == 0){
+        q[0] = q[1] = q[2] = 0;
+        q[3] = 1;
+        return;
+    }
+    GLfloat s = sinf(angle * M_PI/360) / length;
+    q[0] = x*s; q[1] = y*s; q[2] = z*s;
+    q[3] = cosf(angle * M_PI/360);
+}
+
+/*!
+    \fn multiplyQuaternions(GLfloat q[4], const GLfloat a[4], const GLfloat b[4])
+    \brief q = a * b, the rotation b followed by the rotation a
+*/
+void multiplyQuaternions(GLfloat q[4], const GLfloat a[4], const GLfloat b[4]){
+    GLfloat result[4] = {
+        a[3]*b[0] + a[0]*b[3] + a[1]*b[2] - a[2]*b[1],
+        a[3]*b[1] - a[0]*b[2] + a[1]*b[3] + a[2]*b[0],
+        a[3]*b[2] + a[0]*b[1] - a[1]*b[0] + a[2]*b[3],
+        a[3]*b[3] - a[0]*b[0] - a[1]*b[1] - a[2]*b[2]
+    };
+    memcpy(q, result, sizeof(result));
+}
+
+/*!
+    \fn slerpQuaternions(GLfloat q[4], const GLfloat a[4], const GLfloat b[4], GLfloat t)
+    \brief Rotation t of the way from a to b along the shorter arc, both unit quaternions
+    Nearly equal rotations are interpolated linearly, where the arc is too short to divide by.
+*/
+void slerpQuaternions(GLfloat q[4], const GLfloat a[4], const GLfloat b[4], GLfloat t){
+    GLfloat cosine = a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3], sign = 1;
+    if(cosine < 0){
+        cosine = -cosine;
+        sign = -1;
+    }
+    GLfloat wa = 1 - t, wb = t;
+    if(cosine < 0.9995f){
+        GLfloat angle = acosf(cosine), s = sinf(angle);
+        wa = sinf((1 - t)*angle) / s;
+        wb = sinf(t*angle) / s;
+    }
+    GLfloat result[4], length = 0;
+    for(int i=0;i<4;i++){
+        result[i] = wa*a[i] + sign*wb*b[i];
+        length += result[i]*result[i];
+    }
+    length = sqrtf(length);
+    for(int i=0;i<4;i++)
+        q[i] = result[i] / length;
+}
+
+/*!
+    \fn quaternionMatrix(GLfloat m[16], const GLfloat q[4])
+    \brief Rotation matrix of the unit quaternion q
+*/
+void quaternionMatrix(GLfloat m[16], const GLfloat q[4]){
+    GLfloat x = q[0], y = q[1], z = q[2], w = q[3];
+    GLfloat matrix[16] = {
+        1 - 2*(y*y + z*z), 2*(x*y + z*w), 2*(x*z - y*w), 0,
+        2*(x*y - z*w), 1 - 2*(x*x + z*z), 2*(y*z + x*w), 0,
+        2*(x*z + y*w), 2*(y*z - x*w), 1 - 2*(x*x + y*y), 0,
+        0, 0, 0, 1
+    };
+    memcpy(m, matrix, sizeof(matrix));
+}
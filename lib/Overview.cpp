@@ -0,0 +1,349 @@
+/*!
+    /file Overview.cpp
+    /brief Thumbnail grid of every page of a book, rendered lazily into an atlas
+*/
+
+#include "./headers/Overview.h"
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+
+static const GLfloat BACKGROUND[3] = {0.16f, 0.16f, 0.18f};
+static const GLfloat PADDING = 0.08f; /*!< Space around a thumbnail, in cell widths */
+static const GLint THUMBNAIL_SIZE = OVERVIEW_SLOT_SIZE - 2*OVERVIEW_GUTTER; /*!< Texels of a thumbnail, the gutter keeps the mipmap levels of neighbours apart */
+static const GLint SLOTS_ACROSS = OVERVIEW_ATLAS_SIZE / OVERVIEW_SLOT_SIZE;
+
+/*!
+    \fn Overview::Overview()
+    \brief Constructor, the atlas is created on the first update
+*/
+Overview::Overview(){
+    texture = 0;
+    scroll = targetScroll = 0;
+    frame = 0;
+    thumbnailsRendered = thumbnailsEvicted = 0;
+}
+
+/*!
+    \fn Overview::clear()
+    \brief Forget every thumbnail and scroll back to the top, for another book opened
+    The slots keep their place in the atlas, they are rendered again when needed.
+*/
+void Overview::clear(){
+    for(size_t i=0;i<slots.size();i++)
+        slots[i].pageIndex = -1;
+    slotOfPage.assign(slotOfPage.size(), -1);
+    scroll = targetScroll = 0;
+}
+
+/*!
+    \fn Overview::cellWidth(GLint windowWidth)
+    \brief Width of a column of the grid in pixels
+*/
+GLfloat Overview::cellWidth(GLint windowWidth){
+    return (GLfloat)windowWidth / OVERVIEW_COLUMNS;
+}
+
+/*!
+    \fn Overview::rowHeight(GLint windowWidth)
+    \brief Height of a row of the grid in pixels, the page number goes below the thumbnail
+*/
+GLfloat Overview::rowHeight(GLint windowWidth){
+    return cellWidth(windowWidth) * (1 + PADDING);
+}
+
+/*!
+    \fn Overview::maxScroll(GLint noOfPages, GLint windowWidth, GLint windowHeight)
+    \brief Rows that can be scrolled past until the last row reaches the bottom of the window
+*/
+GLfloat Overview::maxScroll(GLint noOfPages, GLint windowWidth, GLint windowHeight){
+    GLint rows = (noOfPages + OVERVIEW_COLUMNS - 1) / OVERVIEW_COLUMNS;
+    return fmaxf(0, rows - windowHeight / rowHeight(windowWidth));
+}
+
+/*!
+    \fn Overview::scrollBy(GLfloat rows, GLint noOfPages, GLint windowWidth, GLint windowHeight)
+    \brief Scroll by rows, the grid eases there on the following steps
+*/
+void Overview::scrollBy(GLfloat rows, GLint noOfPages, GLint windowWidth, GLint windowHeight){
+    targetScroll = fminf(maxScroll(noOfPages, windowWidth, windowHeight), fmaxf(0, targetScroll + rows));
+}
+
+/*!
+    \fn Overview::scrollTo(GLint pageIndex, GLint noOfPages, GLint windowWidth, GLint windowHeight)
+    \brief Jump to the row of a page, placed in the middle of the window
+*/
+void Overview::scrollTo(GLint pageIndex, GLint noOfPages, GLint windowWidth, GLint windowHeight){
+    targetScroll = 0;
+    scrollBy(pageIndex / OVERVIEW_COLUMNS + 0.5f - windowHeight / rowHeight(windowWidth) / 2, noOfPages, windowWidth, windowHeight);
+    scroll = targetScroll;
+}
+
+/*!
+    \fn Overview::step()
+    \brief Move scroll part of the way to targetScroll, called every animation step
+*/
+void Overview::step(){
+    scroll += (targetScroll - scroll) * OVERVIEW_SCROLL_RESPONSE;
+    if(fabsf(targetScroll - scroll) < 0.01f)
+        scroll = targetScroll;
+}
+
+/*!
+    \fn Overview::createTexture()
+    \brief Create the atlas with its mipmap levels and the slots it is divided into
+    Every level starts filled with the background, so the gutters blend into it.
+*/
+void Overview::createTexture(){
+    std::vector<unsigned char> fill(OVERVIEW_ATLAS_SIZE * OVERVIEW_ATLAS_SIZE * 3);
+    for(size_t i=0;i<fill.size();i++)
+        fill[i] = (unsigned char)(BACKGROUND[i % 3] * 255);
+    glGenTextures(1, &texture);
+    fbBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for(int level=0;level<OVERVIEW_MIPMAP_LEVELS;level++)
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGB, OVERVIEW_ATLAS_SIZE >> level, OVERVIEW_ATLAS_SIZE >> level, 0,
+            GL_RGB, GL_UNSIGNED_BYTE, fill.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, OVERVIEW_MIPMAP_LEVELS - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    ThumbnailSlot free = {-1, 0, 0, 0, 0, 0};
+    slots.assign(SLOTS_ACROSS * SLOTS_ACROSS, free);
+    for(int level=0;level<OVERVIEW_MIPMAP_LEVELS;level++)
+        levels[level].resize((THUMBNAIL_SIZE >> level) * (THUMBNAIL_SIZE >> level) * 3);
+    missing.reserve(OVERVIEW_RENDERS_PER_FRAME);
+}
+
+/*!
+    \fn Overview::slotCurrent(GLint slot, const Page *page)
+    \brief Whether slot holds the thumbnail of the current content of page
+*/
+GLint Overview::slotCurrent(GLint slot, const Page *page){
+    const ThumbnailSlot *s = &slots[slot];
+    return s->type == page->type && s->textVersion == page->textVersion
+        && s->drawingVersion == page->drawingVersion && s->highlightVersion == page->highlightVersion;
+}
+
+/*!
+    \fn Overview::takeSlot(GLint pageIndex)
+    \brief Slot to render the thumbnail of a page into
+    The slot the page already has, else a free one, else the one used longest ago.
+*/
+GLint Overview::takeSlot(GLint pageIndex){
+    if(slotOfPage[pageIndex] >= 0)
+        return slotOfPage[pageIndex];
+    GLint oldest = 0;
+    for(size_t i=0;i<slots.size() && slots[oldest].pageIndex >= 0;i++)
+        if(slots[i].pageIndex < 0 || slots[i].lastUsed < slots[oldest].lastUsed)
+            oldest = i;
+    if(slots[oldest].pageIndex >= 0){
+        slotOfPage[slots[oldest].pageIndex] = -1;
+        thumbnailsEvicted++;
+    }
+    slots[oldest].pageIndex = pageIndex;
+    slotOfPage[pageIndex] = oldest;
+    return oldest;
+}
+
+/*!
+    \fn Overview::update(Book *book, GLfloat scroll, GLint windowWidth, GLint windowHeight)
+    \brief Render the missing thumbnails of the rows around the window, must be called on the GL thread
+    Rows on screen go first, then the margin rows around them, so thumbnails are
+    usually ready before they are scrolled into view.
+*/
+void Overview::update(Book *book, GLfloat scroll, GLint windowWidth, GLint windowHeight){
+    frame++;
+    if(texture == 0)
+        createTexture();
+    if((GLint)slotOfPage.size() < book->noOfPages)
+        slotOfPage.resize(book->noOfPages, -1);
+    GLint firstRow = floorf(scroll), lastRow = floorf(scroll + windowHeight / rowHeight(windowWidth));
+    missing.clear();
+    for(int margin=0;margin<=OVERVIEW_MARGIN_ROWS;margin++)
+        for(int side=0;side<(margin == 0 ? 1 : 2);side++){
+            GLint first = margin == 0 ? firstRow : (side == 0 ? lastRow + margin : firstRow - margin);
+            GLint last = margin == 0 ? lastRow : first;
+            for(GLint page=first*OVERVIEW_COLUMNS;page<(last + 1)*OVERVIEW_COLUMNS;page++){
+                if(page < 0 || page >= book->noOfPages)
+                    continue;
+                GLint slot = slotOfPage[page];
+                if(slot >= 0)
+                    slots[slot].lastUsed = frame;
+                if((slot < 0 || !slotCurrent(slot, book->pages[page])) && missing.size() < OVERVIEW_RENDERS_PER_FRAME)
+                    missing.push_back(page);
+            }
+        }
+    renderThumbnails(book, windowWidth, windowHeight);
+}
+
+/*!
+    \fn Overview::renderThumbnails(Book *book, GLint windowWidth, GLint windowHeight)
+    \brief Render the missing pages side by side into the frame buffer, read them back and upload them
+    The pages are drawn directly, not from their recordings, so a book of
+    thousands of pages does not keep a recording of each. The whole batch is
+    read back at once, the frame drawn afterwards clears the frame buffer.
+*/
+void Overview::renderThumbnails(Book *book, GLint windowWidth, GLint windowHeight){
+    GLint across = windowWidth / THUMBNAIL_SIZE, down = windowHeight / THUMBNAIL_SIZE;
+    GLint count = missing.size() < (size_t)(across * down) ? missing.size() : across * down;
+    if(count == 0)
+        return;
+    GLint backend = glBackend;
+    GLRecorder *recorder = glRecorder;
+    setGLBackend(BACKEND_IMMEDIATE);
+    fbDisable(GL_LIGHTING);
+    fbDisable(GL_TEXTURE_2D);
+    fbEnable(GL_DEPTH_TEST);
+    fbClearColor(BACKGROUND[0], BACKGROUND[1], BACKGROUND[2], 1);
+    for(int i=0;i<count;i++)
+        book->pages[missing[i]]->renderImage(i % across * THUMBNAIL_SIZE, i / across * THUMBNAIL_SIZE, THUMBNAIL_SIZE);
+    fbClearColor(0, 0, 0, 1);
+    GLint rowWidth = across * THUMBNAIL_SIZE, rows = (count + across - 1) / across;
+    if(pixels.size() < (size_t)(rowWidth * rows * THUMBNAIL_SIZE * 3))
+        pixels.resize(rowWidth * rows * THUMBNAIL_SIZE * 3);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, rowWidth, rows * THUMBNAIL_SIZE, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    for(int i=0;i<count;i++){
+        GLint x = i % across * THUMBNAIL_SIZE, y = i / across * THUMBNAIL_SIZE;
+        uploadThumbnail(takeSlot(missing[i]), book->pages[missing[i]], &pixels[(y * rowWidth + x) * 3], rowWidth);
+    }
+    thumbnailsRendered += count;
+    setGLBackend(backend, recorder);
+}
+
+/*!
+    \fn Overview::uploadThumbnail(GLint slot, const Page *page, const unsigned char *rgb, GLint rowWidth)
+    \brief Store a thumbnail read back with rowWidth pixels per row and its mipmap levels in slot
+    Each level is the average of 2x2 texels of the one above, the gutter keeps
+    the levels of neighbouring slots apart.
+*/
+void Overview::uploadThumbnail(GLint slot, const Page *page, const unsigned char *rgb, GLint rowWidth){
+    for(int y=0;y<THUMBNAIL_SIZE;y++)
+        memcpy(&levels[0][y * THUMBNAIL_SIZE * 3], &rgb[y * rowWidth * 3], THUMBNAIL_SIZE * 3);
+    for(int level=1;level<OVERVIEW_MIPMAP_LEVELS;level++){
+        GLint size = THUMBNAIL_SIZE >> level, source = size * 2;
+        const unsigned char *s = levels[level - 1].data();
+        for(int y=0;y<size;y++)
+            for(int x=0;x<size;x++)
+                for(int c=0;c<3;c++)
+                    levels[level][(y*size + x)*3 + c] = (s[((2*y)*source + 2*x)*3 + c] + s[((2*y)*source + 2*x + 1)*3 + c]
+                        + s[((2*y + 1)*source + 2*x)*3 + c] + s[((2*y + 1)*source + 2*x + 1)*3 + c] + 2) / 4;
+    }
+    GLint x = slot % SLOTS_ACROSS * OVERVIEW_SLOT_SIZE + OVERVIEW_GUTTER, y = slot / SLOTS_ACROSS * OVERVIEW_SLOT_SIZE + OVERVIEW_GUTTER;
+    fbBindTexture(GL_TEXTURE_2D, texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for(int level=0;level<OVERVIEW_MIPMAP_LEVELS;level++)
+        glTexSubImage2D(GL_TEXTURE_2D, level, x >> level, y >> level, THUMBNAIL_SIZE >> level, THUMBNAIL_SIZE >> level,
+            GL_RGB, GL_UNSIGNED_BYTE, levels[level].data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    ThumbnailSlot *s = &slots[slot];
+    s->type = page->type;
+    s->textVersion = page->textVersion;
+    s->drawingVersion = page->drawingVersion;
+    s->highlightVersion = page->highlightVersion;
+    s->lastUsed = frame;
+}
+
+/*!
+    \fn Overview::render(GLint noOfPages, GLfloat scroll, GLint windowWidth, GLint windowHeight)
+    \brief Draw the rows on screen, scrolled by scroll rows
+    Thumbnails come from the atlas with a single bind, pages whose thumbnail
+    is not rendered yet are drawn as a blank page. A bar on the right shows
+    the part of the book on screen.
+*/
+void Overview::render(GLint noOfPages, GLfloat scroll, GLint windowWidth, GLint windowHeight){
+    GLfloat cell = cellWidth(windowWidth), row = rowHeight(windowWidth), pad = cell * PADDING, size = cell - 2*pad;
+    GLint firstRow = floorf(scroll), lastRow = floorf(scroll + windowHeight / row);
+    GLint firstPage = firstRow * OVERVIEW_COLUMNS, lastPage = (lastRow + 1) * OVERVIEW_COLUMNS;
+    firstPage = firstPage < 0 ? 0 : firstPage;
+    lastPage = lastPage > noOfPages ? noOfPages : lastPage;
+    fbViewport(0, 0, windowWidth, windowHeight);
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadIdentity();
+    fbOrtho(0, windowWidth, 0, windowHeight, -1, 1);
+    fbMatrixMode(GL_MODELVIEW);
+    fbLoadIdentity();
+    fbClearColor(BACKGROUND[0], BACKGROUND[1], BACKGROUND[2], 1);
+    fbClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    fbClearColor(0, 0, 0, 1);
+    fbDisable(GL_DEPTH_TEST);
+    fbDisable(GL_LIGHTING);
+    fbEnable(GL_TEXTURE_2D);
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    fbBindTexture(GL_TEXTURE_2D, texture);
+    fbBegin(GL_QUADS);
+    for(GLint page=firstPage;page<lastPage;page++){
+        GLint slot = page < (GLint)slotOfPage.size() ? slotOfPage[page] : -1;
+        if(slot < 0)
+            continue;
+        GLfloat x = page % OVERVIEW_COLUMNS * cell + pad, y = windowHeight - (page / OVERVIEW_COLUMNS - scroll) * row - pad - size;
+        GLfloat u = (GLfloat)(slot % SLOTS_ACROSS * OVERVIEW_SLOT_SIZE + OVERVIEW_GUTTER) / OVERVIEW_ATLAS_SIZE;
+        GLfloat v = (GLfloat)(slot / SLOTS_ACROSS * OVERVIEW_SLOT_SIZE + OVERVIEW_GUTTER) / OVERVIEW_ATLAS_SIZE;
+        GLfloat extent = (GLfloat)THUMBNAIL_SIZE / OVERVIEW_ATLAS_SIZE;
+        fbTexCoord2f(u, v); fbVertex2f(x, y);
+        fbTexCoord2f(u + extent, v); fbVertex2f(x + size, y);
+        fbTexCoord2f(u + extent, v + extent); fbVertex2f(x + size, y + size);
+        fbTexCoord2f(u, v + extent); fbVertex2f(x, y + size);
+    }
+    fbEnd();
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    fbDisable(GL_TEXTURE_2D);
+    fbColor3f(0.85, 0.85, 0.82);
+    fbBegin(GL_QUADS);
+    for(GLint page=firstPage;page<lastPage;page++){
+        if(page < (GLint)slotOfPage.size() && slotOfPage[page] >= 0)
+            continue;
+        GLfloat x = page % OVERVIEW_COLUMNS * cell + pad, y = windowHeight - (page / OVERVIEW_COLUMNS - scroll) * row - pad - size;
+        fbVertex2f(x, y);
+        fbVertex2f(x + size, y);
+        fbVertex2f(x + size, y + size);
+        fbVertex2f(x, y + size);
+    }
+    fbEnd();
+    /*! Page numbers below the thumbnails */
+    fbColor3f(0.8, 0.8, 0.8);
+    for(GLint page=firstPage;page<lastPage;page++){
+        char label[12];
+        snprintf(label, sizeof(label), "%d", page + 1);
+        fbPushMatrix();
+            fbTranslatef(page % OVERVIEW_COLUMNS * cell + pad, windowHeight - (page / OVERVIEW_COLUMNS + 1 - scroll) * row + pad * 0.4f, 0);
+            fbScalef(pad * 0.006f, pad * 0.006f, 1);
+            for(int i=0;label[i]!='\0';i++)
+                fbStrokeCharacter(label[i]);
+        fbPopMatrix();
+    }
+    /*! Scroll bar */
+    GLfloat rows = (noOfPages + OVERVIEW_COLUMNS - 1) / OVERVIEW_COLUMNS, shown = windowHeight / row;
+    if(rows > shown){
+        GLfloat top = windowHeight * (1 - scroll / rows), height = fmaxf(4, windowHeight * shown / rows);
+        fbColor3f(0.55, 0.55, 0.6);
+        fbBegin(GL_QUADS);
+            fbVertex2f(windowWidth - 6, top - height);
+            fbVertex2f(windowWidth - 2, top - height);
+            fbVertex2f(windowWidth - 2, top);
+            fbVertex2f(windowWidth - 6, top);
+        fbEnd();
+    }
+    fbColor3f(1, 1, 1);
+    fbEnable(GL_DEPTH_TEST);
+}
+
+/*!
+    \fn Overview::pick(GLint noOfPages, GLfloat scroll, GLint x, GLint y, GLint windowWidth, GLint windowHeight)
+    \brief Page whose thumbnail is under window coordinates x, y from the top left, -1 for none
+*/
+GLint Overview::pick(GLint noOfPages, GLfloat scroll, GLint x, GLint y, GLint windowWidth, GLint windowHeight){
+    GLfloat cell = cellWidth(windowWidth), row = rowHeight(windowWidth), pad = cell * PADDING;
+    GLfloat rowPosition = scroll + y / row;
+    GLint column = x / cell, rowIndex = floorf(rowPosition);
+    GLfloat inCellX = x - column * cell, inCellY = (rowPosition - rowIndex) * row;
+    if(column < 0 || column >= OVERVIEW_COLUMNS || rowIndex < 0 || inCellX < pad || inCellX > cell - pad
+        || inCellY < pad || inCellY > cell - pad)
+        return -1;
+    GLint page = rowIndex * OVERVIEW_COLUMNS + column;
+    return page < noOfPages ? page : -1;
+}
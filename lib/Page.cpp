@@ -1,4 +1,11 @@
 #include "./headers/Page.h"
+#include <math.h>
+
+static const GLfloat TEXT_BUFFER = 5; /*!< Gap before the first character and above the baseline */
+/*! Largest error in page units of every detail level, compared against the pixel error once projected */
+static const GLfloat DETAIL_ERROR[PAGE_DETAIL_LEVELS] = {
+    0, PAGE_GLYPH_TOLERANCE * LINE_HEIGHT/130.0f, LINE_HEIGHT/2.0f, LINE_HEIGHT
+};
 
 /*!
     \fn Page::Page(GLint type, GLfloat x, GLfloat y, GLfloat z, char text[])
@@ -43,67 +50,423 @@ void Page::init(GLint type, GLfloat x, GLfloat y, GLfloat z){
     this->marginHeight = MARGIN_HEIGHT;
     this->lineHeight = LINE_HEIGHT;
     this->pageContent = NULL;
+    this->animation = NULL;
+    this->vector = NULL;
     this->text = NULL;
+    this->tinted = 0;
+    this->textVersion = 0;
+    this->drawingVersion = 0;
+    this->highlightVersion = 0;
+}
+
+/*!
+    \fn Page::setText(const char *text)
+    \brief Replace the content by text, turning the Page into a text page
+    The Page keeps its own copy of the text.
+*/
+void Page::setText(const char *text){
+    editedText = text;
+    this->text = &editedText[0];
+    type = PAGE_TYPE_TEXT;
+    textVersion++;
+    contentChanged();
 }
 
 /*!
-    \fn Page::renderPage()
+    \fn Page::setDrawing(void (*pageContent)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat))
+    \brief Replace the content by a drawing, turning the Page into a drawing page
+*/
+void Page::setDrawing(void (*pageContent)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat)){
+    this->pageContent = pageContent;
+    type = PAGE_TYPE_DRAWING;
+    drawingVersion++;
+    contentChanged();
+}
+
+/*!
+    \fn Page::setAnimation(PageAnimation *animation)
+    \brief Replace the content by the frames of animation, turning the Page into an animated page
+    The frame shown is not part of the recordings, it is drawn over them every time the Page is drawn.
+*/
+void Page::setAnimation(PageAnimation *animation){
+    this->animation = animation;
+    type = PAGE_TYPE_ANIMATION;
+    drawingVersion++;
+    contentChanged();
+}
+
+/*!
+    \fn Page::setVector(VectorDrawing *vector)
+    \brief Replace the content by a vector drawing, turning the Page into a vector drawing page
+    The Page owns the drawing, the one it had before is deleted.
+*/
+void Page::setVector(VectorDrawing *vector){
+    if(this->vector != vector)
+        delete this->vector;
+    this->vector = vector;
+    type = PAGE_TYPE_VECTOR;
+    drawingVersion++;
+    contentChanged();
+}
+
+/*!
+    \fn Page::setHighlights(const std::vector<SearchSpan> *spans)
+    \brief Highlight spans of the text, none when spans is NULL
+    The spans are taken as found by SearchIndex::search for the current text.
+*/
+void Page::setHighlights(const std::vector<SearchSpan> *spans){
+    if(spans == NULL && highlights.empty())
+        return;
+    if(spans == NULL)
+        highlights.clear();
+    else
+        highlights = *spans;
+    highlightVersion++;
+}
+
+/*!
+    \fn Page::contentChanged()
+    \brief Drop what was derived from the content of this Page only
+    The recordings are keyed by the content versions and are recorded again
+    when next drawn, the tint is computed again when next needed.
+    Highlights found in the previous content are dropped.
+*/
+void Page::contentChanged(){
+    tinted = 0;
+    setHighlights(NULL);
+}
+
+/*!
+    \fn Page::renderPage(GLint detail)
     \brief Renders the specified Page
     Renders the Page onto the screen after setting the border, margin.
     text pages -> sets lines for the page and render the specified text.
     drawing pages -> calls the user defined function to draw inside the Page.
+    animated pages -> only the border and margin, see renderAnimation for the frame.
+    vector drawing pages -> draws the tessellated drawing fitted inside the Page.
+    detail -> PAGE_DETAIL_GREEKED leaves out the margin and page lines and draws
+    a bar per line of text, PAGE_DETAIL_FLAT draws the page as a tinted quad.
 */
-void Page::renderPage(){
-    glColor3f(0.0,0.0,0.0);
+void Page::renderPage(GLint detail){
+    fbColor3f(0.0,0.0,0.0);
+    if(detail == PAGE_DETAIL_FLAT){
+        renderFlat();
+        return;
+    }
     setBorder();
-    setMargin();
+    if(detail != PAGE_DETAIL_GREEKED)
+        setMargin();
     if(type == PAGE_TYPE_TEXT && text != NULL){
-        setPageLines();
-        renderText();
+        if(detail == PAGE_DETAIL_GREEKED)
+            renderGreekedText();
+        else{
+            setPageLines();
+            if(!highlights.empty())
+                renderHighlights();
+            renderText(detail);
+        }
     }
     else if(type == PAGE_TYPE_DRAWING && pageContent != NULL)
         pageContent(x + marginWidth, y, z, x + width, y + height - marginHeight);
+    else if(type == PAGE_TYPE_VECTOR && vector != NULL)
+        vector->draw(x + marginWidth, y, z, x + width, y + height - marginHeight);
+}
+
+/*!
+    \fn Page::placeGlyph(char ch, GLfloat *sum, GLint *lines, GLfloat position[2])
+    \brief Place the next character of the text and return its width
+    sum -> width of the current line so far, lines -> lines started so far.
+    position -> receives where the character is drawn.
+    On a newline entry or a full line the character starts the next line.
+*/
+GLfloat Page::placeGlyph(char ch, GLfloat *sum, GLint *lines, GLfloat position[2]){
+    GLfloat ratio = LINE_HEIGHT/130.0;
+    int characterWidth = fbStrokeWidth(ch) * ratio;
+    if((*sum + characterWidth > PAGE_WIDTH - MARGIN_WIDTH) || ch == '\n'){
+        (*lines)++;
+        *sum = characterWidth;
+        position[0] = BOOK_BORDER_SIZE + MARGIN_WIDTH;
+    }
+    else{
+        position[0] = BOOK_BORDER_SIZE + MARGIN_WIDTH + *sum;
+        *sum += characterWidth;
+    }
+    position[1] = BOOK_BORDER_SIZE + PAGE_HEIGHT - MARGIN_HEIGHT - (*lines + 1) * LINE_HEIGHT + TEXT_BUFFER;
+    return characterWidth;
 }
 
 /*!
-    \fn Page::renderText()
+    \fn Page::renderText(GLint detail)
     \brief Renders the specified text on the Page.
     Renders the text onto the page after calculating the offset value required 
     for placing the character.
     On a newline entry goto the next line and so on.
+    PAGE_DETAIL_SIMPLE draws the characters with simplified strokes.
 */
-void Page::renderText(){
-    char ch;
-    int i=0, lines=0, characterHeight = 130, characterWidth, len=strlen(text);
-    int bufferWidth = 5, bufferHeight = 5;
-    GLfloat ratio = LINE_HEIGHT/130.0, sum = bufferWidth;
-    for(i=0;i<len;i++){
-        glPushMatrix();
-            ch = text[i];
-            characterWidth = glutStrokeWidth(GLUT_STROKE_ROMAN, ch);
-            characterHeight = characterHeight * ratio;
-            characterWidth = characterWidth * ratio;
-            /*! Goto the next line for placing the character */
-            if((sum + characterWidth > PAGE_WIDTH - MARGIN_WIDTH) || ch == '\n'){
-                lines++;
-                sum = characterWidth;
-                glTranslatef(BOOK_BORDER_SIZE + MARGIN_WIDTH, 
-                    BOOK_BORDER_SIZE + PAGE_HEIGHT - MARGIN_HEIGHT - (lines + 1) * LINE_HEIGHT + bufferWidth,
-                    z);
-            }
-            /*! Place the character in the current line */
-            else{
-                glTranslatef(BOOK_BORDER_SIZE + MARGIN_WIDTH + sum, 
-                    BOOK_BORDER_SIZE + PAGE_HEIGHT - MARGIN_HEIGHT - (lines + 1) * LINE_HEIGHT + bufferWidth,
-                    z);
-                    sum += characterWidth;
+void Page::renderText(GLint detail){
+    GLint lines = 0, len = strlen(text);
+    GLfloat ratio = LINE_HEIGHT/130.0, sum = TEXT_BUFFER, position[2];
+    for(int i=0;i<len;i++){
+        fbPushMatrix();
+            placeGlyph(text[i], &sum, &lines, position);
+            fbTranslatef(position[0], position[1], z);
+            fbScalef(ratio, ratio, 1);
+            if(detail == PAGE_DETAIL_SIMPLE)
+                fbStrokeCharacterSimplified(text[i]);
+            else
+                fbStrokeCharacter(text[i]); /*!< Place the character */
+            fbFlush();
+        fbPopMatrix();
+    }
+}
+
+/*!
+    \fn Page::renderGreekedText()
+    \brief Render a grey bar in place of every line of text
+    A bar runs from the first to the last character of its line, spaces excluded.
+*/
+void Page::renderGreekedText(){
+    GLint lines = 0, barLine = -1, len = strlen(text);
+    GLfloat sum = TEXT_BUFFER, position[2], bar[3] = {0, 0, 0};
+    fbColor3f(0.45, 0.45, 0.45);
+    fbBegin(GL_QUADS);
+    for(int i=0;i<=len;i++){
+        GLfloat characterWidth = i < len ? placeGlyph(text[i], &sum, &lines, position) : 0;
+        if(barLine >= 0 && (i == len || lines != barLine)){
+            fbVertex3f(bar[0], bar[2], z);
+            fbVertex3f(bar[1], bar[2], z);
+            fbVertex3f(bar[1], bar[2] + LINE_HEIGHT/2, z);
+            fbVertex3f(bar[0], bar[2] + LINE_HEIGHT/2, z);
+            barLine = -1;
+        }
+        if(i == len || text[i] == ' ' || text[i] == '\n' || characterWidth == 0)
+            continue;
+        if(barLine < 0){
+            barLine = lines;
+            bar[0] = position[0];
+            bar[2] = position[1];
+        }
+        bar[1] = position[0] + characterWidth;
+    }
+    fbEnd();
+    fbColor3f(0.0, 0.0, 0.0);
+}
+
+/*!
+    \fn Page::renderHighlights()
+    \brief Render a marker behind every character of the highlighted spans
+    The markers lie between the page and its text and fill the line height.
+*/
+void Page::renderHighlights(){
+    GLint lines = 0, len = strlen(text);
+    GLfloat sum = TEXT_BUFFER, position[2];
+    size_t span = 0;
+    fbColor3f(1.0, 0.88, 0.35);
+    fbBegin(GL_QUADS);
+    for(int i=0;i<len && span<highlights.size();i++){
+        GLfloat characterWidth = placeGlyph(text[i], &sum, &lines, position);
+        while(span < highlights.size() && i >= highlights[span].start + highlights[span].length)
+            span++;
+        if(span == highlights.size() || i < highlights[span].start || text[i] == '\n')
+            continue;
+        GLfloat bottom = position[1] - TEXT_BUFFER;
+        fbVertex3f(position[0], bottom, z - PAGE_THICKNESS/2.0f);
+        fbVertex3f(position[0] + characterWidth, bottom, z - PAGE_THICKNESS/2.0f);
+        fbVertex3f(position[0] + characterWidth, bottom + LINE_HEIGHT, z - PAGE_THICKNESS/2.0f);
+        fbVertex3f(position[0], bottom + LINE_HEIGHT, z - PAGE_THICKNESS/2.0f);
+    }
+    fbEnd();
+    fbColor3f(0.0, 0.0, 0.0);
+}
+
+/*!
+    \fn Page::renderFlat()
+    \brief Render the Page as a single quad of its average color
+*/
+void Page::renderFlat(){
+    if(!tinted)
+        computeTint();
+    fbColor3f(tint[0], tint[1], tint[2]);
+    fbBegin(GL_POLYGON);
+        fbVertex3f(x, y, z-PAGE_THICKNESS);
+        fbVertex3f(x + width, y, z-PAGE_THICKNESS);
+        fbVertex3f(x + width, y + height, z-PAGE_THICKNESS);
+        fbVertex3f(x, y + height, z-PAGE_THICKNESS);
+    fbEnd();
+    fbColor3f(0.0, 0.0, 0.0);
+}
+
+/*!
+    \fn Page::renderRecorded(GLint detail)
+    \brief Render the Page at a detail level, replayed from its recording while the Page is unchanged
+*/
+void Page::renderRecorded(GLint detail){
+    GLfloat key[] = {x, y, z, width, height, (GLfloat)type,
+        (GLfloat)textVersion, (GLfloat)drawingVersion, (GLfloat)highlightVersion};
+    if(!replayScene(&content[detail], key, 9)){
+        beginScene(&content[detail], key, 9);
+        renderPage(detail);
+        endScene(&content[detail]);
+    }
+    if(type == PAGE_TYPE_ANIMATION && detail != PAGE_DETAIL_FLAT)
+        renderAnimation();
+}
+
+/*!
+    \fn Page::renderAnimation()
+    \brief Draw the frame the animation of the Page shows, letterboxed inside the margins
+    Nothing is drawn before the first frame is uploaded.
+*/
+void Page::renderAnimation(){
+    GLuint texture = animation == NULL ? 0 : animation->texture.load(std::memory_order_acquire);
+    if(texture == 0)
+        return;
+    GLfloat left = x + marginWidth, bottom = y, right = x + width, top = y + height - marginHeight;
+    GLfloat frameWidth = right - left, frameHeight = top - bottom;
+    if(frameWidth > frameHeight * animation->aspect)
+        frameWidth = frameHeight * animation->aspect;
+    else
+        frameHeight = frameWidth / animation->aspect;
+    left += (right - left - frameWidth) / 2;
+    bottom += (top - bottom - frameHeight) / 2;
+    right = left + frameWidth;
+    top = bottom + frameHeight;
+    /*! Frames are uploaded top row first */
+    GLfloat vertices[4*8] = {
+        left, bottom, z, 0, 0, 1, 0, 1,
+        right, bottom, z, 0, 0, 1, 1, 1,
+        right, top, z, 0, 0, 1, 1, 0,
+        left, top, z, 0, 0, 1, 0, 0
+    };
+    fbEnable(GL_TEXTURE_2D);
+    fbTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    fbBindTexture(GL_TEXTURE_2D, texture);
+    fbColor3f(1,1,1);
+    fbDrawTexturedArrays(GL_QUADS, 4, vertices);
+    fbDisable(GL_TEXTURE_2D);
+    fbColor3f(0.0, 0.0, 0.0);
+}
+
+/*!
+    \fn Page::renderImage(GLint left, GLint bottom, GLint size, GLfloat pixelError)
+    \brief Draw the Page face on into a square of size pixels of the frame buffer
+    The square is cleared to the clear color first, the pixels around it are
+    left alone. The Page is drawn wherever it lies in the book, from its
+    recordings at the detail pixelError allows, or in full without recording
+    it when pixelError is negative.
+    Must be called on the GL thread with the immediate backend, the viewport
+    and both matrices are left set for the square.
+*/
+void Page::renderImage(GLint left, GLint bottom, GLint size, GLfloat pixelError){
+    fbViewport(left, bottom, size, size);
+    glScissor(left, bottom, size, size);
+    glEnable(GL_SCISSOR_TEST);
+    fbClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadIdentity();
+    fbOrtho(x, x + width, y, y + height, -10, 10);
+    fbMatrixMode(GL_MODELVIEW);
+    fbLoadIdentity();
+    fbTranslatef(0, 0, -z); /*!< Page in front, wherever it lies in the stack */
+    if(pixelError < 0){
+        renderPage(PAGE_DETAIL_FULL);
+        if(type == PAGE_TYPE_ANIMATION)
+            renderAnimation();
+    }
+    else
+        renderRecorded(selectDetail(pixelError));
+    glDisable(GL_SCISSOR_TEST);
+}
+
+/*!
+    \fn Page::computeTint()
+    \brief Average color of the white Page with its content drawn on it
+    Text is taken as its greeked bars. The content is recorded aside and every
+    filled polygon weighs in with its area, lines have none. Vector drawings
+    weigh in with the area of their triangles.
+*/
+void Page::computeTint(){
+    CommandBuffer commands;
+    GLRecorder recorder;
+    GLint backend = glBackend;
+    GLRecorder *previousRecorder = glRecorder;
+    recorder.captureVertices = 0;
+    recorder.commands = &commands;
+    setGLBackend(BACKEND_RECORDING, &recorder);
+    if(type == PAGE_TYPE_TEXT && text != NULL)
+        renderGreekedText();
+    else if(type == PAGE_TYPE_DRAWING && pageContent != NULL)
+        pageContent(x + marginWidth, y, z, x + width, y + height - marginHeight);
+    setGLBackend(backend, previousRecorder);
+    GLfloat color[3] = {1, 1, 1}, ink[3] = {0, 0, 0}, inked = 0, pageArea = width * height;
+    if(type == PAGE_TYPE_VECTOR && vector != NULL)
+        inked = vector->ink(x + marginWidth, y, x + width, y + height - marginHeight, ink);
+    GLint mode = GL_POINTS;
+    std::vector<GLfloat> polygon;
+    const GLfloat *a = commands.args.data();
+    for(size_t i=0;i<commands.calls.size();i++){
+        GLint call = commands.calls[i];
+        if(call == CALL_COLOR)
+            memcpy(color, a, sizeof(color));
+        else if(call == CALL_BEGIN){
+            mode = (GLint)a[0];
+            polygon.clear();
+        }
+        else if(call == CALL_VERTEX){
+            polygon.push_back(a[0]);
+            polygon.push_back(a[1]);
+        }
+        else if(call == CALL_END && (mode == GL_POLYGON || mode == GL_QUADS || mode == GL_TRIANGLE_FAN)){
+            GLint corners = mode == GL_QUADS ? 4 : polygon.size()/2;
+            for(size_t first=0;corners>2 && first+2*corners<=polygon.size();first+=2*corners){
+                GLfloat area = 0;
+                for(int k=0;k<corners;k++){
+                    const GLfloat *p = &polygon[first + 2*k], *q = &polygon[first + 2*((k + 1) % corners)];
+                    area += p[0]*q[1] - q[0]*p[1];
+                }
+                area = fabsf(area) / 2;
+                inked += area;
+                for(int k=0;k<3;k++)
+                    ink[k] += color[k] * area;
             }
-            glScalef(ratio, ratio, 1);
-            glutStrokeCharacter(GLUT_STROKE_ROMAN, ch); /*!< Place the character */
-            glFlush();
-        glPopMatrix();
+        }
+        a += callArguments(call, a);
+    }
+    inked = inked < pageArea ? inked : pageArea;
+    for(int k=0;k<3;k++)
+        tint[k] = (pageArea - inked + ink[k]) / pageArea;
+    tinted = 1;
+}
+
+/*!
+    \fn Page::selectDetail(GLfloat pixelError)
+    \brief Coarsest detail level whose error stays within pixelError once projected
+    The Page is projected with the current transform, its size on screen gives
+    the pixels per page unit. A Page reaching behind the eye is drawn in full.
+    Drawing and vector drawing pages only have the full and the flat level.
+*/
+GLint Page::selectDetail(GLfloat pixelError){
+    if(pixelError <= 0)
+        return PAGE_DETAIL_FULL;
+    GLfloat transform[16], viewport[4], screen[4][2], area = 0;
+    GLfloat corners[4][2] = {{x, y}, {x + width, y}, {x + width, y + height}, {x, y + height}};
+    currentTransform(transform, viewport);
+    for(int i=0;i<4;i++){
+        GLfloat clip[4];
+        for(int k=0;k<4;k++)
+            clip[k] = transform[k]*corners[i][0] + transform[4 + k]*corners[i][1] + transform[8 + k]*z + transform[12 + k];
+        if(clip[3] <= 0)
+            return PAGE_DETAIL_FULL;
+        screen[i][0] = clip[0] / clip[3] * viewport[2] / 2;
+        screen[i][1] = clip[1] / clip[3] * viewport[3] / 2;
     }
-    
+    for(int i=0;i<4;i++)
+        area += screen[i][0]*screen[(i + 1) % 4][1] - screen[(i + 1) % 4][0]*screen[i][1];
+    GLfloat scale = sqrtf(fabsf(area) / 2 / (width * height)); /*!< Pixels per page unit */
+    for(int detail=PAGE_DETAIL_FLAT;detail>PAGE_DETAIL_FULL;detail--)
+        if(DETAIL_ERROR[detail] * scale <= pixelError)
+            return ((type == PAGE_TYPE_DRAWING || type == PAGE_TYPE_VECTOR) && detail != PAGE_DETAIL_FLAT) ? PAGE_DETAIL_FULL : detail;
+    return PAGE_DETAIL_FULL;
 }
 
 /*!
@@ -116,15 +479,15 @@ void Page::setBorder(){
     GLfloat xLimit = x + width;
     GLfloat yLimit = y + height;
     GLfloat zLimit = z - PAGE_THICKNESS;
-    glColor3f(0,0,0);
+    fbColor3f(0,0,0);
     cubeConstruction(x, y, z, xLimit, yLimit, zLimit);
-    glColor3f(1,1,1);
-    glBegin(GL_POLYGON);
-        glVertex3f(x, y, z-PAGE_THICKNESS);
-        glVertex3f(x + width, y, z-PAGE_THICKNESS);
-        glVertex3f(x + width, y + height, z-PAGE_THICKNESS);
-        glVertex3f(x, y + height, z-PAGE_THICKNESS);
-    glEnd();
+    fbColor3f(1,1,1);
+    fbBegin(GL_POLYGON);
+        fbVertex3f(x, y, z-PAGE_THICKNESS);
+        fbVertex3f(x + width, y, z-PAGE_THICKNESS);
+        fbVertex3f(x + width, y + height, z-PAGE_THICKNESS);
+        fbVertex3f(x, y + height, z-PAGE_THICKNESS);
+    fbEnd();
 }
 
 /*!
@@ -134,15 +497,15 @@ void Page::setBorder(){
     from the config/constants file.
 */
 void Page::setMargin(){
-    glColor3f(0.0,0.0,0.0);
-    glBegin(GL_LINE_LOOP);
-        glVertex3f(x + marginWidth, y, z);
-        glVertex3f(x + marginWidth, y + height, z);
-    glEnd();
-    glBegin(GL_LINES);
-        glVertex3f(x, y + height - marginHeight, z);
-        glVertex3f(x + width, x + height - marginHeight, z);
-    glEnd();
+    fbColor3f(0.0,0.0,0.0);
+    fbBegin(GL_LINE_LOOP);
+        fbVertex3f(x + marginWidth, y, z);
+        fbVertex3f(x + marginWidth, y + height, z);
+    fbEnd();
+    fbBegin(GL_LINES);
+        fbVertex3f(x, y + height - marginHeight, z);
+        fbVertex3f(x + width, x + height - marginHeight, z);
+    fbEnd();
 }
 
 /*!
@@ -156,16 +519,16 @@ void Page::setPageLines(){
     float pageBodyStartx = x + marginWidth;
     float pageBodyStarty = y + height - marginHeight;
     float pageBodyEndx = x + width;
-    glColor3f(1.0,0.0,0.0);
+    fbColor3f(1.0,0.0,0.0);
     for(index=1;index<MAX_LINES && index<((pageBodyStarty-y)/(lineHeight));index++)
     {
         lines[index] = (pageBodyStarty - (LINE_HEIGHT * index));
-        glBegin(GL_LINES);
-            glVertex3f(pageBodyStartx, lines[index],z);
-            glVertex3f(x + width, lines[index],z);
-        glEnd();
+        fbBegin(GL_LINES);
+            fbVertex3f(pageBodyStartx, lines[index],z);
+            fbVertex3f(x + width, lines[index],z);
+        fbEnd();
     }
-    glColor3f(0.0,0.0,0.0);
+    fbColor3f(0.0,0.0,0.0);
     noOfLines=index-1;
 }
 
@@ -175,16 +538,16 @@ void Page::setPageLines(){
     Construction of a individual faces based on the input of each of the vertices to form a cube
 */
 void squareConstruction(GLint a,GLint b,GLint c,GLint d,GLfloat vertices[][3]){
-    glBegin(GL_LINE_LOOP);
-        glVertex3fv(vertices[a]);
-        glNormal3fv(vertices[a]);
-        glVertex3fv(vertices[b]);
-        glNormal3fv(vertices[b]);
-        glVertex3fv(vertices[c]);
-        glNormal3fv(vertices[c]);
-        glVertex3fv(vertices[d]);
-        glNormal3fv(vertices[d]);
-    glEnd();
+    fbBegin(GL_LINE_LOOP);
+        fbVertex3fv(vertices[a]);
+        fbNormal3fv(vertices[a]);
+        fbVertex3fv(vertices[b]);
+        fbNormal3fv(vertices[b]);
+        fbVertex3fv(vertices[c]);
+        fbNormal3fv(vertices[c]);
+        fbVertex3fv(vertices[d]);
+        fbNormal3fv(vertices[d]);
+    fbEnd();
 }
 
 /*!
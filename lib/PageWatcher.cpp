@@ -0,0 +1,159 @@
+/*!
+    /file PageWatcher.cpp
+    /brief Page sources read from a directory and reloaded as they are saved
+    A page source is a text file named after the page number, 3.txt holds the
+    text of the third page, 3.svg a vector drawing drawn on it.
+*/
+
+#include "./headers/PageWatcher.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+/*!
+    \fn PageWatcher::PageWatcher()
+    \brief Constructor, nothing is watched until watch is called
+*/
+PageWatcher::PageWatcher(){
+    descriptor = -1;
+}
+
+/*!
+    \fn PageWatcher::~PageWatcher()
+    \brief Stop watching
+*/
+PageWatcher::~PageWatcher(){
+    stop();
+}
+
+/*!
+    \fn PageWatcher::watch(const char *directory)
+    \brief Start reporting the page sources written to directory, returns 0 when it cannot be watched
+    Files written in place and files moved in, as editors saving through a
+    temporary file do, are both reported.
+*/
+GLint PageWatcher::watch(const char *directory){
+    stop();
+    this->directory = directory;
+#ifdef __linux__
+    descriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(descriptor >= 0 && inotify_add_watch(descriptor, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+        stop();
+#endif
+    return descriptor >= 0;
+}
+
+/*!
+    \fn PageWatcher::stop()
+    \brief Stop watching the directory
+*/
+void PageWatcher::stop(){
+    if(descriptor >= 0)
+        close(descriptor);
+    descriptor = -1;
+}
+
+/*!
+    \fn PageWatcher::scan(std::vector<PageSource> *sources)
+    \brief Read every page source in the directory, returns the number read
+*/
+GLint PageWatcher::scan(std::vector<PageSource> *sources){
+    DIR *dir = opendir(directory.c_str());
+    if(dir == NULL)
+        return 0;
+    GLint found = 0;
+    for(struct dirent *entry=readdir(dir);entry!=NULL;entry=readdir(dir)){
+        PageSource source;
+        source.pageIndex = pageSourceIndex(entry->d_name, &source.vector);
+        if(source.pageIndex >= 0 && readPageSource((directory + "/" + entry->d_name).c_str(), &source)){
+            sources->push_back(source);
+            found++;
+        }
+    }
+    closedir(dir);
+    return found;
+}
+
+/*!
+    \fn PageWatcher::poll(std::vector<PageSource> *sources)
+    \brief Read the page sources written since the last poll, never waits
+    A file written several times since is read once. Returns the number read.
+*/
+GLint PageWatcher::poll(std::vector<PageSource> *sources){
+    GLint found = 0;
+#ifdef __linux__
+    char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    std::vector<GLint> written;
+    ssize_t length;
+    while(descriptor >= 0 && (length = read(descriptor, events, sizeof(events))) > 0){
+        for(char *at=events;at<events + length;at+=sizeof(struct inotify_event) + ((struct inotify_event*)at)->len){
+            const struct inotify_event *event = (const struct inotify_event*)at;
+            GLint vector = 0, pageIndex = event->len > 0 ? pageSourceIndex(event->name, &vector) : -1;
+            GLint seen = 0;
+            for(size_t i=0;i<written.size();i++)
+                seen |= written[i] == pageIndex;
+            if(pageIndex < 0 || seen)
+                continue;
+            written.push_back(pageIndex);
+            PageSource source;
+            source.pageIndex = pageIndex;
+            source.vector = vector;
+            if(readPageSource((directory + "/" + event->name).c_str(), &source)){
+                sources->push_back(source);
+                found++;
+            }
+        }
+    }
+#endif
+    return found;
+}
+
+/*!
+    \fn pageSourceIndex(const char *filename, GLint *vector)
+    \brief Index of the page a file is the source of, -1 when it is not a page source
+    vector is set to 1 for a vector drawing source, 0 for a text one.
+*/
+GLint pageSourceIndex(const char *filename, GLint *vector){
+    char *end;
+    long number = strtol(filename, &end, 10);
+    GLint drawing = strcmp(end, PAGE_SOURCE_VECTOR_EXTENSION) == 0;
+    if(end == filename || number < 1 || number > PAGE_SOURCE_MAX_PAGE || (!drawing && strcmp(end, PAGE_SOURCE_EXTENSION) != 0))
+        return -1;
+    if(vector != NULL)
+        *vector = drawing;
+    return number - 1;
+}
+
+/*!
+    \fn readPageSource(const char *path, PageSource *source)
+    \brief Read the text and modification time of a page source, returns 0 when it cannot be read
+    At most PAGE_SOURCE_MAX_SIZE bytes of the text are read, VECTOR_SOURCE_MAX_SIZE
+    of a vector drawing.
+*/
+GLint readPageSource(const char *path, PageSource *source){
+    FILE *file = fopen(path, "rb");
+    struct stat status;
+    if(file == NULL)
+        return 0;
+    if(fstat(fileno(file), &status) != 0){
+        fclose(file);
+        return 0;
+    }
+    std::vector<char> text(source->vector ? VECTOR_SOURCE_MAX_SIZE : PAGE_SOURCE_MAX_SIZE);
+    size_t length = fread(text.data(), 1, text.size(), file);
+    fclose(file);
+    source->text.assign(text.data(), length);
+#ifdef __linux__
+    source->saved = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::seconds(status.st_mtim.tv_sec) + std::chrono::nanoseconds(status.st_mtim.tv_nsec)));
+#else
+    source->saved = std::chrono::system_clock::from_time_t(status.st_mtime);
+#endif
+    return 1;
+}
@@ -0,0 +1,138 @@
+/*!
+    /file Riffle.cpp
+    /brief Animation of a jump over many pages of a book
+*/
+
+#include "./headers/Riffle.h"
+#include "./headers/Matrix.h"
+#include <math.h>
+#include <stdlib.h>
+
+/*!
+    \fn Riffle::Riffle()
+    \brief Constructor, no riffle runs
+    The sheets are sized for the most sheets there can be, so drawing a
+    riffle makes no heap allocations.
+*/
+Riffle::Riffle(){
+    fromPage = toPage = 0;
+    time = -1;
+    sheets.reserve(RIFFLE_MAX_SHEETS * 8 * 6);
+}
+
+/*!
+    \fn Riffle::start(GLint from, GLint to)
+    \brief Start riffling from the page from to the page to
+*/
+void Riffle::start(GLint from, GLint to){
+    fromPage = from;
+    toPage = to;
+    time = 0;
+}
+
+/*!
+    \fn Riffle::step()
+    \brief Advance the riffle by an animation step, it stops once the last sheet has landed
+*/
+void Riffle::step(){
+    if(time < 0)
+        return;
+    time += 1;
+    if(time >= duration(fromPage, toPage))
+        time = -1;
+}
+
+/*!
+    \fn Riffle::running()
+    \brief Whether a riffle is being animated
+*/
+GLint Riffle::running(){
+    return time >= 0;
+}
+
+/*!
+    \fn Riffle::sheetCount(GLint from, GLint to)
+    \brief Sheets the pages from from to to are turned in, a sheet per page up to RIFFLE_MAX_SHEETS
+*/
+GLint Riffle::sheetCount(GLint from, GLint to){
+    GLint pages = abs(to - from);
+    return pages < RIFFLE_MAX_SHEETS ? pages : RIFFLE_MAX_SHEETS;
+}
+
+/*!
+    \fn Riffle::duration(GLint from, GLint to)
+    \brief Steps from the start of the first sheet until the last one has landed
+*/
+GLfloat Riffle::duration(GLint from, GLint to){
+    GLint count = sheetCount(from, to);
+    return count > 0 ? RIFFLE_FLIP_STEPS + (count - 1) * RIFFLE_SHEET_INTERVAL : 0;
+}
+
+/*!
+    \fn Riffle::sheetAngle(GLint sheet, GLfloat time)
+    \brief How far a sheet has turned at time, 0 before it starts and 180 once it has landed
+    Sheets ease in and out, so the ones starting and landing overlap less.
+*/
+GLfloat Riffle::sheetAngle(GLint sheet, GLfloat time){
+    GLfloat t = (time - sheet * RIFFLE_SHEET_INTERVAL) / RIFFLE_FLIP_STEPS;
+    t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    return 180 * t * t * (3 - 2*t);
+}
+
+/*!
+    \fn Riffle::shownPage(GLint from, GLint to, GLfloat time)
+    \brief Page the book lies open at while riffling, the pages of the sheets started are turned over
+*/
+GLint Riffle::shownPage(GLint from, GLint to, GLfloat time){
+    GLint count = sheetCount(from, to);
+    if(count == 0 || time <= 0)
+        return from;
+    GLint started = ceilf(time / RIFFLE_SHEET_INTERVAL);
+    started = started < count ? started : count;
+    GLint turned = started * abs(to - from) / count;
+    return to > from ? from + turned : from - turned;
+}
+
+/*!
+    \fn Riffle::render(Book *book, GLint from, GLint to, GLfloat time)
+    \brief Draw the sheets in flight at time with a single call
+    Every sheet is the same blank page, moved to the depth of its first page
+    and turned over the binding of the book by its own angle. Riffling back
+    the sheets come from the pages already read.
+*/
+void Riffle::render(Book *book, GLint from, GLint to, GLfloat time){
+    GLint count = sheetCount(from, to), pages = abs(to - from), forward = to > from;
+    sheets.clear();
+    if(count == 0 || book->noOfPages == 0)
+        return;
+    const Page *page = book->pages[0];
+    GLfloat x0 = page->x, x1 = page->x + page->width, y0 = page->y, y1 = page->y + page->height;
+    GLfloat back = -book->pageSpacing() * PAGE_THICKNESS / (PAGE_THICKNESS + PAGE_GAP);
+    /*! Front and back of a blank page lying at depth 0, vertices and normals */
+    const GLfloat sheet[8][6] = {
+        {x0, y0, 0, 0, 0, 1}, {x1, y0, 0, 0, 0, 1}, {x1, y1, 0, 0, 0, 1}, {x0, y1, 0, 0, 0, 1},
+        {x0, y0, back, 0, 0, -1}, {x0, y1, back, 0, 0, -1}, {x1, y1, back, 0, 0, -1}, {x1, y0, back, 0, 0, -1}
+    };
+    for(int i=0;i<count;i++){
+        GLfloat angle = sheetAngle(i, time);
+        if(angle <= 0 || angle >= 180) /*!< Not started yet or landed, part of a stack */
+            continue;
+        GLint pageIndex = forward ? from + i * pages / count : from - (i + 1) * pages / count;
+        GLfloat m[16], vertex[6];
+        identityMatrix(m);
+        translateMatrix(m, book->x, 0, book->z);
+        rotateMatrix(m, forward ? angle : 180 - angle, 0, -1, 0);
+        translateMatrix(m, -book->x, 0, book->pageDepth(pageIndex) - book->z);
+        for(int v=0;v<8;v++){
+            transformPoints(vertex, m, sheet[v], 1);
+            for(int c=0;c<3;c++)
+                vertex[3 + c] = m[c]*sheet[v][3] + m[4 + c]*sheet[v][4] + m[8 + c]*sheet[v][5];
+            sheets.insert(sheets.end(), vertex, vertex + 6);
+        }
+    }
+    if(sheets.empty())
+        return;
+    fbColor3f(0.95,0.94,0.9);
+    fbDrawArrays(GL_QUADS, sheets.size()/6, sheets.data());
+    fbColor3f(1,1,1);
+}
@@ -0,0 +1,208 @@
+/*!
+    /file SearchIndex.cpp
+    /brief Full text search over the pages of a book
+*/
+
+#include "./headers/SearchIndex.h"
+#include <algorithm>
+#include <ctype.h>
+#include <limits.h>
+
+/*!
+    \struct SearchCursor
+    \brief Position in the postings of a term matching a word of a query
+*/
+struct SearchCursor{
+    const std::vector<SearchPosting> *postings;
+    size_t next; /*!< First posting not yet passed */
+    GLint length; /*!< Characters of the term */
+};
+
+/*!
+    \fn isWordCharacter(char c)
+    \brief Whether c belongs to a word, words are runs of letters and digits
+*/
+static GLint isWordCharacter(char c){
+    return isalnum((unsigned char)c) != 0;
+}
+
+/*!
+    \fn readWord(const char *text, GLint *i, std::string *word)
+    \brief Read the word starting at text[*i] in lower case, leaving *i after it
+*/
+static void readWord(const char *text, GLint *i, std::string *word){
+    word->clear();
+    for(;isWordCharacter(text[*i]);(*i)++)
+        *word += tolower((unsigned char)text[*i]);
+}
+
+static bool postingBefore(const SearchPosting &posting, GLint pageIndex){
+    return posting.pageIndex < pageIndex;
+}
+
+static bool pageBefore(GLint pageIndex, const SearchPosting &posting){
+    return pageIndex < posting.pageIndex;
+}
+
+static bool spanBefore(const SearchSpan &a, const SearchSpan &b){
+    return a.start < b.start || (a.start == b.start && a.length < b.length);
+}
+
+static bool sameSpan(const SearchSpan &a, const SearchSpan &b){
+    return a.start == b.start && a.length == b.length;
+}
+
+/*!
+    \fn SearchIndex::SearchIndex()
+    \brief Constructor, the index starts without pages
+*/
+SearchIndex::SearchIndex(){
+    postings = 0;
+}
+
+/*!
+    \fn SearchIndex::setPage(GLint pageIndex, const char *text)
+    \brief Index the text of a page, replacing what was indexed for it before
+    Pages added in order only append to the postings of their terms.
+*/
+void SearchIndex::setPage(GLint pageIndex, const char *text){
+    removePage(pageIndex);
+    if(pageIndex < 0 || text == NULL)
+        return;
+    if(pageIndex >= (GLint)pageTerms.size())
+        pageTerms.resize(pageIndex + 1);
+    std::vector<const std::string*> *distinct = &pageTerms[pageIndex];
+    std::string word;
+    for(GLint i=0;text[i]!='\0';){
+        if(!isWordCharacter(text[i])){
+            i++;
+            continue;
+        }
+        SearchPosting posting = {pageIndex, i};
+        readWord(text, &i, &word);
+        std::map<std::string, std::vector<SearchPosting> >::iterator term = terms.find(word);
+        if(term == terms.end())
+            term = terms.insert(std::make_pair(word, std::vector<SearchPosting>())).first;
+        std::vector<SearchPosting> *list = &term->second;
+        std::vector<SearchPosting>::iterator at = list->end();
+        if(!list->empty() && list->back().pageIndex > pageIndex) /*!< A page before the last one indexed */
+            at = std::upper_bound(list->begin(), list->end(), pageIndex, pageBefore);
+        if(at == list->begin() || (at - 1)->pageIndex != pageIndex)
+            distinct->push_back(&term->first);
+        list->insert(at, posting);
+        postings++;
+    }
+}
+
+/*!
+    \fn SearchIndex::removePage(GLint pageIndex)
+    \brief Drop everything indexed for a page, terms left without postings are dropped too
+*/
+void SearchIndex::removePage(GLint pageIndex){
+    if(pageIndex < 0 || pageIndex >= (GLint)pageTerms.size())
+        return;
+    std::vector<const std::string*> *distinct = &pageTerms[pageIndex];
+    for(size_t i=0;i<distinct->size();i++){
+        std::map<std::string, std::vector<SearchPosting> >::iterator term = terms.find(*(*distinct)[i]);
+        std::vector<SearchPosting> *list = &term->second;
+        std::vector<SearchPosting>::iterator first = std::lower_bound(list->begin(), list->end(), pageIndex, postingBefore);
+        std::vector<SearchPosting>::iterator last = std::upper_bound(first, list->end(), pageIndex, pageBefore);
+        postings -= last - first;
+        list->erase(first, last);
+        if(list->empty())
+            terms.erase(term);
+    }
+    distinct->clear();
+}
+
+/*!
+    \fn collectHits(std::vector<std::vector<SearchCursor> > *words, GLint from, GLint to, GLint maxPages, std::vector<SearchHit> *hits)
+    \brief Add the pages from from up to to holding every word, until hits holds maxPages
+    The cursors of every word leapfrog to the first page all of them reach,
+    skipping the postings in between by binary search.
+*/
+static void collectHits(std::vector<std::vector<SearchCursor> > *words, GLint from, GLint to, GLint maxPages, std::vector<SearchHit> *hits){
+    for(size_t w=0;w<words->size();w++)
+        for(size_t c=0;c<(*words)[w].size();c++){
+            SearchCursor *cursor = &(*words)[w][c];
+            cursor->next = std::lower_bound(cursor->postings->begin(), cursor->postings->end(), from, postingBefore) - cursor->postings->begin();
+        }
+    GLint page = from;
+    while(page < to && (GLint)hits->size() < maxPages){
+        GLint agreed = 1;
+        for(size_t w=0;w<words->size();w++){
+            GLint first = to;
+            for(size_t c=0;c<(*words)[w].size();c++){
+                SearchCursor *cursor = &(*words)[w][c];
+                const std::vector<SearchPosting> *list = cursor->postings;
+                if(cursor->next < list->size() && (*list)[cursor->next].pageIndex < page)
+                    cursor->next = std::lower_bound(list->begin() + cursor->next, list->end(), page, postingBefore) - list->begin();
+                if(cursor->next < list->size())
+                    first = std::min(first, (*list)[cursor->next].pageIndex);
+            }
+            if(first >= to)
+                return;
+            if(first > page){
+                page = first;
+                agreed = 0;
+            }
+        }
+        if(!agreed)
+            continue;
+        hits->push_back(SearchHit());
+        SearchHit *hit = &hits->back();
+        hit->pageIndex = page;
+        for(size_t w=0;w<words->size();w++)
+            for(size_t c=0;c<(*words)[w].size();c++){
+                SearchCursor *cursor = &(*words)[w][c];
+                const std::vector<SearchPosting> *list = cursor->postings;
+                for(;cursor->next < list->size() && (*list)[cursor->next].pageIndex == page;cursor->next++){
+                    SearchSpan span = {(*list)[cursor->next].start, cursor->length};
+                    hit->spans.push_back(span);
+                }
+            }
+        std::sort(hit->spans.begin(), hit->spans.end(), spanBefore);
+        hit->spans.erase(std::unique(hit->spans.begin(), hit->spans.end(), sameSpan), hit->spans.end());
+        page++;
+    }
+}
+
+/*!
+    \fn SearchIndex::search(const char *query, GLint fromPage, GLint maxPages, std::vector<SearchHit> *hits)
+    \brief Pages holding every word of query, returns how many were found
+    A word ending in * matches every term starting with it.
+    hits -> up to maxPages pages in reading order from fromPage on, wrapping
+    around to the pages before it.
+*/
+GLint SearchIndex::search(const char *query, GLint fromPage, GLint maxPages, std::vector<SearchHit> *hits){
+    std::vector<std::vector<SearchCursor> > words;
+    std::string word;
+    hits->clear();
+    for(GLint i=0;query[i]!='\0';){
+        if(!isWordCharacter(query[i])){
+            i++;
+            continue;
+        }
+        readWord(query, &i, &word);
+        words.push_back(std::vector<SearchCursor>());
+        std::map<std::string, std::vector<SearchPosting> >::const_iterator term;
+        if(query[i] == '*'){ /*!< Prefix, every term from the prefix on up to the first not starting with it */
+            for(term=terms.lower_bound(word);term!=terms.end() && term->first.compare(0, word.size(), word) == 0;term++){
+                SearchCursor cursor = {&term->second, 0, (GLint)term->first.size()};
+                words.back().push_back(cursor);
+            }
+        }
+        else if((term = terms.find(word)) != terms.end()){
+            SearchCursor cursor = {&term->second, 0, (GLint)term->first.size()};
+            words.back().push_back(cursor);
+        }
+        if(words.back().empty())
+            return 0;
+    }
+    if(words.empty() || maxPages <= 0)
+        return 0;
+    fromPage = std::max(fromPage, 0);
+    collectHits(&words, fromPage, INT_MAX, maxPages, hits);
+    collectHits(&words, 0, fromPage, maxPages, hits);
+    return hits->size();
+}
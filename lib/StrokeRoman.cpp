@@ -0,0 +1,744 @@
+/*!
+    /file StrokeRoman.cpp
+    /brief Glyphs of the roman stroke font, as GLUT_STROKE_ROMAN draws them
+    Kept here so text is drawn and recorded the same on any GLUT, and without
+    glutInit. The glyph data is taken from freeglut (fg_stroke_roman.c):
+
+    Copyright (c) 1999-2000 Pawel W. Olszta. All Rights Reserved.
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies or substantial portions of the Software.
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+    OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+    PAWEL W. OLSZTA BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+    WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+    OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Except as contained in this notice, the name of Pawel W. Olszta shall not
+    be used in advertising or otherwise to promote the sale, use or other
+    dealings in this Software without prior written authorization from Pawel
+    W. Olszta.
+*/
+
+#include "./headers/StrokeFont.h"
+#include <stddef.h>
+
+/*! x, y of the vertices of every strip of every character, in font units */
+static const StrokeVertex vertices[] = {
+    /* 33 '!' strip 0 */
+    {13.3819, 100}, {13.3819, 33.3333},
+    /* 33 '!' strip 1 */
+    {13.3819, 9.5238}, {8.62, 4.7619}, {13.3819, 0}, {18.1438, 4.7619}, {13.3819, 9.5238},
+    /* 34 '"' strip 0 */
+    {4.02, 100}, {4.02, 66.6667},
+    /* 34 '"' strip 1 */
+    {42.1152, 100}, {42.1152, 66.6667},
+    /* 35 '#' strip 0 */
+    {41.2952, 119.048}, {7.9619, -33.3333},
+    /* 35 '#' strip 1 */
+    {69.8667, 119.048}, {36.5333, -33.3333},
+    /* 35 '#' strip 2 */
+    {7.9619, 57.1429}, {74.6286, 57.1429},
+    /* 35 '#' strip 3 */
+    {3.2, 28.5714}, {69.8667, 28.5714},
+    /* 36 '$' strip 0 */
+    {28.6295, 119.048}, {28.6295, -19.0476},
+    /* 36 '$' strip 1 */
+    {47.6771, 119.048}, {47.6771, -19.0476},
+    /* 36 '$' strip 2 */
+    {71.4867, 85.7143}, {61.9629, 95.2381}, {47.6771, 100}, {28.6295, 100}, {14.3438, 95.2381}, {4.82, 85.7143},
+    {4.82, 76.1905}, {9.5819, 66.6667}, {14.3438, 61.9048}, {23.8676, 57.1429}, {52.439, 47.619}, {61.9629, 42.8571},
+    {66.7248, 38.0952}, {71.4867, 28.5714}, {71.4867, 14.2857}, {61.9629, 4.7619}, {47.6771, 0}, {28.6295, 0},
+    {14.3438, 4.7619}, {4.82, 14.2857},
+    /* 37 '%' strip 0 */
+    {92.0743, 100}, {6.36, 0},
+    /* 37 '%' strip 1 */
+    {30.1695, 100}, {39.6933, 90.4762}, {39.6933, 80.9524}, {34.9314, 71.4286}, {25.4076, 66.6667}, {15.8838, 66.6667},
+    {6.36, 76.1905}, {6.36, 85.7143}, {11.1219, 95.2381}, {20.6457, 100}, {30.1695, 100}, {39.6933, 95.2381},
+    {53.979, 90.4762}, {68.2648, 90.4762}, {82.5505, 95.2381}, {92.0743, 100},
+    /* 37 '%' strip 2 */
+    {73.0267, 33.3333}, {63.5029, 28.5714}, {58.741, 19.0476}, {58.741, 9.5238}, {68.2648, 0}, {77.7886, 0},
+    {87.3124, 4.7619}, {92.0743, 14.2857}, {92.0743, 23.8095}, {82.5505, 33.3333}, {73.0267, 33.3333},
+    /* 38 '&' strip 0 */
+    {101.218, 57.1429}, {101.218, 61.9048}, {96.4562, 66.6667}, {91.6943, 66.6667}, {86.9324, 61.9048}, {82.1705, 52.381},
+    {72.6467, 28.5714}, {63.1229, 14.2857}, {53.599, 4.7619}, {44.0752, 0}, {25.0276, 0}, {15.5038, 4.7619},
+    {10.7419, 9.5238}, {5.98, 19.0476}, {5.98, 28.5714}, {10.7419, 38.0952}, {15.5038, 42.8571}, {48.8371, 61.9048},
+    {53.599, 66.6667}, {58.361, 76.1905}, {58.361, 85.7143}, {53.599, 95.2381}, {44.0752, 100}, {34.5514, 95.2381},
+    {29.7895, 85.7143}, {29.7895, 76.1905}, {34.5514, 61.9048}, {44.0752, 47.619}, {67.8848, 14.2857}, {77.4086, 4.7619},
+    {86.9324, 0}, {96.4562, 0}, {101.218, 4.7619}, {101.218, 9.5238},
+    /* 39 ''' strip 0 */
+    {4.44, 100}, {4.44, 66.6667},
+    /* 40 '(' strip 0 */
+    {40.9133, 119.048}, {31.3895, 109.524}, {21.8657, 95.2381}, {12.3419, 76.1905}, {7.58, 52.381}, {7.58, 33.3333},
+    {12.3419, 9.5238}, {21.8657, -9.5238}, {31.3895, -23.8095}, {40.9133, -33.3333},
+    /* 41 ')' strip 0 */
+    {5.28, 119.048}, {14.8038, 109.524}, {24.3276, 95.2381}, {33.8514, 76.1905}, {38.6133, 52.381}, {38.6133, 33.3333},
+    {33.8514, 9.5238}, {24.3276, -9.5238}, {14.8038, -23.8095}, {5.28, -33.3333},
+    /* 42 '*' strip 0 */
+    {30.7695, 71.4286}, {30.7695, 14.2857},
+    /* 42 '*' strip 1 */
+    {6.96, 57.1429}, {54.579, 28.5714},
+    /* 42 '*' strip 2 */
+    {54.579, 57.1429}, {6.96, 28.5714},
+    /* 43 '+' strip 0 */
+    {48.8371, 85.7143}, {48.8371, 0},
+    /* 43 '+' strip 1 */
+    {5.98, 42.8571}, {91.6943, 42.8571},
+    /* 44 ',' strip 0 */
+    {18.2838, 4.7619}, {13.5219, 0}, {8.76, 4.7619}, {13.5219, 9.5238}, {18.2838, 4.7619}, {18.2838, -4.7619},
+    {13.5219, -14.2857}, {8.76, -19.0476},
+    /* 45 '-' strip 0 */
+    {7.38, 42.8571}, {93.0943, 42.8571},
+    /* 46 '.' strip 0 */
+    {13.1019, 9.5238}, {8.34, 4.7619}, {13.1019, 0}, {17.8638, 4.7619}, {13.1019, 9.5238},
+    /* 47 '/' strip 0 */
+    {7.24, -14.2857}, {73.9067, 100},
+    /* 48 '0' strip 0 */
+    {33.5514, 100}, {19.2657, 95.2381}, {9.7419, 80.9524}, {4.98, 57.1429}, {4.98, 42.8571}, {9.7419, 19.0476},
+    {19.2657, 4.7619}, {33.5514, 0}, {43.0752, 0}, {57.361, 4.7619}, {66.8848, 19.0476}, {71.6467, 42.8571},
+    {71.6467, 57.1429}, {66.8848, 80.9524}, {57.361, 95.2381}, {43.0752, 100}, {33.5514, 100},
+    /* 49 '1' strip 0 */
+    {11.82, 80.9524}, {21.3438, 85.7143}, {35.6295, 100}, {35.6295, 0},
+    /* 50 '2' strip 0 */
+    {10.1819, 76.1905}, {10.1819, 80.9524}, {14.9438, 90.4762}, {19.7057, 95.2381}, {29.2295, 100}, {48.2771, 100},
+    {57.801, 95.2381}, {62.5629, 90.4762}, {67.3248, 80.9524}, {67.3248, 71.4286}, {62.5629, 61.9048}, {53.039, 47.619},
+    {5.42, 0}, {72.0867, 0},
+    /* 51 '3' strip 0 */
+    {14.5238, 100}, {66.9048, 100}, {38.3333, 61.9048}, {52.619, 61.9048}, {62.1429, 57.1429}, {66.9048, 52.381},
+    {71.6667, 38.0952}, {71.6667, 28.5714}, {66.9048, 14.2857}, {57.381, 4.7619}, {43.0952, 0}, {28.8095, 0},
+    {14.5238, 4.7619}, {9.7619, 9.5238}, {5, 19.0476},
+    /* 52 '4' strip 0 */
+    {51.499, 100}, {3.88, 33.3333}, {75.3086, 33.3333},
+    /* 52 '4' strip 1 */
+    {51.499, 100}, {51.499, 0},
+    /* 53 '5' strip 0 */
+    {62.0029, 100}, {14.3838, 100}, {9.6219, 57.1429}, {14.3838, 61.9048}, {28.6695, 66.6667}, {42.9552, 66.6667},
+    {57.241, 61.9048}, {66.7648, 52.381}, {71.5267, 38.0952}, {71.5267, 28.5714}, {66.7648, 14.2857}, {57.241, 4.7619},
+    {42.9552, 0}, {28.6695, 0}, {14.3838, 4.7619}, {9.6219, 9.5238}, {4.86, 19.0476},
+    /* 54 '6' strip 0 */
+    {62.7229, 85.7143}, {57.961, 95.2381}, {43.6752, 100}, {34.1514, 100}, {19.8657, 95.2381}, {10.3419, 80.9524},
+    {5.58, 57.1429}, {5.58, 33.3333}, {10.3419, 14.2857}, {19.8657, 4.7619}, {34.1514, 0}, {38.9133, 0},
+    {53.199, 4.7619}, {62.7229, 14.2857}, {67.4848, 28.5714}, {67.4848, 33.3333}, {62.7229, 47.619}, {53.199, 57.1429},
+    {38.9133, 61.9048}, {34.1514, 61.9048}, {19.8657, 57.1429}, {10.3419, 47.619}, {5.58, 33.3333},
+    /* 55 '7' strip 0 */
+    {72.2267, 100}, {24.6076, 0},
+    /* 55 '7' strip 1 */
+    {5.56, 100}, {72.2267, 100},
+    /* 56 '8' strip 0 */
+    {29.4095, 100}, {15.1238, 95.2381}, {10.3619, 85.7143}, {10.3619, 76.1905}, {15.1238, 66.6667}, {24.6476, 61.9048},
+    {43.6952, 57.1429}, {57.981, 52.381}, {67.5048, 42.8571}, {72.2667, 33.3333}, {72.2667, 19.0476}, {67.5048, 9.5238},
+    {62.7429, 4.7619}, {48.4571, 0}, {29.4095, 0}, {15.1238, 4.7619}, {10.3619, 9.5238}, {5.6, 19.0476},
+    {5.6, 33.3333}, {10.3619, 42.8571}, {19.8857, 52.381}, {34.1714, 57.1429}, {53.219, 61.9048}, {62.7429, 66.6667},
+    {67.5048, 76.1905}, {67.5048, 85.7143}, {62.7429, 95.2381}, {48.4571, 100}, {29.4095, 100},
+    /* 57 '9' strip 0 */
+    {68.5048, 66.6667}, {63.7429, 52.381}, {54.219, 42.8571}, {39.9333, 38.0952}, {35.1714, 38.0952}, {20.8857, 42.8571},
+    {11.3619, 52.381}, {6.6, 66.6667}, {6.6, 71.4286}, {11.3619, 85.7143}, {20.8857, 95.2381}, {35.1714, 100},
+    {39.9333, 100}, {54.219, 95.2381}, {63.7429, 85.7143}, {68.5048, 66.6667}, {68.5048, 42.8571}, {63.7429, 19.0476},
+    {54.219, 4.7619}, {39.9333, 0}, {30.4095, 0}, {16.1238, 4.7619}, {11.3619, 14.2857},
+    /* 58 ':' strip 0 */
+    {14.0819, 66.6667}, {9.32, 61.9048}, {14.0819, 57.1429}, {18.8438, 61.9048}, {14.0819, 66.6667},
+    /* 58 ':' strip 1 */
+    {14.0819, 9.5238}, {9.32, 4.7619}, {14.0819, 0}, {18.8438, 4.7619}, {14.0819, 9.5238},
+    /* 59 ';' strip 0 */
+    {12.9619, 66.6667}, {8.2, 61.9048}, {12.9619, 57.1429}, {17.7238, 61.9048}, {12.9619, 66.6667},
+    /* 59 ';' strip 1 */
+    {17.7238, 4.7619}, {12.9619, 0}, {8.2, 4.7619}, {12.9619, 9.5238}, {17.7238, 4.7619}, {17.7238, -4.7619},
+    {12.9619, -14.2857}, {8.2, -19.0476},
+    /* 60 '<' strip 0 */
+    {79.2505, 85.7143}, {3.06, 42.8571}, {79.2505, 0},
+    /* 61 '=' strip 0 */
+    {5.7, 57.1429}, {91.4143, 57.1429},
+    /* 61 '=' strip 1 */
+    {5.7, 28.5714}, {91.4143, 28.5714},
+    /* 62 '>' strip 0 */
+    {2.78, 85.7143}, {78.9705, 42.8571}, {2.78, 0},
+    /* 63 '?' strip 0 */
+    {8.42, 76.1905}, {8.42, 80.9524}, {13.1819, 90.4762}, {17.9438, 95.2381}, {27.4676, 100}, {46.5152, 100},
+    {56.039, 95.2381}, {60.801, 90.4762}, {65.5629, 80.9524}, {65.5629, 71.4286}, {60.801, 61.9048}, {56.039, 57.1429},
+    {36.9914, 47.619}, {36.9914, 33.3333},
+    /* 63 '?' strip 1 */
+    {36.9914, 9.5238}, {32.2295, 4.7619}, {36.9914, 0}, {41.7533, 4.7619}, {36.9914, 9.5238},
+    /* 64 '@' strip 0 */
+    {49.2171, 52.381}, {39.6933, 57.1429}, {30.1695, 57.1429}, {25.4076, 47.619}, {25.4076, 42.8571}, {30.1695, 33.3333},
+    {39.6933, 33.3333}, {49.2171, 38.0952},
+    /* 64 '@' strip 1 */
+    {49.2171, 57.1429}, {49.2171, 38.0952}, {53.979, 33.3333}, {63.5029, 33.3333}, {68.2648, 42.8571}, {68.2648, 47.619},
+    {63.5029, 61.9048}, {53.979, 71.4286}, {39.6933, 76.1905}, {34.9314, 76.1905}, {20.6457, 71.4286}, {11.1219, 61.9048},
+    {6.36, 47.619}, {6.36, 42.8571}, {11.1219, 28.5714}, {20.6457, 19.0476}, {34.9314, 14.2857}, {39.6933, 14.2857},
+    {53.979, 19.0476},
+    /* 65 'A' strip 0 */
+    {40.5952, 100}, {2.5, 0},
+    /* 65 'A' strip 1 */
+    {40.5952, 100}, {78.6905, 0},
+    /* 65 'A' strip 2 */
+    {16.7857, 33.3333}, {64.4048, 33.3333},
+    /* 66 'B' strip 0 */
+    {11.42, 100}, {11.42, 0},
+    /* 66 'B' strip 1 */
+    {11.42, 100}, {54.2771, 100}, {68.5629, 95.2381}, {73.3248, 90.4762}, {78.0867, 80.9524}, {78.0867, 71.4286},
+    {73.3248, 61.9048}, {68.5629, 57.1429}, {54.2771, 52.381},
+    /* 66 'B' strip 2 */
+    {11.42, 52.381}, {54.2771, 52.381}, {68.5629, 47.619}, {73.3248, 42.8571}, {78.0867, 33.3333}, {78.0867, 19.0476},
+    {73.3248, 9.5238}, {68.5629, 4.7619}, {54.2771, 0}, {11.42, 0},
+    /* 67 'C' strip 0 */
+    {78.0886, 76.1905}, {73.3267, 85.7143}, {63.8029, 95.2381}, {54.279, 100}, {35.2314, 100}, {25.7076, 95.2381},
+    {16.1838, 85.7143}, {11.4219, 76.1905}, {6.66, 61.9048}, {6.66, 38.0952}, {11.4219, 23.8095}, {16.1838, 14.2857},
+    {25.7076, 4.7619}, {35.2314, 0}, {54.279, 0}, {63.8029, 4.7619}, {73.3267, 14.2857}, {78.0886, 23.8095},
+    /* 68 'D' strip 0 */
+    {11.96, 100}, {11.96, 0},
+    /* 68 'D' strip 1 */
+    {11.96, 100}, {45.2933, 100}, {59.579, 95.2381}, {69.1029, 85.7143}, {73.8648, 76.1905}, {78.6267, 61.9048},
+    {78.6267, 38.0952}, {73.8648, 23.8095}, {69.1029, 14.2857}, {59.579, 4.7619}, {45.2933, 0}, {11.96, 0},
+    /* 69 'E' strip 0 */
+    {11.42, 100}, {11.42, 0},
+    /* 69 'E' strip 1 */
+    {11.42, 100}, {73.3248, 100},
+    /* 69 'E' strip 2 */
+    {11.42, 52.381}, {49.5152, 52.381},
+    /* 69 'E' strip 3 */
+    {11.42, 0}, {73.3248, 0},
+    /* 70 'F' strip 0 */
+    {11.42, 100}, {11.42, 0},
+    /* 70 'F' strip 1 */
+    {11.42, 100}, {73.3248, 100},
+    /* 70 'F' strip 2 */
+    {11.42, 52.381}, {49.5152, 52.381},
+    /* 71 'G' strip 0 */
+    {78.4886, 76.1905}, {73.7267, 85.7143}, {64.2029, 95.2381}, {54.679, 100}, {35.6314, 100}, {26.1076, 95.2381},
+    {16.5838, 85.7143}, {11.8219, 76.1905}, {7.06, 61.9048}, {7.06, 38.0952}, {11.8219, 23.8095}, {16.5838, 14.2857},
+    {26.1076, 4.7619}, {35.6314, 0}, {54.679, 0}, {64.2029, 4.7619}, {73.7267, 14.2857}, {78.4886, 23.8095},
+    {78.4886, 38.0952},
+    /* 71 'G' strip 1 */
+    {54.679, 38.0952}, {78.4886, 38.0952},
+    /* 72 'H' strip 0 */
+    {11.42, 100}, {11.42, 0},
+    /* 72 'H' strip 1 */
+    {78.0867, 100}, {78.0867, 0},
+    /* 72 'H' strip 2 */
+    {11.42, 52.381}, {78.0867, 52.381},
+    /* 73 'I' strip 0 */
+    {10.86, 100}, {10.86, 0},
+    /* 74 'J' strip 0 */
+    {50.119, 100}, {50.119, 23.8095}, {45.3571, 9.5238}, {40.5952, 4.7619}, {31.0714, 0}, {21.5476, 0},
+    {12.0238, 4.7619}, {7.2619, 9.5238}, {2.5, 23.8095}, {2.5, 33.3333},
+    /* 75 'K' strip 0 */
+    {11.28, 100}, {11.28, 0},
+    /* 75 'K' strip 1 */
+    {77.9467, 100}, {11.28, 33.3333},
+    /* 75 'K' strip 2 */
+    {35.0895, 57.1429}, {77.9467, 0},
+    /* 76 'L' strip 0 */
+    {11.68, 100}, {11.68, 0},
+    /* 76 'L' strip 1 */
+    {11.68, 0}, {68.8229, 0},
+    /* 77 'M' strip 0 */
+    {10.86, 100}, {10.86, 0},
+    /* 77 'M' strip 1 */
+    {10.86, 100}, {48.9552, 0},
+    /* 77 'M' strip 2 */
+    {87.0505, 100}, {48.9552, 0},
+    /* 77 'M' strip 3 */
+    {87.0505, 100}, {87.0505, 0},
+    /* 78 'N' strip 0 */
+    {11.14, 100}, {11.14, 0},
+    /* 78 'N' strip 1 */
+    {11.14, 100}, {77.8067, 0},
+    /* 78 'N' strip 2 */
+    {77.8067, 100}, {77.8067, 0},
+    /* 79 'O' strip 0 */
+    {34.8114, 100}, {25.2876, 95.2381}, {15.7638, 85.7143}, {11.0019, 76.1905}, {6.24, 61.9048}, {6.24, 38.0952},
+    {11.0019, 23.8095}, {15.7638, 14.2857}, {25.2876, 4.7619}, {34.8114, 0}, {53.859, 0}, {63.3829, 4.7619},
+    {72.9067, 14.2857}, {77.6686, 23.8095}, {82.4305, 38.0952}, {82.4305, 61.9048}, {77.6686, 76.1905}, {72.9067, 85.7143},
+    {63.3829, 95.2381}, {53.859, 100}, {34.8114, 100},
+    /* 80 'P' strip 0 */
+    {12.1, 100}, {12.1, 0},
+    /* 80 'P' strip 1 */
+    {12.1, 100}, {54.9571, 100}, {69.2429, 95.2381}, {74.0048, 90.4762}, {78.7667, 80.9524}, {78.7667, 66.6667},
+    {74.0048, 57.1429}, {69.2429, 52.381}, {54.9571, 47.619}, {12.1, 47.619},
+    /* 81 'Q' strip 0 */
+    {33.8714, 100}, {24.3476, 95.2381}, {14.8238, 85.7143}, {10.0619, 76.1905}, {5.3, 61.9048}, {5.3, 38.0952},
+    {10.0619, 23.8095}, {14.8238, 14.2857}, {24.3476, 4.7619}, {33.8714, 0}, {52.919, 0}, {62.4429, 4.7619},
+    {71.9667, 14.2857}, {76.7286, 23.8095}, {81.4905, 38.0952}, {81.4905, 61.9048}, {76.7286, 76.1905}, {71.9667, 85.7143},
+    {62.4429, 95.2381}, {52.919, 100}, {33.8714, 100},
+    /* 81 'Q' strip 1 */
+    {48.1571, 19.0476}, {76.7286, -9.5238},
+    /* 82 'R' strip 0 */
+    {11.68, 100}, {11.68, 0},
+    /* 82 'R' strip 1 */
+    {11.68, 100}, {54.5371, 100}, {68.8229, 95.2381}, {73.5848, 90.4762}, {78.3467, 80.9524}, {78.3467, 71.4286},
+    {73.5848, 61.9048}, {68.8229, 57.1429}, {54.5371, 52.381}, {11.68, 52.381},
+    /* 82 'R' strip 2 */
+    {45.0133, 52.381}, {78.3467, 0},
+    /* 83 'S' strip 0 */
+    {74.6667, 85.7143}, {65.1429, 95.2381}, {50.8571, 100}, {31.8095, 100}, {17.5238, 95.2381}, {8, 85.7143},
+    {8, 76.1905}, {12.7619, 66.6667}, {17.5238, 61.9048}, {27.0476, 57.1429}, {55.619, 47.619}, {65.1429, 42.8571},
+    {69.9048, 38.0952}, {74.6667, 28.5714}, {74.6667, 14.2857}, {65.1429, 4.7619}, {50.8571, 0}, {31.8095, 0},
+    {17.5238, 4.7619}, {8, 14.2857},
+    /* 84 'T' strip 0 */
+    {35.6933, 100}, {35.6933, 0},
+    /* 84 'T' strip 1 */
+    {2.36, 100}, {69.0267, 100},
+    /* 85 'U' strip 0 */
+    {11.54, 100}, {11.54, 28.5714}, {16.3019, 14.2857}, {25.8257, 4.7619}, {40.1114, 0}, {49.6352, 0},
+    {63.921, 4.7619}, {73.4448, 14.2857}, {78.2067, 28.5714}, {78.2067, 100},
+    /* 86 'V' strip 0 */
+    {2.36, 100}, {40.4552, 0},
+    /* 86 'V' strip 1 */
+    {78.5505, 100}, {40.4552, 0},
+    /* 87 'W' strip 0 */
+    {2.22, 100}, {26.0295, 0},
+    /* 87 'W' strip 1 */
+    {49.839, 100}, {26.0295, 0},
+    /* 87 'W' strip 2 */
+    {49.839, 100}, {73.6486, 0},
+    /* 87 'W' strip 3 */
+    {97.4581, 100}, {73.6486, 0},
+    /* 88 'X' strip 0 */
+    {2.5, 100}, {69.1667, 0},
+    /* 88 'X' strip 1 */
+    {69.1667, 100}, {2.5, 0},
+    /* 89 'Y' strip 0 */
+    {1.52, 100}, {39.6152, 52.381}, {39.6152, 0},
+    /* 89 'Y' strip 1 */
+    {77.7105, 100}, {39.6152, 52.381},
+    /* 90 'Z' strip 0 */
+    {69.1667, 100}, {2.5, 0},
+    /* 90 'Z' strip 1 */
+    {2.5, 100}, {69.1667, 100},
+    /* 90 'Z' strip 2 */
+    {2.5, 0}, {69.1667, 0},
+    /* 91 '[' strip 0 */
+    {7.78, 119.048}, {7.78, -33.3333},
+    /* 91 '[' strip 1 */
+    {12.5419, 119.048}, {12.5419, -33.3333},
+    /* 91 '[' strip 2 */
+    {7.78, 119.048}, {41.1133, 119.048},
+    /* 91 '[' strip 3 */
+    {7.78, -33.3333}, {41.1133, -33.3333},
+    /* 92 ' ' strip 0 */
+    {5.84, 100}, {72.5067, -14.2857},
+    /* 93 ']' strip 0 */
+    {33.0114, 119.048}, {33.0114, -33.3333},
+    /* 93 ']' strip 1 */
+    {37.7733, 119.048}, {37.7733, -33.3333},
+    /* 93 ']' strip 2 */
+    {4.44, 119.048}, {37.7733, 119.048},
+    /* 93 ']' strip 3 */
+    {4.44, -33.3333}, {37.7733, -33.3333},
+    /* 94 '^' strip 0 */
+    {44.0752, 109.524}, {5.98, 42.8571},
+    /* 94 '^' strip 1 */
+    {44.0752, 109.524}, {82.1705, 42.8571},
+    /* 95 '_' strip 0 */
+    {-1.1, -33.3333}, {103.662, -33.3333}, {103.662, -28.5714}, {-1.1, -28.5714}, {-1.1, -33.3333},
+    /* 96 '`' strip 0 */
+    {33.0219, 100}, {56.8314, 71.4286},
+    /* 96 '`' strip 1 */
+    {33.0219, 100}, {28.26, 95.2381}, {56.8314, 71.4286},
+    /* 97 'a' strip 0 */
+    {63.8229, 66.6667}, {63.8229, 0},
+    /* 97 'a' strip 1 */
+    {63.8229, 52.381}, {54.299, 61.9048}, {44.7752, 66.6667}, {30.4895, 66.6667}, {20.9657, 61.9048}, {11.4419, 52.381},
+    {6.68, 38.0952}, {6.68, 28.5714}, {11.4419, 14.2857}, {20.9657, 4.7619}, {30.4895, 0}, {44.7752, 0},
+    {54.299, 4.7619}, {63.8229, 14.2857},
+    /* 98 'b' strip 0 */
+    {8.76, 100}, {8.76, 0},
+    /* 98 'b' strip 1 */
+    {8.76, 52.381}, {18.2838, 61.9048}, {27.8076, 66.6667}, {42.0933, 66.6667}, {51.6171, 61.9048}, {61.141, 52.381},
+    {65.9029, 38.0952}, {65.9029, 28.5714}, {61.141, 14.2857}, {51.6171, 4.7619}, {42.0933, 0}, {27.8076, 0},
+    {18.2838, 4.7619}, {8.76, 14.2857},
+    /* 99 'c' strip 0 */
+    {62.6629, 52.381}, {53.139, 61.9048}, {43.6152, 66.6667}, {29.3295, 66.6667}, {19.8057, 61.9048}, {10.2819, 52.381},
+    {5.52, 38.0952}, {5.52, 28.5714}, {10.2819, 14.2857}, {19.8057, 4.7619}, {29.3295, 0}, {43.6152, 0},
+    {53.139, 4.7619}, {62.6629, 14.2857},
+    /* 100 'd' strip 0 */
+    {61.7829, 100}, {61.7829, 0},
+    /* 100 'd' strip 1 */
+    {61.7829, 52.381}, {52.259, 61.9048}, {42.7352, 66.6667}, {28.4495, 66.6667}, {18.9257, 61.9048}, {9.4019, 52.381},
+    {4.64, 38.0952}, {4.64, 28.5714}, {9.4019, 14.2857}, {18.9257, 4.7619}, {28.4495, 0}, {42.7352, 0},
+    {52.259, 4.7619}, {61.7829, 14.2857},
+    /* 101 'e' strip 0 */
+    {5.72, 38.0952}, {62.8629, 38.0952}, {62.8629, 47.619}, {58.101, 57.1429}, {53.339, 61.9048}, {43.8152, 66.6667},
+    {29.5295, 66.6667}, {20.0057, 61.9048}, {10.4819, 52.381}, {5.72, 38.0952}, {5.72, 28.5714}, {10.4819, 14.2857},
+    {20.0057, 4.7619}, {29.5295, 0}, {43.8152, 0}, {53.339, 4.7619}, {62.8629, 14.2857},
+    /* 102 'f' strip 0 */
+    {38.7752, 100}, {29.2514, 100}, {19.7276, 95.2381}, {14.9657, 80.9524}, {14.9657, 0},
+    /* 102 'f' strip 1 */
+    {0.68, 66.6667}, {34.0133, 66.6667},
+    /* 103 'g' strip 0 */
+    {62.5029, 66.6667}, {62.5029, -9.5238}, {57.741, -23.8095}, {52.979, -28.5714}, {43.4552, -33.3333}, {29.1695, -33.3333},
+    {19.6457, -28.5714},
+    /* 103 'g' strip 1 */
+    {62.5029, 52.381}, {52.979, 61.9048}, {43.4552, 66.6667}, {29.1695, 66.6667}, {19.6457, 61.9048}, {10.1219, 52.381},
+    {5.36, 38.0952}, {5.36, 28.5714}, {10.1219, 14.2857}, {19.6457, 4.7619}, {29.1695, 0}, {43.4552, 0},
+    {52.979, 4.7619}, {62.5029, 14.2857},
+    /* 104 'h' strip 0 */
+    {9.6, 100}, {9.6, 0},
+    /* 104 'h' strip 1 */
+    {9.6, 47.619}, {23.8857, 61.9048}, {33.4095, 66.6667}, {47.6952, 66.6667}, {57.219, 61.9048}, {61.981, 47.619},
+    {61.981, 0},
+    /* 105 'i' strip 0 */
+    {10.02, 100}, {14.7819, 95.2381}, {19.5438, 100}, {14.7819, 104.762}, {10.02, 100},
+    /* 105 'i' strip 1 */
+    {14.7819, 66.6667}, {14.7819, 0},
+    /* 106 'j' strip 0 */
+    {17.3876, 100}, {22.1495, 95.2381}, {26.9114, 100}, {22.1495, 104.762}, {17.3876, 100},
+    /* 106 'j' strip 1 */
+    {22.1495, 66.6667}, {22.1495, -14.2857}, {17.3876, -28.5714}, {7.8638, -33.3333}, {-1.66, -33.3333},
+    /* 107 'k' strip 0 */
+    {9.6, 100}, {9.6, 0},
+    /* 107 'k' strip 1 */
+    {57.219, 66.6667}, {9.6, 19.0476},
+    /* 107 'k' strip 2 */
+    {28.6476, 38.0952}, {61.981, 0},
+    /* 108 'l' strip 0 */
+    {10.02, 100}, {10.02, 0},
+    /* 109 'm' strip 0 */
+    {9.6, 66.6667}, {9.6, 0},
+    /* 109 'm' strip 1 */
+    {9.6, 47.619}, {23.8857, 61.9048}, {33.4095, 66.6667}, {47.6952, 66.6667}, {57.219, 61.9048}, {61.981, 47.619},
+    {61.981, 0},
+    /* 109 'm' strip 2 */
+    {61.981, 47.619}, {76.2667, 61.9048}, {85.7905, 66.6667}, {100.076, 66.6667}, {109.6, 61.9048}, {114.362, 47.619},
+    {114.362, 0},
+    /* 110 'n' strip 0 */
+    {9.18, 66.6667}, {9.18, 0},
+    /* 110 'n' strip 1 */
+    {9.18, 47.619}, {23.4657, 61.9048}, {32.9895, 66.6667}, {47.2752, 66.6667}, {56.799, 61.9048}, {61.561, 47.619},
+    {61.561, 0},
+    /* 111 'o' strip 0 */
+    {28.7895, 66.6667}, {19.2657, 61.9048}, {9.7419, 52.381}, {4.98, 38.0952}, {4.98, 28.5714}, {9.7419, 14.2857},
+    {19.2657, 4.7619}, {28.7895, 0}, {43.0752, 0}, {52.599, 4.7619}, {62.1229, 14.2857}, {66.8848, 28.5714},
+    {66.8848, 38.0952}, {62.1229, 52.381}, {52.599, 61.9048}, {43.0752, 66.6667}, {28.7895, 66.6667},
+    /* 112 'p' strip 0 */
+    {9.46, 66.6667}, {9.46, -33.3333},
+    /* 112 'p' strip 1 */
+    {9.46, 52.381}, {18.9838, 61.9048}, {28.5076, 66.6667}, {42.7933, 66.6667}, {52.3171, 61.9048}, {61.841, 52.381},
+    {66.6029, 38.0952}, {66.6029, 28.5714}, {61.841, 14.2857}, {52.3171, 4.7619}, {42.7933, 0}, {28.5076, 0},
+    {18.9838, 4.7619}, {9.46, 14.2857},
+    /* 113 'q' strip 0 */
+    {61.9829, 66.6667}, {61.9829, -33.3333},
+    /* 113 'q' strip 1 */
+    {61.9829, 52.381}, {52.459, 61.9048}, {42.9352, 66.6667}, {28.6495, 66.6667}, {19.1257, 61.9048}, {9.6019, 52.381},
+    {4.84, 38.0952}, {4.84, 28.5714}, {9.6019, 14.2857}, {19.1257, 4.7619}, {28.6495, 0}, {42.9352, 0},
+    {52.459, 4.7619}, {61.9829, 14.2857},
+    /* 114 'r' strip 0 */
+    {9.46, 66.6667}, {9.46, 0},
+    /* 114 'r' strip 1 */
+    {9.46, 38.0952}, {14.2219, 52.381}, {23.7457, 61.9048}, {33.2695, 66.6667}, {47.5552, 66.6667},
+    /* 115 's' strip 0 */
+    {57.081, 52.381}, {52.319, 61.9048}, {38.0333, 66.6667}, {23.7476, 66.6667}, {9.4619, 61.9048}, {4.7, 52.381},
+    {9.4619, 42.8571}, {18.9857, 38.0952}, {42.7952, 33.3333}, {52.319, 28.5714}, {57.081, 19.0476}, {57.081, 14.2857},
+    {52.319, 4.7619}, {38.0333, 0}, {23.7476, 0}, {9.4619, 4.7619}, {4.7, 14.2857},
+    /* 116 't' strip 0 */
+    {14.8257, 100}, {14.8257, 19.0476}, {19.5876, 4.7619}, {29.1114, 0}, {38.6352, 0},
+    /* 116 't' strip 1 */
+    {0.54, 66.6667}, {33.8733, 66.6667},
+    /* 117 'u' strip 0 */
+    {9.46, 66.6667}, {9.46, 19.0476}, {14.2219, 4.7619}, {23.7457, 0}, {38.0314, 0}, {47.5552, 4.7619},
+    {61.841, 19.0476},
+    /* 117 'u' strip 1 */
+    {61.841, 66.6667}, {61.841, 0},
+    /* 118 'v' strip 0 */
+    {1.8, 66.6667}, {30.3714, 0},
+    /* 118 'v' strip 1 */
+    {58.9429, 66.6667}, {30.3714, 0},
+    /* 119 'w' strip 0 */
+    {2.5, 66.6667}, {21.5476, 0},
+    /* 119 'w' strip 1 */
+    {40.5952, 66.6667}, {21.5476, 0},
+    /* 119 'w' strip 2 */
+    {40.5952, 66.6667}, {59.6429, 0},
+    /* 119 'w' strip 3 */
+    {78.6905, 66.6667}, {59.6429, 0},
+    /* 120 'x' strip 0 */
+    {1.66, 66.6667}, {54.041, 0},
+    /* 120 'x' strip 1 */
+    {54.041, 66.6667}, {1.66, 0},
+    /* 121 'y' strip 0 */
+    {6.5619, 66.6667}, {35.1333, 0},
+    /* 121 'y' strip 1 */
+    {63.7048, 66.6667}, {35.1333, 0}, {25.6095, -19.0476}, {16.0857, -28.5714}, {6.5619, -33.3333}, {1.8, -33.3333},
+    /* 122 'z' strip 0 */
+    {56.821, 66.6667}, {4.44, 0},
+    /* 122 'z' strip 1 */
+    {4.44, 66.6667}, {56.821, 66.6667},
+    /* 122 'z' strip 2 */
+    {4.44, 0}, {56.821, 0},
+    /* 123 '{' strip 0 */
+    {31.1895, 119.048}, {21.6657, 114.286}, {16.9038, 109.524}, {12.1419, 100}, {12.1419, 90.4762}, {16.9038, 80.9524},
+    {21.6657, 76.1905}, {26.4276, 66.6667}, {26.4276, 57.1429}, {16.9038, 47.619},
+    /* 123 '{' strip 1 */
+    {21.6657, 114.286}, {16.9038, 104.762}, {16.9038, 95.2381}, {21.6657, 85.7143}, {26.4276, 80.9524}, {31.1895, 71.4286},
+    {31.1895, 61.9048}, {26.4276, 52.381}, {7.38, 42.8571}, {26.4276, 33.3333}, {31.1895, 23.8095}, {31.1895, 14.2857},
+    {26.4276, 4.7619}, {21.6657, 0}, {16.9038, -9.5238}, {16.9038, -19.0476}, {21.6657, -28.5714},
+    /* 123 '{' strip 2 */
+    {16.9038, 38.0952}, {26.4276, 28.5714}, {26.4276, 19.0476}, {21.6657, 9.5238}, {16.9038, 4.7619}, {12.1419, -4.7619},
+    {12.1419, -14.2857}, {16.9038, -23.8095}, {21.6657, -28.5714}, {31.1895, -33.3333},
+    /* 124 '|' strip 0 */
+    {11.54, 119.048}, {11.54, -33.3333},
+    /* 125 '}' strip 0 */
+    {9.18, 119.048}, {18.7038, 114.286}, {23.4657, 109.524}, {28.2276, 100}, {28.2276, 90.4762}, {23.4657, 80.9524},
+    {18.7038, 76.1905}, {13.9419, 66.6667}, {13.9419, 57.1429}, {23.4657, 47.619},
+    /* 125 '}' strip 1 */
+    {18.7038, 114.286}, {23.4657, 104.762}, {23.4657, 95.2381}, {18.7038, 85.7143}, {13.9419, 80.9524}, {9.18, 71.4286},
+    {9.18, 61.9048}, {13.9419, 52.381}, {32.9895, 42.8571}, {13.9419, 33.3333}, {9.18, 23.8095}, {9.18, 14.2857},
+    {13.9419, 4.7619}, {18.7038, 0}, {23.4657, -9.5238}, {23.4657, -19.0476}, {18.7038, -28.5714},
+    /* 125 '}' strip 2 */
+    {23.4657, 38.0952}, {13.9419, 28.5714}, {13.9419, 19.0476}, {18.7038, 9.5238}, {23.4657, 4.7619}, {28.2276, -4.7619},
+    {28.2276, -14.2857}, {23.4657, -23.8095}, {18.7038, -28.5714}, {9.18, -33.3333},
+    /* 126 '~' strip 0 */
+    {2.92, 28.5714}, {2.92, 38.0952}, {7.6819, 52.381}, {17.2057, 57.1429}, {26.7295, 57.1429}, {36.2533, 52.381},
+    {55.301, 38.0952}, {64.8248, 33.3333}, {74.3486, 33.3333}, {83.8724, 38.0952}, {88.6343, 47.619},
+    /* 126 '~' strip 1 */
+    {2.92, 38.0952}, {7.6819, 47.619}, {17.2057, 52.381}, {26.7295, 52.381}, {36.2533, 47.619}, {55.301, 33.3333},
+    {64.8248, 28.5714}, {74.3486, 28.5714}, {83.8724, 33.3333}, {88.6343, 47.619}, {88.6343, 57.1429},
+    /* 127 ' ' strip 0 */
+    {52.381, 100}, {14.2857, -33.3333},
+    /* 127 ' ' strip 1 */
+    {28.5714, 66.6667}, {14.2857, 61.9048}, {4.7619, 52.381}, {0, 38.0952}, {0, 23.8095}, {4.7619, 14.2857},
+    {14.2857, 4.7619}, {28.5714, 0}, {38.0952, 0}, {52.381, 4.7619}, {61.9048, 14.2857}, {66.6667, 28.5714},
+    {66.6667, 42.8571}, {61.9048, 52.381}, {52.381, 61.9048}, {38.0952, 66.6667}, {28.5714, 66.6667},
+};
+
+/*! Strips of every character, pointing into vertices */
+static const StrokeStrip strips[] = {
+    {2, &vertices[0]}, {5, &vertices[2]}, /* 33 */
+    {2, &vertices[7]}, {2, &vertices[9]}, /* 34 */
+    {2, &vertices[11]}, {2, &vertices[13]}, {2, &vertices[15]}, {2, &vertices[17]}, /* 35 */
+    {2, &vertices[19]}, {2, &vertices[21]}, {20, &vertices[23]}, /* 36 */
+    {2, &vertices[43]}, {16, &vertices[45]}, {11, &vertices[61]}, /* 37 */
+    {34, &vertices[72]}, /* 38 */
+    {2, &vertices[106]}, /* 39 */
+    {10, &vertices[108]}, /* 40 */
+    {10, &vertices[118]}, /* 41 */
+    {2, &vertices[128]}, {2, &vertices[130]}, {2, &vertices[132]}, /* 42 */
+    {2, &vertices[134]}, {2, &vertices[136]}, /* 43 */
+    {8, &vertices[138]}, /* 44 */
+    {2, &vertices[146]}, /* 45 */
+    {5, &vertices[148]}, /* 46 */
+    {2, &vertices[153]}, /* 47 */
+    {17, &vertices[155]}, /* 48 */
+    {4, &vertices[172]}, /* 49 */
+    {14, &vertices[176]}, /* 50 */
+    {15, &vertices[190]}, /* 51 */
+    {3, &vertices[205]}, {2, &vertices[208]}, /* 52 */
+    {17, &vertices[210]}, /* 53 */
+    {23, &vertices[227]}, /* 54 */
+    {2, &vertices[250]}, {2, &vertices[252]}, /* 55 */
+    {29, &vertices[254]}, /* 56 */
+    {23, &vertices[283]}, /* 57 */
+    {5, &vertices[306]}, {5, &vertices[311]}, /* 58 */
+    {5, &vertices[316]}, {8, &vertices[321]}, /* 59 */
+    {3, &vertices[329]}, /* 60 */
+    {2, &vertices[332]}, {2, &vertices[334]}, /* 61 */
+    {3, &vertices[336]}, /* 62 */
+    {14, &vertices[339]}, {5, &vertices[353]}, /* 63 */
+    {8, &vertices[358]}, {19, &vertices[366]}, /* 64 */
+    {2, &vertices[385]}, {2, &vertices[387]}, {2, &vertices[389]}, /* 65 */
+    {2, &vertices[391]}, {9, &vertices[393]}, {10, &vertices[402]}, /* 66 */
+    {18, &vertices[412]}, /* 67 */
+    {2, &vertices[430]}, {12, &vertices[432]}, /* 68 */
+    {2, &vertices[444]}, {2, &vertices[446]}, {2, &vertices[448]}, {2, &vertices[450]}, /* 69 */
+    {2, &vertices[452]}, {2, &vertices[454]}, {2, &vertices[456]}, /* 70 */
+    {19, &vertices[458]}, {2, &vertices[477]}, /* 71 */
+    {2, &vertices[479]}, {2, &vertices[481]}, {2, &vertices[483]}, /* 72 */
+    {2, &vertices[485]}, /* 73 */
+    {10, &vertices[487]}, /* 74 */
+    {2, &vertices[497]}, {2, &vertices[499]}, {2, &vertices[501]}, /* 75 */
+    {2, &vertices[503]}, {2, &vertices[505]}, /* 76 */
+    {2, &vertices[507]}, {2, &vertices[509]}, {2, &vertices[511]}, {2, &vertices[513]}, /* 77 */
+    {2, &vertices[515]}, {2, &vertices[517]}, {2, &vertices[519]}, /* 78 */
+    {21, &vertices[521]}, /* 79 */
+    {2, &vertices[542]}, {10, &vertices[544]}, /* 80 */
+    {21, &vertices[554]}, {2, &vertices[575]}, /* 81 */
+    {2, &vertices[577]}, {10, &vertices[579]}, {2, &vertices[589]}, /* 82 */
+    {20, &vertices[591]}, /* 83 */
+    {2, &vertices[611]}, {2, &vertices[613]}, /* 84 */
+    {10, &vertices[615]}, /* 85 */
+    {2, &vertices[625]}, {2, &vertices[627]}, /* 86 */
+    {2, &vertices[629]}, {2, &vertices[631]}, {2, &vertices[633]}, {2, &vertices[635]}, /* 87 */
+    {2, &vertices[637]}, {2, &vertices[639]}, /* 88 */
+    {3, &vertices[641]}, {2, &vertices[644]}, /* 89 */
+    {2, &vertices[646]}, {2, &vertices[648]}, {2, &vertices[650]}, /* 90 */
+    {2, &vertices[652]}, {2, &vertices[654]}, {2, &vertices[656]}, {2, &vertices[658]}, /* 91 */
+    {2, &vertices[660]}, /* 92 */
+    {2, &vertices[662]}, {2, &vertices[664]}, {2, &vertices[666]}, {2, &vertices[668]}, /* 93 */
+    {2, &vertices[670]}, {2, &vertices[672]}, /* 94 */
+    {5, &vertices[674]}, /* 95 */
+    {2, &vertices[679]}, {3, &vertices[681]}, /* 96 */
+    {2, &vertices[684]}, {14, &vertices[686]}, /* 97 */
+    {2, &vertices[700]}, {14, &vertices[702]}, /* 98 */
+    {14, &vertices[716]}, /* 99 */
+    {2, &vertices[730]}, {14, &vertices[732]}, /* 100 */
+    {17, &vertices[746]}, /* 101 */
+    {5, &vertices[763]}, {2, &vertices[768]}, /* 102 */
+    {7, &vertices[770]}, {14, &vertices[777]}, /* 103 */
+    {2, &vertices[791]}, {7, &vertices[793]}, /* 104 */
+    {5, &vertices[800]}, {2, &vertices[805]}, /* 105 */
+    {5, &vertices[807]}, {5, &vertices[812]}, /* 106 */
+    {2, &vertices[817]}, {2, &vertices[819]}, {2, &vertices[821]}, /* 107 */
+    {2, &vertices[823]}, /* 108 */
+    {2, &vertices[825]}, {7, &vertices[827]}, {7, &vertices[834]}, /* 109 */
+    {2, &vertices[841]}, {7, &vertices[843]}, /* 110 */
+    {17, &vertices[850]}, /* 111 */
+    {2, &vertices[867]}, {14, &vertices[869]}, /* 112 */
+    {2, &vertices[883]}, {14, &vertices[885]}, /* 113 */
+    {2, &vertices[899]}, {5, &vertices[901]}, /* 114 */
+    {17, &vertices[906]}, /* 115 */
+    {5, &vertices[923]}, {2, &vertices[928]}, /* 116 */
+    {7, &vertices[930]}, {2, &vertices[937]}, /* 117 */
+    {2, &vertices[939]}, {2, &vertices[941]}, /* 118 */
+    {2, &vertices[943]}, {2, &vertices[945]}, {2, &vertices[947]}, {2, &vertices[949]}, /* 119 */
+    {2, &vertices[951]}, {2, &vertices[953]}, /* 120 */
+    {2, &vertices[955]}, {6, &vertices[957]}, /* 121 */
+    {2, &vertices[963]}, {2, &vertices[965]}, {2, &vertices[967]}, /* 122 */
+    {10, &vertices[969]}, {17, &vertices[979]}, {10, &vertices[996]}, /* 123 */
+    {2, &vertices[1006]}, /* 124 */
+    {10, &vertices[1008]}, {17, &vertices[1018]}, {10, &vertices[1035]}, /* 125 */
+    {11, &vertices[1045]}, {11, &vertices[1056]}, /* 126 */
+    {2, &vertices[1067]}, {17, &vertices[1069]}, /* 127 */
+};
+
+/*! Advance and strips of every character, characters without a glyph have no strips */
+static const StrokeChar characters[] = {
+    {0, 0, NULL}, /* 0 */
+    {0, 0, NULL}, /* 1 */
+    {0, 0, NULL}, /* 2 */
+    {0, 0, NULL}, /* 3 */
+    {0, 0, NULL}, /* 4 */
+    {0, 0, NULL}, /* 5 */
+    {0, 0, NULL}, /* 6 */
+    {0, 0, NULL}, /* 7 */
+    {0, 0, NULL}, /* 8 */
+    {0, 0, NULL}, /* 9 */
+    {0, 0, NULL}, /* 10 */
+    {0, 0, NULL}, /* 11 */
+    {0, 0, NULL}, /* 12 */
+    {0, 0, NULL}, /* 13 */
+    {0, 0, NULL}, /* 14 */
+    {0, 0, NULL}, /* 15 */
+    {0, 0, NULL}, /* 16 */
+    {0, 0, NULL}, /* 17 */
+    {0, 0, NULL}, /* 18 */
+    {0, 0, NULL}, /* 19 */
+    {0, 0, NULL}, /* 20 */
+    {0, 0, NULL}, /* 21 */
+    {0, 0, NULL}, /* 22 */
+    {0, 0, NULL}, /* 23 */
+    {0, 0, NULL}, /* 24 */
+    {0, 0, NULL}, /* 25 */
+    {0, 0, NULL}, /* 26 */
+    {0, 0, NULL}, /* 27 */
+    {0, 0, NULL}, /* 28 */
+    {0, 0, NULL}, /* 29 */
+    {0, 0, NULL}, /* 30 */
+    {0, 0, NULL}, /* 31 */
+    {104.762, 0, &strips[0]}, /* 32 */
+    {26.6238, 2, &strips[0]}, /* 33 */
+    {51.4352, 2, &strips[2]}, /* 34 */
+    {79.4886, 4, &strips[4]}, /* 35 */
+    {76.2067, 3, &strips[8]}, /* 36 */
+    {96.5743, 3, &strips[11]}, /* 37 */
+    {101.758, 1, &strips[14]}, /* 38 */
+    {13.62, 1, &strips[15]}, /* 39 */
+    {47.1733, 1, &strips[16]}, /* 40 */
+    {47.5333, 1, &strips[17]}, /* 41 */
+    {59.439, 3, &strips[18]}, /* 42 */
+    {97.2543, 2, &strips[21]}, /* 43 */
+    {26.0638, 1, &strips[23]}, /* 44 */
+    {100.754, 1, &strips[24]}, /* 45 */
+    {26.4838, 1, &strips[25]}, /* 46 */
+    {82.1067, 1, &strips[26]}, /* 47 */
+    {77.0667, 1, &strips[27]}, /* 48 */
+    {66.5295, 1, &strips[28]}, /* 49 */
+    {77.6467, 1, &strips[29]}, /* 50 */
+    {77.0467, 1, &strips[30]}, /* 51 */
+    {80.1686, 2, &strips[31]}, /* 52 */
+    {77.6867, 1, &strips[33]}, /* 53 */
+    {73.8048, 1, &strips[34]}, /* 54 */
+    {77.2267, 2, &strips[35]}, /* 55 */
+    {77.6667, 1, &strips[37]}, /* 56 */
+    {74.0648, 1, &strips[38]}, /* 57 */
+    {26.2238, 2, &strips[39]}, /* 58 */
+    {26.3038, 2, &strips[41]}, /* 59 */
+    {81.6105, 1, &strips[43]}, /* 60 */
+    {97.2543, 2, &strips[44]}, /* 61 */
+    {81.6105, 1, &strips[46]}, /* 62 */
+    {73.9029, 2, &strips[47]}, /* 63 */
+    {74.3648, 2, &strips[49]}, /* 64 */
+    {80.4905, 3, &strips[51]}, /* 65 */
+    {83.6267, 3, &strips[54]}, /* 66 */
+    {84.4886, 1, &strips[57]}, /* 67 */
+    {85.2867, 2, &strips[58]}, /* 68 */
+    {78.1848, 4, &strips[60]}, /* 69 */
+    {78.7448, 3, &strips[64]}, /* 70 */
+    {89.7686, 2, &strips[67]}, /* 71 */
+    {89.0867, 3, &strips[69]}, /* 72 */
+    {21.3, 1, &strips[72]}, /* 73 */
+    {59.999, 1, &strips[73]}, /* 74 */
+    {79.3267, 3, &strips[74]}, /* 75 */
+    {71.3229, 2, &strips[77]}, /* 76 */
+    {97.2105, 4, &strips[79]}, /* 77 */
+    {88.8067, 3, &strips[83]}, /* 78 */
+    {88.8305, 1, &strips[86]}, /* 79 */
+    {85.6667, 2, &strips[87]}, /* 80 */
+    {88.0905, 2, &strips[89]}, /* 81 */
+    {82.3667, 3, &strips[91]}, /* 82 */
+    {80.8267, 1, &strips[94]}, /* 83 */
+    {71.9467, 2, &strips[95]}, /* 84 */
+    {89.4867, 1, &strips[97]}, /* 85 */
+    {81.6105, 2, &strips[98]}, /* 86 */
+    {100.518, 4, &strips[100]}, /* 87 */
+    {72.3667, 2, &strips[104]}, /* 88 */
+    {79.6505, 2, &strips[106]}, /* 89 */
+    {73.7467, 3, &strips[108]}, /* 90 */
+    {46.1133, 4, &strips[111]}, /* 91 */
+    {78.2067, 1, &strips[115]}, /* 92 */
+    {46.3933, 4, &strips[116]}, /* 93 */
+    {90.2305, 2, &strips[120]}, /* 94 */
+    {104.062, 1, &strips[122]}, /* 95 */
+    {83.5714, 2, &strips[123]}, /* 96 */
+    {66.6029, 2, &strips[125]}, /* 97 */
+    {70.4629, 2, &strips[127]}, /* 98 */
+    {68.9229, 1, &strips[129]}, /* 99 */
+    {70.2629, 2, &strips[130]}, /* 100 */
+    {68.5229, 1, &strips[132]}, /* 101 */
+    {38.6552, 2, &strips[133]}, /* 102 */
+    {70.9829, 2, &strips[135]}, /* 103 */
+    {71.021, 2, &strips[137]}, /* 104 */
+    {28.8638, 2, &strips[139]}, /* 105 */
+    {36.2314, 2, &strips[141]}, /* 106 */
+    {62.521, 3, &strips[143]}, /* 107 */
+    {19.34, 1, &strips[146]}, /* 108 */
+    {123.962, 3, &strips[147]}, /* 109 */
+    {70.881, 2, &strips[150]}, /* 110 */
+    {71.7448, 1, &strips[152]}, /* 111 */
+    {70.8029, 2, &strips[153]}, /* 112 */
+    {70.7429, 2, &strips[155]}, /* 113 */
+    {49.4952, 2, &strips[157]}, /* 114 */
+    {62.321, 1, &strips[159]}, /* 115 */
+    {39.3152, 2, &strips[160]}, /* 116 */
+    {71.161, 2, &strips[162]}, /* 117 */
+    {60.6029, 2, &strips[164]}, /* 118 */
+    {80.4905, 4, &strips[166]}, /* 119 */
+    {56.401, 2, &strips[170]}, /* 120 */
+    {66.0648, 2, &strips[172]}, /* 121 */
+    {61.821, 3, &strips[174]}, /* 122 */
+    {41.6295, 3, &strips[177]}, /* 123 */
+    {23.78, 1, &strips[180]}, /* 124 */
+    {41.4695, 3, &strips[181]}, /* 125 */
+    {91.2743, 2, &strips[184]}, /* 126 */
+    {66.6667, 2, &strips[186]}, /* 127 */
+};
+
+const StrokeFont strokeRoman = {"Roman", sizeof(characters)/sizeof(characters[0]), 152.381f, characters};
@@ -0,0 +1,376 @@
+/*!
+    /file Tessellator.cpp
+    /brief Triangles covering filled and stroked outlines
+    Fills are cut into horizontal bands at every vertex and every crossing of
+    two edges, each band holding spans of the inside between pairs of edges.
+    Spans continuing one another from band to band, across the vertices and
+    crossings of their edges, make up regions monotone in y, each cut into
+    triangles once it ends. Concave contours, holes and self-intersecting
+    contours are filled by the nonzero or the even-odd rule.
+*/
+
+#include "./headers/Tessellator.h"
+#include <algorithm>
+#include <math.h>
+
+/*!
+    \struct FillEdge
+    \brief Edge of a fill, from its top (smaller y) to its bottom
+*/
+struct FillEdge{
+    GLfloat x0, y0, y1;
+    GLfloat slope; /*!< Change of x per unit of y */
+    GLint winding; /*!< 1 when the contour runs down the edge, -1 up */
+    GLfloat xAt(GLfloat y) const { return x0 + (y - y0) * slope; }
+};
+
+/*!
+    \struct BandEdge
+    \brief Edge crossing a band with its x at the top and bottom of the band
+*/
+struct BandEdge{
+    GLint edge;
+    GLfloat top, bottom;
+    bool operator<(const BandEdge &other) const {
+        return top < other.top || (top == other.top && bottom < other.bottom);
+    }
+};
+
+/*!
+    \struct FillRegion
+    \brief Part of a fill monotone in y, between a left and a right chain of points
+*/
+struct FillRegion{
+    GLint left, right; /*!< Edges bounding the region in the current band */
+    std::vector<GLfloat> leftChain, rightChain; /*!< x, y of the chain points, top to bottom */
+};
+
+/*!
+    \struct ChainPoint
+    \brief Point of a monotone region and the chain it is on, 0 left and 1 right
+*/
+struct ChainPoint{
+    GLfloat x, y;
+    GLint side;
+};
+
+/*!
+    \fn Outline::moveTo(GLfloat x, GLfloat y)
+    \brief Start a new contour at x, y
+*/
+void Outline::moveTo(GLfloat x, GLfloat y){
+    points.push_back(x);
+    points.push_back(y);
+    ends.push_back(points.size()/2);
+    closed.push_back(0);
+}
+
+/*!
+    \fn Outline::lineTo(GLfloat x, GLfloat y)
+    \brief Extend the contour to x, y, starting one there when there is none
+*/
+void Outline::lineTo(GLfloat x, GLfloat y){
+    if(ends.empty()){
+        moveTo(x, y);
+        return;
+    }
+    points.push_back(x);
+    points.push_back(y);
+    ends.back() = points.size()/2;
+}
+
+/*!
+    \fn Outline::close()
+    \brief Close the contour back to its first point
+*/
+void Outline::close(){
+    if(!closed.empty())
+        closed.back() = 1;
+}
+
+/*!
+    \fn Outline::clear()
+    \brief Drop every contour
+*/
+void Outline::clear(){
+    points.clear();
+    ends.clear();
+    closed.clear();
+}
+
+/*!
+    \fn Outline::noOfPoints()
+    \brief Points of every contour
+*/
+GLint Outline::noOfPoints(){
+    return points.size()/2;
+}
+
+/*!
+    \fn addTriangle(std::vector<GLfloat> *triangles, GLfloat ax, GLfloat ay, GLfloat bx, GLfloat by, GLfloat cx, GLfloat cy)
+    \brief Append a triangle unless it has no area
+*/
+static void addTriangle(std::vector<GLfloat> *triangles, GLfloat ax, GLfloat ay, GLfloat bx, GLfloat by, GLfloat cx, GLfloat cy){
+    if((bx - ax) * (cy - ay) - (cx - ax) * (by - ay) == 0)
+        return;
+    GLfloat corners[] = {ax, ay, bx, by, cx, cy};
+    triangles->insert(triangles->end(), corners, corners + 6);
+}
+
+/*!
+    \fn addChainTriangle(std::vector<GLfloat> *triangles, const ChainPoint *a, const ChainPoint *b, const ChainPoint *c)
+    \brief Append the triangle between three points of a monotone region
+*/
+static void addChainTriangle(std::vector<GLfloat> *triangles, const ChainPoint *a, const ChainPoint *b, const ChainPoint *c){
+    addTriangle(triangles, a->x, a->y, b->x, b->y, c->x, c->y);
+}
+
+/*!
+    \fn triangulateRegion(std::vector<GLfloat> *triangles, const FillRegion *region, std::vector<ChainPoint> *points, std::vector<ChainPoint> *stack)
+    \brief Append the triangles of a monotone region, n - 2 of them for n points
+    Points are visited down in y, left before right at the same y. The stack
+    holds the points not cut off yet, which form a reflex chain; every point
+    cuts off the triangles it sees inside the region from there. points and
+    stack are scratch space kept between regions.
+*/
+static void triangulateRegion(std::vector<GLfloat> *triangles, const FillRegion *region, std::vector<ChainPoint> *points, std::vector<ChainPoint> *stack){
+    const std::vector<GLfloat> &left = region->leftChain, &right = region->rightChain;
+    size_t leftEnd = left.size()/2, rightEnd = right.size()/2;
+    points->clear();
+    ChainPoint top = {left[0], left[1], 0};
+    points->push_back(top);
+    size_t i = 1, j = right[0] == left[0] && right[1] == left[1] ? 1 : 0;
+    if(left[2*leftEnd - 2] == right[2*rightEnd - 2] && left[2*leftEnd - 1] == right[2*rightEnd - 1])
+        leftEnd--; /*!< A bottom point shared by both chains is taken once, from the right one */
+    while(i < leftEnd || j < rightEnd){
+        GLint fromLeft = j >= rightEnd || (i < leftEnd && (left[2*i + 1] < right[2*j + 1] ||
+            (left[2*i + 1] == right[2*j + 1] && left[2*i] <= right[2*j])));
+        const GLfloat *p = fromLeft ? &left[2*i++] : &right[2*j++];
+        ChainPoint point = {p[0], p[1], fromLeft ? 0 : 1};
+        points->push_back(point);
+    }
+    if(points->size() < 3)
+        return;
+    stack->assign(points->begin(), points->begin() + 2);
+    for(size_t k=2;k+1<points->size();k++){
+        ChainPoint p = (*points)[k];
+        if(p.side != stack->back().side){
+            for(size_t s=0;s+1<stack->size();s++)
+                addChainTriangle(triangles, &p, &(*stack)[s], &(*stack)[s + 1]);
+            ChainPoint previous = stack->back();
+            stack->clear();
+            stack->push_back(previous);
+            stack->push_back(p);
+            continue;
+        }
+        ChainPoint last = stack->back();
+        stack->pop_back();
+        while(!stack->empty()){
+            const ChainPoint &before = stack->back();
+            GLfloat turn = (last.x - before.x) * (p.y - last.y) - (last.y - before.y) * (p.x - last.x);
+            if(p.side == 0 ? turn >= 0 : turn <= 0)
+                break; /*!< last is reflex, p cannot see before past it */
+            addChainTriangle(triangles, &p, &last, &before);
+            last = before;
+            stack->pop_back();
+        }
+        stack->push_back(last);
+        stack->push_back(p);
+    }
+    for(size_t s=0;s+1<stack->size();s++)
+        addChainTriangle(triangles, &points->back(), &(*stack)[s], &(*stack)[s + 1]);
+}
+
+/*!
+    \fn addChainPoint(std::vector<GLfloat> *chain, GLfloat x, GLfloat y)
+    \brief Append x, y to the chain of a region
+*/
+static void addChainPoint(std::vector<GLfloat> *chain, GLfloat x, GLfloat y){
+    chain->push_back(x);
+    chain->push_back(y);
+}
+
+/*!
+    \fn tessellateFill(const Outline *outline, GLint evenOdd, std::vector<GLfloat> *triangles)
+    \brief Append triangles covering the inside of outline, returns the number appended
+    Every contour is taken as closed. The inside is where the contours wind
+    around a nonzero number of times, or an odd number of times with evenOdd.
+    Triangles are x, y of their three corners.
+    A span continues the region of the span above it when both start and end
+    at the same points at the band boundary. Otherwise the region above ends
+    and a new one starts, as at the vertices where the inside splits or joins.
+*/
+GLint tessellateFill(const Outline *outline, GLint evenOdd, std::vector<GLfloat> *triangles){
+    std::vector<FillEdge> edges;
+    std::vector<GLfloat> ys;
+    size_t added = triangles->size();
+    GLfloat extent = 0;
+    for(size_t c=0, start=0;c<outline->ends.size();start=outline->ends[c++]){
+        size_t end = outline->ends[c];
+        for(size_t i=start;i<end;i++){
+            const GLfloat *p = &outline->points[2*i], *q = &outline->points[2*(i + 1 < end ? i + 1 : start)];
+            ys.push_back(p[1]);
+            extent = std::max(extent, std::max(fabsf(p[0]), fabsf(p[1])));
+            if(p[1] == q[1])
+                continue; /*!< Horizontal edges bound no band */
+            const GLfloat *top = p[1] < q[1] ? p : q, *bottom = p[1] < q[1] ? q : p;
+            FillEdge edge = {top[0], top[1], bottom[1], (bottom[0] - top[0]) / (bottom[1] - top[1]), p[1] < q[1] ? 1 : -1};
+            edges.push_back(edge);
+        }
+    }
+    if(edges.empty())
+        return 0;
+    GLfloat tolerance = (extent + 1) * 1e-5f; /*!< Points this close are the same, as two edges give them */
+    std::sort(ys.begin(), ys.end());
+    ys.erase(std::unique(ys.begin(), ys.end()), ys.end());
+    std::sort(edges.begin(), edges.end(), [](const FillEdge &a, const FillEdge &b){ return a.y0 < b.y0; });
+    std::vector<GLint> open, stillOpen, unused;
+    std::vector<BandEdge> band;
+    std::vector<FillRegion> regions;
+    std::vector<ChainPoint> points, stack;
+    /*! End region r at y, the bottom being one point when its chains meet */
+    auto closeRegion = [&](GLint r, GLfloat y){
+        FillRegion *region = &regions[r];
+        GLfloat left = edges[region->left].xAt(y), right = edges[region->right].xAt(y);
+        addChainPoint(&region->leftChain, left, y);
+        addChainPoint(&region->rightChain, right - left <= tolerance ? left : right, y);
+        triangulateRegion(triangles, region, &points, &stack);
+        unused.push_back(r);
+    };
+    size_t next = 0;
+    for(size_t k=0;k+1<ys.size();k++){
+        GLfloat y = ys[k], yEnd = ys[k + 1];
+        band.erase(std::remove_if(band.begin(), band.end(), [&edges, y](const BandEdge &e){ return edges[e.edge].y1 <= y; }), band.end());
+        while(next < edges.size() && edges[next].y0 <= y){
+            BandEdge entering = {(GLint)next++, 0, 0};
+            band.push_back(entering);
+        }
+        while(y < yEnd){
+            /*! The band keeps its order from the one above, so insertion sort only moves edges entering or crossing */
+            for(size_t i=0;i<band.size();i++){
+                band[i].top = edges[band[i].edge].xAt(y);
+                band[i].bottom = edges[band[i].edge].xAt(yEnd);
+            }
+            for(size_t i=1;i<band.size();i++)
+                for(size_t j=i;j>0 && band[j] < band[j - 1];j--)
+                    std::swap(band[j], band[j - 1]);
+            /*! The first crossing of two edges is between edges next to each other at the top, the band ends there.
+                Edges crossing so close to the top that it rounds to y have crossed already and swap places. */
+            GLfloat bandEnd = yEnd;
+            for(GLint i=0;i+1<(GLint)band.size();i++){
+                if(band[i].bottom <= band[i + 1].bottom)
+                    continue;
+                GLfloat apart = band[i + 1].top - band[i].top;
+                GLfloat crossing = y + (yEnd - y) * apart / (apart - (band[i + 1].bottom - band[i].bottom));
+                if(crossing > y){
+                    bandEnd = std::min(bandEnd, crossing);
+                    continue;
+                }
+                std::swap(band[i], band[i + 1]);
+                i = std::max(i - 2, -1); /*!< The edge moved left may cross its new neighbour too */
+            }
+            /*! Spans inside the fill, each from a left to a right edge, matched in x order with the regions open above */
+            GLint winding = 0, left = -1;
+            GLfloat leftX = 0;
+            size_t above = 0;
+            for(size_t i=0;i<band.size();i++){
+                GLint inside = evenOdd ? (winding & 1) : winding != 0;
+                winding += evenOdd ? 1 : edges[band[i].edge].winding;
+                GLint insideAfter = evenOdd ? (winding & 1) : winding != 0;
+                if(!inside && insideAfter){
+                    left = band[i].edge;
+                    leftX = band[i].top;
+                }
+                if(!inside || insideAfter)
+                    continue;
+                GLint right = band[i].edge, continued = -1;
+                GLfloat rightX = band[i].top;
+                /*! Regions above ending left of the span are closed, one ending at the span's two points goes on */
+                for(;above<open.size();above++){
+                    FillRegion *region = &regions[open[above]];
+                    GLfloat aboveLeft = edges[region->left].xAt(y), aboveRight = edges[region->right].xAt(y);
+                    if(fabsf(aboveLeft - leftX) <= tolerance && fabsf(aboveRight - rightX) <= tolerance && aboveRight - aboveLeft > tolerance){
+                        continued = open[above++];
+                        break;
+                    }
+                    if(aboveLeft > leftX + tolerance || (aboveLeft >= leftX - tolerance && aboveRight > rightX - tolerance))
+                        break;
+                    closeRegion(open[above], y);
+                }
+                if(continued < 0){
+                    if(unused.empty()){
+                        unused.push_back(regions.size());
+                        regions.push_back(FillRegion());
+                    }
+                    continued = unused.back();
+                    unused.pop_back();
+                    FillRegion *region = &regions[continued];
+                    region->leftChain.clear();
+                    region->rightChain.clear();
+                    addChainPoint(&region->leftChain, leftX, y);
+                    addChainPoint(&region->rightChain, rightX - leftX <= tolerance ? leftX : rightX, y);
+                }
+                else{
+                    FillRegion *region = &regions[continued];
+                    if(region->left != left)
+                        addChainPoint(&region->leftChain, leftX, y);
+                    if(region->right != right)
+                        addChainPoint(&region->rightChain, rightX, y);
+                }
+                regions[continued].left = left;
+                regions[continued].right = right;
+                stillOpen.push_back(continued);
+            }
+            while(above < open.size())
+                closeRegion(open[above++], y);
+            open.swap(stillOpen);
+            stillOpen.clear();
+            y = bandEnd;
+        }
+    }
+    for(size_t i=0;i<open.size();i++)
+        closeRegion(open[i], ys.back());
+    return (triangles->size() - added)/6;
+}
+
+/*!
+    \fn tessellateStroke(const Outline *outline, GLfloat width, std::vector<GLfloat> *triangles)
+    \brief Append triangles covering the contours of outline drawn width wide, returns the number appended
+    Segments get a quad each, butt ended, with bevels filling the joins.
+*/
+GLint tessellateStroke(const Outline *outline, GLfloat width, std::vector<GLfloat> *triangles){
+    size_t added = triangles->size();
+    GLfloat half = width / 2;
+    for(size_t c=0, start=0;c<outline->ends.size();start=outline->ends[c++]){
+        size_t noOfPoints = outline->ends[c] - start;
+        size_t segments = outline->closed[c] ? noOfPoints : noOfPoints - 1;
+        GLfloat first[2] = {0, 0}, previous[2] = {0, 0};
+        const GLfloat *firstPoint = NULL;
+        for(size_t s=0;noOfPoints>1 && s<segments;s++){
+            const GLfloat *p = &outline->points[2*(start + s)], *q = &outline->points[2*(start + (s + 1) % noOfPoints)];
+            GLfloat length = hypotf(q[0] - p[0], q[1] - p[1]);
+            if(length == 0)
+                continue;
+            GLfloat n[2] = {-(q[1] - p[1]) / length * half, (q[0] - p[0]) / length * half};
+            addTriangle(triangles, p[0] + n[0], p[1] + n[1], p[0] - n[0], p[1] - n[1], q[0] - n[0], q[1] - n[1]);
+            addTriangle(triangles, p[0] + n[0], p[1] + n[1], q[0] - n[0], q[1] - n[1], q[0] + n[0], q[1] + n[1]);
+            if(firstPoint == NULL){
+                firstPoint = p;
+                first[0] = n[0];
+                first[1] = n[1];
+            }
+            else{
+                addTriangle(triangles, p[0], p[1], p[0] + previous[0], p[1] + previous[1], p[0] + n[0], p[1] + n[1]);
+                addTriangle(triangles, p[0], p[1], p[0] - previous[0], p[1] - previous[1], p[0] - n[0], p[1] - n[1]);
+            }
+            previous[0] = n[0];
+            previous[1] = n[1];
+        }
+        if(outline->closed[c] && firstPoint != NULL){
+            const GLfloat *p = firstPoint;
+            addTriangle(triangles, p[0], p[1], p[0] + previous[0], p[1] + previous[1], p[0] + first[0], p[1] + first[1]);
+            addTriangle(triangles, p[0], p[1], p[0] - previous[0], p[1] - previous[1], p[0] - first[0], p[1] - first[1]);
+        }
+    }
+    return (triangles->size() - added)/6;
+}
@@ -0,0 +1,96 @@
+/*!
+    /file ThreadPool.cpp
+    /brief Fixed set of worker threads running queued tasks
+*/
+
+#include "./headers/ThreadPool.h"
+
+/*!
+    \fn ThreadPool::ThreadPool(GLint noOfThreads)
+    \brief Constructor starts the worker threads
+    noOfThreads -> number of workers, 0 uses one per hardware thread.
+*/
+ThreadPool::ThreadPool(GLint noOfThreads){
+    if(noOfThreads <= 0)
+        noOfThreads = std::thread::hardware_concurrency();
+    if(noOfThreads <= 0)
+        noOfThreads = 1;
+    activeTasks = 0;
+    running = 1;
+    nextTask = 0;
+    tasks.reserve(noOfThreads * 4); /*!< Enough for a few tasks per worker without growing */
+    for(int i=0;i<noOfThreads;i++)
+        workers.push_back(std::thread(&ThreadPool::run, this));
+}
+
+/*!
+    \fn ThreadPool::~ThreadPool()
+    \brief Destructor finishes the queued tasks and stops the workers
+*/
+ThreadPool::~ThreadPool(){
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = 0;
+    }
+    taskAdded.notify_all();
+    for(size_t i=0;i<workers.size();i++)
+        workers[i].join();
+}
+
+/*!
+    \fn ThreadPool::size()
+    \brief Number of worker threads
+*/
+GLint ThreadPool::size(){
+    return workers.size();
+}
+
+/*!
+    \fn ThreadPool::enqueue(std::function<void()> task)
+    \brief Queue a task to be run by the next free worker
+*/
+void ThreadPool::enqueue(std::function<void()> task){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+        activeTasks++;
+    }
+    taskAdded.notify_one();
+}
+
+/*!
+    \fn ThreadPool::wait()
+    \brief Wait until every queued task has finished
+*/
+void ThreadPool::wait(){
+    std::unique_lock<std::mutex> lock(mutex);
+    tasksDone.wait(lock, [this]{ return activeTasks == 0; });
+}
+
+/*!
+    \fn ThreadPool::run()
+    \brief Worker loop
+*/
+void ThreadPool::run(){
+    while(true){
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAdded.wait(lock, [this]{ return nextTask < tasks.size() || !running; });
+            if(nextTask == tasks.size())
+                return;
+            task.swap(tasks[nextTask++]);
+            if(nextTask == tasks.size()){ /*!< Keeps the capacity for the next tasks */
+                tasks.clear();
+                nextTask = 0;
+            }
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            activeTasks--;
+        }
+        tasksDone.notify_all();
+    }
+}
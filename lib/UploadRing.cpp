@@ -0,0 +1,352 @@
+/*!
+    /file UploadRing.cpp
+    /brief Ring of pixel buffer memory texture uploads are streamed through
+*/
+
+#define GL_GLEXT_PROTOTYPES
+#include "./headers/UploadRing.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+/*!
+    \fn elapsedMilliseconds(std::chrono::steady_clock::time_point start)
+    \brief Milliseconds since start
+*/
+static double elapsedMilliseconds(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*!
+    \fn UploadRing::UploadRing()
+    \brief Constructor, nothing can be streamed before create
+*/
+UploadRing::UploadRing(){
+    size = bandSize = 0;
+    persistent = 0;
+    buffer = 0;
+    memory = NULL;
+    firstJob = noOfJobs = issuedJobs = 0;
+    head = used = 0;
+    resetStatistics();
+}
+
+/*!
+    \fn UploadRing::create(size_t ringSize, size_t frameBudget)
+    \brief Allocate the ring, must be called on the GL thread
+    frameBudget -> bytes pump is meant to upload a frame, bands are cut no larger.
+    Returns 1 when the ring is a mapped pixel buffer object, 0 when it is client memory.
+*/
+GLint UploadRing::create(size_t ringSize, size_t frameBudget){
+    destroy();
+    size = ringSize;
+    bandSize = frameBudget < ringSize/4 ? frameBudget : ringSize/4;
+    jobs.assign(UPLOAD_RING_JOBS, UploadJob());
+    firstJob = noOfJobs = issuedJobs = 0;
+    head = used = 0;
+    const char *extensions = (const char*)glGetString(GL_EXTENSIONS);
+    persistent = extensions != NULL && strstr(extensions, "GL_ARB_buffer_storage") != NULL
+        && strstr(extensions, "GL_ARB_sync") != NULL;
+    if(persistent){
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, NULL, flags);
+        memory = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, flags);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if(memory == NULL){
+            glDeleteBuffers(1, &buffer);
+            buffer = 0;
+            persistent = 0;
+        }
+    }
+    if(persistent == 0){
+        clientMemory.resize(size);
+        memory = clientMemory.data();
+    }
+    resetStatistics();
+    return persistent;
+}
+
+/*!
+    \fn UploadRing::destroy()
+    \brief Upload what is left and free the ring, must be called on the GL thread
+*/
+void UploadRing::destroy(){
+    if(memory == NULL)
+        return;
+    flush();
+    if(buffer != 0){
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glDeleteBuffers(1, &buffer);
+        buffer = 0;
+    }
+    std::vector<unsigned char>().swap(clientMemory);
+    memory = NULL;
+}
+
+/*!
+    \fn UploadRing::write(StreamedTexture *texture, GLint level, GLint width, GLint height, const unsigned char *pixels, size_t levelSize)
+    \brief Copy a level of texture into the ring, in bands of rows uploaded separately
+    Safe to call from any thread, blocks while the ring is full. Levels are
+    written in order, texture being ready once its last level is uploaded.
+    A band of a DXT level holds whole rows of 4x4 blocks.
+*/
+void UploadRing::write(StreamedTexture *texture, GLint level, GLint width, GLint height, const unsigned char *pixels, size_t levelSize){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    GLint pixelRows = texture->compressed ? 4 : 1; /*!< Rows of pixels in a row of data */
+    GLint dataRows = (height + pixelRows - 1) / pixelRows;
+    size_t rowSize = levelSize / dataRows;
+    GLint bandRows = bandSize / rowSize > 0 ? bandSize / rowSize : 1;
+    for(int row=0;row<dataRows;row+=bandRows){
+        GLint rows = bandRows < dataRows - row ? bandRows : dataRows - row;
+        size_t bytes = rows * rowSize, offset, index;
+        size_t aligned = (bytes + UPLOAD_RING_ALIGNMENT - 1) / UPLOAD_RING_ALIGNMENT * UPLOAD_RING_ALIGNMENT;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            size_t skipped;
+            for(;;){
+                if(used == 0)
+                    head = 0;
+                skipped = head + aligned > size ? size - head : 0; /*!< Bands never wrap around the end */
+                if(noOfJobs < jobs.size() && used + skipped + aligned <= size)
+                    break;
+                spaceFreed.wait(lock);
+            }
+            offset = head + aligned > size ? 0 : head;
+            index = (firstJob + noOfJobs) % jobs.size();
+            UploadJob *job = &jobs[index];
+            job->texture = texture;
+            job->level = level;
+            job->width = width;
+            job->height = height;
+            job->y = row * pixelRows;
+            job->rows = rows * pixelRows < height - job->y ? rows * pixelRows : height - job->y;
+            job->offset = offset;
+            job->size = bytes;
+            job->footprint = skipped + aligned;
+            job->written = 0;
+            job->last = level == texture->noOfLevels - 1 && row + rows == dataRows;
+            job->fence = 0;
+            used += job->footprint;
+            head = offset + aligned;
+            noOfJobs++;
+        }
+        memcpy(memory + offset, pixels + row * rowSize, bytes);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs[index].written = 1;
+        }
+        jobWritten.notify_all();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    bytesWritten += levelSize;
+    writeTime += elapsedMilliseconds(start);
+}
+
+/*!
+    \fn UploadRing::createTexture(const UploadJob *job)
+    \brief Create the texture the first band of job->texture is uploaded into
+*/
+void UploadRing::createTexture(const UploadJob *job){
+    glGenTextures(1, &job->texture->texture);
+    glBindTexture(GL_TEXTURE_2D, job->texture->texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, job->texture->noOfLevels - 1);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+/*!
+    \fn UploadRing::issue(const UploadJob *job)
+    \brief Upload a band out of the ring into its level
+    A level held by one band is specified from it, a larger level is
+    allocated by its first band and filled in band by band.
+*/
+void UploadRing::issue(const UploadJob *job){
+    StreamedTexture *texture = job->texture;
+    const GLvoid *source = persistent ? (const GLvoid*)job->offset : memory + job->offset; /*!< Offset into the bound buffer */
+    GLint whole = job->y == 0 && job->rows == job->height;
+    if(texture->texture == 0)
+        createTexture(job);
+    glBindTexture(GL_TEXTURE_2D, texture->texture);
+    if(job->y == 0 && whole == 0){
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if(texture->compressed)
+            glCompressedTexImage2D(GL_TEXTURE_2D, job->level, texture->format, job->width, job->height, 0,
+                ((job->width + 3)/4) * ((job->height + 3)/4) * (texture->format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ? 8 : 16), NULL);
+        else
+            glTexImage2D(GL_TEXTURE_2D, job->level, texture->format, job->width, job->height, 0,
+                texture->format, GL_UNSIGNED_BYTE, NULL);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    }
+    if(texture->compressed && whole)
+        glCompressedTexImage2D(GL_TEXTURE_2D, job->level, texture->format, job->width, job->height, 0, job->size, source);
+    else if(texture->compressed)
+        glCompressedTexSubImage2D(GL_TEXTURE_2D, job->level, 0, job->y, job->width, job->rows, texture->format, job->size, source);
+    else if(whole)
+        glTexImage2D(GL_TEXTURE_2D, job->level, texture->format, job->width, job->height, 0,
+            texture->format, GL_UNSIGNED_BYTE, source);
+    else
+        glTexSubImage2D(GL_TEXTURE_2D, job->level, 0, job->y, job->width, job->rows, texture->format, GL_UNSIGNED_BYTE, source);
+    if(job->last)
+        texture->ready = 1;
+}
+
+/*!
+    \fn UploadRing::pump(size_t budget)
+    \brief Upload the bands written, up to budget bytes, must be called on the GL thread
+    At least one band is uploaded when one is written. The bands are fenced
+    together, and the memory of the bands whose fences are signaled is released.
+    The texture binding is left as it was. Returns the bytes uploaded.
+*/
+size_t UploadRing::pump(size_t budget){
+    if(memory == NULL)
+        return 0;
+    retire(0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+    GLint previousTexture = 0;
+    for(;;){
+        UploadJob job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(issuedJobs == noOfJobs)
+                break;
+            const UploadJob *next = &jobs[(firstJob + issuedJobs) % jobs.size()];
+            if(next->written == 0 || (bytes > 0 && bytes + next->size > budget))
+                break;
+            job = *next;
+        }
+        if(bytes == 0){
+            glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        }
+        issue(&job);
+        bytes += job.size;
+        std::lock_guard<std::mutex> lock(mutex);
+        issuedJobs++;
+    }
+    if(bytes == 0)
+        return 0;
+    if(persistent){
+        GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush(); /*!< A fence not yet flushed may never signal, retire polls it without flushing */
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs[(firstJob + issuedJobs - 1) % jobs.size()].fence = fence;
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, previousTexture);
+    double time = elapsedMilliseconds(start);
+    bytesUploaded += bytes;
+    uploadTime += time;
+    pumps++;
+    if(bytes > largestPump)
+        largestPump = bytes;
+    if(time > longestPump)
+        longestPump = time;
+    retire(0);
+    return bytes;
+}
+
+/*!
+    \fn UploadRing::retire(GLint wait)
+    \brief Release the memory of the uploaded bands whose fences are signaled
+    wait -> 1 waits for every band uploaded to be read, 0 only checks the fences.
+    Bands of client memory are read as they are uploaded, and released at once.
+*/
+void UploadRing::retire(GLint wait){
+    for(;;){
+        size_t released = 0;
+        GLsync fence = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(issuedJobs == 0)
+                return;
+            if(persistent == 0)
+                released = issuedJobs;
+            for(size_t i=0;i<issuedJobs && released == 0;i++)
+                if(jobs[(firstJob + i) % jobs.size()].fence != 0){
+                    fence = jobs[(firstJob + i) % jobs.size()].fence;
+                    released = i + 1;
+                }
+        }
+        if(released == 0)
+            return;
+        if(fence != 0){
+            GLenum status = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? UPLOAD_RING_WAIT : 0);
+            if(status == GL_TIMEOUT_EXPIRED && wait)
+                continue;
+            if(status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                return;
+            glDeleteSync(fence);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(size_t i=0;i<released;i++){
+                used -= jobs[firstJob].footprint;
+                jobs[firstJob].fence = 0;
+                firstJob = (firstJob + 1) % jobs.size();
+            }
+            noOfJobs -= released;
+            issuedJobs -= released;
+        }
+        spaceFreed.notify_all();
+    }
+}
+
+/*!
+    \fn UploadRing::flush()
+    \brief Upload every band written and wait until they are read, must be called on the GL thread
+*/
+void UploadRing::flush(){
+    while(pump(size) > 0);
+    retire(1);
+}
+
+/*!
+    \fn UploadRing::idle()
+    \brief 1 when every band written is uploaded and released
+*/
+GLint UploadRing::idle(){
+    std::lock_guard<std::mutex> lock(mutex);
+    return noOfJobs == 0;
+}
+
+/*!
+    \fn UploadRing::waitForWrite(GLint milliseconds)
+    \brief Wait at most milliseconds for a band to be ready to upload
+*/
+void UploadRing::waitForWrite(GLint milliseconds){
+    std::unique_lock<std::mutex> lock(mutex);
+    jobWritten.wait_for(lock, std::chrono::milliseconds(milliseconds),
+        [this]{ return issuedJobs < noOfJobs && jobs[(firstJob + issuedJobs) % jobs.size()].written; });
+}
+
+/*!
+    \fn UploadRing::resetStatistics()
+    \brief Start measuring the bandwidth again
+*/
+void UploadRing::resetStatistics(){
+    std::lock_guard<std::mutex> lock(mutex);
+    bytesWritten = bytesUploaded = largestPump = 0;
+    writeTime = uploadTime = longestPump = 0;
+    pumps = 0;
+}
+
+/*!
+    \fn UploadRing::report(const char *name)
+    \brief Print the bandwidth achieved copying into the ring and uploading out of it
+*/
+void UploadRing::report(const char *name){
+    std::lock_guard<std::mutex> lock(mutex);
+    printf("%s: %.2f MB streamed through %s of %.0f KB in %u frames, copied in at %.0f MB/s,"
+        " uploaded at %.0f MB/s, at most %.0f KB and %.2f ms a frame\n",
+        name, bytesUploaded/1048576.0, persistent ? "a pixel buffer ring" : "a client memory ring", size/1024.0, pumps,
+        writeTime > 0 ? bytesWritten/1048576.0/(writeTime/1000) : 0, uploadTime > 0 ? bytesUploaded/1048576.0/(uploadTime/1000) : 0,
+        largestPump/1024.0, longestPump);
+    fflush(stdout);
+}
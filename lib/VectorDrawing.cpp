@@ -0,0 +1,633 @@
+/*!
+    /file VectorDrawing.cpp
+    /brief Vector drawings read from a subset of SVG and tessellated once
+    Every filled or stroked shape becomes a layer of triangles. The layers are
+    drawn in order in a single call, each a little above the one before, so
+    shapes painted later cover those below without sorting.
+*/
+
+#include "./headers/VectorDrawing.h"
+#include "./headers/GLBackend.h"
+#include <chrono>
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*!
+    \struct NamedColor
+    \brief Color keyword and its value
+*/
+struct NamedColor{
+    const char *name;
+    GLfloat color[3];
+};
+
+static const NamedColor NAMED_COLORS[] = {
+    {"black", {0, 0, 0}}, {"white", {1, 1, 1}}, {"red", {1, 0, 0}}, {"green", {0, 0.5f, 0}},
+    {"lime", {0, 1, 0}}, {"blue", {0, 0, 1}}, {"yellow", {1, 1, 0}}, {"cyan", {0, 1, 1}},
+    {"magenta", {1, 0, 1}}, {"gray", {0.5f, 0.5f, 0.5f}}, {"grey", {0.5f, 0.5f, 0.5f}},
+    {"orange", {1, 0.65f, 0}}, {"purple", {0.5f, 0, 0.5f}}, {"brown", {0.65f, 0.16f, 0.16f}}
+};
+
+/*!
+    \fn skipSeparators(const char *at)
+    \brief First character after white space and commas
+*/
+static const char* skipSeparators(const char *at){
+    while(*at == ',' || isspace((unsigned char)*at))
+        at++;
+    return at;
+}
+
+/*!
+    \fn readNumber(const char **at, GLfloat *number)
+    \brief Read a number after separators and move past it, returns 0 when there is none
+*/
+static GLint readNumber(const char **at, GLfloat *number){
+    const char *start = skipSeparators(*at);
+    char *end;
+    *number = strtof(start, &end);
+    if(end == start)
+        return 0;
+    *at = end;
+    return 1;
+}
+
+/*!
+    \fn readFlag(const char **at, GLfloat *flag)
+    \brief Read an arc flag, a single 0 or 1 which may touch the next number
+*/
+static GLint readFlag(const char **at, GLfloat *flag){
+    const char *start = skipSeparators(*at);
+    if(*start != '0' && *start != '1')
+        return 0;
+    *flag = *start - '0';
+    *at = start + 1;
+    return 1;
+}
+
+/*!
+    \fn readColor(const char *value, GLfloat color[3])
+    \brief Read a color, returns 1 for a color, 0 for none and -1 for a value not understood
+    #rgb, #rrggbb, rgb(r, g, b) and a few color keywords are understood.
+*/
+static GLint readColor(const char *value, GLfloat color[3]){
+    unsigned int r, g, b;
+    value = skipSeparators(value);
+    if(strncmp(value, "none", 4) == 0 || strncmp(value, "transparent", 11) == 0)
+        return 0;
+    if(value[0] == '#'){
+        size_t digits = strspn(value + 1, "0123456789abcdefABCDEF");
+        if(digits == 6 && sscanf(value + 1, "%2x%2x%2x", &r, &g, &b) == 3){
+            color[0] = r/255.0f, color[1] = g/255.0f, color[2] = b/255.0f;
+            return 1;
+        }
+        if(digits == 3 && sscanf(value + 1, "%1x%1x%1x", &r, &g, &b) == 3){
+            color[0] = r/15.0f, color[1] = g/15.0f, color[2] = b/15.0f;
+            return 1;
+        }
+        return -1;
+    }
+    if(sscanf(value, "rgb(%u ,%u ,%u )", &r, &g, &b) == 3){
+        color[0] = r/255.0f, color[1] = g/255.0f, color[2] = b/255.0f;
+        return 1;
+    }
+    for(size_t i=0;i<sizeof(NAMED_COLORS)/sizeof(NAMED_COLORS[0]);i++){
+        size_t length = strlen(NAMED_COLORS[i].name);
+        if(strncmp(value, NAMED_COLORS[i].name, length) == 0 && !isalpha((unsigned char)value[length])){
+            memcpy(color, NAMED_COLORS[i].color, sizeof(NAMED_COLORS[i].color));
+            return 1;
+        }
+    }
+    return -1;
+}
+
+/*!
+    \fn applyPaint(const std::string &name, const char *value, VectorPaint *paint)
+    \brief Apply a presentation attribute or style property to paint, others are left alone
+*/
+static void applyPaint(const std::string &name, const char *value, VectorPaint *paint){
+    if(name == "fill"){
+        GLint read = readColor(value, paint->fill);
+        if(read >= 0)
+            paint->filled = read;
+    }
+    else if(name == "stroke"){
+        GLint read = readColor(value, paint->stroke);
+        if(read >= 0)
+            paint->stroked = read;
+    }
+    else if(name == "stroke-width")
+        paint->strokeWidth = atof(value);
+    else if(name == "fill-rule")
+        paint->evenOdd = strncmp(skipSeparators(value), "evenodd", 7) == 0;
+}
+
+/*!
+    \fn applyStyle(const std::string &style, VectorPaint *paint)
+    \brief Apply the properties of a style attribute, name: value pairs separated by semicolons
+*/
+static void applyStyle(const std::string &style, VectorPaint *paint){
+    size_t start = 0;
+    while(start < style.size()){
+        size_t end = style.find(';', start), colon = style.find(':', start);
+        end = end == std::string::npos ? style.size() : end;
+        if(colon < end){
+            size_t first = style.find_first_not_of(" \t\n\r", start), last = style.find_last_not_of(" \t\n\r", colon - 1);
+            if(first <= last && last < colon)
+                applyPaint(style.substr(first, last - first + 1), style.substr(colon + 1, end - colon - 1).c_str(), paint);
+        }
+        start = end + 1;
+    }
+}
+
+/*!
+    \fn curveSegments(GLfloat deviation, GLfloat tolerance)
+    \brief Segments a curve is flattened into, for a curve straying deviation from its chord
+*/
+static GLint curveSegments(GLfloat deviation, GLfloat tolerance){
+    GLint segments = (GLint)ceilf(sqrtf(deviation / tolerance));
+    return segments < 1 ? 1 : (segments > VECTOR_MAX_CURVE_SEGMENTS ? VECTOR_MAX_CURVE_SEGMENTS : segments);
+}
+
+/*!
+    \fn cubicTo(Outline *outline, GLfloat tolerance, const GLfloat p[8])
+    \brief Flatten the cubic Bezier curve through control points p into outline, Wang's formula picking the segments
+*/
+static void cubicTo(Outline *outline, GLfloat tolerance, const GLfloat p[8]){
+    GLfloat d1 = hypotf(p[0] - 2*p[2] + p[4], p[1] - 2*p[3] + p[5]), d2 = hypotf(p[2] - 2*p[4] + p[6], p[3] - 2*p[5] + p[7]);
+    GLint segments = curveSegments(0.75f * (d1 > d2 ? d1 : d2), tolerance);
+    for(int i=1;i<=segments;i++){
+        GLfloat t = (GLfloat)i / segments, s = 1 - t;
+        GLfloat a = s*s*s, b = 3*s*s*t, c = 3*s*t*t, d = t*t*t;
+        outline->lineTo(a*p[0] + b*p[2] + c*p[4] + d*p[6], a*p[1] + b*p[3] + c*p[5] + d*p[7]);
+    }
+}
+
+/*!
+    \fn quadraticTo(Outline *outline, GLfloat tolerance, const GLfloat p[6])
+    \brief Flatten the quadratic Bezier curve through control points p into outline
+*/
+static void quadraticTo(Outline *outline, GLfloat tolerance, const GLfloat p[6]){
+    GLint segments = curveSegments(0.25f * hypotf(p[0] - 2*p[2] + p[4], p[1] - 2*p[3] + p[5]), tolerance);
+    for(int i=1;i<=segments;i++){
+        GLfloat t = (GLfloat)i / segments, s = 1 - t;
+        outline->lineTo(s*s*p[0] + 2*s*t*p[2] + t*t*p[4], s*s*p[1] + 2*s*t*p[3] + t*t*p[5]);
+    }
+}
+
+/*!
+    \fn ellipseSegments(GLfloat radius, GLfloat angle, GLfloat tolerance)
+    \brief Segments an arc of angle radians and radius is flattened into
+*/
+static GLint ellipseSegments(GLfloat radius, GLfloat angle, GLfloat tolerance){
+    GLfloat step = radius > tolerance ? 2 * acosf(1 - tolerance / radius) : (GLfloat)M_PI;
+    GLint segments = (GLint)ceilf(fabsf(angle) / step);
+    return segments < 1 ? 1 : (segments > 4*VECTOR_MAX_CURVE_SEGMENTS ? 4*VECTOR_MAX_CURVE_SEGMENTS : segments);
+}
+
+/*!
+    \fn arcTo(Outline *outline, GLfloat tolerance, GLfloat x, GLfloat y, const GLfloat a[7])
+    \brief Flatten the elliptical arc from x, y with arguments a of the SVG A command into outline
+    The center is found as the SVG specification describes, radii too small
+    to reach the end are scaled up.
+*/
+static void arcTo(Outline *outline, GLfloat tolerance, GLfloat x, GLfloat y, const GLfloat a[7]){
+    GLfloat rx = fabsf(a[0]), ry = fabsf(a[1]), phi = a[2] * (GLfloat)M_PI / 180, endX = a[5], endY = a[6];
+    if(rx == 0 || ry == 0 || (x == endX && y == endY)){
+        outline->lineTo(endX, endY);
+        return;
+    }
+    GLfloat cosPhi = cosf(phi), sinPhi = sinf(phi);
+    GLfloat dx = (x - endX) / 2, dy = (y - endY) / 2;
+    GLfloat x1 = cosPhi*dx + sinPhi*dy, y1 = -sinPhi*dx + cosPhi*dy;
+    GLfloat lambda = x1*x1/(rx*rx) + y1*y1/(ry*ry);
+    if(lambda > 1){
+        rx *= sqrtf(lambda);
+        ry *= sqrtf(lambda);
+    }
+    GLfloat numerator = rx*rx*ry*ry - rx*rx*y1*y1 - ry*ry*x1*x1, denominator = rx*rx*y1*y1 + ry*ry*x1*x1;
+    GLfloat root = sqrtf(numerator > 0 ? numerator / denominator : 0) * (a[3] == a[4] ? -1 : 1);
+    GLfloat cx1 = root * rx * y1 / ry, cy1 = -root * ry * x1 / rx;
+    GLfloat cx = cosPhi*cx1 - sinPhi*cy1 + (x + endX) / 2, cy = sinPhi*cx1 + cosPhi*cy1 + (y + endY) / 2;
+    GLfloat start = atan2f((y1 - cy1) / ry, (x1 - cx1) / rx), end = atan2f((-y1 - cy1) / ry, (-x1 - cx1) / rx);
+    GLfloat sweep = end - start;
+    if(a[4] != 0 && sweep < 0)
+        sweep += 2 * (GLfloat)M_PI;
+    else if(a[4] == 0 && sweep > 0)
+        sweep -= 2 * (GLfloat)M_PI;
+    GLint segments = ellipseSegments(rx > ry ? rx : ry, sweep, tolerance);
+    for(int i=1;i<segments;i++){
+        GLfloat angle = start + sweep * i / segments, ex = rx * cosf(angle), ey = ry * sinf(angle);
+        outline->lineTo(cosPhi*ex - sinPhi*ey + cx, sinPhi*ex + cosPhi*ey + cy);
+    }
+    outline->lineTo(endX, endY);
+}
+
+/*!
+    \fn VectorDrawing::VectorDrawing()
+    \brief Constructor, the drawing is empty
+*/
+VectorDrawing::VectorDrawing(){
+    for(int i=0;i<4;i++)
+        viewBox[i] = 0;
+    noOfShapes = noOfLayers = noOfPoints = skipped = 0;
+    tessellationTime = 0;
+    tolerance = VECTOR_FLATNESS;
+}
+
+/*!
+    \fn VectorDrawing::readPath(const char *data)
+    \brief Read the d attribute of a path into the outline
+    Reading stops at the first command it cannot read, which counts as skipped.
+*/
+void VectorDrawing::readPath(const char *data){
+    static const char COMMANDS[] = "MLHVCSQTAZ";
+    static const GLint ARGUMENTS[] = {2, 2, 1, 1, 6, 4, 4, 2, 7, 0};
+    GLfloat x = 0, y = 0, startX = 0, startY = 0, controlX = 0, controlY = 0;
+    char command = 0, previous = 0;
+    GLint open = 0; /*!< A contour is open to draw on, after closing one the next starts at its first point */
+    const char *at = data;
+    while(*(at = skipSeparators(at)) != 0){
+        if(isalpha((unsigned char)*at))
+            command = *at++;
+        else if(command == 0 || toupper(command) == 'Z'){
+            skipped++;
+            return;
+        }
+        const char *known = strchr(COMMANDS, toupper(command));
+        if(known == NULL){
+            skipped++;
+            return;
+        }
+        GLint kind = toupper(command), relative = islower(command);
+        GLfloat a[7];
+        for(int i=0;i<ARGUMENTS[known - COMMANDS];i++){
+            if(!((kind == 'A' && (i == 3 || i == 4)) ? readFlag(&at, &a[i]) : readNumber(&at, &a[i]))){
+                skipped++;
+                return;
+            }
+        }
+        if(kind == 'Z'){
+            outline.close();
+            x = startX;
+            y = startY;
+            open = 0;
+            previous = kind;
+            continue;
+        }
+        if(kind != 'M' && !open){
+            outline.moveTo(x, y);
+            startX = x;
+            startY = y;
+        }
+        open = 1;
+        GLfloat originX = relative ? x : 0, originY = relative ? y : 0;
+        GLfloat p[8] = {x, y};
+        switch(kind){
+            case 'M':
+                x = originX + a[0];
+                y = originY + a[1];
+                outline.moveTo(x, y);
+                startX = x;
+                startY = y;
+                command = relative ? 'l' : 'L'; /*!< Further pairs are lines */
+                break;
+            case 'L':
+                x = originX + a[0];
+                y = originY + a[1];
+                outline.lineTo(x, y);
+                break;
+            case 'H':
+                x = originX + a[0];
+                outline.lineTo(x, y);
+                break;
+            case 'V':
+                y = originY + a[0];
+                outline.lineTo(x, y);
+                break;
+            case 'C':
+            case 'S':
+                if(kind == 'S'){
+                    p[2] = (previous == 'C' || previous == 'S') ? 2*x - controlX : x;
+                    p[3] = (previous == 'C' || previous == 'S') ? 2*y - controlY : y;
+                }
+                for(int i=(kind == 'S' ? 2 : 0);i<6;i++)
+                    p[i + 2] = (i % 2 ? originY : originX) + a[kind == 'S' ? i - 2 : i];
+                cubicTo(&outline, tolerance, p);
+                controlX = p[4];
+                controlY = p[5];
+                x = p[6];
+                y = p[7];
+                break;
+            case 'Q':
+            case 'T':
+                if(kind == 'T'){
+                    p[2] = (previous == 'Q' || previous == 'T') ? 2*x - controlX : x;
+                    p[3] = (previous == 'Q' || previous == 'T') ? 2*y - controlY : y;
+                }
+                for(int i=(kind == 'T' ? 2 : 0);i<4;i++)
+                    p[i + 2] = (i % 2 ? originY : originX) + a[kind == 'T' ? i - 2 : i];
+                quadraticTo(&outline, tolerance, p);
+                controlX = p[2];
+                controlY = p[3];
+                x = p[4];
+                y = p[5];
+                break;
+            case 'A':
+                a[5] += originX;
+                a[6] += originY;
+                arcTo(&outline, tolerance, x, y, a);
+                x = a[5];
+                y = a[6];
+                break;
+        }
+        previous = kind;
+    }
+}
+
+/*!
+    \fn VectorDrawing::addLayer(const GLfloat *color)
+    \brief Append the triangles of the shape being read to the mesh as a layer of color
+*/
+void VectorDrawing::addLayer(const GLfloat *color){
+    if(triangles.empty())
+        return;
+    for(size_t i=0;i<triangles.size();i+=2){
+        GLfloat corner[] = {triangles[i], triangles[i + 1], (GLfloat)noOfLayers, color[0], color[1], color[2]};
+        mesh.insert(mesh.end(), corner, corner + 6);
+    }
+    noOfLayers++;
+}
+
+/*!
+    \fn VectorDrawing::addShape(const VectorPaint *paint)
+    \brief Tessellate the outline read with paint, its fill below its stroke, and start a new outline
+*/
+void VectorDrawing::addShape(const VectorPaint *paint){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if(paint->filled){
+        triangles.clear();
+        tessellateFill(&outline, paint->evenOdd, &triangles);
+        addLayer(paint->fill);
+    }
+    if(paint->stroked && paint->strokeWidth > 0){
+        triangles.clear();
+        tessellateStroke(&outline, paint->strokeWidth, &triangles);
+        addLayer(paint->stroke);
+    }
+    tessellationTime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    noOfShapes++;
+    noOfPoints += outline.noOfPoints();
+    outline.clear();
+}
+
+/*!
+    \fn VectorDrawing::parse(const char *text)
+    \brief Read and tessellate the drawing in text, returns 0 when it holds no shape
+    Without a viewBox or a size on the svg element, the drawing spans the
+    bounds of its triangles.
+*/
+GLint VectorDrawing::parse(const char *text){
+    VectorPaint initial = {{0, 0, 0}, {0, 0, 0}, 1, 0, 1, 0}; /*!< Black fill, no stroke, as SVG starts */
+    std::vector<VectorPaint> paints(1, initial);
+    std::vector<std::string> names, values;
+    mesh.clear();
+    noOfShapes = noOfLayers = noOfPoints = skipped = 0;
+    tessellationTime = 0;
+    for(int i=0;i<4;i++)
+        viewBox[i] = 0;
+    for(const char *at=strchr(text, '<');at!=NULL;at=strchr(at, '<')){
+        at++;
+        if(strncmp(at, "!--", 3) == 0){
+            const char *end = strstr(at, "-->");
+            at = end == NULL ? at + strlen(at) : end + 3;
+            continue;
+        }
+        if(*at == '/'){
+            if(strncmp(at + 1, "g", 1) == 0 && !isalnum((unsigned char)at[2]) && paints.size() > 1)
+                paints.pop_back();
+            continue;
+        }
+        if(!isalpha((unsigned char)*at))
+            continue; /*!< Declarations and processing instructions */
+        const char *nameEnd = at;
+        while(isalnum((unsigned char)*nameEnd) || *nameEnd == ':' || *nameEnd == '-')
+            nameEnd++;
+        std::string element(at, nameEnd);
+        names.clear();
+        values.clear();
+        at = nameEnd;
+        GLint selfClosing = 0;
+        for(;;){
+            while(isspace((unsigned char)*at))
+                at++;
+            if(*at == 0 || *at == '>')
+                break;
+            if(*at == '/'){
+                selfClosing = 1;
+                at++;
+                continue;
+            }
+            const char *attributeEnd = at;
+            while(*attributeEnd != 0 && *attributeEnd != '=' && *attributeEnd != '>' && !isspace((unsigned char)*attributeEnd))
+                attributeEnd++;
+            names.push_back(std::string(at, attributeEnd));
+            at = attributeEnd;
+            while(isspace((unsigned char)*at))
+                at++;
+            if(*at != '='){
+                values.push_back("");
+                continue;
+            }
+            at++;
+            while(isspace((unsigned char)*at))
+                at++;
+            char quote = *at;
+            const char *valueEnd = (quote == '"' || quote == '\'') ? strchr(at + 1, quote) : NULL;
+            if(valueEnd == NULL){
+                values.push_back("");
+                continue;
+            }
+            values.push_back(std::string(at + 1, valueEnd));
+            at = valueEnd + 1;
+        }
+        VectorPaint paint = paints.back();
+        for(size_t i=0;i<names.size();i++){
+            if(names[i] == "style")
+                applyStyle(values[i], &paint);
+            else
+                applyPaint(names[i], values[i].c_str(), &paint);
+        }
+        /*! Geometry attributes, 0 for those the element has not */
+        static const char *GEOMETRY[] = {"x", "y", "width", "height", "cx", "cy", "r", "rx", "ry", "x1", "y1", "x2", "y2"};
+        enum {X, Y, WIDTH, HEIGHT, CX, CY, R, RX, RY, X1, Y1, X2, Y2, NO_OF_GEOMETRY};
+        GLfloat geometry[NO_OF_GEOMETRY] = {0};
+        for(size_t i=0;i<names.size();i++)
+            for(int k=0;k<NO_OF_GEOMETRY;k++)
+                if(names[i] == GEOMETRY[k])
+                    geometry[k] = atof(values[i].c_str());
+        if(element == "svg"){
+            for(size_t i=0;i<names.size();i++){
+                const char *value = values[i].c_str();
+                if(names[i] == "viewBox")
+                    for(int k=0;k<4 && readNumber(&value, &viewBox[k]);k++);
+            }
+            if(viewBox[2] <= 0 || viewBox[3] <= 0){
+                viewBox[0] = viewBox[1] = 0;
+                viewBox[2] = geometry[WIDTH];
+                viewBox[3] = geometry[HEIGHT];
+            }
+            if(viewBox[2] > 0 && viewBox[3] > 0)
+                tolerance = VECTOR_FLATNESS * (viewBox[2] > viewBox[3] ? viewBox[2] : viewBox[3]) / 1000;
+            if(!selfClosing)
+                paints.push_back(paint);
+            continue;
+        }
+        if(element == "g"){
+            if(!selfClosing)
+                paints.push_back(paint);
+            continue;
+        }
+        if(element == "path"){
+            for(size_t i=0;i<names.size();i++)
+                if(names[i] == "d")
+                    readPath(values[i].c_str());
+        }
+        else if(element == "rect" && geometry[WIDTH] > 0 && geometry[HEIGHT] > 0){
+            outline.moveTo(geometry[X], geometry[Y]);
+            outline.lineTo(geometry[X] + geometry[WIDTH], geometry[Y]);
+            outline.lineTo(geometry[X] + geometry[WIDTH], geometry[Y] + geometry[HEIGHT]);
+            outline.lineTo(geometry[X], geometry[Y] + geometry[HEIGHT]);
+            outline.close();
+        }
+        else if((element == "circle" && geometry[R] > 0) || (element == "ellipse" && geometry[RX] > 0 && geometry[RY] > 0)){
+            GLfloat rx = element == "circle" ? geometry[R] : geometry[RX], ry = element == "circle" ? geometry[R] : geometry[RY];
+            GLint segments = ellipseSegments(rx > ry ? rx : ry, 2 * (GLfloat)M_PI, tolerance);
+            segments = segments < 8 ? 8 : segments;
+            for(int i=0;i<segments;i++){
+                GLfloat angle = 2 * (GLfloat)M_PI * i / segments;
+                if(i == 0)
+                    outline.moveTo(geometry[CX] + rx, geometry[CY]);
+                else
+                    outline.lineTo(geometry[CX] + rx * cosf(angle), geometry[CY] + ry * sinf(angle));
+            }
+            outline.close();
+        }
+        else if(element == "polygon" || element == "polyline"){
+            for(size_t i=0;i<names.size();i++){
+                if(names[i] != "points")
+                    continue;
+                const char *value = values[i].c_str();
+                GLfloat x, y;
+                while(readNumber(&value, &x) && readNumber(&value, &y))
+                    outline.lineTo(x, y);
+            }
+            if(element == "polygon")
+                outline.close();
+        }
+        else if(element == "line"){
+            outline.moveTo(geometry[X1], geometry[Y1]);
+            outline.lineTo(geometry[X2], geometry[Y2]);
+        }
+        else if(element != "title" && element != "desc" && element != "metadata" && element != "defs"){
+            skipped++;
+            continue;
+        }
+        if(outline.noOfPoints() > 0)
+            addShape(&paint);
+    }
+    if((viewBox[2] <= 0 || viewBox[3] <= 0) && !mesh.empty()){
+        GLfloat bounds[4] = {mesh[0], mesh[1], mesh[0], mesh[1]};
+        for(size_t i=0;i<mesh.size();i+=6){
+            bounds[0] = fminf(bounds[0], mesh[i]);
+            bounds[1] = fminf(bounds[1], mesh[i + 1]);
+            bounds[2] = fmaxf(bounds[2], mesh[i]);
+            bounds[3] = fmaxf(bounds[3], mesh[i + 1]);
+        }
+        viewBox[0] = bounds[0];
+        viewBox[1] = bounds[1];
+        viewBox[2] = bounds[2] - bounds[0];
+        viewBox[3] = bounds[3] - bounds[1];
+    }
+    return noOfShapes > 0;
+}
+
+/*!
+    \fn VectorDrawing::load(const char *filename)
+    \brief Read and tessellate the drawing of a file, returns 0 when it cannot be read or holds no shape
+*/
+GLint VectorDrawing::load(const char *filename){
+    FILE *file = fopen(filename, "rb");
+    if(file == NULL)
+        return 0;
+    std::string text;
+    char buffer[4096];
+    size_t length;
+    while((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        text.append(buffer, length);
+    fclose(file);
+    return parse(text.c_str());
+}
+
+/*!
+    \fn VectorDrawing::noOfTriangles()
+    \brief Triangles of the mesh
+*/
+GLint VectorDrawing::noOfTriangles(){
+    return mesh.size() / 18;
+}
+
+/*!
+    \fn VectorDrawing::place(GLfloat left, GLfloat bottom, GLfloat right, GLfloat top, GLfloat offset[2])
+    \brief Scale fitting the drawing centered into a rectangle, y up
+    A point x, y of the drawing lies at offset[0] + x*scale, offset[1] - y*scale.
+*/
+GLfloat VectorDrawing::place(GLfloat left, GLfloat bottom, GLfloat right, GLfloat top, GLfloat offset[2]){
+    GLfloat width = viewBox[2] > 0 ? viewBox[2] : 1, height = viewBox[3] > 0 ? viewBox[3] : 1;
+    GLfloat scale = fminf((right - left) / width, (top - bottom) / height);
+    offset[0] = left + ((right - left) - width * scale) / 2 - viewBox[0] * scale;
+    offset[1] = top - ((top - bottom) - height * scale) / 2 + viewBox[1] * scale;
+    return scale;
+}
+
+/*!
+    \fn VectorDrawing::draw(GLfloat left, GLfloat bottom, GLfloat z, GLfloat right, GLfloat top)
+    \brief Draw the drawing fitted into a rectangle of a page at depth z, in one call
+    Layers rise from half a page thickness under z up to z.
+*/
+void VectorDrawing::draw(GLfloat left, GLfloat bottom, GLfloat z, GLfloat right, GLfloat top){
+    if(mesh.empty())
+        return;
+    GLfloat offset[2], scale = place(left, bottom, right, top, offset);
+    vertices.resize(mesh.size() / 6 * 9);
+    for(size_t i=0, k=0;i<mesh.size();i+=6, k+=9){
+        vertices[k] = offset[0] + mesh[i] * scale;
+        vertices[k + 1] = offset[1] - mesh[i + 1] * scale;
+        vertices[k + 2] = z - PAGE_THICKNESS/2.0f * (1 - (mesh[i + 2] + 1) / noOfLayers);
+        vertices[k + 3] = vertices[k + 4] = 0;
+        vertices[k + 5] = 1;
+        memcpy(&vertices[k + 6], &mesh[i + 3], 3*sizeof(GLfloat));
+    }
+    fbDrawColoredArrays(GL_TRIANGLES, vertices.size() / 9, vertices.data());
+    fbColor3f(0.0, 0.0, 0.0);
+}
+
+/*!
+    \fn VectorDrawing::ink(GLfloat left, GLfloat bottom, GLfloat right, GLfloat top, GLfloat ink[3])
+    \brief Area the drawing covers once fitted into a rectangle, its color weighed by area is added to ink
+    Shapes covering each other count twice, as drawing pages do in Page::computeTint.
+*/
+GLfloat VectorDrawing::ink(GLfloat left, GLfloat bottom, GLfloat right, GLfloat top, GLfloat ink[3]){
+    GLfloat offset[2], scale = place(left, bottom, right, top, offset), inked = 0;
+    for(size_t i=0;i<mesh.size();i+=18){
+        const GLfloat *a = &mesh[i], *b = &mesh[i + 6], *c = &mesh[i + 12];
+        GLfloat area = fabsf((b[0] - a[0]) * (c[1] - a[1]) - (c[0] - a[0]) * (b[1] - a[1])) / 2 * scale * scale;
+        inked += area;
+        for(int k=0;k<3;k++)
+            ink[k] += a[3 + k] * area;
+    }
+    return inked;
+}
@@ -0,0 +1,42 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _ALLOCATIONS_H
+#define _ALLOCATIONS_H
+/*!
+    \enum AllocationTag
+    \brief Subsystem a heap allocation is counted against
+    Every thread has a current tag, set with setAllocationTag.
+*/
+enum AllocationTag{
+    ALLOCATION_OTHER,
+    ALLOCATION_SCENE, /*!< Room, lighting and transforms */
+    ALLOCATION_PAGES, /*!< Book, page stacks and pages */
+    ALLOCATION_LIBRARY,
+    ALLOCATION_WELCOME,
+    ALLOCATION_COMMANDS, /*!< Submitting recorded frames */
+    ALLOCATION_ASSETS, /*!< Loading and reloading textures and pages */
+    ALLOCATION_RECORDINGS, /*!< Sub-scenes recorded once and replayed across frames */
+    ALLOCATION_TAGS
+};
+
+/*!
+    \struct AllocationCounts
+    \brief Heap allocations and bytes allocated per subsystem
+*/
+struct AllocationCounts{
+    unsigned long allocations[ALLOCATION_TAGS];
+    unsigned long bytes[ALLOCATION_TAGS];
+};
+GLint setAllocationTag(GLint);
+void readAllocationCounts(AllocationCounts*);
+unsigned long allocationsSince(const AllocationCounts*, AllocationCounts*);
+const char* allocationTagName(GLint);
+#endif
@@ -0,0 +1,47 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _ANTIALIASING_H
+#define _ANTIALIASING_H
+#include "./GLBackend.h"
+#include <string>
+
+/*!
+    \class Antialiasing
+    \brief Post-process anti-aliasing of the drawn frame, after FXAA
+    The frame is copied into a texture and a fullscreen quad is drawn over it
+    with an ARB fragment program: a pixel on an edge found from the luma of
+    its neighbours is blended across the edge by how far it lies from the
+    ends of the edge, searched for along it. Thin lines and single pixels are
+    blended with their neighbours too. A first pass reading five texels a
+    pixel marks the pixels on an edge in the depth buffer, the filter is
+    depth tested against the mark, so blocks of pixels on no edge are
+    skipped before it runs and keep the frame as drawn.
+*/
+class Antialiasing{
+    public:
+        GLint quality; /*!< ANTIALIASING_OFF to ANTIALIASING_HIGH */
+        GLint supported; /*!< 1 with ARB_fragment_program, 0 without, -1 until the first frame filtered */
+        GLint width, height; /*!< Size of the frame last filtered */
+        GLuint texture; /*!< Texture the frame is copied into */
+        GLint textureWidth, textureHeight;
+        GLuint programs[ANTIALIASING_HIGH + 1]; /*!< Fragment program of every quality level, the one finding the edges at ANTIALIASING_OFF, 0 until used */
+        GLuint frames; /*!< Frames filtered at the current quality */
+        Antialiasing();
+        ~Antialiasing();
+        void setQuality(GLint);
+        void apply(GLint, GLint);
+        void report();
+        static const char *qualityName(GLint);
+        static std::string programSource(GLint);
+    private:
+        GLuint program(GLint);
+};
+#endif
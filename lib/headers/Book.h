@@ -22,13 +22,32 @@ class Book{
         GLfloat x, y, z; /*!< x, y, z Coordinates for the Book */
         GLfloat width, height; /*!< Book width and height */
         GLint noOfPages, currentPageIndex, destinationPageIndex; /*!< Page Index */
+        GLint capacity; /*!< Size of the pages array, grows as pages are added */
         Page **pages; /*!< Array of Page Instances */
+        RecordedScene shell; /*!< Recording of the rendered book border and faces */
+        std::vector<GLfloat> stack; /*!< Vertices and normals of the page stacks */
+        GLint stackPageIndex, stackNoOfPages; /*!< Reading position and size the stacks were built for */
+        GLfloat pixelError; /*!< Largest error in pixels pages are drawn with, see Page::selectDetail */
+        SearchIndex index; /*!< Text of the text pages, kept up to date as pages are added or edited */
+        GLint highlightedPage; /*!< Page showing the spans of the last search found, -1 for none */
         Book();
         void addPage(GLint, char[]);
         void addPage(GLint, void (*)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat));
+        GLint setPageText(GLint, const char*);
+        GLint setPageDrawing(GLint, void (*)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat));
+        GLint setPageAnimation(GLint, PageAnimation*);
+        GLint setPageVector(GLint, VectorDrawing*);
+        void highlight(GLint, const std::vector<SearchSpan>*);
+        void growPages();
+        GLfloat pageSpacing();
+        GLfloat pageDepth(GLint);
+        GLfloat thickness();
         void renderPage();
         void renderPage(GLint);
         void renderBook();
+        void renderStacks(GLint);
+        void buildStacks(GLint);
+        void addSlab(GLint, GLint, GLint);
         void setBorder();
         void fillFaces(GLfloat, GLfloat, GLfloat);
 };
@@ -0,0 +1,73 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _CLOTH_H
+#define _CLOTH_H
+#include "./ThreadPool.h"
+#include <vector>
+/*!
+    \struct ClothConstraint
+    \brief Distance kept between two particles of a cloth
+*/
+struct ClothConstraint{
+    GLint a, b; /*!< Particles */
+    GLfloat rest; /*!< Distance at rest */
+};
+
+/*!
+    \struct ClothBatch
+    \brief Constraints sharing no particle, projected in parallel
+*/
+struct ClothBatch{
+    std::vector<ClothConstraint> constraints;
+    GLfloat stiffness; /*!< Part of the error corrected every iteration */
+};
+
+class Cloth;
+/*!
+    \struct ClothTask
+    \brief Constraints of a batch projected by one worker of the thread pool
+*/
+struct ClothTask{
+    Cloth *cloth;
+    const ClothBatch *batch;
+    GLint first, last;
+};
+
+/*!
+    \class Cloth
+    \brief Grid of particles held together by distance constraints, solved by position based dynamics
+    Particles are integrated with Verlet and the constraints projected a fixed
+    number of iterations in a fixed number of substeps, so a step costs the
+    same every frame. The constraints are split into batches in which no two
+    constraints share a particle: a batch is projected in chunks on a thread
+    pool and the result is the same bit for bit whatever the number of threads.
+    Particles of inverse mass 0 are driven, they move towards their target.
+    Free particles are pulled towards theirs by follow, so the sheet keeps
+    its shape yet lags behind where it is driven to.
+*/
+class Cloth{
+    public:
+        GLint columns, rows;
+        std::vector<GLfloat> positions, previous, targets; /*!< x, y, z of every particle, row by row */
+        std::vector<GLfloat> inverseMass; /*!< 0 for driven particles */
+        std::vector<ClothBatch> batches;
+        std::vector<ClothTask> tasks; /*!< Chunks of the batch being projected, the pool is handed pointers into it */
+        GLfloat follow; /*!< Part of the way to its target a free particle is pulled every substep, the stiffness of the sheet */
+        GLfloat floorX, floorZ[2]; /*!< Particles do not sink below floorZ[0] right of floorX and floorZ[1] left of it */
+        Cloth();
+        void create(GLint, GLint, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+        void reset(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+        void addBatch(GLint, GLint, GLint, GLint, GLint, GLint, GLfloat);
+        void step(GLint, GLint, ThreadPool*);
+        void projectBatch(GLint, ThreadPool*);
+        void project(const ClothBatch*, GLint, GLint);
+};
+#endif
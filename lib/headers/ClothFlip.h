@@ -0,0 +1,66 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _CLOTH_FLIP_H
+#define _CLOTH_FLIP_H
+#include "./Book.h"
+#include "./Cloth.h"
+#include "./ThreadPool.h"
+#include <vector>
+/*!
+    \struct ClothFrame
+    \brief Pages bent by the cloth flip as a frame draws them, copied into the frame state
+*/
+struct ClothFrame{
+    GLint pages; /*!< Pages in flight, the first ones of the arrays */
+    GLuint textures[CLOTH_MAX_PAGES]; /*!< Image of every page */
+    GLfloat positions[CLOTH_MAX_PAGES][CLOTH_COLUMNS*CLOTH_ROWS*3]; /*!< Particles of every page */
+};
+
+/*!
+    \struct ClothSlot
+    \brief Page bent by the cloth flip, with its cloth and the image drawn on it
+*/
+struct ClothSlot{
+    Cloth cloth;
+    GLint pageIndex; /*!< -1 while free */
+    GLint settling; /*!< Steps since the page stopped being the one turned */
+    GLuint texture;
+    GLint type; /*!< Type and versions of the page the image was taken of, type -1 for no image */
+    GLuint textVersion, drawingVersion, highlightVersion;
+};
+
+/*!
+    \class ClothFlip
+    \brief Pages turned as cloth, bending as they are lifted over the binding and settling on the stack
+    The page turned is held along the binding and by its bottom corner, which
+    are moved to where a rigid page would be turned to, the rest of the page
+    follows as a cloth. Pages turned before keep settling on the stack for
+    CLOTH_SETTLE_STEPS steps, so several pages are in flight at once, every
+    one solved as a task of a thread pool. The page is drawn as a textured
+    grid, its image rendered once into a texture on the GL thread.
+*/
+class ClothFlip{
+    public:
+        std::vector<ClothSlot> slots; /*!< CLOTH_MAX_PAGES of them */
+        ThreadPool *pool; /*!< Started with the first page turned */
+        std::vector<GLfloat> vertices; /*!< Vertices, normals and texture coordinates of a page drawn, rebuilt every frame */
+        ClothFlip();
+        ~ClothFlip();
+        void step(Book*, GLint, GLfloat);
+        void clear();
+        GLint stale(Book*);
+        void update(Book*);
+        void capture(ClothFrame*);
+        void render(const ClothFrame*);
+        GLint takeSlot(Book*, GLint);
+        void drive(ClothSlot*, Book*, GLfloat, GLint);
+};
+#endif
@@ -0,0 +1,54 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _COMMAND_BUFFER_H
+#define _COMMAND_BUFFER_H
+#include "./GLBackend.h"
+#include "./Allocations.h"
+/*!
+    \class CommandBuffer
+    \brief Compact recording of GL calls
+    Stores one byte per call and the call arguments in a separate stream,
+    so a recorded frame or sub-scene can be replayed or saved to disk.
+*/
+class CommandBuffer{
+    public:
+        std::vector<unsigned char> calls; /*!< Encoded GLCall of every command */
+        std::vector<GLfloat> args; /*!< Arguments of every command, in order */
+        void clear();
+        void append(GLint, GLint, const GLfloat*);
+        void replay();
+        GLint save(const char*);
+        GLint load(const char*);
+};
+
+/*!
+    \class RecordedScene
+    \brief A sub-scene recorded once and replayed while it is unchanged
+    The key holds every value the sub-scene depends on, the scene is recorded
+    again whenever the key differs from the one it was recorded with.
+*/
+class RecordedScene{
+    public:
+        CommandBuffer commands; /*!< Commands of the recorded sub-scene */
+        GLRecorder recorder; /*!< Recorder filling commands */
+        std::vector<GLfloat> key; /*!< Values the recording depends on */
+        GLint valid; /*!< Whether commands hold a usable recording */
+        GLint previousBackend; /*!< Backend active before recording started */
+        GLRecorder *previousRecorder; /*!< Recorder active before recording started */
+        GLint previousAllocationTag; /*!< Allocation tag active before recording started */
+        RecordedScene();
+        void invalidate();
+};
+GLint callArguments(GLint, const GLfloat*);
+GLint replayScene(RecordedScene*, const GLfloat *key = NULL, GLint noOfKeys = 0);
+void beginScene(RecordedScene*, const GLfloat *key = NULL, GLint noOfKeys = 0);
+void endScene(RecordedScene*);
+#endif
@@ -0,0 +1,45 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _DYNAMIC_RESOLUTION_H
+#define _DYNAMIC_RESOLUTION_H
+#include "./GLBackend.h"
+#include <chrono>
+#include <stdio.h>
+/*!
+    \class DynamicResolution
+    \brief Draw the scene at a resolution which holds a frame time budget
+    The scene is drawn into the lower left width x height of the back buffer,
+    then copied into a texture and stretched over the whole window by present.
+    update adjusts the scale from the measured frame time, the draw cost being
+    taken as proportional to the number of pixels.
+*/
+class DynamicResolution{
+    public:
+        GLint enabled;
+        GLfloat budget; /*!< Frame time to hold, in ms */
+        GLfloat scale; /*!< Fraction of the window width and height the scene is drawn at */
+        GLint width, height; /*!< Size the scene is drawn at */
+        GLuint texture; /*!< Texture the scene is copied into before scaling up */
+        GLint textureWidth, textureHeight;
+        GLuint frames, framesOverBudget; /*!< Frames measured since enable, frames which missed the budget */
+        double totalFrameTime, totalScale;
+        FILE *log; /*!< Time, frame time and scale of every frame */
+        std::chrono::steady_clock::time_point start;
+        DynamicResolution();
+        ~DynamicResolution();
+        void enable(GLfloat);
+        void disable();
+        void resize(GLint, GLint);
+        void present(GLint, GLint, GLint, GLint);
+        void update(double);
+        void report();
+};
+#endif
@@ -0,0 +1,35 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _FRAME_ARENA_H
+#define _FRAME_ARENA_H
+#include <stddef.h>
+#include <vector>
+/*!
+    \class FrameArena
+    \brief Bump allocator for data living no longer than the frame it is made for
+    allocate hands out the next bytes of a block and reset takes them all
+    back at once. A frame needing more than the block gets overflow blocks,
+    which reset merges into one block large enough for such a frame, so in
+    steady state the arena makes no heap allocations.
+*/
+class FrameArena{
+    public:
+        char *block;
+        size_t capacity, used; /*!< Bytes of block, bytes handed out of it this frame */
+        std::vector<char*> overflow; /*!< Blocks allocated this frame as block was full */
+        size_t overflowBytes, highWater; /*!< Bytes of the overflow blocks, most bytes any frame took */
+        FrameArena();
+        ~FrameArena();
+        void* allocate(size_t);
+        void reset();
+};
+FrameArena* frameArena();
+#endif
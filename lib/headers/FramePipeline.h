@@ -0,0 +1,54 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _FRAME_PIPELINE_H
+#define _FRAME_PIPELINE_H
+#include "./CommandBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+/*!
+    \class FramePipeline
+    \brief Prepare the next frame on a worker thread
+    The worker records frame N+1 into one command buffer while the GL thread
+    submits frame N from the other. The buffers change hands in submit, which
+    never waits for the worker once the first frame exists. The hand-off is a
+    pair of atomic flags; the mutex is only taken to wake a parked worker.
+*/
+class FramePipeline{
+    public:
+        CommandBuffer frames[2]; /*!< Double buffered frame recordings */
+        GLRecorder recorders[2]; /*!< Recorder filling each frame */
+        GLint front, back; /*!< Frame submitted by the GL thread, frame recorded by the worker */
+        GLuint framesPrepared, framesRepeated; /*!< Frames recorded, frames submitted twice as the worker was busy */
+        GLuint workerParks; /*!< Times the worker parked instead of catching the next frame spinning */
+        GLint lockstep; /*!< 1 waits for the worker instead of submitting a frame twice, as replays do */
+        FramePipeline();
+        ~FramePipeline();
+        void start(void (*)(void*), size_t);
+        void stop();
+        void drain();
+        GLint started();
+        CommandBuffer* submit(const void*);
+        const void* submittedState();
+    private:
+        void (*prepare)(void*); /*!< Function recording a frame from a state */
+        std::vector<char> states[2]; /*!< State each frame is recorded from, the back one read by the worker */
+        GLint spinTime; /*!< Microseconds the worker spins before parking, 0 on a single hardware thread */
+        std::atomic<GLint> busy, pending, running, parked;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::thread worker;
+        void request(const void*);
+        GLint awaitRequest();
+        void run();
+};
+#endif
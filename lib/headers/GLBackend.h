@@ -0,0 +1,104 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _GL_BACKEND_H
+#define _GL_BACKEND_H
+#include "./Matrix.h"
+#include <vector>
+class CommandBuffer;
+/*!
+    \enum GLCall
+    \brief Identify every GL entry point routed through the backend
+*/
+enum GLCall{
+    CALL_BEGIN, CALL_END, CALL_VERTEX, CALL_NORMAL, CALL_COLOR, CALL_TEX_COORD,
+    CALL_PUSH_MATRIX, CALL_POP_MATRIX, CALL_LOAD_IDENTITY, CALL_TRANSLATE, CALL_ROTATE, CALL_SCALE,
+    CALL_ENABLE, CALL_DISABLE, CALL_BIND_TEXTURE, CALL_TEX_ENV, CALL_LINE_WIDTH,
+    CALL_LIGHT, CALL_MATERIAL, CALL_FLUSH, CALL_STROKE_CHARACTER,
+    CALL_MATRIX_MODE, CALL_LOAD_MATRIX, CALL_MULT_MATRIX, CALL_CLEAR, CALL_CLEAR_COLOR, CALL_VIEWPORT,
+    CALL_DRAW_ARRAYS, CALL_DRAW_COLORED_ARRAYS, CALL_DRAW_TEXTURED_ARRAYS,
+    CALL_ACTIVE_TEXTURE, CALL_MULTI_TEX_COORD,
+    CALL_COUNT
+};
+
+/*!
+    \class GLRecorder
+    \brief Capture GL calls into memory
+    Counts every call made through the backend and captures the submitted
+    vertices, so the drawing code can be measured without a GL context.
+    When commands is set, every call is also encoded into that CommandBuffer.
+*/
+class GLRecorder{
+    public:
+        GLuint calls[CALL_COUNT]; /*!< Number of calls made per entry point */
+        GLuint totalCalls, vertices; /*!< Total calls and vertices submitted */
+        std::vector<GLfloat> vertexData; /*!< Captured x, y, z of every vertex */
+        GLint captureVertices; /*!< Store submitted vertices in vertexData */
+        CommandBuffer *commands; /*!< Command buffer receiving the encoded calls */
+        GLfloat matrices[2][16]; /*!< Current modelview and projection matrix */
+        std::vector<GLfloat> matrixStacks[2]; /*!< Matrices saved by push matrix */
+        GLint matrixMode; /*!< 0 -> modelview, 1 -> projection */
+        GLfloat viewport[4]; /*!< Last viewport set */
+        GLRecorder();
+        void reset();
+        void record(GLint, GLint noOfArgs = 0, const GLfloat *args = NULL);
+        void trackMatrix(GLint, const GLfloat*);
+        void vertex(GLfloat, GLfloat, GLfloat);
+};
+
+extern thread_local GLint glBackend;
+extern thread_local GLRecorder *glRecorder;
+void setGLBackend(GLint, GLRecorder *recorder = NULL);
+
+void fbBegin(GLenum);
+void fbEnd();
+void fbVertex2f(GLfloat, GLfloat);
+void fbVertex3f(GLfloat, GLfloat, GLfloat);
+void fbVertex3fv(const GLfloat*);
+void fbNormal3f(GLfloat, GLfloat, GLfloat);
+void fbNormal3fv(const GLfloat*);
+void fbColor3f(GLfloat, GLfloat, GLfloat);
+void fbTexCoord2f(GLfloat, GLfloat);
+void fbMultiTexCoord2f(GLenum, GLfloat, GLfloat);
+void fbPushMatrix();
+void fbPopMatrix();
+void fbLoadIdentity();
+void fbTranslatef(GLfloat, GLfloat, GLfloat);
+void fbRotatef(GLfloat, GLfloat, GLfloat, GLfloat);
+void fbScalef(GLfloat, GLfloat, GLfloat);
+void fbEnable(GLenum);
+void fbDisable(GLenum);
+GLuint registerTextureRegion(GLuint, GLfloat, GLfloat, GLfloat, GLfloat);
+void textureSize(GLuint, GLint*, GLint*);
+void fbBindTexture(GLenum, GLuint);
+void fbTexEnvf(GLenum, GLenum, GLfloat);
+void fbActiveTexture(GLenum);
+void fbLineWidth(GLfloat);
+void fbLightfv(GLenum, GLenum, const GLfloat*);
+void fbMaterialfv(GLenum, GLenum, const GLfloat*);
+void fbFlush();
+void fbMatrixMode(GLenum);
+void fbLoadMatrixf(const GLfloat*);
+void fbMultMatrixf(const GLfloat*);
+void currentTransform(GLfloat[16], GLfloat[4]);
+void fbLookAt(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+void fbOrtho(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+void fbPerspective(GLfloat, GLfloat, GLfloat, GLfloat);
+void fbClear(GLbitfield);
+void fbClearColor(GLfloat, GLfloat, GLfloat, GLfloat);
+void fbViewport(GLint, GLint, GLsizei, GLsizei);
+void fbDrawArrays(GLenum, GLint, const GLfloat*);
+void fbDrawColoredArrays(GLenum, GLint, const GLfloat*);
+void fbDrawTexturedArrays(GLenum, GLint, const GLfloat*);
+void drawInterleavedArrays(GLenum, GLint, const GLfloat*, GLint colors = 0, GLint texCoords = 0);
+void fbStrokeCharacter(int);
+void fbStrokeCharacterSimplified(int);
+int fbStrokeWidth(int);
+#endif
@@ -0,0 +1,78 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _INPUT_JOURNAL_H
+#define _INPUT_JOURNAL_H
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+/*!
+    \enum InputEventType
+    \brief Callbacks an input event is fed to
+*/
+enum InputEventType{
+    INPUT_KEYBOARD, /*!< key, x, y */
+    INPUT_SPECIAL, /*!< key, x, y */
+    INPUT_CLICK, /*!< button, state, x, y */
+    INPUT_MOTION, /*!< x, y */
+    INPUT_MENU, /*!< menu id */
+    INPUT_RESHAPE, /*!< width, height */
+    INPUT_EVENT_TYPES
+};
+
+/*!
+    \struct InputEvent
+    \brief An input event and when it arrived
+*/
+struct InputEvent{
+    GLuint step; /*!< Animation steps taken before the event */
+    double time; /*!< ms since recording started */
+    GLint type;
+    GLint values[4];
+};
+
+/*!
+    \class InputJournal
+    \brief Record input events to a file and feed them back in the same order
+    The animation advances a fixed amount per idle step, so the step count is
+    the clock of a replay: an event recorded after step N is replayed right
+    before step N + 1 is taken, however long the steps take. The time of the
+    event is kept for reference. The journal ends with the step count and the
+    frame state hash on exit, which a replay is checked against.
+    A replay also writes the frame time and heap allocations of every step
+    to INPUT_PROFILE_LOG.
+*/
+class InputJournal{
+    public:
+        GLint recording, replaying;
+        GLuint step; /*!< Animation steps taken */
+        std::vector<InputEvent> events; /*!< Events replayed */
+        size_t next; /*!< Next event to replay */
+        GLuint endStep, endHash; /*!< Step count and frame state hash the recording ended with */
+        GLint ended; /*!< 2 when the journal ends with both, 1 with the step count only */
+        FILE *file; /*!< Journal being recorded */
+        FILE *profile; /*!< Frame time and state hash of every replayed step */
+        GLuint framesProfiled, lastProfiledStep;
+        GLuint framesAllocating; /*!< Frames profiled which made heap allocations */
+        unsigned long allocations; /*!< Heap allocations of the frames profiled */
+        std::vector<double> frameTimes;
+        std::chrono::steady_clock::time_point start;
+        InputJournal();
+        ~InputJournal();
+        GLint record(const char*);
+        void add(GLint, GLint, GLint = 0, GLint = 0, GLint = 0);
+        GLint load(const char*);
+        GLint pending(InputEvent*);
+        GLint finished();
+        void windowSize(GLint*, GLint*);
+        void frameDrawn(GLuint, double, unsigned long);
+        void close(GLuint);
+};
+#endif
@@ -0,0 +1,79 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _LIBRARY_H
+#define _LIBRARY_H
+#include "./GLBackend.h"
+#include <vector>
+
+/*!
+    \enum LibraryDetail
+    \brief Levels of detail a closed book is drawn with
+*/
+enum LibraryDetail{
+    DETAIL_FULL, /*!< Covers, spine and page block */
+    DETAIL_BOX, /*!< A single box */
+    DETAIL_IMPOSTOR, /*!< The spine as a flat quad */
+    DETAIL_LEVELS
+};
+
+/*!
+    \struct ShelfBook
+    \brief A closed book standing on a shelf
+    The spine faces the hall, side is 1 for books on the left wall and -1 on the right.
+*/
+struct ShelfBook{
+    GLfloat x, y, z; /*!< Spine corner on the shelf, nearest to the library entrance */
+    GLfloat width, height, depth; /*!< Thickness along the wall, height and depth into the shelf */
+    GLfloat color[3]; /*!< Cover color */
+    GLint side;
+};
+
+/*!
+    \struct Bookcase
+    \brief Books first to last - 1 and the box around them
+*/
+struct Bookcase{
+    GLint first, last;
+    GLfloat min[3], max[3];
+    GLint side;
+};
+
+/*!
+    \class Library
+    \brief Hall of bookcases holding thousands of closed books
+    update culls the bookcases and books against the view frustum, then sorts
+    the visible books into one vertex batch per level of detail, picked by their
+    distance to the eye. render draws the whole library with one call per batch.
+*/
+class Library{
+    public:
+        std::vector<ShelfBook> books;
+        std::vector<Bookcase> bookcases;
+        std::vector<GLfloat> batches[DETAIL_LEVELS]; /*!< Vertices, normals and colors drawn per level of detail */
+        GLuint visible[DETAIL_LEVELS], culled; /*!< Books drawn per level of detail and books culled by the last update */
+        GLint culling, levelOfDetail; /*!< Cull against the frustum, pick the detail by distance */
+        GLfloat length; /*!< Length of the hall along -z */
+        GLfloat projection[16], view[16], planes[6][4]; /*!< Matrices and frustum planes of the last update */
+        Library();
+        void build(GLint);
+        void setCamera(const GLfloat[3], GLfloat, GLfloat);
+        void update(const GLfloat[3], GLfloat, GLfloat, GLint);
+        void loadCamera();
+        void render();
+        GLint pick(const GLfloat[3], GLfloat, GLfloat, GLfloat, GLfloat, GLint);
+        GLint boxVisible(const GLfloat[3], const GLfloat[3], GLint*);
+        void addBook(const ShelfBook*, GLint, GLfloat);
+        void addBookcase(const Bookcase*);
+};
+void cameraAxes(GLfloat, GLfloat[3], GLfloat[3]);
+void bookBounds(const ShelfBook*, GLfloat, GLfloat[3], GLfloat[3]);
+void addBox(std::vector<GLfloat>*, const GLfloat[3], const GLfloat[3], const GLfloat[3], GLint faces = 0x3f);
+#endif
@@ -0,0 +1,31 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _MATRIX_H
+#define _MATRIX_H
+/*!
+    Matrices are GLfloat[16] stored column major as OpenGL stores them,
+    quaternions are GLfloat[4] stored x, y, z, w. Products are vectorized
+    with SSE or NEON when the compiler targets them. Every function accepts
+    its output aliasing one of its inputs.
+*/
+void multiplyMatricesReference(GLfloat[16], const GLfloat[16], const GLfloat[16]);
+void multiplyMatrices(GLfloat[16], const GLfloat[16], const GLfloat[16]);
+void multiplyMatrix(GLfloat[16], const GLfloat[16]);
+void multiplyMatrixBatch(GLfloat*, const GLfloat[16], const GLfloat*, GLint);
+void transformPoints(GLfloat*, const GLfloat[16], const GLfloat*, GLint);
+void identityMatrix(GLfloat[16]);
+void translateMatrix(GLfloat[16], GLfloat, GLfloat, GLfloat);
+void rotateMatrix(GLfloat[16], GLfloat, GLfloat, GLfloat, GLfloat);
+void scaleMatrix(GLfloat[16], GLfloat, GLfloat, GLfloat);
+void rotationMatrix(GLfloat[16], GLfloat, GLfloat, GLfloat, GLfloat);
+void lookAtMatrix(GLfloat[16], GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+void perspectiveMatrix(GLfloat[16], GLfloat, GLfloat, GLfloat, GLfloat);
+void orthoMatrix(GLfloat[16], GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+void axisAngleQuaternion(GLfloat[4], GLfloat, GLfloat, GLfloat, GLfloat);
+void multiplyQuaternions(GLfloat[4], const GLfloat[4], const GLfloat[4]);
+void slerpQuaternions(GLfloat[4], const GLfloat[4], const GLfloat[4], GLfloat);
+void quaternionMatrix(GLfloat[16], const GLfloat[4]);
+#endif
@@ -0,0 +1,9 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _OFFSCREEN_H
+#define _OFFSCREEN_H
+GLint createOffscreenContext(GLint, GLint);
+#endif
@@ -0,0 +1,64 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _OVERVIEW_H
+#define _OVERVIEW_H
+#include "./Book.h"
+#include <vector>
+/*!
+    \struct ThumbnailSlot
+    \brief Place in the thumbnail atlas and the version of the page drawn into it
+*/
+struct ThumbnailSlot{
+    GLint pageIndex; /*!< -1 while free */
+    GLint type;
+    GLuint textVersion, drawingVersion, highlightVersion;
+    GLuint lastUsed; /*!< Frame the slot was last needed in */
+};
+
+/*!
+    \class Overview
+    \brief Scrollable grid of thumbnails of every page of a book
+    Only the rows on screen and OVERVIEW_MARGIN_ROWS rows around them are
+    looked at, so the cost of a frame does not depend on the size of the book.
+    Thumbnails are rendered when first needed, at most OVERVIEW_RENDERS_PER_FRAME
+    a frame, read back once and stored with their mipmap levels in a slot of a
+    single atlas texture. The slot used longest ago is reused when none is free.
+    update renders on the GL thread, render draws the grid with one texture bind.
+*/
+class Overview{
+    public:
+        GLuint texture; /*!< Atlas of OVERVIEW_ATLAS_SIZE texels square holding the thumbnails */
+        std::vector<ThumbnailSlot> slots;
+        std::vector<GLint> slotOfPage; /*!< Slot holding the thumbnail of every page, -1 for none */
+        GLfloat scroll, targetScroll; /*!< Rows scrolled past the top, scroll eases towards targetScroll */
+        GLuint frame; /*!< Frames updated */
+        GLuint thumbnailsRendered, thumbnailsEvicted;
+        std::vector<GLint> missing; /*!< Pages to render a thumbnail of this frame, those on screen first */
+        std::vector<unsigned char> pixels; /*!< Thumbnails read back from the frame buffer */
+        std::vector<unsigned char> levels[OVERVIEW_MIPMAP_LEVELS]; /*!< Mipmap levels of one thumbnail */
+        Overview();
+        void clear();
+        GLfloat cellWidth(GLint);
+        GLfloat rowHeight(GLint);
+        GLfloat maxScroll(GLint, GLint, GLint);
+        void scrollBy(GLfloat, GLint, GLint, GLint);
+        void scrollTo(GLint, GLint, GLint, GLint);
+        void step();
+        void update(Book*, GLfloat, GLint, GLint);
+        void render(GLint, GLfloat, GLint, GLint);
+        GLint pick(GLint, GLfloat, GLint, GLint, GLint, GLint);
+        void createTexture();
+        GLint slotCurrent(GLint, const Page*);
+        GLint takeSlot(GLint);
+        void renderThumbnails(Book*, GLint, GLint);
+        void uploadThumbnail(GLint, const Page*, const unsigned char*, GLint);
+};
+#endif
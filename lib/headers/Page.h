@@ -10,7 +10,21 @@
 
 #ifndef _PAGE_H
 #define _PAGE_H
+#include <atomic>
 #include <string.h>
+#include <string>
+#include "./CommandBuffer.h"
+#include "./SearchIndex.h"
+#include "./VectorDrawing.h"
+/*!
+    \struct PageAnimation
+    \brief Frame an animated page shows, swapped by whoever plays the animation
+*/
+struct PageAnimation{
+    std::atomic<GLuint> texture; /*!< Texture of the frame shown, 0 before the first frame is uploaded */
+    GLfloat aspect; /*!< Width over height of a frame */
+};
+
 /*!
     \class Page
     \brief Create a Page instance
@@ -26,13 +40,37 @@ class Page{
         GLfloat marginWidth, marginHeight; /*!< Set margin of the Page */
         GLfloat lineHeight, noOfLines, currentLine, lines[MAX_LINES];
         void (*pageContent)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat); /*!< Set function to be called for rendering a drawing page */
+        PageAnimation *animation; /*!< Frames of an animated page */
+        VectorDrawing *vector; /*!< Drawing of a vector drawing page, owned by the Page */
+        RecordedScene content[PAGE_DETAIL_LEVELS]; /*!< Recording of the rendered Page per detail level, replayed by Book::renderPage */
+        GLfloat tint[3]; /*!< Average color of the Page, drawn at PAGE_DETAIL_FLAT */
+        GLint tinted; /*!< Whether tint has been computed */
+        std::string editedText; /*!< Text set by setText, text points into it */
+        GLuint textVersion, drawingVersion; /*!< Bumped on every edit of the text or the drawing */
+        std::vector<SearchSpan> highlights; /*!< Spans of the text drawn highlighted, sorted by start */
+        GLuint highlightVersion; /*!< Bumped whenever highlights change */
         Page(GLint, GLfloat, GLfloat, GLfloat, char[]);
         Page(GLint, GLfloat, GLfloat, GLfloat, void (*)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat));
-        void renderPage();
+        void setText(const char*);
+        void setDrawing(void (*)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat));
+        void setAnimation(PageAnimation*);
+        void setVector(VectorDrawing*);
+        void contentChanged();
+        void setHighlights(const std::vector<SearchSpan>*);
+        void renderPage(GLint detail = PAGE_DETAIL_FULL);
         void setMargin();
         void setPageLines();
         void setBorder();
-        void renderText();
+        void renderText(GLint detail = PAGE_DETAIL_FULL);
+        void renderGreekedText();
+        void renderHighlights();
+        void renderAnimation();
+        void renderFlat();
+        void renderRecorded(GLint);
+        void renderImage(GLint, GLint, GLint, GLfloat pixelError = -1);
+        void computeTint();
+        GLint selectDetail(GLfloat);
+        GLfloat placeGlyph(char, GLfloat*, GLint*, GLfloat[2]);
         void init(GLint, GLfloat, GLfloat, GLfloat);
 };
 void squareConstruction(GLint, GLint, GLint, GLint, GLfloat**);
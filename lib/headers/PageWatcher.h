@@ -0,0 +1,45 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _PAGE_WATCHER_H
+#define _PAGE_WATCHER_H
+#include <chrono>
+#include <string>
+#include <vector>
+/*!
+    \struct PageSource
+    \brief Text of a page read from its source file
+*/
+struct PageSource{
+    GLint pageIndex; /*!< Page the file is the source of, 3.txt -> index 2 */
+    GLint vector; /*!< 1 for a vector drawing, 3.svg */
+    std::string text;
+    std::chrono::system_clock::time_point saved; /*!< Modification time of the file */
+};
+
+/*!
+    \class PageWatcher
+    \brief Watch a directory of page sources and report the files written to it
+    Uses inotify on Linux, elsewhere only scan is available.
+*/
+class PageWatcher{
+    public:
+        std::string directory;
+        GLint descriptor; /*!< inotify instance, -1 when not watching */
+        PageWatcher();
+        ~PageWatcher();
+        GLint watch(const char*);
+        void stop();
+        GLint scan(std::vector<PageSource>*);
+        GLint poll(std::vector<PageSource>*);
+};
+GLint pageSourceIndex(const char*, GLint *vector = NULL);
+GLint readPageSource(const char*, PageSource*);
+#endif
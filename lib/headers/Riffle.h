@@ -0,0 +1,41 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _RIFFLE_H
+#define _RIFFLE_H
+#include "./Book.h"
+#include <vector>
+/*!
+    \class Riffle
+    \brief Animation of a jump over many pages, with dozens of pages turning at once
+    The pages jumped over are split into at most RIFFLE_MAX_SHEETS sheets.
+    Each sheet turns over the binding in RIFFLE_FLIP_STEPS steps, the next one
+    starting RIFFLE_SHEET_INTERVAL steps later. The sheets in flight share the
+    geometry of a blank page and differ only in their transform, they are
+    placed on the CPU and drawn with a single call.
+    The riffle is drawn from fromPage, toPage and time alone, so a frame
+    prepared on the frame pipeline worker draws the state it was given.
+*/
+class Riffle{
+    public:
+        GLint fromPage, toPage; /*!< Page shown before and after the jump */
+        GLfloat time; /*!< Steps since the riffle started, -1 while none runs */
+        std::vector<GLfloat> sheets; /*!< Vertices and normals of the sheets in flight, rebuilt every frame drawn */
+        Riffle();
+        void start(GLint, GLint);
+        void step();
+        GLint running();
+        GLint sheetCount(GLint, GLint);
+        GLfloat duration(GLint, GLint);
+        GLfloat sheetAngle(GLint, GLfloat);
+        GLint shownPage(GLint, GLint, GLfloat);
+        void render(Book*, GLint, GLint, GLfloat);
+};
+#endif
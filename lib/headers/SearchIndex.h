@@ -0,0 +1,59 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _SEARCH_INDEX_H
+#define _SEARCH_INDEX_H
+#include <map>
+#include <string>
+#include <vector>
+/*!
+    \struct SearchPosting
+    \brief Where a term starts in the text of a page
+*/
+struct SearchPosting{
+    GLint pageIndex, start;
+};
+
+/*!
+    \struct SearchSpan
+    \brief Characters of a page text matching a query, to be highlighted
+*/
+struct SearchSpan{
+    GLint start, length;
+};
+
+/*!
+    \struct SearchHit
+    \brief Page matching every word of a query and where they are on it
+*/
+struct SearchHit{
+    GLint pageIndex;
+    std::vector<SearchSpan> spans; /*!< Sorted by start */
+};
+
+/*!
+    \class SearchIndex
+    \brief Inverted index over the text of the pages of a book
+    Words are runs of letters and digits, indexed in lower case. Every term
+    keeps the places it occurs at sorted by page, so a query only walks the
+    postings of its own terms, from the page it starts at on.
+    Pages are indexed again one by one as their text changes.
+*/
+class SearchIndex{
+    public:
+        std::map<std::string, std::vector<SearchPosting> > terms; /*!< Postings of every term, sorted by page and start */
+        std::vector<std::vector<const std::string*> > pageTerms; /*!< Distinct terms of every page, keys of terms */
+        size_t postings; /*!< Postings of all the terms */
+        SearchIndex();
+        void setPage(GLint, const char*);
+        void removePage(GLint);
+        GLint search(const char*, GLint, GLint, std::vector<SearchHit>*);
+};
+#endif
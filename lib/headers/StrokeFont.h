@@ -0,0 +1,50 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _STROKE_FONT_H
+#define _STROKE_FONT_H
+/*!
+    \struct StrokeVertex
+    \brief Point of a glyph, in font units
+*/
+struct StrokeVertex{ GLfloat x, y; };
+
+/*!
+    \struct StrokeStrip
+    \brief Line strip of a glyph
+*/
+struct StrokeStrip{
+    GLint noOfVertices;
+    const StrokeVertex *vertices;
+};
+
+/*!
+    \struct StrokeChar
+    \brief Glyph of a stroke font, drawn as line strips and followed by a move of right
+*/
+struct StrokeChar{
+    GLfloat right; /*!< Advance to the next character */
+    GLint noOfStrips; /*!< 0 for characters the font has no glyph for */
+    const StrokeStrip *strips;
+};
+
+/*!
+    \struct StrokeFont
+    \brief Stroke font covering the characters 0 to noOfChars-1
+*/
+struct StrokeFont{
+    const char *name;
+    GLint noOfChars;
+    GLfloat height; /*!< Height of a line, in font units */
+    const StrokeChar *chars;
+};
+
+extern const StrokeFont strokeRoman; /*!< The font GLUT_STROKE_ROMAN draws with */
+#endif
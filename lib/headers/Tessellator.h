@@ -0,0 +1,32 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _TESSELLATOR_H
+#define _TESSELLATOR_H
+#include <vector>
+
+/*!
+    \struct Outline
+    \brief Contours of a shape, each a polyline of x, y points
+*/
+struct Outline{
+    std::vector<GLfloat> points; /*!< x, y of every contour, one contour after another */
+    std::vector<GLint> ends; /*!< Points of the contours up to the end of each */
+    std::vector<GLint> closed; /*!< 1 for a contour closed by a segment back to its first point */
+    void moveTo(GLfloat, GLfloat);
+    void lineTo(GLfloat, GLfloat);
+    void close();
+    void clear();
+    GLint noOfPoints();
+};
+
+GLint tessellateFill(const Outline*, GLint, std::vector<GLfloat>*);
+GLint tessellateStroke(const Outline*, GLfloat, std::vector<GLfloat>*);
+#endif
@@ -0,0 +1,36 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _THREAD_POOL_H
+#define _THREAD_POOL_H
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+/*!
+    \class ThreadPool
+    \brief Fixed set of worker threads running queued tasks
+    The queue is emptied in one go once every task has started, so a pool
+    queuing tasks that capture no more than a pointer every frame makes no
+    heap allocations.
+*/
+class ThreadPool{
+    public:
+        ThreadPool(GLint noOfThreads = 0);
+        ~ThreadPool();
+        GLint size();
+        void enqueue(std::function<void()>);
+        void wait();
+    private:
+        std::vector<std::thread> workers; /*!< Worker threads */
+        std::vector<std::function<void()> > tasks; /*!< Tasks queued since the queue last ran empty */
+        size_t nextTask; /*!< First task of tasks not yet started */
+        std::mutex mutex;
+        std::condition_variable taskAdded, tasksDone;
+        GLint activeTasks, running;
+        void run();
+};
+#endif
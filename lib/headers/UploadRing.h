@@ -0,0 +1,90 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _UPLOAD_RING_H
+#define _UPLOAD_RING_H
+#include <condition_variable>
+#include <mutex>
+#include <stddef.h>
+#include <vector>
+
+/*!
+    \struct StreamedTexture
+    \brief Texture filled by the rows written into an UploadRing
+    The producer sets the size, format and number of levels before writing,
+    the GL thread creates the texture before uploading its first rows.
+*/
+struct StreamedTexture{
+    GLuint texture; /*!< 0 until the first rows are uploaded */
+    GLint noOfLevels;
+    GLenum format; /*!< GL_RGB, GL_RGBA or one of the DXT formats */
+    GLint compressed;
+    GLint ready; /*!< 1 once the last rows of the last level are uploaded, set on the GL thread */
+};
+
+/*!
+    \struct UploadJob
+    \brief Band of rows of one level, copied into the ring and waiting to be uploaded
+*/
+struct UploadJob{
+    StreamedTexture *texture;
+    GLint level, width, height; /*!< Level the rows belong to and its size */
+    GLint y, rows; /*!< Rows of the level in the band */
+    size_t offset, size; /*!< Bytes of the band in the ring */
+    size_t footprint; /*!< Bytes released with the band, including those skipped at the end of the ring */
+    GLint written; /*!< 1 once the producer copied the rows in */
+    GLint last; /*!< Last band of the last level of the texture */
+    GLsync fence; /*!< Signaled once this band and those issued before it are read, 0 for none */
+};
+
+/*!
+    \class UploadRing
+    \brief Ring of pixel buffer memory texture uploads are streamed through
+    Any thread copies decoded levels into the ring with write, which blocks
+    while the ring is full. The GL thread calls pump every frame, which
+    uploads at most a budget of bytes and fences them, the memory of a band
+    being reused once its fence is signaled. The ring is a persistently mapped
+    pixel buffer object, or client memory uploaded synchronously when buffer
+    storage is not supported.
+*/
+class UploadRing{
+    public:
+        size_t size; /*!< Bytes of the ring */
+        size_t bandSize; /*!< Most bytes of a band, no larger than the budget of a frame */
+        GLint persistent; /*!< 1 when the ring is a mapped pixel buffer object */
+        size_t bytesWritten, bytesUploaded;
+        double writeTime, uploadTime; /*!< ms spent copying into the ring and issuing the uploads out of it */
+        GLuint pumps; /*!< Calls of pump which uploaded something */
+        size_t largestPump; /*!< Most bytes uploaded by one call of pump */
+        double longestPump; /*!< Longest call of pump, in ms */
+        UploadRing();
+        GLint create(size_t, size_t);
+        void destroy();
+        void write(StreamedTexture*, GLint, GLint, GLint, const unsigned char*, size_t);
+        size_t pump(size_t);
+        void flush();
+        GLint idle();
+        void waitForWrite(GLint);
+        void resetStatistics();
+        void report(const char*);
+    private:
+        GLuint buffer; /*!< Pixel buffer object, 0 when the ring is client memory */
+        unsigned char *memory; /*!< Mapped buffer or clientMemory */
+        std::vector<unsigned char> clientMemory;
+        std::vector<UploadJob> jobs; /*!< Circular queue of bands, oldest first */
+        size_t firstJob, noOfJobs, issuedJobs; /*!< Oldest band, bands queued, bands uploaded but not released */
+        size_t head, used; /*!< Next byte written, bytes not released */
+        std::mutex mutex;
+        std::condition_variable spaceFreed, jobWritten;
+        void createTexture(const UploadJob*);
+        void issue(const UploadJob*);
+        void retire(GLint);
+};
+#endif
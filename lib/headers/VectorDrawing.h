@@ -0,0 +1,60 @@
+#ifndef _OPENGL_H
+#define _OPENGL_H
+#include <GL/glut.h>
+#endif
+
+#ifndef _CONSTANTS_H
+#define _CONSTANTS_H
+#include "../../config/Constants.h"
+#endif
+
+#ifndef _VECTOR_DRAWING_H
+#define _VECTOR_DRAWING_H
+#include "./Tessellator.h"
+#include <string>
+#include <vector>
+
+/*!
+    \struct VectorPaint
+    \brief How a shape of a vector drawing is filled and stroked
+*/
+struct VectorPaint{
+    GLfloat fill[3], stroke[3];
+    GLint filled, stroked; /*!< 0 for none */
+    GLfloat strokeWidth;
+    GLint evenOdd; /*!< fill-rule evenodd, nonzero otherwise */
+};
+
+/*!
+    \class VectorDrawing
+    \brief Drawing read from a subset of SVG, tessellated once into triangles
+    Paths, rectangles, circles, ellipses, lines, polylines and polygons are
+    read, filled and stroked with solid colors, grouped by g elements passing
+    their paint on. Transforms, gradients and text are not. The triangles are
+    kept in drawing units, y down as in SVG, and placed on a page when drawn.
+*/
+class VectorDrawing{
+    public:
+        GLfloat viewBox[4]; /*!< x, y, width, height of the drawing */
+        std::vector<GLfloat> mesh; /*!< x, y, layer, r, g, b of every triangle corner, layers painted in order */
+        GLint noOfShapes, noOfLayers;
+        GLint noOfPoints; /*!< Points of the outlines tessellated */
+        GLint skipped; /*!< Elements or path commands left out */
+        double tessellationTime; /*!< ms spent tessellating, reading the source left out */
+        VectorDrawing();
+        GLint parse(const char*);
+        GLint load(const char*);
+        GLint noOfTriangles();
+        GLfloat place(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat[2]);
+        void draw(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+        GLfloat ink(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat[3]);
+    private:
+        Outline outline; /*!< Shape being read */
+        std::vector<GLfloat> triangles; /*!< Triangles of the shape being read */
+        std::vector<GLfloat> vertices; /*!< Mesh placed on a page, as fbDrawColoredArrays takes it */
+        GLfloat tolerance; /*!< Most distance of a flattened curve from the curve, in drawing units */
+        void readPath(const char*);
+        void addShape(const VectorPaint*);
+        void addLayer(const GLfloat*);
+};
+#endif
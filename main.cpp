@@ -15,69 +15,96 @@ void setHexColor(int color /*!< color received as Hexadecimal*/){
     GLfloat b = (color%0xff)/255.0;
     GLfloat g = ((color>>8)%0xff)/255.0;
     GLfloat r = ((color>>16)%0xff)/255.0;
-    glColor3f(r, g, b); /*!< Detailed description after the member */
+    fbColor3f(r, g, b); /*!< Detailed description after the member */
 }
 
 /*!
-    \fn selectFlippingPageType()
+    \fn selectFlippingPageType(const FrameState *state, GLfloat m[16])
     \brief Select Page Flip Type.
-    Selects the type of page flip chosen by the user.
+    Transform of the page turned by the page flip type chosen by the user,
+    rotated around the top of the binding.
     flipId -> holds the page flipid chosen by the user.
         which is set by the user from input interaction.
 
 */
-void selectFlippingPageType(){
-    if(flipId == 0){
-        pageFlipLimit = 270;
-        glRotatef(pageAngle,0.0,-1.0,0.0); /*!< Book Flip type */
-    }
-    else if(flipId == 1){
-        pageFlipLimit = 320;
-        glRotatef(pageAngle,-1.0,-1.0,0.0); /*!< Writing Page Flip */
-    }
-    else if(flipId == 2){
-        pageFlipLimit = 350;
-        glRotatef(pageAngle,-1.0,-0.0,0.0); /*!< Notepad Page Flip */
-    }
-    else if(flipId == 3){
-        pageFlipLimit = 340;
-        glRotatef(pageAngle,-1.0,0.0,-1.0); /*!< Special Page Flip */
-    }
+void selectFlippingPageType(const FrameState *state, GLfloat m[16]){
+    static const GLfloat axes[][3] = {
+        {0.0,-1.0,0.0}, /*!< Book Flip type */
+        {-1.0,-1.0,0.0}, /*!< Writing Page Flip */
+        {-1.0,-0.0,0.0}, /*!< Notepad Page Flip */
+        {-1.0,0.0,-1.0} /*!< Special Page Flip */
+    };
+    identityMatrix(m);
+    if(state->flipId < 0 || state->flipId > 3)
+        return;
+    const GLfloat *axis = axes[state->flipId];
+    translateMatrix(m, 0, PAGE_HEIGHT+BOOK_BORDER_SIZE, 0);
+    rotateMatrix(m, state->pageAngle, axis[0], axis[1], axis[2]);
+    translateMatrix(m, 0, -PAGE_HEIGHT-BOOK_BORDER_SIZE, 0);
 }
 
 /*!
-    \fn selectViewingAngle()
+    \fn selectViewingAngle(const FrameState *state, GLfloat m[16])
     \brief Select Viewing Type
-    Selects the view type based on user input interaction
+    Viewing transform of the view type selected by user input interaction
         Selection based on viewId value.
 */
-void selectViewingAngle(){
-    if(viewId == 0){
-        gluLookAt(0,0,1900,0,0,0,0,50,0); /*!< Normal View */
+void selectViewingAngle(const FrameState *state, GLfloat m[16]){
+    if(state->viewId == 1){
+        lookAtMatrix(m,0,700,2500,0,0,0,0,10,0); /*!< Top View */
     }
-    else if(viewId == 1){
-        gluLookAt(0,700,2500,0,0,0,0,10,0); /*!< Top View */
+    else if(state->viewId == 2){
+        lookAtMatrix(m,0,-700,2500,20,0,-50,0,50,0); /*!< Bottom View */
     }
-    else if(viewId == 2){
-        gluLookAt(0,-700,2500,20,0,-50,0,50,0); /*!< Bottom View */
+    else if(state->viewId == 3){
+        lookAtMatrix(m,-500,0,3000,0,0,0,0,80,0); /*!< Horizontal View */
+        rotateMatrix(m,state->viewAngle,0.0,-1.0,-1.0); /*!< 360 deg rotation */
     }
-    else if(viewId == 3){
-        viewAngleLimit = 720;
-        gluLookAt(-500,0,3000,0,0,0,0,80,0); /*!< Horizontal View */
-        glRotatef(viewAngle,0.0,-1.0,-1.0); /*!< 360 deg rotation */
+    else if(state->viewId == 4){
+        lookAtMatrix(m,0,-500,3000,0,0,0,0,80,0); /*!< Vertical View */
+        rotateMatrix(m,state->viewAngle,-1.0,0.0,0.0); /*!< 360 deg rotation */
     }
-    else if(viewId == 4){
-        viewAngleLimit = 720;
-        gluLookAt(0,-500,3000,0,0,0,0,80,0); /*!< Vertical View */
-        glRotatef(viewAngle,-1.0,0.0,0.0); /*!< 360 deg rotation */
+    else if(state->viewId == 5){
+        lookAtMatrix(m,0,500,3000,0,0,0,0,80,0); /*!< Horizontal and Vertical View */
+        rotateMatrix(m,state->viewAngle,1.0,-1.0,1.0); /*!< 360 deg rotation */
     }
-    else if(viewId == 5){
-        viewAngleLimit = 720;
-        gluLookAt(0,500,3000,0,0,0,0,80,0); /*!< Horizontal and Vertical View */
-        glRotatef(viewAngle,1.0,-1.0,1.0); /*!< 360 deg rotation */
+    else{
+        lookAtMatrix(m,0,0,1900,0,0,0,0,50,0); /*!< Normal View */
     }
 }
 
+/*!
+    \fn bookPlacement(const FrameState *state, GLfloat m[16])
+    \brief Transform of the book, laying down on the table or held up for flipping
+*/
+void bookPlacement(const FrameState *state, GLfloat m[16]){
+    identityMatrix(m);
+    translateMatrix(m,-100,-100,0);
+    if(state->startFlipping == 0){ /*!< Book laying down on the table */
+        translateMatrix(m,-80, -110, -150);
+        rotateMatrix(m,-90, 1, 0, 0);
+    }
+    else{
+        translateMatrix(m,state->translateBookbyX,state->translateBookbyY,50);
+    }
+}
+
+/*!
+    \fn updateAnimationLimits()
+    \brief Set the limits of the page and view rotation
+    pageFlipLimit depends on the screen shown and the flip type chosen,
+    viewAngleLimit on the 360 deg views.
+*/
+void updateAnimationLimits(){
+    GLfloat flipLimits[] = {270, 320, 350, 340, 200};
+    if(showWelcomeScreen == 1)
+        pageFlipLimit = 720;
+    else if(flipId >= 0 && flipId <= 4)
+        pageFlipLimit = flipLimits[flipId];
+    if(viewId >= 3)
+        viewAngleLimit = 720;
+}
+
 /*!
     \fn flipPage()
     \brief Increase the angle of rotation
@@ -86,6 +113,7 @@ void selectViewingAngle(){
     viewAngle -> for changing the viewing angle until viewAngleLimit
 */
 void flipPage(){
+    updateAnimationLimits();
     if(startFlipping == 1 && pauseFlipping == 0){
         if(pageAngle <= pageFlipLimit){
             pageAngle += speed; /*!< Increase pageAngle based on the chosen speed */
@@ -103,6 +131,95 @@ void flipPage(){
     }
 }
 
+/*!
+    \fn flipClothPages()
+    \brief Advance the pages bent by the cloth flip
+    Only the open book in the room turns its pages as cloth, and not while
+    riffling. Images of pages newly lifted are taken on the GL thread with
+    the frame pipeline drained, as the worker reads the pages.
+*/
+void flipClothPages(){
+    if(flipId != 4 || showWelcomeScreen == 1 || showLibrary == 1 || showOverview == 1 || riffle.running()){
+        clothFlip.clear();
+        return;
+    }
+    GLint tag = setAllocationTag(ALLOCATION_PAGES);
+    clothFlip.step(flipbook, pageId, pageAngle);
+    if(clothFlip.stale(flipbook)){
+        if(threadedRendering == 1)
+            framePipeline.drain();
+        clothFlip.update(flipbook);
+    }
+    setAllocationTag(tag);
+}
+
+/*!
+    \fn currentFrameState()
+    \brief Snapshot of everything a frame is drawn from
+    Input and animation keep changing the globals while a frame is being prepared,
+    so frames are drawn from a copy taken at the start of the frame.
+*/
+FrameState currentFrameState(){
+    FrameState state;
+    state.pageAngle = pageAngle;
+    state.viewAngle = viewAngle;
+    state.translateBookbyX = translateBookbyX;
+    state.translateBookbyY = translateBookbyY;
+    state.windowWidth = window_width;
+    state.windowHeight = window_height;
+    state.pageId = pageId;
+    state.flipId = flipId;
+    state.viewId = viewId;
+    state.showWelcomeScreen = showWelcomeScreen;
+    state.startFlipping = startFlipping;
+    state.showLibrary = showLibrary;
+    state.pulledBook = pulledBook;
+    state.openedShelfBook = openedShelfBook;
+    for(int i=0;i<3;i++)
+        state.libraryEye[i] = libraryEye[i];
+    state.libraryYaw = libraryYaw;
+    state.showFooter = 1;
+    state.showOverview = showOverview;
+    state.overviewScroll = overview.scroll;
+    state.riffleFrom = riffle.fromPage;
+    state.riffleTo = riffle.toPage;
+    state.riffleTime = riffle.time;
+    if(riffle.running()){ /*!< The book lies open where the riffle has got to */
+        state.pageId = riffle.shownPage(riffle.fromPage, riffle.toPage, riffle.time);
+        state.pageAngle = 0;
+    }
+    clothFlip.capture(&state.cloth);
+    state.searching = searching;
+    state.searchFailed = searchFailed;
+    memcpy(state.searchQuery, searchQuery, sizeof(searchQuery));
+    state.animationFrame = animationPlayer.playedFrame;
+    return state;
+}
+
+/*!
+    \fn frameStateHash(const FrameState *state)
+    \brief FNV-1a hash of a frame state, equal for states drawing the same frame
+    FrameState holds only 4 byte fields and a query of a multiple of 4
+    characters, so it has no padding to leave out. Characters after the end
+    of the query are kept 0.
+*/
+GLuint frameStateHash(const FrameState *state){
+    const unsigned char *bytes = (const unsigned char*)state;
+    GLuint hash = 2166136261u;
+    for(size_t i=0;i<sizeof(FrameState);i++)
+        hash = (hash ^ bytes[i]) * 16777619u;
+    return hash;
+}
+
+/*!
+    \fn postRedisplay()
+    \brief Ask for the window to be drawn again, headless replays draw every step themselves
+*/
+void postRedisplay(){
+    if(headless == 0)
+        glutPostRedisplay();
+}
+
 /*!
     \fn idleStateExecution()
     \brief Called on idle state of Opengl execution.
@@ -110,53 +227,164 @@ void flipPage(){
     renders flipPage for controlling the angle for pageflip and viewing.
 */
 void idleStateExecute(){
+    GLint tag = setAllocationTag(ALLOCATION_ASSETS);
+    uploadRing.pump(UPLOAD_BYTES_PER_FRAME); /*!< Textures decoded in the background are uploaded a slice a frame */
+    if(assetsLoaded == 0 && assetsDecoded == 1 && uploadRing.idle())
+        finishLoadingAssets();
+    reloadPages();
+    setAllocationTag(tag);
+    if(showOverview == 1)
+        overview.step();
+    riffle.step();
     flipPage();
-    glutPostRedisplay();
+    flipClothPages();
+    animationPlayer.update(inputJournal.step); /*!< After the pump, frames uploaded this step are shown */
+    inputJournal.step++;
+    postRedisplay();
 }
 
 /*!
-    \fn initReshape(int w, int h)
-    \brief Callback for window reshape
-    Called initially during rendering and on window reshape.
-    sets the PROJECTION_MATRIX and based on screen display
+    \fn setProjection(int w, int h, int welcomeScreen)
+    \brief Set the viewport and the PROJECTION_MATRIX
     Welcome screen -> Parallel Projection
     Main screen -> Perspective Projection
 */
-void initReshape(int w, int h){
-    window_height = h;
-    window_width = w;
-    glViewport(0, 0, w, h);
-    glClearColor(0.0,0.0,0.0,1.0);
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-    if(showWelcomeScreen == 1) /*!< Welcome Screen -> Parallel Projection */
+void setProjection(int w, int h, int welcomeScreen){
+    fbViewport(0, 0, w, h);
+    fbClearColor(0.0,0.0,0.0,1.0);
+    fbMatrixMode(GL_PROJECTION);
+    fbLoadIdentity();
+    if(welcomeScreen == 1) /*!< Welcome Screen -> Parallel Projection */
     {
         if(w<=h)
-            glOrtho(-WINDOW_WIDTH,WINDOW_WIDTH,-WINDOW_HEIGHT*(GLfloat)h/(GLfloat)w,WINDOW_HEIGHT*(GLfloat)h/(GLfloat)w,-MAX_NO_PAGES*BOOK_THICKNESS,MAX_NO_PAGES*BOOK_THICKNESS);
+            fbOrtho(-WINDOW_WIDTH,WINDOW_WIDTH,-WINDOW_HEIGHT*(GLfloat)h/(GLfloat)w,WINDOW_HEIGHT*(GLfloat)h/(GLfloat)w,-MAX_NO_PAGES*BOOK_THICKNESS,MAX_NO_PAGES*BOOK_THICKNESS);
         else
-            glOrtho(-WINDOW_WIDTH*(GLfloat)w/(GLfloat)h,WINDOW_WIDTH*(GLfloat)w/(GLfloat)h,-WINDOW_HEIGHT,WINDOW_HEIGHT,-MAX_NO_PAGES*BOOK_THICKNESS,MAX_NO_PAGES*BOOK_THICKNESS);
+            fbOrtho(-WINDOW_WIDTH*(GLfloat)w/(GLfloat)h,WINDOW_WIDTH*(GLfloat)w/(GLfloat)h,-WINDOW_HEIGHT,WINDOW_HEIGHT,-MAX_NO_PAGES*BOOK_THICKNESS,MAX_NO_PAGES*BOOK_THICKNESS);
     }
     else
-        gluPerspective(45,(w/h),20,20000); /** Main Page -> Perspective Projection */
-    glMatrixMode(GL_MODELVIEW);
+        fbPerspective(45,(w/h),20,20000); /** Main Page -> Perspective Projection */
+    fbMatrixMode(GL_MODELVIEW);
 }
 
 /*!
-    \fn display()
-    \brief Render function used in Opengl
-    the Render function used to display
+    \fn initReshape(int w, int h)
+    \brief Callback for window reshape
+    Called on window reshape.
+    sets the PROJECTION_MATRIX and based on screen display
+*/
+void initReshape(int w, int h){
+    inputJournal.add(INPUT_RESHAPE, w, h);
+    window_height = h;
+    window_width = w;
+    setProjection(w, h, showWelcomeScreen);
+}
+
+/*!
+    \fn createFlipbook()
+    \brief Create the Flipbook and add its pages
+    The Flipbook is created once, so the recordings of its pages are reused across frames.
+*/
+void createFlipbook(){
+    flipbook = new Book(); /*!< Flipbook Creation */
+    flipbook->pixelError = pagePixelError;
+    flipbook->addPage(PAGE_TYPE_TEXT,firstPageText);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level1);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level2);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level3);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level4);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level5);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level6);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level7);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level8);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level9);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level10);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level11);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level12);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level13);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level14);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level15);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level16);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level17);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level18);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level19);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level20);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level21);
+    flipbook->addPage(PAGE_TYPE_DRAWING,level22);
+    for(int i=flipbook->noOfPages;i<noOfPages-1;i++) /*!< Filler pages asked for with --pages */
+        flipbook->addPage(PAGE_TYPE_TEXT,fillerPageText);
+    flipbook->addPage(PAGE_TYPE_TEXT,lastPageText);
+    storyBook = flipbook;
+}
+
+/*!
+    \fn drawLibrary(const FrameState *state)
+    \brief Draw the library view, lit by a lamp above the eye
+*/
+void drawLibrary(const FrameState *state){
+    GLfloat LIGHT_AMBIENT[]={0.35f, 0.33f, 0.3f, 1.0f};
+    GLfloat LIGHT_DIFFUSE[]={0.8f, 0.75f, 0.65f, 1.0f};
+    GLfloat LIGHT_POSITION[]={state->libraryEye[0], LIBRARY_SHELVES*LIBRARY_SHELF_HEIGHT, state->libraryEye[2], 1.0f};
+    fbViewport(0, 0, state->windowWidth, state->windowHeight);
+    library.update(state->libraryEye, state->libraryYaw, (GLfloat)state->windowWidth/state->windowHeight, state->pulledBook);
+    library.loadCamera();
+    fbEnable(GL_LIGHTING);
+    fbEnable(GL_LIGHT1);
+    fbLightfv(GL_LIGHT1, GL_AMBIENT, LIGHT_AMBIENT);
+    fbLightfv(GL_LIGHT1, GL_DIFFUSE, LIGHT_DIFFUSE);
+    fbLightfv(GL_LIGHT1, GL_POSITION, LIGHT_POSITION);
+    library.render();
+    fbDisable(GL_LIGHTING);
+    fbDisable(GL_LIGHT1);
+}
+
+/*!
+    \fn drawSearchPrompt(const FrameState *state)
+    \brief Draw the search prompt over the bottom of the room
+*/
+void drawSearchPrompt(const FrameState *state){
+    char prompt[SEARCH_QUERY_LENGTH + 24];
+    snprintf(prompt, sizeof(prompt), "Search: %s%s", state->searchQuery, state->searchFailed == 1 ? "  not found" : "_");
+    fbClear(GL_DEPTH_BUFFER_BIT);
+    setProjection(state->windowWidth, state->windowHeight, 1);
+    fbLoadIdentity();
+    fbColor3f(1.0, 0.88, 0.35);
+    fbLineWidth(2);
+    fbPushMatrix();
+        fbTranslatef(-WINDOW_WIDTH + 40, -WINDOW_HEIGHT + 60, 0);
+        fbScalef(0.5, 0.5, 1);
+        renderText(prompt);
+        fbFlush();
+    fbPopMatrix();
+    fbLineWidth(1);
+    fbColor3f(1, 1, 1);
+}
+
+/*!
+    \fn drawScene(const FrameState *state)
+    \brief Draw the frame described by state
     showWelcomeScreen decides welcome screen or main screen to be rendered.
-    Flipbook created, room setup, added pages for the flipbook,
-    transformations for flipping the pages, lighting and shading operations.
+    Room setup, transformations for flipping the pages, lighting and shading operations.
+    The view, book and page transforms are combined on the CPU and loaded as finished matrices.
+    The room is replayed from its recording while its textures are unchanged.
+    Heap allocations are counted against the part of the scene making them.
 */
-void display(){
-    char string1[]="\n The \n   TETRIS  \n Game";
-    char string[]="\n\n  Game Over!";
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
-    glLoadIdentity();
-    if(showWelcomeScreen == 1){ /*!< Welcome Screen */
-        initReshape(window_width, window_height);
-        runWelcomeScreen();
+void drawScene(const FrameState *state){
+    GLint tag = setAllocationTag(ALLOCATION_SCENE);
+    fbClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+    fbLoadIdentity();
+    if(state->showWelcomeScreen == 1){ /*!< Welcome Screen */
+        setAllocationTag(ALLOCATION_WELCOME);
+        setProjection(state->windowWidth, state->windowHeight, 1);
+        runWelcomeScreen(state->pageAngle, state->showFooter);
+    }
+    else if(state->showLibrary == 1){ /*!< Library */
+        setAllocationTag(ALLOCATION_LIBRARY);
+        drawLibrary(state);
+    }
+    else if(state->showOverview == 1){ /*!< Thumbnails of every page */
+        setAllocationTag(ALLOCATION_PAGES);
+        overview.render(openedBook(state->openedShelfBook)->noOfPages, state->overviewScroll, state->windowWidth, state->windowHeight);
     }
     else{ /*!< Main Screen */
         GLfloat LIGHT_AMBIENT[]={0.5f,0.59f, 0.57f, 0.0f};
@@ -166,76 +394,227 @@ void display(){
         GLfloat mat_diffuse[]={0.5f,0.5f,0.5f,1.0f};
         GLfloat mat_specular[]={1.0f,1.0f,1.0f,1.0f};
         GLfloat mat_shininess[]={50.0f};
-        initReshape(window_width, window_height);
+        GLfloat roomKey[]={(GLfloat)wallTexture, (GLfloat)wall2Texture, (GLfloat)floorTexture,
+            (GLfloat)picTexture, (GLfloat)pic2Texture, (GLfloat)tableTexture, (GLfloat)litRoomTexture};
+        setProjection(state->windowWidth, state->windowHeight, 0);
+        /*!< Lights placed in eye coordinates, enabled once the room with its baked light is drawn */
+        fbLightfv(GL_LIGHT1, GL_AMBIENT, LIGHT_AMBIENT);
+        fbLightfv(GL_LIGHT1, GL_DIFFUSE, LIGHT_DIFFUSE);
+        fbLightfv(GL_LIGHT1, GL_POSITION, LIGHT_POSITION);
+        GLfloat view[16], book[16], flip[16];
+        selectViewingAngle(state, view);
+        bookPlacement(state, book);
+        selectFlippingPageType(state, flip);
+        multiplyMatrices(book, view, book);
+        multiplyMatrices(flip, book, flip);
+        fbLoadMatrixf(view);
+        if(!replayScene(&roomScene, roomKey, 7)){
+            beginScene(&roomScene, roomKey, 7);
+            drawRoom();
+            endScene(&roomScene);
+        }
         /*!< Lighting and Shading */
-        glEnable(GL_LIGHTING);
-        glEnable(GL_LIGHT0);
-        glEnable(GL_LIGHT1);
-        glLightfv(GL_LIGHT1, GL_AMBIENT, LIGHT_AMBIENT);
-        glLightfv(GL_LIGHT1, GL_DIFFUSE, LIGHT_DIFFUSE);
-        glLightfv(GL_LIGHT1, GL_POSITION, LIGHT_POSITION);
-        selectViewingAngle();
-        drawRoom();
-        glPushMatrix();
-            glTranslatef(-100,-100,0);
-            Book *flipbook=new Book(); /*!< Flipbook Creation */
-            glMaterialfv(GL_FRONT,GL_AMBIENT,mat_ambient);
-            glMaterialfv(GL_FRONT,GL_DIFFUSE,mat_diffuse);
-            glMaterialfv(GL_FRONT,GL_SPECULAR,mat_specular);
-            glMaterialfv(GL_FRONT,GL_SHININESS,mat_shininess);
-            /*!< Shading */
-            flipbook->addPage(PAGE_TYPE_TEXT,string1);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level1);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level2);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level3);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level4);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level5);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level6);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level7);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level8);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level9);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level10);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level11);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level12);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level13);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level14);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level15);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level16);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level17);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level18);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level19);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level20);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level21);
-            flipbook->addPage(PAGE_TYPE_DRAWING,level22);
-            flipbook->addPage(PAGE_TYPE_TEXT,string);
-            glColor3f(0,0,0);
-            if(startFlipping == 0){ /*!< Book laying down on the table */
-                glTranslatef(-80, -110, -150);
-                glRotatef(-90, 1, 0, 0);
-            }
-            else{
-                glTranslatef(translateBookbyX,translateBookbyY,50);
-            }
-            flipbook->renderBook(); /*!< Render Flipbook */
-            glPushMatrix();
-                glTranslatef(0,PAGE_HEIGHT+BOOK_BORDER_SIZE,0);
-                selectFlippingPageType(); /*!< Flip current Page */
-                glTranslatef(0,-PAGE_HEIGHT-BOOK_BORDER_SIZE,0);
-                flipbook->renderPage(pageId);
-                glFlush();
-            glPopMatrix();
-            flipbook->renderPage(pageId+1); /*!< Render next Page */
-            glColor3f(0,0,0);
-            glFlush();
-        glPopMatrix();
-        glDisable(GL_LIGHTING);
-        glDisable(GL_LIGHT0);
-        glDisable(GL_LIGHT1);
-        glDisable(GL_LIGHT2);
-    }
-    glFlush();
-    glutSwapBuffers();
+        fbEnable(GL_LIGHTING);
+        fbEnable(GL_LIGHT0);
+        fbEnable(GL_LIGHT1);
+        setAllocationTag(ALLOCATION_PAGES);
+        fbLoadMatrixf(book);
+        fbMaterialfv(GL_FRONT,GL_AMBIENT,mat_ambient);
+        fbMaterialfv(GL_FRONT,GL_DIFFUSE,mat_diffuse);
+        fbMaterialfv(GL_FRONT,GL_SPECULAR,mat_specular);
+        fbMaterialfv(GL_FRONT,GL_SHININESS,mat_shininess);
+        /*!< Shading */
+        fbColor3f(0,0,0);
+        Book *opened = openedBook(state->openedShelfBook);
+        opened->renderBook(); /*!< Render Flipbook */
+        opened->renderStacks(state->pageId); /*!< Pages read and still to read */
+        if(state->riffleTime >= 0)
+            riffle.render(opened, state->riffleFrom, state->riffleTo, state->riffleTime); /*!< Pages in flight */
+        if(state->flipId == 4 && state->cloth.pages > 0)
+            clothFlip.render(&state->cloth); /*!< Current Page and those settling, bent as cloth */
+        else{
+            fbLoadMatrixf(flip); /*!< Flip current Page */
+            opened->renderPage(state->pageId);
+        }
+        fbFlush();
+        fbLoadMatrixf(book);
+        opened->renderPage(state->pageId+1); /*!< Render next Page */
+        fbColor3f(0,0,0);
+        fbFlush();
+        fbDisable(GL_LIGHTING);
+        fbDisable(GL_LIGHT0);
+        fbDisable(GL_LIGHT1);
+        fbDisable(GL_LIGHT2);
+        if(state->searching == 1)
+            drawSearchPrompt(state);
+    }
+    fbFlush();
+    setAllocationTag(tag);
+}
+
+/*!
+    \fn prepareFrame(void *state)
+    \brief Record the frame described by state, called on the frame pipeline worker
+*/
+void prepareFrame(void *state){
+    drawScene((const FrameState*)state);
+}
+
+/*!
+    \fn saveCapture(CommandBuffer *commands)
+    \brief Save a recorded frame to CAPTURE_FILENAME
+*/
+void saveCapture(CommandBuffer *commands){
+    if(commands->save(CAPTURE_FILENAME))
+        cout<<endl<<"Frame captured to "<<CAPTURE_FILENAME<<" ("<<commands->calls.size()<<" commands)";
+    else
+        cout<<endl<<"Frame capture Error: could not write "<<CAPTURE_FILENAME;
+}
+
+/*!
+    \fn presentScaledFrame(const FrameState *state, std::chrono::steady_clock::time_point start)
+    \brief Scale the scene up to the window, draw the footer over it and measure the frame
+    state -> the state the frame was drawn from, holding the scaled size.
+    The frame time runs from start until GL has finished the frame, so it
+    covers the time spent on the CPU and in the GL implementation.
+*/
+void presentScaledFrame(const FrameState *state, std::chrono::steady_clock::time_point start){
+    dynamicResolution.present(state->windowWidth, state->windowHeight, window_width, window_height);
+    if(state->showWelcomeScreen == 1){ /*!< Footer marquee at full resolution */
+        fbClear(GL_DEPTH_BUFFER_BIT);
+        setProjection(window_width, window_height, 1);
+        fbLoadIdentity();
+        showFooter(state->pageAngle);
+    }
+    glFinish();
+    dynamicResolution.update(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+}
+
+/*!
+    \fn countFrameAllocations()
+    \brief Heap allocations made since the previous frame, by every thread
+    With --allocations the frames making any are printed per subsystem.
+    Recordings of sub-scenes are kept across frames, they are printed but
+    not counted.
+*/
+unsigned long countFrameAllocations(){
+    AllocationCounts since;
+    unsigned long total = allocationsSince(&frameAllocations, &since);
+    readAllocationCounts(&frameAllocations);
+    if(reportAllocations == 1 && total > 0){
+        printf("Frame %u: %lu heap allocations", inputJournal.step, total);
+        for(int i=0;i<ALLOCATION_TAGS;i++)
+            if(since.allocations[i] > 0)
+                printf(", %s %lu (%lu bytes)", allocationTagName(i), since.allocations[i], since.bytes[i]);
+        printf("\n");
+    }
+    return total - since.allocations[ALLOCATION_RECORDINGS];
+}
+
+/*!
+    \fn display()
+    \brief Render function used in Opengl
+    Draws the current frame and swaps the buffers.
+    Threaded rendering -> the frame prepared by the worker is submitted while
+        the worker records the next one from the current state.
+    When a capture is requested the frame is recorded into a command buffer,
+    replayed onto the screen and saved to CAPTURE_FILENAME.
+    Anti-aliasing -> the scene is filtered before it is scaled up.
+    Dynamic resolution -> the scene is drawn at the scaled size and then scaled up.
+    Page overview -> missing thumbnails are rendered first, on the GL thread.
+    Replaying input -> every frame is finished and profiled before the swap.
+    Data the frame kept in the frame arena is released once it is swapped.
+*/
+void display(){
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    FrameState state = currentFrameState();
+    GLuint stateHash = frameStateHash(&state);
+    if(dynamicResolution.enabled == 1){
+        dynamicResolution.resize(state.windowWidth, state.windowHeight);
+        state.windowWidth = dynamicResolution.width;
+        state.windowHeight = dynamicResolution.height;
+        state.showFooter = 0;
+    }
+    if(state.showOverview == 1){
+        GLint tag = setAllocationTag(ALLOCATION_PAGES);
+        overview.update(flipbook, state.overviewScroll, state.windowWidth, state.windowHeight);
+        setAllocationTag(tag);
+    }
+    const FrameState *drawn = &state; /*!< A threaded frame may come from an older state, drawn at its scaled size */
+    if(threadedRendering == 1){
+        GLint tag = setAllocationTag(ALLOCATION_COMMANDS);
+        CommandBuffer *frame = framePipeline.submit(&state);
+        drawn = (const FrameState*)framePipeline.submittedState();
+        frame->replay();
+        if(captureFrame == 1)
+            saveCapture(frame);
+        setAllocationTag(tag);
+    }
+    else if(captureFrame == 1){
+        frameCommands.clear();
+        frameRecorder.reset();
+        setGLBackend(BACKEND_RECORDING, &frameRecorder);
+        drawScene(&state);
+        setGLBackend(BACKEND_IMMEDIATE);
+        frameCommands.replay();
+        saveCapture(&frameCommands);
+    }
+    else
+        drawScene(&state);
+    if(dynamicResolution.enabled == 1)
+        presentScaledFrame(drawn, start);
+    unsigned long allocations = countFrameAllocations();
+    if(inputJournal.replaying == 1){
+        glFinish();
+        inputJournal.frameDrawn(stateHash, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(), allocations);
+    }
+    captureFrame = 0;
+    if(headless == 0)
+        glutSwapBuffers();
+    frameArena()->reset();
+    if(reloadedPage >= 0){
+        glFinish();
+        printf("Page %d reloaded, on screen %.2f ms after its source was saved\n", reloadedPage + 1,
+            std::chrono::duration<double, std::milli>(std::chrono::system_clock::now() - reloadedPageSaved).count());
+        fflush(stdout);
+        reloadedPage = -1;
+    }
+    if(firstFrameShown == 0){
+        firstFrameShown = 1;
+        printf("\nFirst frame shown %.2f ms after start\n",
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupTime).count());
+        fflush(stdout);
+    }
+}
+
+/*!
+    \fn setThreadedRendering(int enable)
+    \brief Start or stop preparing frames on the frame pipeline worker
+    The worker owns the scene recordings while it prepares a frame, so it is
+    drained before the GL thread draws the scene itself again. It is started
+    once and stays parked while frames are drawn on the GL thread.
+*/
+void setThreadedRendering(int enable){
+    if(enable == 1 && framePipeline.started() == 0)
+        framePipeline.start(prepareFrame, sizeof(FrameState));
+    else if(enable == 0 && threadedRendering == 1)
+        framePipeline.drain();
+    threadedRendering = enable;
+}
+
+/*!
+    \fn setDynamicResolution(int enable)
+    \brief Start or stop scaling the scene resolution to hold the frame budget
+    The frame pipeline is drained, so no frame prepared at the other size is
+    presented with the new setting.
+*/
+void setDynamicResolution(int enable){
+    if(threadedRendering == 1)
+        framePipeline.drain();
+    if(enable == 1)
+        dynamicResolution.enable(dynamicResolution.budget);
+    else
+        dynamicResolution.disable();
 }
 
 /*!
@@ -247,27 +626,288 @@ void display(){
     y -> y coordinate
 */
 void mykeyboard(unsigned char key, GLint x,GLint y){
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
-    if(key == 'n' || key == 'N')
+    inputJournal.add(INPUT_KEYBOARD, key, x, y);
+    fbClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+    if(searching == 1)
+        typeSearchQuery(key); /*!< The prompt takes every key until it is closed */
+    else if(showOverview == 1 && (key == 27 || key == 'o' || key == 'O'))
+        setOverview(0);
+    else if((key == 'o' || key == 'O') && showWelcomeScreen == 0 && showLibrary == 0)
+        setOverview(1); /*!< Thumbnails of every page */
+    else if(key == '/' && showWelcomeScreen == 0 && showLibrary == 0 && showOverview == 0){
+        searching = 1; /*!< Open the search prompt with the last query */
+        searchFailed = 0;
+    }
+    else if(key == 'n' || key == 'N')
         pageId = ( pageId + 1 ) % noOfPages; /*!< Goto next Page */
     else if(key == 'p' || key == 'P')
         pageId = ( pageId - 1 ) % noOfPages; /*!< Goto previous Page */
+    else if(key == 13 && showLibrary == 1 && pulledBook >= 0)
+        openPulledBook();
     else if(key == 13){ /*!< Transition from welcome page to main page */
+        finishLoadingAssets(); /*!< Waits only if the room is still loading */
         showWelcomeScreen = 0;
+        showLibrary = 0;
         startFlipping = 0;
         pageAngle = 0;
     }
+    else if(key == 'l' || key == 'L'){ /*!< Enter or leave the library */
+        finishLoadingAssets();
+        setOverview(0);
+        openBook(-1); /*!< Books of the library go back on their shelf */
+        showWelcomeScreen = 0;
+        showLibrary = !showLibrary;
+    }
     else if(key == 'W' || key == 'w'){
+        setOverview(0);
         showWelcomeScreen = 1;
+        showLibrary = 0;
         startFlipping = 1;
     }
     else if(key == 'q' || key == 'Q')
         exit(0);
+    else if(key == 'c' || key == 'C')
+        captureFrame = 1; /*!< Capture the next frame into a command buffer */
     else if(key == 61)
         speed += 1; /*!< Increase speed */
     else if(key == 45)
         speed -= 1; /*!< Decrease speed */
-    glutPostRedisplay();
+    postRedisplay();
+}
+
+/*!
+    \fn typeSearchQuery(unsigned char key)
+    \brief Edit the search query
+    Enter searches, Escape closes the prompt, Backspace removes the last character.
+*/
+void typeSearchQuery(unsigned char key){
+    GLint length = strlen(searchQuery);
+    if(key == 13)
+        searchBook();
+    else if(key == 27)
+        searching = 0;
+    else if((key == 8 || key == 127) && length > 0){
+        searchQuery[length - 1] = '\0';
+        searchFailed = 0;
+    }
+    else if(key >= 32 && key < 127 && length < SEARCH_QUERY_LENGTH - 1){
+        searchQuery[length] = key;
+        searchFailed = 0;
+    }
+}
+
+/*!
+    \fn searchBook()
+    \brief Flip to the next page holding every word of the query and highlight them
+    The search starts after the page shown, so searching again for the same
+    query moves on to the next page found. The frame pipeline is paused while
+    the highlights change, as the worker reads the pages.
+*/
+void searchBook(){
+    std::vector<SearchHit> hits;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    GLint found = flipbook->index.search(searchQuery, pageId + 1, 1, &hits);
+    double searchTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if(found == 0){
+        printf("Search \"%s\" found no page in %.3f ms\n", searchQuery, searchTime);
+        searchFailed = 1;
+        return;
+    }
+    printf("Search \"%s\" found page %d in %.3f ms\n", searchQuery, hits[0].pageIndex + 1, searchTime);
+    if(threadedRendering == 1)
+        framePipeline.drain(); /*!< The worker reads the highlights */
+    flipbook->highlight(hits[0].pageIndex, &hits[0].spans);
+    showPage(hits[0].pageIndex);
+    searching = 0;
+}
+
+/*!
+    \fn showPage(GLint pageIndex)
+    \brief Open the book at a page and stay on it
+    Jumps over RIFFLE_MIN_PAGES pages or more are riffled, from wherever a
+    riffle still running has got to.
+*/
+void showPage(GLint pageIndex){
+    GLint from = riffle.running() ? riffle.shownPage(riffle.fromPage, riffle.toPage, riffle.time) : pageId;
+    if(abs(pageIndex - from) >= RIFFLE_MIN_PAGES)
+        riffle.start(from, pageIndex);
+    pageId = pageIndex;
+    pageAngle = 0;
+    pauseFlipping = 1;
+}
+
+/*!
+    \fn setOverview(int show)
+    \brief Open or close the thumbnail overview of the pages
+    The overview opens at the row of the page shown. Thumbnails are rendered
+    on the GL thread, so the frame pipeline is drained while it is open and
+    used again when it closes.
+*/
+void setOverview(int show){
+    if(show == 1 && showOverview == 0){
+        overviewThreaded = threadedRendering;
+        setThreadedRendering(0);
+        overview.scrollTo(pageId, flipbook->noOfPages, window_width, window_height);
+    }
+    else if(show == 0 && showOverview == 1)
+        setThreadedRendering(overviewThreaded);
+    showOverview = show;
+}
+
+/*!
+    \fn scrollOverview(GLfloat rows)
+    \brief Scroll the overview by rows, negative rows scroll up
+*/
+void scrollOverview(GLfloat rows){
+    overview.scrollBy(rows, flipbook->noOfPages, window_width, window_height);
+}
+
+/*!
+    \fn mySpecialKeys(int key, int x, int y)
+    \brief Arrow keys walk through the library
+    Up and down walk along the viewing direction, left and right turn.
+    In the room page up and page down riffle RIFFLE_JUMP_PAGES pages.
+    In the page overview up and down scroll a row, page up and page down a
+    window, home and end go to the first and the last page.
+*/
+void mySpecialKeys(int key, int x, int y){
+    inputJournal.add(INPUT_SPECIAL, key, x, y);
+    if(showOverview == 1){
+        GLfloat rows = window_height / overview.rowHeight(window_width);
+        if(key == GLUT_KEY_UP || key == GLUT_KEY_DOWN)
+            scrollOverview(key == GLUT_KEY_UP ? -1 : 1);
+        else if(key == GLUT_KEY_PAGE_UP || key == GLUT_KEY_PAGE_DOWN)
+            scrollOverview(key == GLUT_KEY_PAGE_UP ? -rows : rows);
+        else if(key == GLUT_KEY_HOME || key == GLUT_KEY_END)
+            scrollOverview(key == GLUT_KEY_HOME ? -overview.targetScroll : overview.maxScroll(flipbook->noOfPages, window_width, window_height));
+        postRedisplay();
+        return;
+    }
+    if(showWelcomeScreen == 0 && showLibrary == 0 && (key == GLUT_KEY_PAGE_UP || key == GLUT_KEY_PAGE_DOWN)){
+        GLint target = pageId + (key == GLUT_KEY_PAGE_UP ? -RIFFLE_JUMP_PAGES : RIFFLE_JUMP_PAGES);
+        showPage(std::max(0, std::min(noOfPages - 1, target)));
+        postRedisplay();
+        return;
+    }
+    if(showLibrary == 0)
+        return;
+    GLfloat forward[3], right[3];
+    cameraAxes(libraryYaw, forward, right);
+    if(key == GLUT_KEY_UP || key == GLUT_KEY_DOWN){
+        GLfloat step = key == GLUT_KEY_UP ? LIBRARY_WALK_STEP : -LIBRARY_WALK_STEP;
+        GLfloat wall = LIBRARY_HALL_WIDTH/2 - LIBRARY_WALK_STEP;
+        libraryEye[0] = fminf(wall, fmaxf(-wall, libraryEye[0] + step*forward[0]));
+        libraryEye[2] = fminf(LIBRARY_CASE_WIDTH, fmaxf(-library.length, libraryEye[2] + step*forward[2]));
+    }
+    else if(key == GLUT_KEY_LEFT)
+        libraryYaw += 5;
+    else if(key == GLUT_KEY_RIGHT)
+        libraryYaw -= 5;
+    postRedisplay();
+}
+
+/*!
+    \fn myMouseClick(int button, int buttonState, int x, int y)
+    \brief Left click in the library pulls a book out of its shelf
+    Clicking the book already pulled out opens it.
+    In the page overview the wheel scrolls and a left click opens the page clicked.
+*/
+void myMouseClick(int button, int buttonState, int x, int y){
+    inputJournal.add(INPUT_CLICK, button, buttonState, x, y);
+    if(showOverview == 1 && buttonState == GLUT_DOWN){
+        GLint picked = overview.pick(flipbook->noOfPages, overview.scroll, x, y, window_width, window_height);
+        if(button == 3 || button == 4) /*!< Mouse wheel */
+            scrollOverview(button == 3 ? -1 : 1);
+        else if(button == GLUT_LEFT_BUTTON && picked >= 0){
+            setOverview(0);
+            showPage(picked);
+        }
+        postRedisplay();
+        return;
+    }
+    if(showLibrary == 0 || button != GLUT_LEFT_BUTTON || buttonState != GLUT_DOWN)
+        return;
+    GLint picked = library.pick(libraryEye, libraryYaw, window_width/window_height,
+        2*x/window_width - 1, 1 - 2*y/window_height, pulledBook);
+    if(picked >= 0 && picked == pulledBook)
+        openPulledBook();
+    else
+        pulledBook = picked;
+    postRedisplay();
+}
+
+/*!
+    \fn shelfBook(GLint index)
+    \brief Book of the library at index, written the first time it is opened
+    Its length and words are drawn from its index, so a book reads the same
+    every time it is pulled out. It is kept like the story, a frame being
+    prepared may still draw it.
+*/
+Book *shelfBook(GLint index){
+    static const char *words[] = {"ink", "quill", "dust", "tale", "map", "rain", "salt", "moth",
+        "wick", "fern", "gold", "owl", "sea", "key", "lamp", "rust"};
+    const GLint noOfWords = sizeof(words) / sizeof(words[0]);
+    if(shelfBooks[index] != NULL)
+        return shelfBooks[index];
+    GLuint seed = index*2654435761u + 1;
+    seed = seed*1664525 + 1013904223;
+    GLint pages = LIBRARY_BOOK_MIN_PAGES + (seed >> 8) % (LIBRARY_BOOK_MAX_PAGES - LIBRARY_BOOK_MIN_PAGES + 1);
+    Book *book = new Book();
+    book->pixelError = pagePixelError;
+    char text[64];
+    for(int i=0;i<pages;i++){
+        seed = seed*1664525 + 1013904223;
+        if(i == 0)
+            snprintf(text, sizeof(text), "\n\n Volume\n   %d", index + 1);
+        else if(i == pages - 1)
+            snprintf(text, sizeof(text), "\n\n  The End");
+        else
+            snprintf(text, sizeof(text), "\n %s %s\n  %s\n\n   %d", words[(seed >> 8) % noOfWords],
+                words[(seed >> 14) % noOfWords], words[(seed >> 20) % noOfWords], i + 1);
+        book->addPage(PAGE_TYPE_TEXT, strdup(text)); /*!< Pages keep their text */
+    }
+    shelfBooks[index] = book;
+    return book;
+}
+
+/*!
+    \fn openedBook(GLint shelf)
+    \brief Book open in the room, the book of the library at index shelf or the story for -1
+*/
+Book *openedBook(GLint shelf){
+    return shelf < 0 ? storyBook : shelfBooks[shelf];
+}
+
+/*!
+    \fn openBook(GLint shelf)
+    \brief Open the book of the library at index shelf in the room, or the story for -1, at its first page
+*/
+void openBook(GLint shelf){
+    if(shelf == openedShelfBook)
+        return;
+    if(threadedRendering == 1)
+        framePipeline.drain(); /*!< The worker reads the cloth pages and the shelf books */
+    flipbook = shelf < 0 ? storyBook : shelfBook(shelf);
+    openedShelfBook = shelf;
+    noOfPages = flipbook->noOfPages;
+    pageId = 0;
+    pageAngle = 0;
+    riffle.time = -1;
+    clothFlip.clear();
+    overview.clear();
+}
+
+/*!
+    \fn openPulledBook()
+    \brief Leave the library and flip through the book pulled out of its shelf
+*/
+void openPulledBook(){
+    openBook(pulledBook);
+    showLibrary = 0;
+    startFlipping = 1;
+    pauseFlipping = 0;
+    pageId = 0;
+    pageAngle = 0;
 }
 
 /*!
@@ -275,6 +915,7 @@ void mykeyboard(unsigned char key, GLint x,GLint y){
     \brief Mouse interaction for movement of Book
 */
 void myMouseMovement(int x, int y){
+    inputJournal.add(INPUT_MOTION, x, y);
     if(allowBookMovement == 1){
         float centerX = (float)WINDOW_WIDTH / 2.0;
         float centerY = (float)WINDOW_HEIGHT / 2.0;
@@ -292,7 +933,8 @@ void myMouseMovement(int x, int y){
     int id -> id of the clicked menu item from the user.
 */
 void mymenu(int id /*!< Menu id picked by the user */){
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+    inputJournal.add(INPUT_MENU, id);
+    fbClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
     switch(id){
         case 1:
             pageId = ( pageId + 1 ) % noOfPages;break; /*!< Goto next page */
@@ -306,6 +948,8 @@ void mymenu(int id /*!< Menu id picked by the user */){
             flipId = 2;break; /*!< Notepad Flip*/
         case 6:
             flipId = 3;break; /*!< Special Page Flip */
+        case 21:
+            flipId = 4;break; /*!< Cloth Flip */
         case 7:
             viewId = 0;break; /*!< Normal View */
         case 8:
@@ -332,23 +976,301 @@ void mymenu(int id /*!< Menu id picked by the user */){
         case 15:
             viewId = 5;break; /*!< 360 deg Horizontal and Vertical View */
         case 16:
-            allowBookMovement = !allowBookMovement;
+            allowBookMovement = !allowBookMovement;break;
+        case 17:
+            if(showOverview == 1)
+                overviewThreaded = !overviewThreaded; /*!< Applied when the overview closes */
+            else
+                setThreadedRendering(!threadedRendering); /*!< Prepare frames on a worker thread */
+            break;
+        case 19:
+            setDynamicResolution(!dynamicResolution.enabled);break; /*!< Hold the frame budget */
+        case 18:{
+            finishLoadingAssets();
+            setOverview(0);
+            openBook(-1); /*!< Books of the library go back on their shelf */
+            showWelcomeScreen = 0;
+            showLibrary = !showLibrary;break; /*!< Library of closed books */
+        }
+        case 20:
+            if(showWelcomeScreen == 0 && showLibrary == 0)
+                setOverview(!showOverview); /*!< Thumbnails of every page */
+            break;
     }
-    glutPostRedisplay();
+    postRedisplay();
+}
+
+/*!
+    \fn dispatchInput(const InputEvent *event)
+    \brief Feed a recorded event to the callback it was recorded from
+*/
+void dispatchInput(const InputEvent *event){
+    const GLint *values = event->values;
+    switch(event->type){
+        case INPUT_KEYBOARD:
+            mykeyboard(values[0], values[1], values[2]);break;
+        case INPUT_SPECIAL:
+            mySpecialKeys(values[0], values[1], values[2]);break;
+        case INPUT_CLICK:
+            myMouseClick(values[0], values[1], values[2], values[3]);break;
+        case INPUT_MOTION:
+            myMouseMovement(values[0], values[1]);break;
+        case INPUT_MENU:
+            mymenu(values[0]);break;
+        case INPUT_RESHAPE:{
+            if(headless == 0)
+                glutReshapeWindow(values[0], values[1]);
+            initReshape(values[0], values[1]);break;
+        }
+    }
+}
+
+/*!
+    \fn replayInput()
+    \brief Idle callback of a replay, feeds the events due and takes one step
+    Exits once the whole journal is replayed.
+*/
+void replayInput(){
+    InputEvent event;
+    while(inputJournal.pending(&event))
+        dispatchInput(&event);
+    if(inputJournal.finished())
+        exit(0);
+    idleStateExecute();
+}
+
+/*!
+    \fn stopInputJournal()
+    \brief End the recording, or check the replay against it, on exit
+*/
+void stopInputJournal(){
+    FrameState state = currentFrameState();
+    inputJournal.close(frameStateHash(&state));
 }
 
 /*!
     \fn convertPicstoTextures()
     \brief Load individual images as textures for texture mapping
+    Only the welcome screen texture is loaded before the first frame, the room
+    textures and the book are loaded on a background thread meanwhile, the
+    room textures being streamed through the upload ring.
 */
 void convertPicstoTextures(){
-    wallTexture = loadTextures(wallImageFilename);
-    picTexture = loadTextures(picImageFilename);
-    welcomeTexture = loadTextures(welcomeImageFilename);
-    tableTexture = loadTextures(tableImageFilename);
-    floorTexture = loadTextures(floorImageFilename);
-    pic2Texture = loadTextures(pic2ImageFilename);
-    wall2Texture = loadTextures(wall2ImageFilename);
+    char *filenames[] = {welcomeImageFilename};
+    GLuint *textures[] = {&welcomeTexture};
+    loadTexturesParallel(filenames, textures, 1);
+    uploadRing.create(UPLOAD_RING_SIZE, UPLOAD_BYTES_PER_FRAME);
+    assetLoader = std::thread(loadAssets, textureCompressionSupported(), maxTextureSize());
+    atexit(stopLoadingAssets);
+}
+
+/*!
+    \fn loadAssets(GLint compress, GLint maxSize)
+    \brief Decode the room textures, load its lightmap, create the Flipbook and fill the library, runs on the loader thread
+    The room textures share one atlas unless TEXTURE_ATLAS is 0, they are written
+    into the upload ring as soon as decoded. The lightmap is baked only when its cache is stale.
+*/
+void loadAssets(GLint compress, GLint maxSize){
+    setAllocationTag(ALLOCATION_ASSETS);
+    if(TEXTURE_ATLAS){
+        prepareTextureAtlas(roomImageFilenames, 6, compress, maxSize, &roomAtlas);
+        streamTexture(&uploadRing, &roomAtlas, &roomStreams[0]);
+    }
+    else{
+        decodeTextures(roomImageFilenames, roomImages, 6, compress);
+        for(int i=0;i<6;i++)
+            streamTexture(&uploadRing, &roomImages[i], &roomStreams[i]);
+    }
+    std::chrono::steady_clock::time_point bakeStart = std::chrono::steady_clock::now();
+    loadLightmap(lightmapFilename, roomSurfaces, noOfRoomSurfaces, &roomLightmap);
+    if(roomLightmap.threads > 0)
+        printf("Room lightmap baked in %.2f ms on %d threads\n",
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - bakeStart).count(), roomLightmap.threads);
+    createFlipbook();
+    if(pageSourceDirectory != NULL)
+        loadPageSources();
+    loadVectorPages();
+    loadAnimations();
+    library.build(LIBRARY_BOOKS);
+    shelfBooks.assign(library.books.size(), NULL);
+    assetsDecoded = 1;
+}
+
+/*!
+    \fn loadPageSources()
+    \brief Replace the pages by their sources in pageSourceDirectory and start watching it
+    Runs on the loader thread, right after the Flipbook is created.
+*/
+void loadPageSources(){
+    std::vector<PageSource> sources;
+    if(!pageWatcher.watch(pageSourceDirectory))
+        printf("Page sources in %s are read once, the directory cannot be watched\n", pageSourceDirectory);
+    pageWatcher.scan(&sources);
+    GLint loaded = 0;
+    for(size_t i=0;i<sources.size();i++)
+        loaded += setPageSource(&sources[i]);
+    printf("%d page sources read from %s\n", loaded, pageSourceDirectory);
+}
+
+/*!
+    \fn loadAnimations()
+    \brief Turn the pages asked for with --animate-page into animated pages
+    Runs on the loader thread, the sprite sheets are decoded here and the
+    frames once the room is loaded.
+*/
+void loadAnimations(){
+    for(size_t i=0;i<animationSources.size();i++){
+        const AnimationSource *source = &animationSources[i];
+        if(source->pageIndex < 0 || source->pageIndex >= flipbook->noOfPages){
+            printf("The book has no page %d to animate\n", source->pageIndex + 1);
+            continue;
+        }
+        Animation *animation = animationPlayer.add(source->path, source->columns, source->rows);
+        if(animation == NULL)
+            printf("Animation %s cannot be read\n", source->path);
+        else{
+            flipbook->setPageAnimation(source->pageIndex, &animation->page);
+            printf("Page %d plays %d frames of %s\n", source->pageIndex + 1, animation->noOfFrames, source->path);
+        }
+    }
+}
+
+/*!
+    \fn stopAnimations()
+    \brief Stop decoding frames on exit and report how smoothly the animated pages played
+*/
+void stopAnimations(){
+    animationPlayer.stop();
+    if(!animationPlayer.animations.empty())
+        animationPlayer.report();
+}
+
+/*!
+    \fn setPageSource(const PageSource *source)
+    \brief Replace a page by its source, text or vector drawing, returns 0 when it was not replaced
+    A vector drawing is tessellated here, once for as long as its source is unchanged.
+*/
+GLint setPageSource(const PageSource *source){
+    if(source->vector == 0)
+        return storyBook->setPageText(source->pageIndex, source->text.c_str());
+    VectorDrawing *drawing = new VectorDrawing();
+    if(!drawing->parse(source->text.c_str()) || !storyBook->setPageVector(source->pageIndex, drawing)){
+        printf("Page %d has no vector drawing to show\n", source->pageIndex + 1);
+        delete drawing;
+        return 0;
+    }
+    printf("Page %d draws %d shapes as %d triangles, tessellated in %.2f ms", source->pageIndex + 1,
+        drawing->noOfShapes, drawing->noOfTriangles(), drawing->tessellationTime);
+    if(drawing->skipped > 0)
+        printf(", %d elements or path commands left out", drawing->skipped);
+    printf("\n");
+    return 1;
+}
+
+/*!
+    \fn loadVectorPages()
+    \brief Turn the pages asked for with --vector-page into vector drawing pages
+    Runs on the loader thread, right after the Flipbook is created.
+*/
+void loadVectorPages(){
+    for(size_t i=0;i<vectorPageSources.size();i++){
+        PageSource source;
+        source.pageIndex = vectorPageSources[i].pageIndex;
+        source.vector = 1;
+        if(!readPageSource(vectorPageSources[i].path, &source))
+            printf("Vector drawing %s cannot be read\n", vectorPageSources[i].path);
+        else
+            setPageSource(&source);
+    }
+}
+
+/*!
+    \fn reloadPages()
+    \brief Replace the pages whose sources were saved since the last call
+    Only the recordings of the pages edited are recorded again. The frame
+    pipeline is drained first, as the worker reads the pages.
+*/
+void reloadPages(){
+    std::vector<PageSource> sources;
+    if(assetsLoaded == 0 || pageWatcher.poll(&sources) == 0)
+        return;
+    if(threadedRendering == 1)
+        framePipeline.drain();
+    for(size_t i=0;i<sources.size();i++){
+        if(!setPageSource(&sources[i]))
+            continue;
+        reloadedPage = sources[i].pageIndex;
+        reloadedPageSaved = sources[i].saved;
+    }
+}
+
+/*!
+    \fn joinAssetLoader()
+    \brief Wait for the loader thread, uploading what it streams meanwhile as it may wait for the ring
+*/
+void joinAssetLoader(){
+    while(assetsDecoded == 0){
+        uploadRing.pump(UPLOAD_RING_SIZE);
+        uploadRing.waitForWrite(1);
+    }
+    assetLoader.join();
+}
+
+/*!
+    \fn stopLoadingAssets()
+    \brief Wait for the loader thread on exit, before the globals it fills are destroyed
+*/
+void stopLoadingAssets(){
+    if(assetLoader.joinable() && assetLoader.get_id() != std::this_thread::get_id())
+        joinAssetLoader();
+    else if(assetLoader.joinable())
+        assetLoader.detach(); /*!< exit called by the loader itself */
+}
+
+/*!
+    \fn finishLoadingAssets()
+    \brief Register the room textures and bake their light into them once the loader thread is done
+    Waits for the loader if it is still running, and for the room textures
+    left in the upload ring. The frame pipeline is drained first, as the
+    texture regions must not change while a frame is prepared.
+*/
+void finishLoadingAssets(){
+    if(assetsLoaded == 1)
+        return;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    GLint waited = assetsDecoded == 0 || uploadRing.idle() == 0;
+    joinAssetLoader();
+    uploadRing.flush();
+    double waitTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if(threadedRendering == 1)
+        framePipeline.drain();
+    if(TEXTURE_ATLAS)
+        registerTextureAtlas(&roomAtlas, roomStreams[0].texture, roomImageFilenames, roomTextures, 6);
+    else{
+        for(int i=0;i<6;i++){
+            *roomTextures[i] = roomStreams[i].texture;
+            cout<<endl<<roomImageFilenames[i]<<" -> Loaded Successfully";
+        }
+        cout<<endl;
+    }
+    uploadRing.report("Room textures");
+    litRoomTexture = composeLitRoom(roomSurfaces, noOfRoomSurfaces, &roomLightmap, litRoomTiles);
+    assetsLoaded = 1;
+    animationPlayer.start(&uploadRing, inputJournal.step);
+    atexit(stopAnimations);
+    /*! Count the texture binds of the room */
+    GLRecorder recorder;
+    recorder.captureVertices = 0;
+    setGLBackend(BACKEND_RECORDING, &recorder);
+    drawRoom();
+    setGLBackend(BACKEND_IMMEDIATE);
+    printf("Room draws with %u texture binds per frame\n", recorder.calls[CALL_BIND_TEXTURE]);
+    printf("Room and book ready %.2f ms after start",
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupTime).count());
+    if(waited)
+        printf(", entering the room waited %.2f ms for them", waitTime);
+    printf("\n");
+    fflush(stdout);
 }
 
 /*!
@@ -371,6 +1293,7 @@ void addMenuInteraction(){
     glutAddMenuEntry("Writing Pad Flip", 4);
     glutAddMenuEntry("Notebook Flip", 5);
     glutAddMenuEntry("Special Flip", 6);
+    glutAddMenuEntry("Cloth Flip", 21);
     /*!< Create menu and add entries for mouse interaction */
     mainMenu=glutCreateMenu(mymenu);
     glutAddMenuEntry("Toggle Flipping", 11);
@@ -381,6 +1304,10 @@ void addMenuInteraction(){
     glutAddMenuEntry("Speed Up", 12);
     glutAddMenuEntry("Speed Down", 13);
     glutAddMenuEntry("Toggle Book Movement",16);
+    glutAddMenuEntry("Toggle Threaded Rendering",17);
+    glutAddMenuEntry("Toggle Library View",18);
+    glutAddMenuEntry("Toggle Dynamic Resolution",19);
+    glutAddMenuEntry("Toggle Page Overview",20);
     glutAttachMenu(GLUT_RIGHT_BUTTON);
 }
 /*!
@@ -389,28 +1316,115 @@ void addMenuInteraction(){
     Input interactions used -> mouse, keyboard.
     Add menu entries for mouse interaction.
     Enable lighting and shading.
+    Replaying input -> live input is ignored, the journal drives the idle steps,
+        headless replays draw into an offscreen framebuffer without a window.
 */
 int main(int argc, char **argv){
-    glutInit(&argc,argv);
-    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
-    glutInitWindowPosition(50,50);
-    glutInitWindowSize(WINDOW_WIDTH,WINDOW_HEIGHT);
-    glutCreateWindow("FlipBook");
-    glutReshapeFunc(initReshape);
-    glutDisplayFunc(display);
-    /*! Load images into textures */
+    startupTime = std::chrono::steady_clock::now();
+    const char *recordFilename = NULL, *replayFilename = NULL;
+    frameRecorder.captureVertices = 0;
+    frameRecorder.commands = &frameCommands;
+    for(int i=1;i<argc;i++){
+        if(strcmp(argv[i], "--threaded") == 0)
+            setThreadedRendering(1);
+        else if(strcmp(argv[i], "--pixel-error") == 0 && i + 1 < argc)
+            pagePixelError = atof(argv[++i]); /*!< Read before the loader thread creates the Flipbook */
+        else if(strcmp(argv[i], "--pages") == 0 && i + 1 < argc)
+            noOfPages = std::max(noOfPages, atoi(argv[++i])); /*!< Never fewer than the story has */
+        else if(strcmp(argv[i], "--watch-pages") == 0) /*!< Optionally followed by the directory */
+            pageSourceDirectory = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : PAGE_SOURCE_DIRECTORY;
+        else if(strcmp(argv[i], "--frame-budget") == 0 && i + 1 < argc){
+            dynamicResolution.budget = atof(argv[++i]);
+            setDynamicResolution(1);
+        }
+        else if(strcmp(argv[i], "--msaa") == 0 && i + 1 < argc)
+            multisamples = atoi(argv[++i]);
+        else if(strcmp(argv[i], "--record-input") == 0) /*!< Optionally followed by the journal */
+            recordFilename = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : INPUT_JOURNAL_FILENAME;
+        else if(strcmp(argv[i], "--replay-input") == 0)
+            replayFilename = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i] : INPUT_JOURNAL_FILENAME;
+        else if(strcmp(argv[i], "--headless") == 0)
+            headless = 1;
+        else if(strcmp(argv[i], "--allocations") == 0)
+            reportAllocations = 1;
+        else if(strcmp(argv[i], "--vector-page") == 0 && i + 2 < argc){
+            VectorPageSource source = {atoi(argv[i + 1]) - 1, argv[i + 2]};
+            vectorPageSources.push_back(source);
+            i += 2;
+        }
+        else if(strcmp(argv[i], "--animate-page") == 0 && i + 2 < argc){ /*!< Optionally followed by columns x rows */
+            AnimationSource source = {atoi(argv[i + 1]) - 1, argv[i + 2], 0, 0};
+            i += 2;
+            if(i + 1 < argc && sscanf(argv[i + 1], "%dx%d", &source.columns, &source.rows) == 2)
+                i++;
+            animationSources.push_back(source);
+        }
+    }
+    if(replayFilename != NULL && !inputJournal.load(replayFilename)){
+        printf("Input journal %s cannot be read\n", replayFilename);
+        return -1;
+    }
+    if(headless == 1){
+        GLint width, height;
+        inputJournal.windowSize(&width, &height);
+        if(inputJournal.replaying == 0 || !createOffscreenContext(width, height)){
+            printf("--headless needs --replay-input and an offscreen EGL context\n");
+            return -1;
+        }
+        if(multisamples > 0)
+            printf("--msaa needs a window, make antialias compares it offscreen\n");
+        initReshape(width, height);
+    }
+    else{
+        glutInit(&argc,argv);
+        if(multisamples > 0){ /*!< Every edge sampled several times, resolved when the buffers are swapped */
+            char displayString[64];
+            snprintf(displayString, sizeof(displayString), "rgb double depth samples=%d", multisamples);
+            glutInitDisplayString(displayString);
+        }
+        else
+            glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
+        glutInitWindowPosition(50,50);
+        glutInitWindowSize(WINDOW_WIDTH,WINDOW_HEIGHT);
+        glutCreateWindow("FlipBook");
+        if(multisamples > 0){
+            GLint samples = 0;
+            glGetIntegerv(GL_SAMPLES, &samples);
+            printf("Window drawn with %d samples per pixel\n", samples);
+        }
+        glutReshapeFunc(initReshape);
+        glutDisplayFunc(display);
+    }
+    if(recordFilename != NULL && inputJournal.replaying == 0 && !inputJournal.record(recordFilename))
+        printf("Input journal %s cannot be written\n", recordFilename);
+    if(inputJournal.recording == 1 || inputJournal.replaying == 1)
+        atexit(stopInputJournal);
+    framePipeline.lockstep = inputJournal.replaying; /*!< Replays never submit a frame twice */
+    /*! Load images into textures, the room and book keep loading in the background */
     convertPicstoTextures();
-    /*!< Create menu and add entries for mouse interaction */
-    addMenuInteraction();
     /*!< Lighting, shading, keyboard, mouse, idle interactions enabled */
     glShadeModel(GL_SMOOTH);
-    glEnable(GL_DEPTH_TEST);
-    glEnable(GL_NORMALIZE);
-    glEnable(GL_COLOR_MATERIAL);
-    glutKeyboardFunc(mykeyboard);
-    glutIdleFunc(idleStateExecute);
-    glutPassiveMotionFunc(myMouseMovement);
-    glutSetCursor(GLUT_CURSOR_FULL_CROSSHAIR);
-    glEnable(GL_DEPTH_TEST);
+    fbEnable(GL_DEPTH_TEST);
+    fbEnable(GL_NORMALIZE);
+    fbEnable(GL_COLOR_MATERIAL);
+    if(headless == 1){
+        while(true){
+            replayInput();
+            display();
+        }
+    }
+    if(inputJournal.replaying == 1)
+        glutIdleFunc(replayInput);
+    else{
+        /*!< Create menu and add entries for mouse interaction */
+        addMenuInteraction();
+        glutKeyboardFunc(mykeyboard);
+        glutIdleFunc(idleStateExecute);
+        glutPassiveMotionFunc(myMouseMovement);
+        glutSpecialFunc(mySpecialKeys);
+        glutMouseFunc(myMouseClick);
+        glutSetCursor(GLUT_CURSOR_FULL_CROSSHAIR);
+    }
+    fbEnable(GL_DEPTH_TEST);
     glutMainLoop();
 }
@@ -10,11 +10,64 @@
 
 #ifndef _MAIN_H_
 #define _MAIN_H_
+#include "./components/headers/Animation.h"
+#include "./components/headers/Atlas.h"
 #include "./components/headers/Drawings.h"
+#include "./components/headers/Lightmap.h"
 #include "./components/headers/Room.h"
 #include "./components/headers/Textures.h"
 #include "./components/headers/Welcome.h"
+#include "./lib/headers/Allocations.h"
 #include "./lib/headers/Book.h"
+#include "./lib/headers/CommandBuffer.h"
+#include "./lib/headers/DynamicResolution.h"
+#include "./lib/headers/FrameArena.h"
+#include "./lib/headers/FramePipeline.h"
+#include "./lib/headers/InputJournal.h"
+#include "./lib/headers/Library.h"
+#include "./lib/headers/Offscreen.h"
+#include "./lib/headers/Overview.h"
+#include "./lib/headers/PageWatcher.h"
+#include "./lib/headers/Riffle.h"
+#include "./lib/headers/ClothFlip.h"
+#include "./lib/headers/UploadRing.h"
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <thread>
+
+/*!
+    \struct FrameState
+    \brief Everything a frame is drawn from
+*/
+struct FrameState{
+    GLfloat pageAngle, viewAngle;
+    GLfloat translateBookbyX, translateBookbyY;
+    GLint windowWidth, windowHeight;
+    GLint pageId, flipId, viewId;
+    GLint showWelcomeScreen, startFlipping;
+    GLint showLibrary, pulledBook;
+    GLint openedShelfBook; /*!< Book of the library open in the room, -1 for the story */
+    GLfloat libraryEye[3], libraryYaw;
+    GLint showFooter; /*!< 0 when the footer is drawn after scaling the scene up */
+    GLint showOverview;
+    GLfloat overviewScroll; /*!< Rows of the overview scrolled past */
+    GLint riffleFrom, riffleTo;
+    GLfloat riffleTime; /*!< -1 while no riffle runs */
+    ClothFrame cloth; /*!< Pages bent by the cloth flip */
+    GLint searching, searchFailed; /*!< Search prompt open, last search found nothing */
+    char searchQuery[SEARCH_QUERY_LENGTH];
+    GLint animationFrame; /*!< Frame due on the animated pages */
+};
+
+/*!
+    \struct VectorPageSource
+    \brief Vector drawing page asked for on the command line
+*/
+struct VectorPageSource{
+    GLint pageIndex;
+    const char *path;
+};
 
 extern GLuint wallTexture;
 extern GLuint ceilingTexture;
@@ -31,7 +84,43 @@ int showWelcomeScreen = 1;
 int startFlipping = 1;
 int pauseFlipping = 0;
 int noOfPages = 25;
+GLfloat pagePixelError = PAGE_DETAIL_PIXEL_ERROR; /*!< Set with --pixel-error, 0 draws every page in full */
 int allowBookMovement = 0;
+int captureFrame = 0;
+Book *flipbook; /*!< Book open in the room, storyBook or a book of the library */
+Book *storyBook; /*!< Book of the story, open unless a book of the library is */
+std::vector<Book*> shelfBooks; /*!< Books of the library opened so far by their index, NULL until opened */
+int openedShelfBook = -1; /*!< Book of the library open in the room, -1 for the story */
+RecordedScene roomScene;
+CommandBuffer frameCommands;
+GLRecorder frameRecorder;
+int threadedRendering = 0;
+Library library; /*!< Closed books of the library view */
+int showLibrary = 0;
+int pulledBook = -1; /*!< Book pulled out of its shelf in the library, -1 for none */
+GLfloat libraryEye[3] = {0, LIBRARY_EYE_HEIGHT, 800};
+GLfloat libraryYaw = 0;
+FramePipeline framePipeline;
+DynamicResolution dynamicResolution; /*!< Enabled with --frame-budget or the menu */
+int multisamples = 0; /*!< Samples per pixel of the window asked for with --msaa, 0 for one */
+PageWatcher pageWatcher; /*!< Page sources reloaded while the window runs, see --watch-pages */
+const char *pageSourceDirectory = NULL; /*!< Directory of the page sources, NULL when not watched */
+int reloadedPage = -1; /*!< Page reloaded since the last frame shown, -1 for none */
+std::chrono::system_clock::time_point reloadedPageSaved; /*!< When the source of reloadedPage was saved */
+InputJournal inputJournal; /*!< Input recorded with --record-input or replayed with --replay-input */
+int headless = 0; /*!< 1 replays into an offscreen framebuffer, without a window */
+AllocationCounts frameAllocations; /*!< Heap allocations counted when the last frame was shown */
+int reportAllocations = 0; /*!< 1 prints every frame making heap allocations, see --allocations */
+int searching = 0, searchFailed = 0; /*!< Search prompt opened with / */
+char searchQuery[SEARCH_QUERY_LENGTH]; /*!< Typed into the search prompt, kept for searching again */
+Overview overview; /*!< Thumbnails of every page, opened with o */
+int showOverview = 0;
+int overviewThreaded = 0; /*!< Threaded rendering to restore when the overview is closed */
+Riffle riffle; /*!< Jump over many pages being animated */
+ClothFlip clothFlip; /*!< Pages in flight of the cloth flip */
+char firstPageText[]="\n The \n   TETRIS  \n Game";
+char lastPageText[]="\n\n  Game Over!";
+char fillerPageText[]="\n\n   Level\n  skipped";
 GLfloat translateBookbyY=0, translateBookbyX=0;
 char wallImageFilename[]="../img/wall.bmp";
 char welcomeImageFilename[]="../img/welcome.jpg";
@@ -40,13 +129,70 @@ char tableImageFilename[]="../img/table.jpg";
 char floorImageFilename[]="../img/floor.bmp";
 char pic2ImageFilename[]="../img/pic2.bmp";
 char wall2ImageFilename[]="../img/wall2.png";
+char lightmapFilename[]="../img/room.fblm"; /*!< Cache of the light baked over the room */
+char *roomImageFilenames[]={wallImageFilename, picImageFilename, tableImageFilename,
+    floorImageFilename, pic2ImageFilename, wall2ImageFilename};
+GLuint *roomTextures[]={&wallTexture, &picTexture, &tableTexture, &floorTexture, &pic2Texture, &wall2Texture};
+TextureImage roomAtlas, roomImages[6]; /*!< Room textures decoded in the background */
+UploadRing uploadRing; /*!< Textures decoded in the background are streamed through it */
+StreamedTexture roomStreams[6]; /*!< Room textures created from the ring, the atlas is the first */
+std::vector<VectorPageSource> vectorPageSources; /*!< Vector drawing pages asked for with --vector-page */
+std::vector<AnimationSource> animationSources; /*!< Animated pages asked for with --animate-page */
+AnimationPlayer animationPlayer; /*!< Plays the animated pages once the room is loaded */
+Lightmap roomLightmap; /*!< Baked or read from its cache in the background */
+std::chrono::steady_clock::time_point startupTime;
+std::thread assetLoader;
+std::atomic<int> assetsDecoded(0); /*!< Set by the loader once room and book are ready to upload */
+int assetsLoaded = 0, firstFrameShown = 0;
 void setHexColor(int);
-void selectFlippingPageType();
-void selectViewingAngle();
+void selectFlippingPageType(const FrameState*, GLfloat[16]);
+void selectViewingAngle(const FrameState*, GLfloat[16]);
+void bookPlacement(const FrameState*, GLfloat[16]);
+void updateAnimationLimits();
 void flipPage();
+void flipClothPages();
+FrameState currentFrameState();
+GLuint frameStateHash(const FrameState*);
+void postRedisplay();
+void setProjection(int, int, int);
 void idleStateExecute();
 void initReshape(int, int);
+void createFlipbook();
+void loadAssets(GLint, GLint);
+void joinAssetLoader();
+void stopLoadingAssets();
+void finishLoadingAssets();
+void loadPageSources();
+GLint setPageSource(const PageSource*);
+void loadVectorPages();
+void loadAnimations();
+void stopAnimations();
+void reloadPages();
+void drawLibrary(const FrameState*);
+void drawSearchPrompt(const FrameState*);
+void drawScene(const FrameState*);
+void prepareFrame(void*);
+void saveCapture(CommandBuffer*);
+void presentScaledFrame(const FrameState*, std::chrono::steady_clock::time_point);
+unsigned long countFrameAllocations();
 void display();
+void setThreadedRendering(int);
+void setDynamicResolution(int);
 void mykeyboard(unsigned char, GLint,GLint);
+void mySpecialKeys(int, int, int);
+void typeSearchQuery(unsigned char);
+void searchBook();
+void showPage(GLint);
+void setOverview(int);
+void scrollOverview(GLfloat);
+void myMouseClick(int, int, int, int);
+Book *shelfBook(GLint);
+Book *openedBook(GLint);
+void openBook(GLint);
+void openPulledBook();
+void myMouseMovement(int, int);
 void mymenu(int);
+void dispatchInput(const InputEvent*);
+void replayInput();
+void stopInputJournal();
 #endif